@@ -146,6 +146,10 @@
 # build on non-x86:
 #set (CMAKE_POSITION_INDEPENDENT_CODE TRUE)
 
+# Use a system LAPACK/BLAS for the dense linear solvers (e.g., in greenspline)
+# instead of the built-in multithreaded ones [FALSE]:
+#set (GMT_USE_LAPACK TRUE)
+
 # Build GMT shared lib with supplemental modules [TRUE]:
 #set (BUILD_SUPPLEMENTS FALSE)
 
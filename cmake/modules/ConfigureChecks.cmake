@@ -115,6 +115,7 @@ check_include_file (fcntl.h             HAVE_FCNTL_H_)
 check_include_file (signal.h            HAVE_SIGNAL_H_)
 check_include_file (stdbool.h           HAVE_STDBOOL_H_)
 check_include_file (sys/dir.h           HAVE_SYS_DIR_H_)
+check_include_file (sys/mman.h          HAVE_SYS_MMAN_H_)
 check_include_file (sys/resource.h      HAVE_SYS_RESOURCE_H_)
 check_include_file (sys/stat.h          HAVE_SYS_STAT_H_)
 check_include_file (sys/time.h          HAVE_SYS_TIME_H_)
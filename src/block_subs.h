@@ -29,10 +29,12 @@
 #define BLOCKMEDIAN_CTRL BLOCK_CTRL
 #define NEW_BLK New_blockmedian_Ctrl
 #define FREE_BLK Free_blockmedian_Ctrl
+#define SORT_BLK blockmedian_sort_by_cell
 #else
 #define BLOCKMODE_CTRL BLOCK_CTRL
 #define NEW_BLK New_blockmode_Ctrl
 #define FREE_BLK Free_blockmode_Ctrl
+#define SORT_BLK blockmode_sort_by_cell
 #endif
 
 struct BLOCK_CTRL {	/* All control options for this program (except common args) */
@@ -147,6 +149,20 @@ struct BLK_PAIR {	/* Used for weighted mean location */
 struct BLK_SLHG {	/* Holds std, low, high, and sigma^2 values */
 	double a[4];	/* a[0] = w.std, a[1] = min, a[2] = max, a[3] = sigma^2 */
 };
+
+#define BLK_HASH_EMPTY	UINT64_MAX		/* Marks an unused hash table entry */
+#define BLK_DENSE_MAX	268435456U		/* Use sparse accumulators if dense arrays would need more than 256 Mb */
+
+struct BLK_NODE {	/* One hash table entry: a block node and its accumulator slot */
+	uint64_t node;	/* Block node (BLK_HASH_EMPTY if unused) */
+	uint64_t slot;	/* Index into the compact accumulator arrays */
+};
+
+struct BLK_HASH {	/* Maps occupied block nodes to compact accumulator slots */
+	uint64_t n_used;	/* Number of occupied blocks, i.e., slots handed out so far */
+	uint64_t mask;		/* Table size - 1; the table size is a power of 2 */
+	struct BLK_NODE *entry;	/* The hash table */
+};
 #else	/* Only used by blockmedian and blockmode */
 #define BLK_DO_EXTEND3	1
 #define BLK_DO_EXTEND4	2
@@ -187,10 +203,128 @@ void FREE_BLK (struct GMT_CTRL *GMT, struct  BLOCK_CTRL *C) {	/* Deallocate cont
 	GMT_free (GMT, C);	
 }
 
-#if !defined(BLOCKMEAN)	/* Only used by blockmean */
+#if defined(BLOCKMEAN)	/* Only used by blockmean */
+struct BLK_HASH * BLK_hash_create (struct GMT_CTRL *GMT, uint64_t n) {
+	/* Create empty hash table with room for at least n occupied blocks at 50% load */
+	uint64_t k, size = 1024;
+	struct BLK_HASH *H = GMT_memory (GMT, NULL, 1, struct BLK_HASH);
+	while (size < 2 * n) size <<= 1;
+	H->mask = size - 1;
+	H->entry = GMT_memory (GMT, NULL, size, struct BLK_NODE);
+	for (k = 0; k < size; k++) H->entry[k].node = BLK_HASH_EMPTY;
+	return (H);
+}
+
+void BLK_hash_free (struct GMT_CTRL *GMT, struct BLK_HASH **H) {
+	if (*H == NULL) return;
+	GMT_free (GMT, (*H)->entry);
+	GMT_free (GMT, *H);
+}
+
+static inline uint64_t blk_hash_first (struct BLK_HASH *H, uint64_t node) {
+	/* Starting table position for this node (Fibonacci hashing) */
+	uint64_t h = node * 0x9E3779B97F4A7C15ULL;
+	return ((h ^ (h >> 32)) & H->mask);
+}
+
+uint64_t BLK_hash_slot (struct GMT_CTRL *GMT, struct BLK_HASH *H, uint64_t node) {
+	/* Return accumulator slot for this block node.  New nodes get the next free slot,
+	 * so slots are handed out as 0, 1, 2, ... and the caller can detect a new block
+	 * by the returned slot being equal to the previous value of H->n_used. */
+	uint64_t k = blk_hash_first (H, node);
+
+	while (H->entry[k].node != BLK_HASH_EMPTY) {	/* Linear probing */
+		if (H->entry[k].node == node) return (H->entry[k].slot);
+		k = (k + 1) & H->mask;
+	}
+	if (2 * (H->n_used + 1) > H->mask + 1) {	/* Table would get more than half full; double it and rehash */
+		uint64_t j, old_size = H->mask + 1;
+		struct BLK_NODE *old = H->entry;
+		H->mask = 2 * old_size - 1;
+		H->entry = GMT_memory (GMT, NULL, 2 * old_size, struct BLK_NODE);
+		for (j = 0; j <= H->mask; j++) H->entry[j].node = BLK_HASH_EMPTY;
+		for (j = 0; j < old_size; j++) {
+			if (old[j].node == BLK_HASH_EMPTY) continue;
+			k = blk_hash_first (H, old[j].node);
+			while (H->entry[k].node != BLK_HASH_EMPTY) k = (k + 1) & H->mask;
+			H->entry[k] = old[j];
+		}
+		GMT_free (GMT, old);
+		k = blk_hash_first (H, node);
+		while (H->entry[k].node != BLK_HASH_EMPTY) k = (k + 1) & H->mask;
+	}
+	H->entry[k].node = node;
+	H->entry[k].slot = H->n_used++;
+	return (H->entry[k].slot);
+}
+
+int BLK_compare_node (const void *point_1, const void *point_2) {
+	const struct BLK_NODE *p1 = point_1, *p2 = point_2;
+	if (p1->node < p2->node) return (-1);
+	if (p1->node > p2->node) return (+1);
+	return (0);
+}
+
+struct BLK_NODE * BLK_hash_sorted (struct GMT_CTRL *GMT, struct BLK_HASH *H) {
+	/* Compact the used table entries to the front and sort them on node so that blocks
+	 * can be reported in the same order as when using dense arrays.  The table can no
+	 * longer be used for lookups after this. */
+	uint64_t j, k;
+	for (j = k = 0; j <= H->mask; j++) if (H->entry[j].node != BLK_HASH_EMPTY) H->entry[k++] = H->entry[j];
+	qsort (H->entry, k, sizeof (struct BLK_NODE), BLK_compare_node);
+	GMT_Report (GMT->parent, GMT_MSG_DEBUG, "Sorted %" PRIu64 " occupied blocks\n", k);
+	return (H->entry);
+}
+#else
 /* blockmedian and blockmode */
 EXTERN_MSC int BLK_compare_x (const void *point_1, const void *point_2);
 EXTERN_MSC int BLK_compare_y (const void *point_1, const void *point_2);
 EXTERN_MSC int BLK_compare_index_z (const void *point_1, const void *point_2);
 EXTERN_MSC int BLK_compare_sub (const void *point_1, const void *point_2, int item);
+
+void SORT_BLK (struct GMT_CTRL *GMT, struct BLK_DATA *data, uint64_t n, uint64_t nm)
+{	/* Sort data on cell index ij, then on z within each cell.  Rather than sorting all n records
+	 * we first partition them into cells in place (American flag sort: count, then swap each
+	 * record directly into its cell), which takes linear time, and then sort each cell on z.
+	 * Cells are independent so those sorts are shared among threads.  The partition needs two
+	 * counters per cell, so for grids with many more cells than points we just sort it all. */
+	uint64_t c, k, *start = NULL, *next = NULL;
+	int64_t cell;
+	struct BLK_DATA tmp;
+
+	if (nm > 2 * n) {	/* Counters would use more memory than the data; do the full sort instead */
+		qsort (data, n, sizeof (struct BLK_DATA), BLK_compare_index_z);
+		return;
+	}
+
+	start = GMT_memory (GMT, NULL, nm + 1, uint64_t);
+	next  = GMT_memory (GMT, NULL, nm, uint64_t);
+	for (k = 0; k < n; k++) start[data[k].ij+1]++;	/* Count records per cell */
+	for (c = 0; c < nm; c++) {	/* Turn counts into starting positions */
+		start[c+1] += start[c];
+		next[c] = start[c];
+	}
+	for (c = 0; c < nm; c++) {	/* Move all records that belong in cell c into place */
+		while (next[c] < start[c+1]) {
+			k = data[next[c]].ij;
+			if (k == c)	/* Already in the right cell */
+				next[c]++;
+			else {	/* Swap it into the next free slot of its own cell */
+				tmp = data[next[k]];	data[next[k]] = data[next[c]];	data[next[c]] = tmp;
+				next[k]++;
+			}
+		}
+	}
+	GMT_free (GMT, next);
+
+	/* Now sort each cell on z */
+#ifdef _OPENMP
+#pragma omp parallel for private(cell) shared(data,start,nm) schedule(dynamic,1024)
+#endif
+	for (cell = 0; cell < (int64_t)nm; cell++) {
+		if (start[cell+1] - start[cell] > 1)
+			qsort (&data[start[cell]], start[cell+1] - start[cell], sizeof (struct BLK_DATA), BLK_compare_index_z);
+	}
+	GMT_free (GMT, start);
+}
 #endif
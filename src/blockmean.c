@@ -165,13 +165,31 @@ int GMT_blockmean_parse (struct GMT_CTRL *GMT, struct BLOCKMEAN_CTRL *Ctrl, stru
 	return (n_errors ? GMT_PARSE_ERROR : GMT_OK);
 }
 
+void blockmean_alloc (struct GMT_CTRL *GMT, struct BLOCKMEAN_CTRL *Ctrl, uint64_t n_old, uint64_t n_new, struct BLK_PAIR **zw, struct BLK_PAIR **xy, struct BLK_SLHG **slhg, uint64_t **np)
+{	/* Allocate or extend the block accumulator arrays from n_old to n_new entries; new entries are zeroed */
+	*zw = GMT_memory (GMT, *zw, n_new, struct BLK_PAIR);
+	GMT_memset (&(*zw)[n_old], n_new - n_old, struct BLK_PAIR);
+	if (!Ctrl->C.active) {	/* Need weighted x,y sums */
+		*xy = GMT_memory (GMT, *xy, n_new, struct BLK_PAIR);
+		GMT_memset (&(*xy)[n_old], n_new - n_old, struct BLK_PAIR);
+	}
+	if (Ctrl->E.active) {	/* Need sums for extended attributes */
+		*slhg = GMT_memory (GMT, *slhg, n_new, struct BLK_SLHG);
+		GMT_memset (&(*slhg)[n_old], n_new - n_old, struct BLK_SLHG);
+		if (Ctrl->W.weighted[GMT_IN]) {
+			*np = GMT_memory (GMT, *np, n_new, uint64_t);
+			GMT_memset (&(*np)[n_old], n_new - n_old, uint64_t);
+		}
+	}
+}
+
 /* Must free allocated memory before returning */
 #define bailout(code) {GMT_Free_Options (mode); return (code);}
-#define Return(code) {GMT_Destroy_Data (API, &Grid); GMT_free (GMT, zw); if (xy) GMT_free (GMT, xy); if (np) GMT_free (GMT, np); if (slhg) GMT_free (GMT, slhg); Free_blockmean_Ctrl (GMT, Ctrl); GMT_end_module (GMT, GMT_cpy); bailout(code);}
+#define Return(code) {GMT_Destroy_Data (API, &Grid); if (zw) GMT_free (GMT, zw); if (xy) GMT_free (GMT, xy); if (np) GMT_free (GMT, np); if (slhg) GMT_free (GMT, slhg); BLK_hash_free (GMT, &hash); Free_blockmean_Ctrl (GMT, Ctrl); GMT_end_module (GMT, GMT_cpy); bailout(code);}
 
 int GMT_blockmean (void *V_API, int mode, void *args)
 {
-	uint64_t node, n_cells_filled, n_read, n_lost, n_pitched, w_col, *np = NULL;
+	uint64_t node, k, k_slot, n_out, n_alloc = 0, n_cells_filled, n_read, n_lost, n_pitched, w_col, *np = NULL;
 	unsigned int row, col;
 	int error;
 	bool use_xy, use_weight, duplicate_col;
@@ -184,6 +202,8 @@ int GMT_blockmean (void *V_API, int mode, void *args)
 	struct GMT_GRID *Grid = NULL;
 	struct BLK_PAIR *xy = NULL, *zw = NULL;
 	struct BLK_SLHG *slhg = NULL;
+	struct BLK_HASH *hash = NULL;
+	struct BLK_NODE *order = NULL;
 	struct BLOCKMEAN_CTRL *Ctrl = NULL;
 	struct GMT_CTRL *GMT = NULL, *GMT_cpy = NULL;
 	struct GMTAPI_CTRL *API = GMT_get_API_ptr (V_API);	/* Cast from void to GMTAPI_CTRL pointer */
@@ -214,10 +234,6 @@ int GMT_blockmean (void *V_API, int mode, void *args)
 	duplicate_col = (GMT_360_RANGE (Grid->header->wesn[XLO], Grid->header->wesn[XHI]) && Grid->header->registration == GMT_GRID_NODE_REG);	/* E.g., lon = 0 column should match lon = 360 column */
 	half_dx = 0.5 * Grid->header->inc[GMT_X];
 	use_xy = !Ctrl->C.active;	/* If not -C then we must keep track of x,y locations */
-	zw = GMT_memory (GMT, NULL, Grid->header->nm, struct BLK_PAIR);
-	if (use_xy) xy = GMT_memory (GMT, NULL, Grid->header->nm, struct BLK_PAIR);
-	if (Ctrl->E.active) slhg = GMT_memory (GMT, NULL, Grid->header->nm, struct BLK_SLHG);
-	if (Ctrl->W.weighted[GMT_IN] && Ctrl->E.active) np = GMT_memory (GMT, NULL, Grid->header->nm, uint64_t);
 
 	/* Specify input and output expected columns */
 	if ((error = GMT_set_cols (GMT, GMT_IN,  3 + Ctrl->W.weighted[GMT_IN])) != GMT_OK) {
@@ -241,7 +257,7 @@ int GMT_blockmean (void *V_API, int mode, void *args)
 		GMT_Report (API, GMT_MSG_VERBOSE, format, Grid->header->wesn[XLO], Grid->header->wesn[XHI], Grid->header->wesn[YLO], Grid->header->wesn[YHI], Grid->header->nx, Grid->header->ny);
 	}
 	
-	if (GMT_is_verbose (GMT, GMT_MSG_LONG_VERBOSE)) {	/* Memory reporting */
+	{	/* Decide between dense per-node arrays and compact per-block arrays found via a hash table */
 		unsigned int kind = 0;
 		size_t n_bytes_per_record = sizeof (struct BLK_PAIR);
 		double mem;
@@ -249,9 +265,17 @@ int GMT_blockmean (void *V_API, int mode, void *args)
 		if (!Ctrl->C.active) n_bytes_per_record += sizeof (struct BLK_PAIR);
 		if (Ctrl->E.active)  n_bytes_per_record += sizeof (struct BLK_SLHG);
 		if (Ctrl->W.weighted[GMT_IN] && Ctrl->E.active) n_bytes_per_record += sizeof (uint64_t);
-		mem = n_bytes_per_record * Grid->header->nm / 1024.0;	/* Report kbytes unless it is too much */
-		while (mem > 1024.0 && kind < 2) { mem /= 1024.0;	kind++; }	/* Goto next higher unit */
-		GMT_Report (API, GMT_MSG_LONG_VERBOSE, "Using a total of %.3g %cb for all arrays.\n", mem, unit[kind]);
+		if (n_bytes_per_record * Grid->header->nm > BLK_DENSE_MAX) {	/* Too much; only allocate space for blocks that receive data */
+			hash = BLK_hash_create (GMT, 0);
+			GMT_Report (API, GMT_MSG_LONG_VERBOSE, "Large grid: Only allocating memory for blocks with data, using %d bytes per block.\n", (int)(n_bytes_per_record + 2 * sizeof (struct BLK_NODE)));
+		}
+		else {	/* Dense arrays where the accumulator slot is simply the node */
+			blockmean_alloc (GMT, Ctrl, 0, Grid->header->nm, &zw, &xy, &slhg, &np);
+			n_alloc = Grid->header->nm;
+			mem = n_bytes_per_record * Grid->header->nm / 1024.0;	/* Report kbytes unless it is too much */
+			while (mem > 1024.0 && kind < 2) { mem /= 1024.0;	kind++; }	/* Goto next higher unit */
+			GMT_Report (API, GMT_MSG_LONG_VERBOSE, "Using a total of %.3g %cb for all arrays.\n", mem, unit[kind]);
+		}
 	}
 
 	/* Initialize the i/o for doing record-by-record reading/writing */
@@ -300,23 +324,33 @@ int GMT_blockmean (void *V_API, int mode, void *args)
 		if (use_weight) weight = in[3];		/* Use provided weight instead of 1 */
 		weighted_z = in[GMT_Z] * weight;			/* Weighted value */
 		node = GMT_IJ0 (Grid->header, row, col);		/* Bin node */
+		if (hash) {	/* Look up (or add) the compact slot for this block */
+			k = BLK_hash_slot (GMT, hash, node);
+			if (k == n_alloc) {	/* First point in a new block and we are out of space; grow arrays by 50% */
+				uint64_t n_new = MAX (GMT_CHUNK, n_alloc + n_alloc / 2);
+				blockmean_alloc (GMT, Ctrl, n_alloc, n_new, &zw, &xy, &slhg, &np);
+				n_alloc = n_new;
+			}
+		}
+		else	/* Dense arrays */
+			k = node;
 		if (use_xy) {						/* Must keep track of weighted location */
-			xy[node].a[GMT_X] += (in[GMT_X] * weight);
-			xy[node].a[GMT_Y] += (in[GMT_Y] * weight);
+			xy[k].a[GMT_X] += (in[GMT_X] * weight);
+			xy[k].a[GMT_Y] += (in[GMT_Y] * weight);
 		}
 		if (Ctrl->E.active) {	/* Add up sum (w*z^2) and n for weighted stdev and keep track of min,max */
-			slhg[node].a[BLK_S] += (weighted_z * in[GMT_Z]);
-			if (Ctrl->W.weighted[GMT_IN]) np[node]++;
-			if (zw[node].a[BLK_W] == 0.0) {	/* Initialize low,high the first time */
-				slhg[node].a[BLK_L] = +DBL_MAX;
-				slhg[node].a[BLK_H] = -DBL_MAX;
+			slhg[k].a[BLK_S] += (weighted_z * in[GMT_Z]);
+			if (Ctrl->W.weighted[GMT_IN]) np[k]++;
+			if (zw[k].a[BLK_W] == 0.0) {	/* Initialize low,high the first time */
+				slhg[k].a[BLK_L] = +DBL_MAX;
+				slhg[k].a[BLK_H] = -DBL_MAX;
 			}
-			if (in[GMT_Z] < slhg[node].a[BLK_L]) slhg[node].a[BLK_L] = in[GMT_Z];
-			if (in[GMT_Z] > slhg[node].a[BLK_H]) slhg[node].a[BLK_H] = in[GMT_Z];
-			if (Ctrl->E.mode == 1) slhg[node].a[BLK_G] += 1.0 / weight;	/* Sum of sigma squared*/
+			if (in[GMT_Z] < slhg[k].a[BLK_L]) slhg[k].a[BLK_L] = in[GMT_Z];
+			if (in[GMT_Z] > slhg[k].a[BLK_H]) slhg[k].a[BLK_H] = in[GMT_Z];
+			if (Ctrl->E.mode == 1) slhg[k].a[BLK_G] += 1.0 / weight;	/* Sum of sigma squared*/
 		}
-		zw[node].a[BLK_W] += weight;		/* Sum up the weights */
-		zw[node].a[BLK_Z] += weighted_z;	/* Sum up the weighted values */
+		zw[k].a[BLK_W] += weight;		/* Sum up the weights */
+		zw[k].a[BLK_Z] += weighted_z;	/* Sum up the weighted values */
 		n_pitched++;				/* Number of points actually used */
 	} while (true);
 
@@ -359,16 +393,29 @@ int GMT_blockmean (void *V_API, int mode, void *args)
 		Return (API->error);
 	}
 
-	for (node = 0; node < Grid->header->nm; node++) {	/* Visit all possible blocks to see if they were visited */
+	if (hash) {	/* Visit only the occupied blocks, in node order */
+		order = BLK_hash_sorted (GMT, hash);
+		n_out = hash->n_used;
+	}
+	else
+		n_out = Grid->header->nm;
+
+	for (k = 0; k < n_out; k++) {	/* Visit all possible blocks to see if they were visited */
 
-		if (zw[node].a[BLK_W] == 0.0) continue;	/* No values in this block; skip */
+		if (hash) {	/* Get node and its compact slot */
+			node = order[k].node;
+			k_slot = order[k].slot;
+		}
+		else
+			node = k_slot = k;
+		if (zw[k_slot].a[BLK_W] == 0.0) continue;	/* No values in this block; skip */
 
 		n_cells_filled++;	/* Increase number of blocks with values found so far */
-		if (Ctrl->W.weighted[GMT_OUT]) out[w_col] = zw[node].a[BLK_W];
-		iw = 1.0 / zw[node].a[BLK_W];	/* Inverse weight to avoid divisions later */
+		if (Ctrl->W.weighted[GMT_OUT]) out[w_col] = zw[k_slot].a[BLK_W];
+		iw = 1.0 / zw[k_slot].a[BLK_W];	/* Inverse weight to avoid divisions later */
 		if (use_xy) {	/* Determine and report mean point location */
-			out[GMT_X] = xy[node].a[GMT_X] * iw;
-			out[GMT_Y] = xy[node].a[GMT_Y] * iw;
+			out[GMT_X] = xy[k_slot].a[GMT_X] * iw;
+			out[GMT_Y] = xy[k_slot].a[GMT_Y] * iw;
 		}
 		else {		/* Report block center */
 			col = (unsigned int)GMT_col (Grid->header, node);
@@ -377,25 +424,25 @@ int GMT_blockmean (void *V_API, int mode, void *args)
 			out[GMT_Y] = GMT_grd_row_to_y (GMT, row, Grid->header);
 		}
 		if (Ctrl->S.mode)	/* Report block sums or weights */
-			out[GMT_Z] = (Ctrl->S.mode >= 2) ? zw[node].a[BLK_W] : zw[node].a[BLK_Z];
+			out[GMT_Z] = (Ctrl->S.mode >= 2) ? zw[k_slot].a[BLK_W] : zw[k_slot].a[BLK_Z];
 		else			/* Report block means */
-			out[GMT_Z] = zw[node].a[BLK_Z] * iw;
+			out[GMT_Z] = zw[k_slot].a[BLK_Z] * iw;
 		if (Ctrl->E.active) {	/* Compute and report extended attributes */
 			if (Ctrl->W.weighted[GMT_IN]) {	/* Weighted standard deviation */
 				if (Ctrl->E.mode == 1) {	/* Error propagation assuming weights were 1/sigma^2 */
-					out[3] = d_sqrt (slhg[node].a[BLK_G]) / np[node];
+					out[3] = d_sqrt (slhg[k_slot].a[BLK_G]) / np[k_slot];
 				}
 				else {
-					out[3] = (np[node] > 1) ? d_sqrt ((zw[node].a[BLK_W] * slhg[node].a[BLK_S] - zw[node].a[BLK_Z] * zw[node].a[BLK_Z]) \
-					/ (zw[node].a[BLK_W] * zw[node].a[BLK_W] * ((np[node] - 1.0) / np[node]))) : GMT->session.d_NaN;
+					out[3] = (np[k_slot] > 1) ? d_sqrt ((zw[k_slot].a[BLK_W] * slhg[k_slot].a[BLK_S] - zw[k_slot].a[BLK_Z] * zw[k_slot].a[BLK_Z]) \
+					/ (zw[k_slot].a[BLK_W] * zw[k_slot].a[BLK_W] * ((np[k_slot] - 1.0) / np[k_slot]))) : GMT->session.d_NaN;
 				}
 			}
 			else {					/* Normal standard deviation */
-				out[3] = (zw[node].a[BLK_W] > 1.0) ? d_sqrt ((zw[node].a[BLK_W] * slhg[node].a[BLK_S] - zw[node].a[BLK_Z] * zw[node].a[BLK_Z]) \
-				/ (zw[node].a[BLK_W] * (zw[node].a[BLK_W] - 1.0))) : GMT->session.d_NaN;
+				out[3] = (zw[k_slot].a[BLK_W] > 1.0) ? d_sqrt ((zw[k_slot].a[BLK_W] * slhg[k_slot].a[BLK_S] - zw[k_slot].a[BLK_Z] * zw[k_slot].a[BLK_Z]) \
+				/ (zw[k_slot].a[BLK_W] * (zw[k_slot].a[BLK_W] - 1.0))) : GMT->session.d_NaN;
 			}
-			out[4] = slhg[node].a[BLK_L];	/* Minimum value in block */
-			out[5] = slhg[node].a[BLK_H];	/* Maximum value in block */
+			out[4] = slhg[k_slot].a[BLK_L];	/* Minimum value in block */
+			out[5] = slhg[k_slot].a[BLK_H];	/* Maximum value in block */
 		}
 		GMT_Put_Record (API, GMT_WRITE_DOUBLE, out);	/* Write this to output */
 	}
@@ -424,7 +424,7 @@ int GMT_blockmedian (void *V_API, int mode, void *args)
 
 	/* Sort on node and Z value */
 
-	qsort (data, n_pitched, sizeof (struct BLK_DATA), BLK_compare_index_z);
+	SORT_BLK (GMT, data, n_pitched, Grid->header->size);
 
 	/* Find n_in_cell and write appropriate output  */
 
@@ -583,7 +583,7 @@ int GMT_blockmode (void *V_API, int mode, void *args)
 
 	/* Sort on node and Z value */
 
-	qsort (data, n_pitched, sizeof (struct BLK_DATA), BLK_compare_index_z);
+	SORT_BLK (GMT, data, n_pitched, Grid->header->size);
 
 	if (Ctrl->D.active) {	/* Choose to compute unweighted modes by histogram binning */
 		B = bin_setup (GMT, data, Ctrl->D.width, Ctrl->D.center, Ctrl->D.mode, is_integer, n_pitched, GMT_Z);
@@ -877,6 +877,8 @@ int gmt_open_grd (struct GMT_CTRL *GMT, char *file, struct GMT_GRID *G, char mod
 		R->edge[1] = G->header->nx;
 		R->start[0] = G->header->ny-1;
 		R->start[1] = 0;
+		if (r_w == 0 && GMT->current.setting.io_nc4_tile_cache)	/* Page chunks in and out of a tile cache, if the grid is chunked */
+			R->cache = GMT_nc_tile_open (GMT, R->fid, G->header, (size_t)GMT->current.setting.io_nc4_tile_cache * 1048576U);
 	}
 	else {		/* Regular binary file with/w.o standard GMT header, or Sun rasterfile */
 		if (r_w == 0) {	/* Open for plain reading */
@@ -912,6 +914,7 @@ void gmt_close_grd (struct GMT_CTRL *GMT, struct GMT_GRID *G)
 {
 	struct GMT_GRID_ROWBYROW *R = gmt_get_rbr_ptr (G->extra);	/* Shorthand to row-by-row book-keeping structure */
 	if (R->v_row) GMT_free (GMT, R->v_row);
+	if (R->cache) GMT_nc_tile_close (GMT, &R->cache);
 	if (GMT->session.grdformat[G->header->type][0] == 'c' || GMT->session.grdformat[G->header->type][0] == 'n')
 		nc_close (R->fid);
 	else
@@ -4978,7 +4981,12 @@ int GMT_Get_Row (void *V_API, int row_no, struct GMT_GRID *G, float *row)
 			R->row = row_no;
 			R->start[0] = G->header->ny - 1 - R->row;
 		}
-		GMT_err_trap (nc_get_vara_float (R->fid, G->header->z_id, R->start, R->edge, row));
+		if (R->cache) {	/* Chunked grid; assemble row from cached tiles */
+			GMT_err_trap (GMT_nc_tile_read_row (GMT, R->cache, R->row, row));
+		}
+		else {
+			GMT_err_trap (nc_get_vara_float (R->fid, G->header->z_id, R->start, R->edge, row));
+		}
 		if (R->auto_advance) R->start[0] --;	/* Advance to next row if auto */
 	}
 	else {			/* Get a native binary row */
@@ -73,6 +73,8 @@
  *
  *	GMT_bcr_init		Initialize structure for convolution interpolation
  *	GMT_get_bcr_z		Get interpolated grid value by convolution
+ *	GMT_get_bcr_weights	Get kernel node and weights for a point in a grid
+ *	GMT_get_bcr_z_weights	Get interpolated grid value from precomputed weights
  *	GMT_get_bcr_img		Get interpolated image value(s) by convolution
  */
 
@@ -225,23 +227,27 @@ uint64_t gmt_bcr_prep (struct GMT_GRID_HEADER *h, double xx, double yy, double w
 	return (ij);
 }
 
-double GMT_get_bcr_z (struct GMT_CTRL *GMT, struct GMT_GRID *G, double xx, double yy)
+unsigned int GMT_get_bcr_weights (struct GMT_GRID_HEADER *h, double xx, double yy, uint64_t *ij, double wx[], double wy[])
 {
-	/* Given xx, yy in user's grid file (in non-normalized units)
-	   this routine returns the desired interpolated value (nearest-neighbor, bilinear
-	   B-spline or bicubic) at xx, yy. */
-
-	unsigned int i, j;
-	uint64_t ij, node;
-	double retval, wsum, wx[4], wy[4], w;
-
-	/* First check that xx,yy are not Nan or outside domain - if so return NaN */
-
-	if (gmt_bcr_reject (G->header, &xx, &yy)) return (GMT->session.d_NaN);	/* NaNs or outside */
+	/* Given xx, yy in user's grid file (in non-normalized units), determine the
+	   upper left node ij of the convolution kernel and the weights wx, wy.
+	   Returns nonzero if xx,yy is NaN or outside the domain.  Since the result
+	   only depends on the header, it can be reused by GMT_get_bcr_z_weights for
+	   any number of grids that share this header. */
+
+	if (gmt_bcr_reject (h, &xx, &yy)) return (1);	/* NaNs or outside */
+	*ij = gmt_bcr_prep (h, xx, yy, wx, wy);
+	return (0);
+}
 
-	/* Determine nearest node ij and set weights wx, wy */
+double GMT_get_bcr_z_weights (struct GMT_CTRL *GMT, struct GMT_GRID *G, uint64_t ij, double wx[], double wy[])
+{
+	/* Returns the interpolated value given the kernel node ij and weights wx, wy
+	   as determined by GMT_get_bcr_weights for this grid's header. */
 
-	ij = gmt_bcr_prep (G->header, xx, yy, wx, wy);
+	unsigned int i, j;
+	uint64_t node;
+	double retval, wsum, w;
 
 	retval = wsum = 0.0;
 	for (j = 0; j < G->header->bcr_n; j++) {
@@ -268,6 +274,26 @@ double GMT_get_bcr_z (struct GMT_CTRL *GMT, struct GMT_GRID *G, double xx, doubl
 	return (GMT->session.d_NaN);
 }
 
+double GMT_get_bcr_z (struct GMT_CTRL *GMT, struct GMT_GRID *G, double xx, double yy)
+{
+	/* Given xx, yy in user's grid file (in non-normalized units)
+	   this routine returns the desired interpolated value (nearest-neighbor, bilinear
+	   B-spline or bicubic) at xx, yy. */
+
+	uint64_t ij;
+	double wx[4], wy[4];
+
+	/* First check that xx,yy are not Nan or outside domain - if so return NaN */
+
+	if (gmt_bcr_reject (G->header, &xx, &yy)) return (GMT->session.d_NaN);	/* NaNs or outside */
+
+	/* Determine nearest node ij and set weights wx, wy */
+
+	ij = gmt_bcr_prep (G->header, xx, yy, wx, wy);
+
+	return (GMT_get_bcr_z_weights (GMT, G, ij, wx, wy));
+}
+
 int GMT_get_bcr_img (struct GMT_CTRL *GMT, struct GMT_IMAGE *G, double xx, double yy, unsigned char *z)
 {
 	/* Given xx, yy in user's image file (in non-normalized units)
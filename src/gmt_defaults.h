@@ -98,6 +98,7 @@ struct GMT_DEFAULTS {	/* Holds all variables directly controlled by GMT Default
 	unsigned int io_nan_mode;		/* -s: 1 means skip NaN (x,y) records on output, 2 = inverse (only output nan-records; -sr), 0 reports all records */
 	size_t io_nc4_chunksize[2]; /* NetCDF chunk size (lat,lon) on output [0] */
 	unsigned int io_nc4_deflation_level;	/* NetCDF deflation level on output [0] */
+	unsigned int io_nc4_tile_cache;		/* Memory (MiB) for caching netCDF chunks during row-by-row input [256] */
 	bool io_gridfile_shorthand;		/* Use shorthand suffix notation for embedded grid file formats [false] */
 	bool io_header[2];			/* Input & Output data has header records [false, false] */
 	bool io_nan_records;			/* Determines what NaNs in input records should mean (beyond skipping the record) */
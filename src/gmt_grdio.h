@@ -93,6 +93,8 @@ struct GMT_GRID_INFO {	/* Holds any -R -I -F settings passed indirectly via -R<g
 	bool active;		/* true if initialized via -R */
 };
 
+struct GMT_GRID_TILECACHE;	/* Opaque; defined in gmt_nc.c */
+
 struct GMT_GRID_ROWBYROW {	/* Holds book-keeping information needed for row-by-row actions */
 	size_t size;		/* Bytes per item [4 for float, 1 for byte, etc] */
 	size_t n_byte;		/* Number of bytes for row */
@@ -104,6 +106,7 @@ struct GMT_GRID_ROWBYROW {	/* Holds book-keeping information needed for row-by-r
 	int fid;		/* NetCDF file number [netcdf files only] */
 	size_t edge[2];		/* Dimension arrays [netcdf files only] */
 	size_t start[2];	/* Position arrays [netcdf files only] */
+	struct GMT_GRID_TILECACHE *cache;	/* Tile cache for chunked grids, or NULL [netcdf files only] */
 
 	FILE *fp;		/* File pointer [for native files] */
 
@@ -4197,6 +4197,16 @@ unsigned int gmt_setparameter (struct GMT_CTRL *GMT, char *keyword, char *value)
 			else
 				error = true;
 			break;
+		case GMTCASE_IO_NC4_TILE_CACHE:
+			if (!strcmp (lower_value, "false"))
+				ival = 0;
+			else
+				ival = atoi (value);
+			if (ival >= 0)
+				GMT->current.setting.io_nc4_tile_cache = ival;
+			else
+				error = true;
+			break;
 		case GMTCASE_XY_TOGGLE:
 			if (GMT_compat_check (GMT, 4))	/* GMT4: */
 				GMT_COMPAT_CHANGE ("IO_LONLAT_TOGGLE");
@@ -5267,6 +5277,9 @@ char *GMT_putparameter (struct GMT_CTRL *GMT, char *keyword)
 		case GMTCASE_IO_NC4_DEFLATION_LEVEL:
 			sprintf (value, "%u", GMT->current.setting.io_nc4_deflation_level);
 			break;
+		case GMTCASE_IO_NC4_TILE_CACHE:
+			sprintf (value, "%u", GMT->current.setting.io_nc4_tile_cache);
+			break;
 		case GMTCASE_XY_TOGGLE:
 			if (GMT_compat_check (GMT, 4))	/* GMT4: */
 				GMT_COMPAT_WARN;
@@ -6333,6 +6346,7 @@ void GMT_end (struct GMT_CTRL *GMT)
 
 	if (GMT->init.runtime_bindir) {free (GMT->init.runtime_bindir); GMT->init.runtime_bindir = NULL;}
 	if (GMT->init.runtime_libdir) {free (GMT->init.runtime_libdir); GMT->init.runtime_libdir = NULL;}
+	GMT_grd_project_free_cache (GMT);
 	free (GMT->session.SHAREDIR); GMT->session.SHAREDIR = NULL;
 	free (GMT->session.HOMEDIR); GMT->session.HOMEDIR = NULL;
 	if (GMT->session.DATADIR) {free (GMT->session.DATADIR); GMT->session.DATADIR = NULL;}
@@ -6367,6 +6381,8 @@ void GMT_end (struct GMT_CTRL *GMT)
 	fflush (GMT->session.std[GMT_OUT]);	/* Make sure output buffer is flushed */
 
 	GMT_free_ogr (GMT, &(GMT->current.io.OGR), 1);	/* Free up the GMT/OGR structure, if used */
+	GMT_free_ascii_block (GMT);			/* Free ascii read-ahead buffer, if used */
+	GMT_free_binary_block (GMT);			/* Free binary read-ahead buffer, if used */
 	GMT_free_tmp_arrays (GMT);			/* Free emp memory for vector io or processing */
 	gmt_free_user_media (GMT);
 	/* Terminate PSL machinery (if used) */
@@ -6427,6 +6443,8 @@ struct GMT_CTRL * GMT_begin_module (struct GMTAPI_CTRL *API, const char *lib_nam
 	/* GMT_IO */
 	Csave->current.io.OGR = GMT_duplicate_ogr (GMT, GMT->current.io.OGR);	/* Duplicate OGR struct, if set */
 	GMT_free_ogr (GMT, &(GMT->current.io.OGR), 1);		/* Free up the GMT/OGR structure, if used */
+	GMT->current.io.block = NULL;	/* The module gets its own ascii read-ahead buffer */
+	GMT->current.io.bin_block = NULL;	/* ...and binary read-ahead buffer */
 
 	GMT_memset (Csave->current.io.o_format, GMT_MAX_COLUMNS, char *);
 	for (i = 0; i < GMT_MAX_COLUMNS; i++)
@@ -6492,6 +6510,7 @@ void GMT_end_module (struct GMT_CTRL *GMT, struct GMT_CTRL *Ccopy)
 
 	Ccopy->current.ps.clip_level = GMT->current.ps.clip_level;
 	Ccopy->current.ps.layer = GMT->current.ps.layer;
+	Ccopy->current.grdproj_cache = GMT->current.grdproj_cache;	/* May have been set or replaced by this module */
 
 	/* GMT_COMMON */
 
@@ -6514,6 +6533,8 @@ void GMT_end_module (struct GMT_CTRL *GMT, struct GMT_CTRL *Ccopy)
 	/* GMT_IO */
 
 	GMT_free_ogr (GMT, &(GMT->current.io.OGR), 1);	/* Free up the GMT/OGR structure, if used */
+	GMT_free_ascii_block (GMT);			/* Free ascii read-ahead buffer, if used */
+	GMT_free_binary_block (GMT);			/* Free binary read-ahead buffer, if used */
 	GMT_free_tmp_arrays (GMT);			/* Free emp memory for vector io or processing */
 	for (i = 0; i < GMT_MAX_COLUMNS; i++) if (GMT->current.io.o_format[i]) {
 		free (GMT->current.io.o_format[i]);
@@ -47,9 +47,14 @@ EXTERN_MSC void gmt_plot_C_format (struct GMT_CTRL *GMT);
 EXTERN_MSC void gmt_clock_C_format (struct GMT_CTRL *GMT, char *form, struct GMT_CLOCK_IO *S, unsigned int mode);
 EXTERN_MSC void gmt_date_C_format (struct GMT_CTRL *GMT, char *form, struct GMT_DATE_IO *S, unsigned int mode);
 EXTERN_MSC void * GMT_ascii_textinput (struct GMT_CTRL *GMT, FILE *fp, uint64_t *ncol, int *status);
+EXTERN_MSC void GMT_free_ascii_block (struct GMT_CTRL *GMT);
+EXTERN_MSC void GMT_free_binary_block (struct GMT_CTRL *GMT);
 EXTERN_MSC double GMT_get_map_interval (struct GMT_CTRL *GMT, struct GMT_PLOT_AXIS_ITEM *T);
 EXTERN_MSC unsigned int GMT_log_array (struct GMT_CTRL *GMT, double min, double max, double delta, double **array);
 EXTERN_MSC int GMT_nc_get_att_text (struct GMT_CTRL *GMT, int ncid, int varid, char *name, char *text, size_t textlen);
+EXTERN_MSC struct GMT_GRID_TILECACHE * GMT_nc_tile_open (struct GMT_CTRL *GMT, int ncid, struct GMT_GRID_HEADER *header, size_t budget);
+EXTERN_MSC int GMT_nc_tile_read_row (struct GMT_CTRL *GMT, struct GMT_GRID_TILECACHE *C, unsigned int row, float *z);
+EXTERN_MSC void GMT_nc_tile_close (struct GMT_CTRL *GMT, struct GMT_GRID_TILECACHE **C);
 EXTERN_MSC int GMT_akima (struct GMT_CTRL *GMT, double *x, double *y, uint64_t nx, double *c);
 EXTERN_MSC int GMT_cspline (struct GMT_CTRL *GMT, double *x, double *y, uint64_t n, double *c);
 EXTERN_MSC bool GMT_annot_pos (struct GMT_CTRL *GMT, double min, double max, struct GMT_PLOT_AXIS_ITEM *T, double coord[], double *pos);
@@ -208,6 +213,12 @@ EXTERN_MSC void GMT_utm (struct GMT_CTRL *GMT, double lon, double lat, double *x
 EXTERN_MSC void GMT_iutm (struct GMT_CTRL *GMT, double *lon, double *lat, double x, double y);		/* Convert x/y (UTM) to lon/lat 	*/
 EXTERN_MSC void GMT_utm_sph (struct GMT_CTRL *GMT, double lon, double lat, double *x, double *y);		/* Convert lon/lat to x/y (UTM Spherical)	*/
 EXTERN_MSC void GMT_iutm_sph (struct GMT_CTRL *GMT, double *lon, double *lat, double x, double y);	/* Convert x/y (UTM Spherical) to lon/lat 	*/
+EXTERN_MSC void gmt_linearxy (struct GMT_CTRL *GMT, double x, double y, double *x_i, double *y_i);	/* Convert x/y to x/y (Linear)	*/
+EXTERN_MSC void gmt_ilinearxy (struct GMT_CTRL *GMT, double *x, double *y, double x_i, double y_i);	/* Convert x/y (Linear) to x/y	*/
+EXTERN_MSC void GMT_grd_project_free_cache (struct GMT_CTRL *GMT);
+EXTERN_MSC bool GMT_proj_is_reentrant (struct GMT_CTRL *GMT);	/* true if current projection may be used by several threads	*/
+EXTERN_MSC bool GMT_proj_fwd_n (struct GMT_CTRL *GMT, double *lon, double *lat, double *x, double *y, uint64_t n);	/* Convert n lon/lat to x/y, if supported	*/
+EXTERN_MSC bool GMT_proj_inv_n (struct GMT_CTRL *GMT, double *lon, double *lat, double *x, double *y, uint64_t n);	/* Convert n x/y to lon/lat, if supported	*/
 EXTERN_MSC void GMT_winkel (struct GMT_CTRL *GMT, double lon, double lat, double *x, double *y);		/* Convert lon/lat to x/y (Winkel)	*/
 EXTERN_MSC void GMT_iwinkel (struct GMT_CTRL *GMT, double *lon, double *lat, double x, double y);		/* Convert x/y (Winkel) to lon/lat	*/
 EXTERN_MSC void GMT_eckert4 (struct GMT_CTRL *GMT, double lon, double lat, double *x, double *y);		/* Convert lon/lat to x/y (Eckert IV)	*/
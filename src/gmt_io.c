@@ -99,6 +99,8 @@ EXTERN_MSC int GMTAPI_Unregister_IO (struct GMTAPI_CTRL *API, int object_ID, uns
 EXTERN_MSC int GMTAPI_Validate_ID (struct GMTAPI_CTRL *API, int family, int object_ID, int direction);
 
 uint64_t gmt_bin_colselect (struct GMT_CTRL *GMT);
+static inline void gmt_ascii_block_detach (struct GMT_CTRL *GMT, FILE *fp);
+static inline void gmt_binary_block_detach (struct GMT_CTRL *GMT, FILE *fp);
 
 #ifdef HAVE_DIRENT_H_
 #	include <dirent.h>
@@ -177,6 +179,8 @@ int GMT_fclose (struct GMT_CTRL *GMT, FILE *stream)
 	if (stream == GMT->session.std[GMT_IN])  return (0);
 	if (stream == GMT->session.std[GMT_OUT]) return (0);
 	if (stream == GMT->session.std[GMT_ERR]) return (0);
+	gmt_ascii_block_detach (GMT, stream);	/* Forget any read-ahead text for this stream */
+	gmt_binary_block_detach (GMT, stream);	/* Forget any read-ahead bytes for this stream */
 	if ((size_t)stream == (size_t)-GMT->current.io.ncid) {
 		/* Special treatment for netCDF files */
 		nc_close (GMT->current.io.ncid);
@@ -1395,16 +1399,234 @@ unsigned int gmt_is_segment_header (struct GMT_CTRL *GMT, char *line)
 	return (0);	/* Not a segment header */
 }
 
+/* Block read-ahead for ASCII tables.  When the input stream is a regular file we read
+ * GMT_ASCII_BLOCK_SIZE bytes at the time and split the text into records.  The first time
+ * gmt_ascii_input needs a data record from a block, all records in the block that look like
+ * data are tokenized and converted in one go (in parallel when OpenMP is enabled).  The
+ * records are then handed out one by one so that table headers, segment headers, -g gaps,
+ * duplicate checks, -: and periodic longitudes are still processed serially in record order.
+ * Records that did not decode cleanly (short, bad, or mixed text) are simply decoded again
+ * the old way when we get to them.  Pipes and terminals are still read line by line, and so is
+ * any file that is read while another file still has unread text in the block. */
+
+#define GMT_ASCII_BLOCK_SIZE	8388608U	/* Read ascii tables in chunks of 8 Mb */
+#define GMT_ASCII_BLOCK_MIN_REC	4096		/* Not worth starting threads for fewer records than this */
+
+enum GMT_enum_ascii_rec {
+	GMT_ASCII_REC_RAW = 0,	/* Record has not been decoded, or decoding needs to be done record by record */
+	GMT_ASCII_REC_OK  = 1,	/* All n_cols columns were decoded and assigned */
+	GMT_ASCII_REC_NAN = 2};	/* ...but found a NaN in a column that is flagged by skip_if_NaN */
+
+enum GMT_enum_ascii_decode {	/* Return flags from gmt_ascii_decode */
+	GMT_ASCII_DEC_BAD = 1,	/* Record failed our test and had NaNs */
+	GMT_ASCII_DEC_NAN = 2};	/* Found a NaN in a column where that means we should skip */
+
+static inline unsigned int gmt_ascii_decode (struct GMT_CTRL *GMT, char *line, uint64_t n_use, double *rec, uint64_t *n_col, uint64_t *n_good)
+{	/* Tokenize the (already stripped) record in line and convert up to n_use columns into rec.
+	 * Returns the number of columns found in *n_col, the number of OK values in *n_good, and
+	 * a combination of GMT_ASCII_DEC_* flags.  Only reads the GMT settings, so it is safe to
+	 * call from several threads as long as the column types do not modify GMT state. */
+	uint64_t col_no = 0, col_pos, n_ok = 0;
+	int64_t in_col = -1;	/* Since we will increment right away inside the loop */
+	unsigned int flags = 0;
+	char *token = NULL, *stringp = line;
+	double val;
+
+	while (!(flags & GMT_ASCII_DEC_BAD) && col_no < n_use && (token = strsepz (&stringp, GMT_TOKEN_SEPARATORS)) != NULL) {	/* Get one field at the time until we run out or have issues */
+		++in_col;	/* This is the actual column number in the input file */
+		if (GMT->common.i.active) {	/* Must do special column-based processing since the -i option was set */
+			if (GMT->current.io.col_skip[in_col]) continue;		/* Just skip and not even count this column */
+			col_pos = GMT->current.io.col[GMT_IN][col_no].order;	/* Which data column will receive this value */
+		}
+		else				/* Default column order */
+			col_pos = col_no;
+		if (GMT_scanf (GMT, token, GMT->current.io.col_type[GMT_IN][col_pos], &val) == GMT_IS_NAN) {	/* Got a NaN or it failed to decode the string */
+			if (GMT->current.setting.io_nan_records || !GMT->current.io.skip_if_NaN[col_pos]) {	/* This field (or all fields) can be NaN so we pass it on */
+				rec[col_pos] = GMT->session.d_NaN;
+				n_ok++;	/* Since NaN is considered an OK result */
+			}
+			else	/* Cannot have NaN in this column, flag record as bad */
+				flags |= GMT_ASCII_DEC_BAD;
+			if (GMT->current.io.skip_if_NaN[col_pos]) flags |= GMT_ASCII_DEC_NAN;	/* Flag that we found NaN in a column that means we should skip */
+		}
+		else {					/* Successful decode, assign the value to the input array */
+			gmt_convert_col (GMT->current.io.col[GMT_IN][col_no], val);
+			rec[col_pos] = val;
+			n_ok++;
+		}
+		col_no++;		/* Count up number of columns found */
+	}
+	*n_col = col_no;
+	*n_good = n_ok;
+	return (flags);
+}
+
+void GMT_free_ascii_block (struct GMT_CTRL *GMT)
+{	/* Free the ascii read-ahead buffer, if used */
+	struct GMT_ASCII_BLOCK *B = GMT->current.io.block;
+	if (!B) return;
+	GMT_free (GMT, B->text);
+	GMT_free (GMT, B->start);
+	GMT_free (GMT, B->value);
+	GMT_free (GMT, B->n_ok);
+	GMT_free (GMT, B->flag);
+	GMT_free (GMT, GMT->current.io.block);
+}
+
+static inline void gmt_ascii_block_detach (struct GMT_CTRL *GMT, FILE *fp)
+{	/* Called when fp is closed or exhausted so that a new stream (possibly at the same address) starts afresh */
+	struct GMT_ASCII_BLOCK *B = GMT->current.io.block;
+	if (!B || B->fp != fp) return;
+	B->fp = NULL;
+	B->active = B->eof = B->decoded = false;
+	B->n_bytes = B->n_records = B->next = 0;
+}
+
+static void gmt_ascii_block_attach (struct GMT_CTRL *GMT, FILE *fp)
+{	/* Start reading a new stream.  Only regular files are read ahead; for pipes or terminals
+	 * that could stall an interactive or streaming session so we leave those to GMT_fgets */
+	struct GMT_ASCII_BLOCK *B = NULL;
+	struct stat buf;
+
+	if (!GMT->current.io.block) GMT->current.io.block = GMT_memory (GMT, NULL, 1, struct GMT_ASCII_BLOCK);
+	B = GMT->current.io.block;
+	B->fp = fp;
+	B->eof = B->decoded = false;
+	B->n_bytes = B->n_records = B->next = 0;
+	B->active = (fp && !fstat (fileno (fp), &buf) && (buf.st_mode & S_IFMT) == S_IFREG);
+	if (B->active && B->n_alloc == 0) {
+		B->n_alloc = GMT_ASCII_BLOCK_SIZE;
+		B->text = GMT_memory (GMT, NULL, B->n_alloc, char);
+	}
+}
+
+static bool gmt_ascii_block_fill (struct GMT_CTRL *GMT, struct GMT_ASCII_BLOCK *B)
+{	/* Read the next block of text and find the complete records in it.  Returns false at EOF */
+	size_t used, k, n_read;
+
+	if (B->n_records) {	/* Move any incomplete trailing record to the start of the buffer */
+		used = B->start[B->n_records];
+		B->n_bytes -= used;
+		if (B->n_bytes) memmove (B->text, &B->text[used], B->n_bytes);
+	}
+	B->n_records = B->next = 0;
+	B->decoded = false;
+
+	while (B->n_records == 0) {
+		if (!B->eof) {
+			if (B->n_bytes == B->n_alloc) {	/* A single record longer than the buffer; must grow it */
+				B->n_alloc <<= 1;
+				B->text = GMT_memory (GMT, B->text, B->n_alloc, char);
+			}
+			n_read = fread (&B->text[B->n_bytes], sizeof (char), B->n_alloc - B->n_bytes, B->fp);
+			B->n_bytes += n_read;
+			if (n_read == 0) B->eof = true;
+		}
+		if (B->n_bytes == 0) return (false);	/* Nothing left */
+		/* Count the records so we can allocate the arrays once */
+		for (k = 0, used = 0; k < B->n_bytes; k++) if (B->text[k] == '\n') used++;
+		if (B->eof && B->text[B->n_bytes-1] != '\n') used++;	/* Last record without a linefeed */
+		if (used == 0) continue;	/* Not a single complete record in the buffer; read more */
+		if (used >= B->n_rec_alloc) {
+			B->n_rec_alloc = used + 1;
+			B->start = GMT_memory (GMT, B->start, B->n_rec_alloc, size_t);
+			B->n_ok = GMT_memory (GMT, B->n_ok, B->n_rec_alloc, uint64_t);
+			B->flag = GMT_memory (GMT, B->flag, B->n_rec_alloc, unsigned int);
+		}
+		B->start[0] = 0;
+		for (k = 0; k < B->n_bytes; k++) if (B->text[k] == '\n') B->start[++B->n_records] = k + 1;
+		if (B->eof && B->text[B->n_bytes-1] != '\n') B->start[++B->n_records] = B->n_bytes;
+	}
+	return (true);
+}
+
+static void gmt_ascii_block_decode (struct GMT_CTRL *GMT, struct GMT_ASCII_BLOCK *B, uint64_t n_use)
+{	/* Decode n_use columns for all remaining data-like records in the current block */
+	int64_t k, n_rec = (int64_t)B->n_records;
+	uint64_t col;
+	bool parallel = true;
+
+	B->decoded = true;
+	B->n_cols = n_use;
+	GMT_memset (B->flag, B->n_records, unsigned int);	/* All GMT_ASCII_REC_RAW */
+	if (GMT->common.i.active) {	/* Make sure -i will only place values in the first n_use columns */
+		for (col = 0; col < n_use; col++) if (GMT->current.io.col[GMT_IN][col].order >= n_use) return;
+	}
+	for (col = 0; col < n_use; col++) {	/* Some conversions update GMT state and must stay serial */
+		if (GMT->current.io.col_type[GMT_IN][col] & GMT_IS_UNKNOWN) parallel = false;
+		if (GMT->current.io.col_type[GMT_IN][col] == GMT_IS_ABSTIME && GMT->current.setting.time_is_interval) parallel = false;
+	}
+	if (n_use * B->n_records > B->n_val_alloc) {
+		B->n_val_alloc = n_use * B->n_records;
+		B->value = GMT_memory (GMT, B->value, B->n_val_alloc, double);
+	}
+
+#ifdef _OPENMP
+#pragma omp parallel for private(k) shared(GMT,B,n_rec,n_use) schedule(static) if (parallel && n_rec >= GMT_ASCII_BLOCK_MIN_REC)
+#endif
+	for (k = (int64_t)B->next; k < n_rec; k++) {
+		char line[GMT_BUFSIZ], *text = &B->text[B->start[k]];
+		size_t len = B->start[k+1] - B->start[k];
+		uint64_t n_col, n_good;
+		unsigned int flags;
+		if (text[0] == '#' || text[0] == GMT->current.setting.io_seg_marker[GMT_IN]) continue;	/* Comment or segment header */
+		if (len >= GMT_BUFSIZ) continue;	/* Long records get truncated (with a warning) by the regular path */
+		memcpy (line, text, len);	line[len] = '\0';
+		GMT_strstrip (line, false);	/* Eliminate DOS endings and trailing white space */
+		flags = gmt_ascii_decode (GMT, line, n_use, &B->value[k*n_use], &n_col, &n_good);
+		if (flags & GMT_ASCII_DEC_BAD || n_col < n_use) continue;	/* Leave these for the regular path */
+		B->n_ok[k] = n_good;
+		B->flag[k] = (flags & GMT_ASCII_DEC_NAN) ? GMT_ASCII_REC_OK | GMT_ASCII_REC_NAN : GMT_ASCII_REC_OK;
+	}
+	if (!parallel) GMT_Report (GMT->parent, GMT_MSG_DEBUG, "Column types prevent parallel decoding of ascii records\n");
+}
+
+static char *gmt_ascii_fgets (struct GMT_CTRL *GMT, char *str, int size, FILE *fp, int64_t *rec)
+{	/* Like GMT_fgets but hands out records from the read-ahead block when fp is a regular file.
+	 * *rec returns the record number in the block or -1 if not from a block */
+	struct GMT_ASCII_BLOCK *B = GMT->current.io.block;
+	size_t len;
+
+	*rec = -1;
+	if (B && B->fp && B->fp != fp && B->active)	/* Another file still has unread text in the block; read this one line by line */
+		return (GMT_fgets (GMT, str, size, fp));
+	if (!B || B->fp != fp) {
+		gmt_ascii_block_attach (GMT, fp);
+		B = GMT->current.io.block;
+	}
+	if (!B->active) return (GMT_fgets (GMT, str, size, fp));
+	if (B->next == B->n_records && !gmt_ascii_block_fill (GMT, B)) {	/* Reached EOF */
+		gmt_ascii_block_detach (GMT, fp);
+		return (NULL);
+	}
+	*rec = (int64_t)B->next;
+	len = B->start[B->next+1] - B->start[B->next];
+	if (len > (size_t)(size - 1)) {	/* Same truncation and warning as in GMT_fgets */
+		bool linefeed = (B->text[B->start[B->next]+len-1] == '\n');
+		GMT_Report (GMT->parent, GMT_MSG_NORMAL, "Long input record (%d bytes) was truncated to first %d bytes!\n", (int)len, size-2);
+		memcpy (str, &B->text[B->start[B->next]], size - 2);
+		len = size - 2;
+		if (linefeed) str[len++] = '\n';
+		*rec = -1;	/* Must be decoded the regular way */
+	}
+	else
+		memcpy (str, &B->text[B->start[B->next]], len);
+	str[len] = '\0';
+	B->next++;
+	return (str);
+}
+
 /* This is the lowest-most input function in GMT.  All ASCII table data are read via
  * gmt_ascii_input.  Changes here affect all programs that read such data. */
 
 void * gmt_ascii_input (struct GMT_CTRL *GMT, FILE *fp, uint64_t *n, int *status)
 {
-	uint64_t pos, col_no = 0, col_pos, n_convert, n_ok = 0, kind, add, n_use = 0;
-	int64_t in_col;
+	uint64_t col_no = 0, col_pos, n_ok = 0, kind, add, n_use = 0;
+	int64_t rec = -1;
 	bool done = false, bad_record, set_nan_flag = false;
-	char line[GMT_BUFSIZ] = {""}, *p = NULL, *token, *stringp;
-	double val;
+	unsigned int flags;
+	char line[GMT_BUFSIZ] = {""}, *p = NULL;
+	struct GMT_ASCII_BLOCK *B = NULL;
 
 	/* gmt_ascii_input will skip blank lines and shell comment lines which start
 	 * with #.  Fields may be separated by spaces, tabs, or commas.  The routine returns
@@ -1424,7 +1646,7 @@ void * gmt_ascii_input (struct GMT_CTRL *GMT, FILE *fp, uint64_t *n, int *status
 		GMT->current.io.rec_no++;		/* Counts up, regardless of what this record is (data, junk, segment header, etc) */
 		GMT->current.io.rec_in_tbl_no++;	/* Counts up, regardless of what this record is (data, junk, segment header, etc) */
 		if (GMT->current.setting.io_header[GMT_IN] && GMT->current.io.rec_in_tbl_no <= GMT->current.setting.io_n_header_items) {	/* Must treat first io_n_header_items as headers */
-			p = GMT_fgets (GMT, line, GMT_BUFSIZ, fp);	/* Get the line */
+			p = gmt_ascii_fgets (GMT, line, GMT_BUFSIZ, fp, &rec);	/* Get the line */
 			if (GMT->common.h.mode == GMT_COMMENT_IS_RESET) continue;	/* Simplest way to replace headers on output is to ignore them on input */
 			strncpy (GMT->current.io.current_record, line, GMT_BUFSIZ);
 			GMT->current.io.status = GMT_IO_TABLE_HEADER;
@@ -1434,11 +1656,11 @@ void * gmt_ascii_input (struct GMT_CTRL *GMT, FILE *fp, uint64_t *n, int *status
 		}
 		/* Here we are done with any header records implied by -h */
 		if (GMT->current.setting.io_blankline[GMT_IN]) {	/* Treat blank lines as segment markers, so only read a single line */
-			p = GMT_fgets (GMT, line, GMT_BUFSIZ, fp);
+			p = gmt_ascii_fgets (GMT, line, GMT_BUFSIZ, fp, &rec);
 			GMT->current.io.rec_no++, GMT->current.io.rec_in_tbl_no++;
 		}
 		else {	/* Default is to skip all blank lines until we get something else (or hit EOF) */
-			while ((p = GMT_fgets (GMT, line, GMT_BUFSIZ, fp)) && GMT_is_a_blank_line (line)) GMT->current.io.rec_no++, GMT->current.io.rec_in_tbl_no++;
+			while ((p = gmt_ascii_fgets (GMT, line, GMT_BUFSIZ, fp, &rec)) && GMT_is_a_blank_line (line)) GMT->current.io.rec_no++, GMT->current.io.rec_in_tbl_no++;
 		}
 		if (!p) {	/* Ran out of records, which can happen if file ends in a comment record */
 			GMT->current.io.status = GMT_IO_EOF;
@@ -1487,35 +1709,25 @@ void * gmt_ascii_input (struct GMT_CTRL *GMT, FILE *fp, uint64_t *n, int *status
 
 		GMT_strstrip (line, false); /* Eliminate DOS endings and trailing white space, add linefeed */
 
-		bad_record = set_nan_flag = false;		/* Initialize flags */
 		strncpy (GMT->current.io.current_record, line, GMT_BUFSIZ);	/* Keep copy of current record around */
-		col_no = pos = n_ok = 0;			/* Initialize counters */
-		in_col = -1;					/* Since we will increment right away inside the loop */
-
-		stringp = line;
-		while (!bad_record && col_no < n_use && (token = strsepz (&stringp, GMT_TOKEN_SEPARATORS)) != NULL) {	/* Get one field at the time until we run out or have issues */
-			++in_col;	/* This is the actual column number in the input file */
-			if (GMT->common.i.active) {	/* Must do special column-based processing since the -i option was set */
-				if (GMT->current.io.col_skip[in_col]) continue;		/* Just skip and not even count this column */
-				col_pos = GMT->current.io.col[GMT_IN][col_no].order;	/* Which data column will receive this value */
-			}
-			else				/* Default column order */
-				col_pos = col_no;
-			if ((n_convert = GMT_scanf (GMT, token, GMT->current.io.col_type[GMT_IN][col_pos], &val)) == GMT_IS_NAN) {	/* Got a NaN or it failed to decode the string */
-				if (GMT->current.setting.io_nan_records || !GMT->current.io.skip_if_NaN[col_pos]) {	/* This field (or all fields) can be NaN so we pass it on */
-					GMT->current.io.curr_rec[col_pos] = GMT->session.d_NaN;
-					n_ok++;	/* Since NaN is considered an OK result */
-				}
-				else	/* Cannot have NaN in this column, flag record as bad */
-					bad_record = true;
-				if (GMT->current.io.skip_if_NaN[col_pos]) set_nan_flag = true;	/* Flag that we found NaN in a column that means we should skip */
-			}
-			else {					/* Successful decode, assign the value to the input array */
-				gmt_convert_col (GMT->current.io.col[GMT_IN][col_no], val);
-				GMT->current.io.curr_rec[col_pos] = val;
-				n_ok++;
+
+		B = GMT->current.io.block;
+		if (rec >= 0 && n_use != GMT_MAX_COLUMNS && !GMT->current.io.read_mixed && (!B->decoded || B->n_cols != n_use))
+			gmt_ascii_block_decode (GMT, B, n_use);	/* Decode all the data records in this block */
+		if (rec >= 0 && B->decoded && B->n_cols == n_use && (B->flag[rec] & GMT_ASCII_REC_OK)) {	/* Already decoded */
+			double *val = &B->value[rec*n_use];
+			for (col_no = 0; col_no < n_use; col_no++) {
+				col_pos = (GMT->common.i.active) ? GMT->current.io.col[GMT_IN][col_no].order : col_no;
+				GMT->current.io.curr_rec[col_pos] = val[col_pos];
 			}
-			col_no++;		/* Count up number of columns found */
+			n_ok = B->n_ok[rec];
+			bad_record = false;
+			set_nan_flag = (B->flag[rec] & GMT_ASCII_REC_NAN);
+		}
+		else {	/* Decode this record now */
+			flags = gmt_ascii_decode (GMT, line, n_use, GMT->current.io.curr_rec, &col_no, &n_ok);
+			bad_record = (flags & GMT_ASCII_DEC_BAD);
+			set_nan_flag = (flags & GMT_ASCII_DEC_NAN);
 		}
 		if ((add = gmt_assign_aspatial_cols (GMT))) {	/* We appended <add> columns given via aspatial OGR/GMT values */
 			col_no += add;
@@ -1559,6 +1771,7 @@ void * gmt_ascii_input (struct GMT_CTRL *GMT, FILE *fp, uint64_t *n, int *status
 void * GMT_ascii_textinput (struct GMT_CTRL *GMT, FILE *fp, uint64_t *n, int *status)
 {
 	bool more = true;
+	int64_t rec;
 	char line[GMT_BUFSIZ] = {""}, *p = NULL;
 
 	/* GMT_ascii_textinput will read one text line and return it, setting
@@ -1570,7 +1783,7 @@ void * GMT_ascii_textinput (struct GMT_CTRL *GMT, FILE *fp, uint64_t *n, int *st
 
 		GMT->current.io.rec_no++;		/* Counts up, regardless of what this record is (data, junk, segment header, etc) */
 		GMT->current.io.rec_in_tbl_no++;	/* Counts up, regardless of what this record is (data, junk, segment header, etc) */
-		while ((p = GMT_fgets (GMT, line, GMT_BUFSIZ, fp)) && gmt_ogr_parser (GMT, line)) {	/* Exits loop when we successfully have read a data record */
+		while ((p = gmt_ascii_fgets (GMT, line, GMT_BUFSIZ, fp, &rec)) && gmt_ogr_parser (GMT, line)) {	/* Exits loop when we successfully have read a data record */
 			GMT->current.io.rec_no++;		/* Counts up, regardless of what this record is (data, junk, segment header, etc) */
 			GMT->current.io.rec_in_tbl_no++;	/* Counts up, regardless of what this record is (data, junk, segment header, etc) */
 		}
@@ -1647,6 +1860,14 @@ uint64_t gmt_bin_colselect (struct GMT_CTRL *GMT)
 
 /* Sub functions for gmt_bin_input */
 
+static inline void gmt_bin_report_bad (struct GMT_CTRL *GMT)
+{	/* At the end of a binary file; report summary of bad records and reset */
+	if (GMT->current.io.give_report && GMT->current.io.n_bad_records) {
+		GMT_Report (GMT->parent, GMT_MSG_NORMAL, "This file had %" PRIu64 " data records with invalid x and/or y values\n", GMT->current.io.n_bad_records);
+		GMT->current.io.n_bad_records = GMT->current.io.rec_no = GMT->current.io.pt_no = GMT->current.io.n_clean_rec = 0;
+	}
+}
+
 int gmt_x_read (struct GMT_CTRL *GMT, FILE *fp, off_t rel_move)
 {	/* Used to skip rel_move bytes; no reading takes place */
 	if (fseek (fp, rel_move, SEEK_CUR)) {
@@ -1656,24 +1877,202 @@ int gmt_x_read (struct GMT_CTRL *GMT, FILE *fp, off_t rel_move)
 	return (GMT_OK);
 }
 
+/* Block read-ahead for binary tables.  Rather than calling the per-item read functions
+ * (and fread) for every column of every record, we read GMT_BINARY_BLOCK_SIZE bytes at the
+ * time and convert all complete records in the block, one column at the time, into an array
+ * of doubles.  Since each column loop deals with a single data type and byte order, the
+ * compiler can vectorize the conversions.  The records are then handed out one by one to
+ * gmt_bin_input so segment headers, -s, -: gaps etc are still processed per record.  Only
+ * regular files are read this way; pipes and terminals are still read record by record. */
+
+#define GMT_BINARY_BLOCK_SIZE	8388608U	/* Read binary tables in chunks of 8 Mb */
+
+static size_t gmt_binary_type_size[GMT_N_TYPES] = {1, 1, 2, 2, 4, 4, 8, 8, 4, 8, 0, 0};
+
+void GMT_free_binary_block (struct GMT_CTRL *GMT)
+{	/* Free the binary read-ahead buffer, if used */
+	struct GMT_BINARY_BLOCK *B = GMT->current.io.bin_block;
+	if (!B) return;
+	GMT_free (GMT, B->buffer);
+	GMT_free (GMT, B->offset);
+	GMT_free (GMT, B->value);
+	GMT_free (GMT, GMT->current.io.bin_block);
+}
+
+static inline void gmt_binary_block_detach (struct GMT_CTRL *GMT, FILE *fp)
+{	/* Called when fp is closed or exhausted so that a new stream (possibly at the same address) starts afresh */
+	struct GMT_BINARY_BLOCK *B = GMT->current.io.bin_block;
+	if (!B || B->fp != fp) return;
+	B->fp = NULL;
+	B->active = B->eof = false;
+	B->n_bytes = B->pos = B->n_records = B->next = B->n_cols = 0;
+}
+
+static struct GMT_BINARY_BLOCK * gmt_binary_block_attach (struct GMT_CTRL *GMT, FILE *fp)
+{	/* Start reading a new stream.  Only regular files are read ahead; for pipes or terminals
+	 * the block would not be handed out before it was full, which stalls streaming pipelines */
+	struct GMT_BINARY_BLOCK *B = NULL;
+	struct stat buf;
+
+	if (!GMT->current.io.bin_block) GMT->current.io.bin_block = GMT_memory (GMT, NULL, 1, struct GMT_BINARY_BLOCK);
+	B = GMT->current.io.bin_block;
+	gmt_binary_block_detach (GMT, B->fp);
+	B->fp = fp;
+	B->active = (fp && !fstat (fileno (fp), &buf) && (buf.st_mode & S_IFMT) == S_IFREG);
+	if (B->active && B->n_alloc == 0) {
+		B->n_alloc = GMT_BINARY_BLOCK_SIZE;
+		B->buffer = GMT_memory (GMT, NULL, B->n_alloc, char);
+	}
+	return (B);
+}
+
+static inline bool gmt_binary_col_swab (struct GMT_CTRL *GMT, unsigned int dir, uint64_t col)
+{	/* Byte-swapping is set per column via the io function pointer, so see if it is the swab version */
+	static char letter[GMT_DOUBLE+2] = "cuhHiIlLfd";
+	return (GMT->current.io.fmt[dir][col].io == GMT_get_io_ptr (GMT, dir, (dir == GMT_IN) ? k_swap_in : k_swap_out, letter[GMT->current.io.fmt[dir][col].type-1]));
+}
+
+static bool gmt_binary_block_usable (struct GMT_CTRL *GMT, uint64_t n)
+{	/* Only plain binary types can be converted in blocks */
+	uint64_t col;
+	for (col = 0; col < n; col++) {
+		if (GMT->current.io.fmt[GMT_IN][col].type < GMT_CHAR + 1 || GMT->current.io.fmt[GMT_IN][col].type > GMT_DOUBLE + 1) return (false);
+	}
+	return (true);
+}
+
+#define GMT_BIN_CONVERT(ctype,utype,swap) {\
+	ctype v; utype u;\
+	if (swab) {\
+		for (row = 0; row < n_rec; row++, in += B->rec_size, out += n) {\
+			memcpy (&u, in, sizeof (utype)); u = swap (u); memcpy (&v, &u, sizeof (utype)); *out = (double)v;\
+		}\
+	}\
+	else {\
+		for (row = 0; row < n_rec; row++, in += B->rec_size, out += n) {\
+			memcpy (&v, in, sizeof (ctype)); *out = (double)v;\
+		}\
+	}\
+}
+#define GMT_NO_SWAP(x) (x)
+
+static void gmt_binary_block_layout (struct GMT_CTRL *GMT, struct GMT_BINARY_BLOCK *B, uint64_t n)
+{	/* Determine the byte offset of each of the n columns and the total record size */
+	uint64_t col;
+	size_t k;
+
+	B->offset = GMT_memory (GMT, B->offset, n, size_t);
+	for (col = 0, k = 0; col < n; col++) {
+		if (GMT->current.io.fmt[GMT_IN][col].skip < 0) k -= GMT->current.io.fmt[GMT_IN][col].skip;	/* Pre-skip */
+		B->offset[col] = k;
+		k += gmt_binary_type_size[GMT->current.io.fmt[GMT_IN][col].type-1];
+		if (GMT->current.io.fmt[GMT_IN][col].skip > 0) k += GMT->current.io.fmt[GMT_IN][col].skip;	/* Post-skip */
+	}
+	B->rec_size = k;
+	B->n_cols = n;
+}
+
+static void gmt_binary_block_convert (struct GMT_CTRL *GMT, struct GMT_BINARY_BLOCK *B)
+{	/* Convert all complete records from B->pos onwards */
+	uint64_t col, row, n_rec, n = B->n_cols;
+	bool swab;
+	char *in = NULL;
+	double *out = NULL;
+
+	B->next = 0;
+	B->n_records = n_rec = (B->rec_size) ? (B->n_bytes - B->pos) / B->rec_size : 0;
+	if (n_rec * n > B->n_val_alloc) {
+		B->n_val_alloc = n_rec * n;
+		B->value = GMT_memory (GMT, B->value, B->n_val_alloc, double);
+	}
+	for (col = 0; col < n; col++) {	/* Convert one column at the time */
+		in = &B->buffer[B->pos + B->offset[col]];
+		out = &B->value[col];
+		swab = gmt_binary_col_swab (GMT, GMT_IN, col);
+		switch (GMT->current.io.fmt[GMT_IN][col].type-1) {
+			case GMT_CHAR:   GMT_BIN_CONVERT (int8_t,   uint8_t,  GMT_NO_SWAP); break;
+			case GMT_UCHAR:  GMT_BIN_CONVERT (uint8_t,  uint8_t,  GMT_NO_SWAP); break;
+			case GMT_SHORT:  GMT_BIN_CONVERT (int16_t,  uint16_t, bswap16); break;
+			case GMT_USHORT: GMT_BIN_CONVERT (uint16_t, uint16_t, bswap16); break;
+			case GMT_INT:    GMT_BIN_CONVERT (int32_t,  uint32_t, bswap32); break;
+			case GMT_UINT:   GMT_BIN_CONVERT (uint32_t, uint32_t, bswap32); break;
+			case GMT_LONG:   GMT_BIN_CONVERT (int64_t,  uint64_t, bswap64); break;
+			case GMT_ULONG:  GMT_BIN_CONVERT (uint64_t, uint64_t, bswap64); break;
+			case GMT_FLOAT:  GMT_BIN_CONVERT (float,    uint32_t, bswap32); break;
+			case GMT_DOUBLE: GMT_BIN_CONVERT (double,   uint64_t, bswap64); break;
+		}
+	}
+}
+
+static bool gmt_binary_block_fill (struct GMT_CTRL *GMT, struct GMT_BINARY_BLOCK *B)
+{	/* Discard the used records, read more bytes and convert them.  Returns false if no complete record is left */
+	size_t used = B->pos + B->next * B->rec_size, n_read;
+
+	B->n_bytes -= used;	/* Move any incomplete trailing record to the start of the buffer */
+	if (B->n_bytes) memmove (B->buffer, &B->buffer[used], B->n_bytes);
+	B->pos = 0;
+	if (B->rec_size > B->n_alloc) {	/* Very long records, make sure we can hold at least one */
+		B->n_alloc = B->rec_size;
+		B->buffer = GMT_memory (GMT, B->buffer, B->n_alloc, char);
+	}
+	while (!B->eof && B->n_bytes < B->n_alloc) {	/* Fill up the buffer */
+		if ((n_read = GMT_fread (&B->buffer[B->n_bytes], sizeof (char), B->n_alloc - B->n_bytes, B->fp)) == 0)
+			B->eof = true;
+		B->n_bytes += n_read;
+	}
+	gmt_binary_block_convert (GMT, B);
+	return (B->n_records > 0);
+}
+
+static bool gmt_get_binary_block_input (struct GMT_CTRL *GMT, FILE *fp, uint64_t n) {
+	/* Same as gmt_get_binary_input but takes the next record from the read-ahead block attached to fp */
+	struct GMT_BINARY_BLOCK *B = GMT->current.io.bin_block;
+
+	if (n != B->n_cols) {	/* Number of columns changed, convert the remaining records again */
+		B->pos += B->next * B->rec_size;
+		gmt_binary_block_layout (GMT, B, n);
+		gmt_binary_block_convert (GMT, B);
+	}
+	if (B->next == B->n_records && !gmt_binary_block_fill (GMT, B)) {	/* No more complete records */
+		if (B->n_bytes) {	/* File ends with a partial record */
+			GMT_Report (GMT->parent, GMT_MSG_NORMAL, "Binary file ends with an incomplete record of %" PRIuS " bytes\n", B->n_bytes);
+			GMT->current.io.status = GMT_IO_MISMATCH;
+		}
+		else
+			GMT->current.io.status = GMT_IO_EOF;
+		gmt_binary_block_detach (GMT, fp);
+		return (true);
+	}
+	GMT_memcpy (GMT->current.io.curr_rec, &B->value[B->next*n], n, double);
+	B->next++;
+	return (false);	/* OK so far */
+}
+
 bool gmt_get_binary_input (struct GMT_CTRL *GMT, FILE *fp, uint64_t n) {
 	/* Reads the n binary doubles from input and saves to GMT->current.io.curr_rec[] */
 	uint64_t i;
+	struct GMT_BINARY_BLOCK *B = GMT->current.io.bin_block;
 
 	if (n > GMT_MAX_COLUMNS) {
 		GMT_Report (GMT->parent, GMT_MSG_NORMAL, "Number of data columns (%d) exceeds limit (GMT_MAX_COLUMS = %d)\n", n, GMT_MAX_COLUMNS);
 		return (true);	/* Done with this file */
 	}
+	if (gmt_binary_block_usable (GMT, n) && !(B && B->fp && B->fp != fp && B->active)) {	/* Unless another file still has unread bytes in the block */
+		if (!B || B->fp != fp) B = gmt_binary_block_attach (GMT, fp);
+		if (B->active) {	/* The fast way for regular files */
+			if (gmt_get_binary_block_input (GMT, fp, n)) {
+				gmt_bin_report_bad (GMT);
+				return (true);	/* Done with this file */
+			}
+			return (false);	/* OK so far */
+		}
+	}
 	for (i = 0; i < n; i++) {
 		if (GMT->current.io.fmt[GMT_IN][i].skip < 0) gmt_x_read (GMT, fp, -GMT->current.io.fmt[GMT_IN][i].skip);	/* Pre-skip */
 		if (GMT->current.io.fmt[GMT_IN][i].io (GMT, fp, 1, &GMT->current.io.curr_rec[i]) == GMT_DATA_READ_ERROR) {
 			/* EOF or came up short */
 			GMT->current.io.status = (feof (fp)) ? GMT_IO_EOF : GMT_IO_MISMATCH;
-			if (GMT->current.io.give_report && GMT->current.io.n_bad_records) {
-				/* Report summary and reset */
-				GMT_Report (GMT->parent, GMT_MSG_NORMAL, "This file had %" PRIu64 " data records with invalid x and/or y values\n", GMT->current.io.n_bad_records);
-				GMT->current.io.n_bad_records = GMT->current.io.rec_no = GMT->current.io.pt_no = GMT->current.io.n_clean_rec = 0;
-			}
+			gmt_bin_report_bad (GMT);
 			return (true);	/* Done with this file */
 		}
 		if (GMT->current.io.fmt[GMT_IN][i].skip > 0) gmt_x_read (GMT, fp, GMT->current.io.fmt[GMT_IN][i].skip);	/* Post-skip */
@@ -1738,6 +2137,59 @@ int gmt_x_write (struct GMT_CTRL *GMT, FILE *fp, off_t n)
 	return (GMT_NOERROR);
 }
 
+#define GMT_BIN_PACK(ctype,utype,swap) {\
+	ctype v = (ctype)val; utype u;\
+	memcpy (&u, &v, sizeof (utype)); if (swab) u = swap (u); memcpy (&record[k], &u, sizeof (utype));\
+}
+
+static bool gmt_bin_pack_output (struct GMT_CTRL *GMT, FILE *fp, uint64_t n, uint64_t n_out, double *ptr, int *status)
+{	/* Convert all columns of an output record into a byte buffer and write it with a single fwrite.
+	 * Returns false if the column formats are not plain binary types or the record is too long,
+	 * otherwise true with the write status in *status */
+	char record[GMT_BUFSIZ];
+	uint64_t i, col_pos;
+	size_t k = 0;
+	unsigned int type;
+	bool swab;
+	double val;
+
+	for (i = 0; i < n_out; i++) {	/* First check that we can do this */
+		type = GMT->current.io.fmt[GMT_OUT][i].type;
+		if (type < GMT_CHAR + 1 || type > GMT_DOUBLE + 1) return (false);
+		k += gmt_binary_type_size[type-1] + labs ((long)GMT->current.io.fmt[GMT_OUT][i].skip);
+	}
+	if (k > GMT_BUFSIZ) return (false);
+	for (i = 0, k = 0; i < n_out; i++) {
+		col_pos = (GMT->common.o.active) ? GMT->current.io.col[GMT_OUT][i].col : i;	/* Which data column to pick */
+		val = (col_pos >= n) ? GMT->session.d_NaN : ptr[col_pos];	/* If we request beyond length of array, return NaN */
+		if (GMT->current.io.col_type[GMT_OUT][col_pos] == GMT_IS_LON) GMT_lon_range_adjust (GMT->current.io.geo.range, &val);
+		if (GMT->current.io.fmt[GMT_OUT][i].skip < 0) {	/* Pre-fill */
+			memset (&record[k], ' ', -GMT->current.io.fmt[GMT_OUT][i].skip);
+			k -= GMT->current.io.fmt[GMT_OUT][i].skip;
+		}
+		swab = gmt_binary_col_swab (GMT, GMT_OUT, i);
+		switch (GMT->current.io.fmt[GMT_OUT][i].type-1) {
+			case GMT_CHAR:   GMT_BIN_PACK (int8_t,   uint8_t,  GMT_NO_SWAP); break;
+			case GMT_UCHAR:  GMT_BIN_PACK (uint8_t,  uint8_t,  GMT_NO_SWAP); break;
+			case GMT_SHORT:  GMT_BIN_PACK (int16_t,  uint16_t, bswap16); break;
+			case GMT_USHORT: GMT_BIN_PACK (uint16_t, uint16_t, bswap16); break;
+			case GMT_INT:    GMT_BIN_PACK (int32_t,  uint32_t, bswap32); break;
+			case GMT_UINT:   GMT_BIN_PACK (uint32_t, uint32_t, bswap32); break;
+			case GMT_LONG:   GMT_BIN_PACK (int64_t,  uint64_t, bswap64); break;
+			case GMT_ULONG:  GMT_BIN_PACK (uint64_t, uint64_t, bswap64); break;
+			case GMT_FLOAT:  GMT_BIN_PACK (float,    uint32_t, bswap32); break;
+			case GMT_DOUBLE: GMT_BIN_PACK (double,   uint64_t, bswap64); break;
+		}
+		k += gmt_binary_type_size[GMT->current.io.fmt[GMT_OUT][i].type-1];
+		if (GMT->current.io.fmt[GMT_OUT][i].skip > 0) {	/* Post-fill */
+			memset (&record[k], ' ', GMT->current.io.fmt[GMT_OUT][i].skip);
+			k += GMT->current.io.fmt[GMT_OUT][i].skip;
+		}
+	}
+	*status = (GMT_fwrite (record, sizeof (char), k, fp) == k) ? GMT_OK : GMT_DATA_WRITE_ERROR;
+	return (true);
+}
+
 int gmt_bin_output (struct GMT_CTRL *GMT, FILE *fp, uint64_t n, double *ptr)
 {	/* Return 0 if record was suppressed, otherwise number of items written */
 	int k;
@@ -1747,6 +2199,7 @@ int gmt_bin_output (struct GMT_CTRL *GMT, FILE *fp, uint64_t n, double *ptr)
 	if (gmt_skip_output (GMT, ptr, n)) return (0);	/* Record was skipped via -s[a|r] */
 	if (GMT->current.setting.io_lonlat_toggle[GMT_OUT]) double_swap (ptr[GMT_X], ptr[GMT_Y]);	/* Write lat/lon instead of lon/lat */
 	n_out = (GMT->common.o.active) ? GMT->common.o.n_cols : n;
+	if (gmt_bin_pack_output (GMT, fp, n, n_out, ptr, &k)) return (k);	/* Wrote the whole record at once */
 	for (i = 0, k = 0; i < n_out; i++) {
 		col_pos = (GMT->common.o.active) ? GMT->current.io.col[GMT_OUT][i].col : i;	/* Which data column to pick */
 		val = (col_pos >= n) ? GMT->session.d_NaN : ptr[col_pos];	/* If we request beyond length of array, return NaN */
@@ -4310,6 +4763,106 @@ int gmt_scanf_geo (char *s, double *val)
 }
 
 
+/* Fast path for plain decimal numbers such as 12.345 or -1.2e-3.  When the significant
+ * digits fit in an integer that is exactly representable as a double (< 2^53) and the
+ * power of ten is at most 22 (10^22 is the largest exact power of ten in a double), then
+ * a single multiplication or division gives the correctly rounded result (Clinger, 1990).
+ * Digits are checked and combined eight at the time by treating them as one 64-bit word.
+ * Anything else (too many digits, large exponents, hex, inf/nan, etc.) goes to strtod. */
+
+#define GMT_FLOAT_FAST_MAX_MANT	9007199254740992ULL	/* 2^53 */
+#define GMT_FLOAT_FAST_MAX_EXP	22
+
+static double gmt_pow10_exact[GMT_FLOAT_FAST_MAX_EXP+1] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static inline uint64_t gmt_load_eight_chars (const char *p)
+{	/* Return the next 8 characters as a little-endian 64-bit word */
+	uint64_t v;
+	memcpy (&v, p, 8U);
+#ifdef WORDS_BIGENDIAN
+	v = bswap64 (v);
+#endif
+	return (v);
+}
+
+static inline bool gmt_is_eight_digits (uint64_t v)
+{	/* true if all 8 bytes are '0'-'9' */
+	return (((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+}
+
+static inline uint64_t gmt_parse_eight_digits (uint64_t v)
+{	/* Convert 8 ASCII digits (first digit in the lowest byte) to their integer value */
+	v = ((v & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;		/* Pairs of digits */
+	v = ((v & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;	/* Groups of four */
+	return ((((v & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32) & 0xFFFFFFFFULL);
+}
+
+static inline bool gmt_scanf_float_fast (const char *s, double *val)
+{	/* Returns true if s was a plain number that could be converted exactly */
+#if defined FLT_EVAL_METHOD && FLT_EVAL_METHOD == 0	/* Needs true double arithmetic (i.e., not x87 extended precision) */
+	const char *p = s, *end = s + strlen (s);
+	uint64_t m = 0;
+	int64_t e10 = 0, e_val = 0;
+	unsigned int n_sig = 0, n_digits = 0;
+	bool negative = false, e_negative = false;
+	double x;
+
+	if (*p == '-' || *p == '+') negative = (*p++ == '-');
+	while (p < end && *p == '0') p++, n_digits++;	/* Leading zeros do not count as significant */
+	while (end - p >= 8 && n_sig + 8 <= 19U && gmt_is_eight_digits (gmt_load_eight_chars (p))) {
+		m = m * 100000000ULL + gmt_parse_eight_digits (gmt_load_eight_chars (p));
+		p += 8, n_sig += 8, n_digits += 8;
+	}
+	while (p < end && isdigit ((int)*p)) {
+		if (n_sig == 19U) return (false);	/* Too many digits for uint64_t */
+		m = 10 * m + (*p++ - '0'), n_sig++, n_digits++;
+	}
+	if (*p == '.') {	/* Fractional part */
+		const char *f = ++p;
+		if (m == 0) while (p < end && *p == '0') p++;	/* Only leading zeros so far */
+		while (end - p >= 8 && n_sig + 8 <= 19U && gmt_is_eight_digits (gmt_load_eight_chars (p))) {
+			m = m * 100000000ULL + gmt_parse_eight_digits (gmt_load_eight_chars (p));
+			p += 8, n_sig += 8;
+		}
+		while (p < end && isdigit ((int)*p)) {
+			if (n_sig == 19U) return (false);
+			m = 10 * m + (*p++ - '0'), n_sig++;
+		}
+		e10 = -(int64_t)(p - f);
+		n_digits += (unsigned int)(p - f);
+	}
+	if (n_digits == 0) return (false);	/* No digits at all */
+	if (*p == 'e' || *p == 'E' || *p == 'd' || *p == 'D') {	/* Exponent (d|D for Fortran double precision) */
+		p++;
+		if (*p == '-' || *p == '+') e_negative = (*p++ == '-');
+		if (!isdigit ((int)*p)) return (false);
+		while (p < end && isdigit ((int)*p)) {
+			if (e_val < 100000) e_val = 10 * e_val + (*p - '0');
+			p++;
+		}
+		e10 += (e_negative) ? -e_val : e_val;
+	}
+	if (p != end) return (false);	/* Trailing junk */
+	if (m == 0)
+		x = 0.0;
+	else {
+		if (m > GMT_FLOAT_FAST_MAX_MANT) return (false);
+		if (e10 > GMT_FLOAT_FAST_MAX_EXP && e10 <= GMT_FLOAT_FAST_MAX_EXP + 15) {	/* Perhaps we can move some of the power into m exactly */
+			while (e10 > GMT_FLOAT_FAST_MAX_EXP && m <= GMT_FLOAT_FAST_MAX_MANT / 10) m *= 10, e10--;
+		}
+		if (e10 < -GMT_FLOAT_FAST_MAX_EXP || e10 > GMT_FLOAT_FAST_MAX_EXP) return (false);
+		x = (double)m;
+		x = (e10 < 0) ? x / gmt_pow10_exact[-e10] : x * gmt_pow10_exact[e10];
+	}
+	*val = (negative) ? -x : x;
+	return (true);
+#else
+	return (false);
+#endif
+}
+
 int gmt_scanf_float (char *s, double *val)
 {
 	/* Try to decode a value from s and store
@@ -4328,6 +4881,8 @@ int gmt_scanf_float (char *s, double *val)
 	double x;
 	size_t j, k;
 
+	if (gmt_scanf_float_fast (s, val)) return (GMT_IS_FLOAT);	/* The common case of a plain number */
+
 	x = strtod (s, &p);
 	if (p[0] == 0) {	/* Success (non-Fortran).  */
 		*val = x;
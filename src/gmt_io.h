@@ -232,6 +232,42 @@ struct GMT_COL_TYPE {	/* Used by -b for binary formatting */
 	int (*io) (struct GMT_CTRL *, FILE *, uint64_t, double *);	/* Pointer to the correct read or write function given type/swab */
 };
 
+struct GMT_ASCII_BLOCK {	/* Used to read and decode ascii tables in large blocks (see gmt_ascii_input) */
+	FILE *fp;		/* The stream this block belongs to (NULL if not attached) */
+	bool active;		/* true if fp is a regular file we may read ahead from */
+	bool eof;		/* true once we have read the last byte from fp */
+	bool decoded;		/* true once the records in the current block have been decoded */
+	char *text;		/* The raw text of the current block */
+	size_t n_bytes;		/* Number of bytes currently in text */
+	size_t n_alloc;		/* Number of bytes allocated for text */
+	size_t *start;		/* Offset into text of the start of each complete record (plus one past the last) */
+	uint64_t n_records;	/* Number of complete records in the current block */
+	uint64_t n_rec_alloc;	/* Number of records allocated for start, value, and flag */
+	uint64_t next;		/* Next record in the block to be returned */
+	uint64_t n_cols;	/* Number of columns decoded per record */
+	uint64_t n_val_alloc;	/* Number of doubles allocated for value */
+	double *value;		/* Decoded values [n_records * n_cols] */
+	uint64_t *n_ok;		/* Number of columns successfully decoded per record */
+	unsigned int *flag;	/* GMT_ASCII_REC_* decoding status per record */
+};
+
+struct GMT_BINARY_BLOCK {	/* Used to read and convert binary tables in large blocks (see gmt_get_binary_input) */
+	FILE *fp;		/* The stream this block belongs to (NULL if not attached) */
+	bool active;		/* true if fp is a regular file that we read ahead from */
+	bool eof;		/* true once we have read the last byte from fp */
+	char *buffer;		/* The raw bytes of the current block */
+	size_t n_bytes;		/* Number of bytes currently in buffer */
+	size_t n_alloc;		/* Number of bytes allocated for buffer */
+	size_t pos;		/* Offset into buffer of the first converted record */
+	size_t rec_size;	/* Number of bytes per record (including any skips) for n_cols columns */
+	size_t *offset;		/* Offset of each column within a record */
+	uint64_t n_cols;	/* Number of columns converted per record */
+	uint64_t n_records;	/* Number of records converted starting at pos */
+	uint64_t next;		/* Next converted record to be returned */
+	uint64_t n_val_alloc;	/* Number of doubles allocated for value */
+	double *value;		/* Converted values [n_records * n_cols] */
+};
+
 struct GMT_IO {				/* Used to process input data records */
 	void * (*input) (struct GMT_CTRL *, FILE *, uint64_t *, int *);	/* Pointer to function reading ascii or binary tables */
 	int (*output) (struct GMT_CTRL *, FILE *, uint64_t, double *);	/* Pointer to function writing ascii or binary tables */
@@ -295,6 +331,8 @@ struct GMT_IO {				/* Used to process input data records */
 	struct GMT_COL_INFO col[2][GMT_MAX_COLUMNS];	/* Order of columns on input and output unless 0,1,2,3,... */
 	struct GMT_COL_TYPE fmt[2][GMT_MAX_COLUMNS];	/* Formatting information for binary data */
 	struct GMT_OGR *OGR;		/* Pointer to GMT/OGR info used during reading */
+	struct GMT_ASCII_BLOCK *block;	/* Read-ahead buffer for ascii tables in regular files */
+	struct GMT_BINARY_BLOCK *bin_block;	/* Read-ahead buffer for binary tables */
 	/* The remainder are just pointers to memory allocated elsewhere */
 	int *varid;			/* Array of variable IDs (netCDF only) */
 	double *scale_factor;		/* Array of scale factors (netCDF only) */
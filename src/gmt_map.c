@@ -47,6 +47,7 @@
  *	GMT_compact_line :	Remove redundant pen movements
  *	GMT_geo_to_xy :		Generic lon/lat to x/y
  *	GMT_geo_to_xy_line :	Same for polygons
+ *	GMT_geo_to_xy_n :	Same for an array
  *	GMT_geoz_to_xy :	Generic 3-D lon/lat/z to x/y
  *	GMT_grd_project :	Generalized grid projection with interpolation
  *	GMT_great_circle_dist :	Returns great circle distance in degrees
@@ -56,6 +57,7 @@
  *	GMT_map_setup :		Initialize map projection
  *	GMT_project_init :	Initialize parameters for grid/image transformations
  *	GMT_xy_to_geo :		Generic inverse x/y to lon/lat projection
+ *	GMT_xy_to_geo_n :	Same for an array
  *	GMT_xyz_to_xy :		Generic xyz to xy projection
  *	GMT_xyz_to_xy_n :	Same for an array
  *
@@ -1185,7 +1187,7 @@ uint64_t GMT_clip_to_map (struct GMT_CTRL *GMT, double *lon, double *lat, uint64
 	}
 	if (out == 0) {		/* All points are inside map boundary; no clipping required */
 		GMT_malloc2 (GMT, xx, yy, np, NULL, double);
-		for (i = 0; i < np; i++) GMT_geo_to_xy (GMT, lon[i], lat[i], &xx[i], &yy[i]);
+		GMT_geo_to_xy_n (GMT, lon, lat, xx, yy, np);
 		*x = xx;	*y = yy;	n = np;
 	}
 	else if (out == np) {	/* All points are outside map boundary */
@@ -1431,7 +1433,8 @@ uint64_t gmt_rect_clip (struct GMT_CTRL *GMT, double *lon, double *lat, uint64_t
 
 	/* Get Cartesian map coordinates */
 
-	for (m = 0; m < n; m++) GMT_geo_to_xy (GMT, lon[m], lat[m], &xtmp[0][m], &ytmp[0][m]);
+	GMT_geo_to_xy_n (GMT, lon, lat, xtmp[0], ytmp[0], n);
+	m = n;
 
 #ifdef DEBUG
 	if (dump) {
@@ -2407,7 +2410,7 @@ double gmt_az_backaz_geodesic (struct GMT_CTRL *GMT, double lonE, double latE, d
 	** Modified by P.W. from: http://article.gmane.org/gmane.comp.gis.proj-4.devel/3478
 	*/
 	int n_iter = 0;
-	static double az, c, d, e, r, f, d_lon, dx, x, y, sa, cx, cy, cz, sx, sy, c2a, cu1, cu2, su1, tu1, tu2, ts, baz, faz;
+	double az, c, d, e, r, f, d_lon, dx, x, y, sa, cx, cy, cz, sx, sy, c2a, cu1, cu2, su1, tu1, tu2, ts, baz, faz;
 
 	f = GMT->current.setting.ref_ellipsoid[GMT->current.setting.proj_ellipsoid].flattening;
 	r = 1.0 - f;
@@ -2440,9 +2443,15 @@ double gmt_az_backaz_geodesic (struct GMT_CTRL *GMT, double lonE, double latE, d
 		x = (1.0 - c) * x * f + dx;
 	} while (fabs (d - x) > VINCENTY_EPS && n_iter <= VINCENTY_MAX_ITER);
 	if (n_iter > VINCENTY_MAX_ITER) {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
 		GMT->current.proj.n_geodesic_approx++;	/* Count inaccurate results */
 		GMT_Report (GMT->parent, GMT_MSG_NORMAL, "Near- or actual antipodal points encountered. Precision may be reduced slightly.\n");
 	}
+#ifdef _OPENMP
+#pragma omp atomic	/* May be called from threads */
+#endif
 	GMT->current.proj.n_geodesic_calls++;
 	/* To give the same sense of results as all other codes, we must basically swap baz and faz; here done in the ? test */
 	az = (back_az) ? atan2 (tu1, tu2) : atan2 (cu1 * sx, baz * cx - su1 * cu2) + M_PI;
@@ -2814,6 +2823,42 @@ void GMT_xy_to_geo_noshift (struct GMT_CTRL *GMT, double *lon, double *lat, doub
 	(*GMT->current.proj.inv) (GMT, lon, lat, x, y);
 }
 
+void GMT_geo_to_xy_n (struct GMT_CTRL *GMT, double *lon, double *lat, double *x, double *y, uint64_t n)
+{	/* Converts n lon/lat points to x/y using the current projection; x,y may be the same arrays as lon,lat */
+	uint64_t k;
+
+	if (!GMT_proj_fwd_n (GMT, lon, lat, x, y, n)) {	/* No array version; do one point at a time */
+		for (k = 0; k < n; k++) GMT_geo_to_xy (GMT, lon[k], lat[k], &x[k], &y[k]);
+		return;
+	}
+	for (k = 0; k < n; k++) {	/* Scale and shift to plot units; NaNs stay NaN */
+		x[k] = x[k] * GMT->current.proj.scale[GMT_X] + GMT->current.proj.origin[GMT_X];
+		y[k] = y[k] * GMT->current.proj.scale[GMT_Y] + GMT->current.proj.origin[GMT_Y];
+	}
+}
+
+void GMT_xy_to_geo_n (struct GMT_CTRL *GMT, double *lon, double *lat, double *x, double *y, uint64_t n)
+{	/* Converts n x/y points to lon/lat using the current projection; lon,lat may be the same arrays as x,y */
+	uint64_t k;
+	double *xp = NULL, *yp = NULL;
+
+	GMT_malloc2 (GMT, xp, yp, n, NULL, double);
+	for (k = 0; k < n; k++) {	/* Remove shift and scale of plot units */
+		xp[k] = (x[k] - GMT->current.proj.origin[GMT_X]) * GMT->current.proj.i_scale[GMT_X];
+		yp[k] = (y[k] - GMT->current.proj.origin[GMT_Y]) * GMT->current.proj.i_scale[GMT_Y];
+	}
+	if (!GMT_proj_inv_n (GMT, lon, lat, xp, yp, n)) {	/* No array version; do one point at a time */
+		for (k = 0; k < n; k++) {
+			if (GMT_is_dnan (xp[k]) || GMT_is_dnan (yp[k]))
+				lon[k] = lat[k] = GMT->session.d_NaN;
+			else
+				(*GMT->current.proj.inv) (GMT, &lon[k], &lat[k], xp[k], yp[k]);
+		}
+	}
+	GMT_free (GMT, xp);
+	GMT_free (GMT, yp);
+}
+
 void GMT_geoz_to_xy (struct GMT_CTRL *GMT, double x, double y, double z, double *x_out, double *y_out)
 {	/* Map-projects xy first, the projects xyz onto xy plane */
 	double x0, y0;
@@ -5589,7 +5634,7 @@ double gmt_geodesic_dist_meter (struct GMT_CTRL *GMT, double lonS, double latS,
 	**	s -- distance between points in meters.
 	** Modified by P.W. from: http://article.gmane.org/gmane.comp.gis.proj-4.devel/3478
 	*/
-	static double s, c, d, e, r, f, d_lon, dx, x, y, sa, cx, cy, cz, sx, sy, c2a, cu1, cu2, su1, tu1, tu2, ts, baz, faz;
+	double s, c, d, e, r, f, d_lon, dx, x, y, sa, cx, cy, cz, sx, sy, c2a, cu1, cu2, su1, tu1, tu2, ts, baz, faz;
 	int n_iter = 0;
 
 	f = GMT->current.setting.ref_ellipsoid[GMT->current.setting.proj_ellipsoid].flattening;
@@ -5623,6 +5668,9 @@ double gmt_geodesic_dist_meter (struct GMT_CTRL *GMT, double lonS, double latS,
 		x = (1.0 - c) * x * f + dx;
 	} while (fabs (d - x) > VINCENTY_EPS && n_iter <= 50);
 	if (n_iter > VINCENTY_MAX_ITER) {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
 		GMT->current.proj.n_geodesic_approx++;	/* Count inaccurate results */
 		GMT_Report (GMT->parent, GMT_MSG_LONG_VERBOSE, "Near- or actual antipodal points encountered. Precision may be reduced slightly.\n");
 		s = M_PI;
@@ -5638,6 +5686,9 @@ double gmt_geodesic_dist_meter (struct GMT_CTRL *GMT, double lonS, double latS,
 			s = M_PI;
 		}
 	}
+#ifdef _OPENMP
+#pragma omp atomic	/* May be called from threads */
+#endif
 	GMT->current.proj.n_geodesic_calls++;
 	return (s * GMT->current.proj.EQ_RAD);
 }
@@ -6090,6 +6141,343 @@ bool gmt_near_lines_spherical (struct GMT_CTRL *P, double lon, double lat, struc
 	return (OK);
 }
 
+/* Uniform-grid index over a table of points or lines so that the near point/line tests only examine
+ * the items close to the test location instead of every vertex in the table. */
+
+#define GMT_DIST_INDEX_MAX_CELLS	4194304U	/* Upper limit on the number of cells in a GMT_DIST_INDEX */
+
+bool gmt_dist_index_reach (struct GMT_CTRL *GMT, bool lines, double dist, double *reach, bool *geo)
+{	/* Convert the largest distance used in the near point (lines = false) or near line tests into a search
+	 * radius in x,y units (Cartesian) or degrees (geographic) that encloses everything the tests can accept.
+	 * Returns false for the distance modes where we cannot bound this radius. */
+	struct GMT_DIST *D = &GMT->current.map.dist[GMT_MAP_DIST];
+
+	*geo = false;
+	switch (D->mode) {
+		case GMT_CARTESIAN_DIST:	/* Distances are r, but gmt_near_a_point_cartesian compares them with dist^2 */
+			*reach = (lines) ? dist : dist * dist;
+			break;
+		case GMT_CARTESIAN_DIST2:	/* Distances are r^2, but gmt_near_a_line_cartesian compares them with dist */
+			*reach = (lines) ? sqrt (dist) : dist;
+			break;
+		case GMT_DIST_M+GMT_GREATCIRCLE:
+		case GMT_DIST_M+GMT_GEODESIC:
+		case GMT_DIST_DEG+GMT_GREATCIRCLE:
+		case GMT_DIST_DEG+GMT_GEODESIC:
+			*reach = dist / D->scale;	/* In meters or degrees */
+			if (!D->arc) *reach /= GMT->current.proj.DIST_M_PR_DEG;	/* Now in degrees */
+			if ((D->mode % 10) == GMT_GEODESIC || GMT->current.setting.proj_aux_latitude != GMT_LATSWAP_NONE)
+				*reach = 1.01 * (*reach) + 0.5;	/* Allow for ellipsoidal distances and auxiliary latitudes */
+			*geo = true;
+			break;
+		default:	/* Flat Earth, loxodromes and projected distances are not handled */
+			return (false);
+	}
+	*reach *= (1.0 + GMT_CONV8_LIMIT);	/* Guard against round-off */
+	return (true);
+}
+
+double gmt_dist_index_west (struct GMT_DIST_INDEX *I)
+{	/* Start of the 360-degree longitude frame used by the cells.  For a non-periodic index
+	 * the frame starts in the middle of the gap between the east and west ends of the data */
+	return ((I->periodic) ? 0.0 : I->wesn[XLO] - 0.5 * (360.0 - (I->wesn[XHI] - I->wesn[XLO])));
+}
+
+double gmt_dist_index_frame (struct GMT_DIST_INDEX *I, double x)
+{	/* Put longitude x in the 360-degree frame used by the cells */
+	double west = gmt_dist_index_west (I);
+	while (x < west) x += 360.0;
+	while (x >= west + 360.0) x -= 360.0;
+	return (x);
+}
+
+int gmt_dist_index_col (struct GMT_DIST_INDEX *I, double x)
+{	/* Cell column for x, which must already be in the frame if geographic */
+	int col = (int)floor ((x - I->wesn[XLO]) * I->r_inc);
+	if (I->periodic) {	/* Wrap around */
+		col %= (int)I->nx;
+		if (col < 0) col += I->nx;
+	}
+	else if (col < 0) col = 0;
+	else if (col >= (int)I->nx) col = I->nx - 1;
+	return (col);
+}
+
+int gmt_dist_index_row (struct GMT_DIST_INDEX *I, double y)
+{	/* Cell row for y */
+	int row = (int)floor ((y - I->wesn[YLO]) * I->r_inc);
+	if (row < 0) row = 0;
+	else if (row >= (int)I->ny) row = I->ny - 1;
+	return (row);
+}
+
+void gmt_dist_index_add (struct GMT_DIST_INDEX *I, double x, double y, uint64_t seg, uint64_t row, uint64_t *last, uint64_t *next)
+{	/* Register item (seg,row) at location (x,y): count it if next is NULL, else store it.  Consecutive
+	 * samples of the same item falling in the same cell are only registered once. */
+	uint64_t cell;
+	if (I->geo) x = gmt_dist_index_frame (I, x);
+	cell = (uint64_t)gmt_dist_index_row (I, y) * I->nx + gmt_dist_index_col (I, x);
+	if (cell == *last) return;
+	*last = cell;
+	if (next) {
+		I->item[next[cell]].seg = seg;
+		I->item[next[cell]++].row = row;
+	}
+	else
+		I->start[cell+1]++;
+}
+
+void gmt_dist_index_register (struct GMT_CTRL *GMT, struct GMT_DIST_INDEX *I, uint64_t *next)
+{	/* Count (next == NULL) or store all items.  Points are registered at their location, line segments at
+	 * points spaced no more than a cell size apart along the straight line or great circle arc */
+	uint64_t seg, row, last, j, n;
+	double t, theta, s, f0, f1, A[3], B[3], P[3], x, y;
+	struct GMT_DATASEGMENT *S = NULL;
+
+	for (seg = 0; seg < I->T->n_segments; seg++) {
+		S = I->T->segment[seg];
+		for (row = 0; row < S->n_rows; row++) {
+			last = UINT64_MAX;
+			gmt_dist_index_add (I, S->coord[GMT_X][row], S->coord[GMT_Y][row], seg, row, &last, next);
+			if (!I->lines || row == S->n_rows - 1) continue;	/* Points only, or no line segment starts here */
+			if (I->geo) {	/* Sample the great circle arc */
+				GMT_geo_to_cart (GMT, S->coord[GMT_Y][row], S->coord[GMT_X][row], A, true);
+				GMT_geo_to_cart (GMT, S->coord[GMT_Y][row+1], S->coord[GMT_X][row+1], B, true);
+				theta = d_acosd (GMT_dot3v (GMT, A, B));
+				s = sind (theta);
+				n = (s > GMT_CONV8_LIMIT) ? (uint64_t)ceil (theta * I->r_inc) : 1;	/* Nearly coincident (or antipodal) points: use the end points */
+				for (j = 1; j < n; j++) {
+					t = (double)j / (double)n;
+					f0 = sind ((1.0 - t) * theta) / s;	f1 = sind (t * theta) / s;
+					P[0] = f0 * A[0] + f1 * B[0];	P[1] = f0 * A[1] + f1 * B[1];	P[2] = f0 * A[2] + f1 * B[2];
+					GMT_cart_to_geo (GMT, &y, &x, P, true);
+					gmt_dist_index_add (I, x, y, seg, row, &last, next);
+				}
+			}
+			else {	/* Sample the straight line */
+				n = (uint64_t)ceil (hypot (S->coord[GMT_X][row+1] - S->coord[GMT_X][row], S->coord[GMT_Y][row+1] - S->coord[GMT_Y][row]) * I->r_inc);
+				for (j = 1; j < n; j++) {
+					t = (double)j / (double)n;
+					x = S->coord[GMT_X][row] + t * (S->coord[GMT_X][row+1] - S->coord[GMT_X][row]);
+					y = S->coord[GMT_Y][row] + t * (S->coord[GMT_Y][row+1] - S->coord[GMT_Y][row]);
+					gmt_dist_index_add (I, x, y, seg, row, &last, next);
+				}
+			}
+			gmt_dist_index_add (I, S->coord[GMT_X][row+1], S->coord[GMT_Y][row+1], seg, row, &last, next);
+		}
+	}
+}
+
+struct GMT_DIST_INDEX * GMT_create_dist_index (struct GMT_CTRL *GMT, struct GMT_DATATABLE *T, bool lines, double dist)
+{	/* Create an index of the points (lines = false) or line segments (lines = true) in T for use with
+	 * GMT_near_a_point_indexed or GMT_near_lines_indexed.  GMT_init_distaz must already have been called.
+	 * For points, dist is the distance later passed to GMT_near_a_point_indexed (0 means use the 3rd column);
+	 * for lines, the segment distances S->dist are used.  Returns NULL if the distance mode cannot be indexed,
+	 * in which case the caller should use GMT_near_a_point or GMT_near_lines instead. */
+	bool geo;
+	uint64_t seg, row, n_cells, cell, *next = NULL;
+	double d_max = 0.0, reach, h, width, height, x, y;
+	double wesn[4] = {DBL_MAX, -DBL_MAX, DBL_MAX, -DBL_MAX}, w180[2] = {DBL_MAX, -DBL_MAX};
+	struct GMT_DIST_INDEX *I = NULL;
+
+	if (T->n_records == 0) return (NULL);
+
+	/* Get the largest distance we will be testing for */
+	for (seg = 0; seg < T->n_segments; seg++) {
+		if (lines)
+			d_max = MAX (d_max, T->segment[seg]->dist);
+		else if (dist <= 0.0 && T->segment[0]->n_columns > 2) {	/* Each point has its own distance */
+			for (row = 0; row < T->segment[seg]->n_rows; row++) d_max = MAX (d_max, T->segment[seg]->coord[GMT_Z][row]);
+		}
+		else
+			d_max = dist;
+	}
+	if (!gmt_dist_index_reach (GMT, lines, d_max, &reach, &geo)) {
+		GMT_Report (GMT->parent, GMT_MSG_LONG_VERBOSE, "Distance mode cannot be indexed; all %s will be searched\n", (lines) ? "lines" : "points");
+		return (NULL);
+	}
+
+	/* Get the extent of the data; for longitudes we try both 0/360 and -180/180 and pick the narrower */
+	for (seg = 0; seg < T->n_segments; seg++) {
+		for (row = 0; row < T->segment[seg]->n_rows; row++) {
+			x = T->segment[seg]->coord[GMT_X][row];	y = T->segment[seg]->coord[GMT_Y][row];
+			if (geo) {
+				while (x < 0.0) x += 360.0;
+				while (x >= 360.0) x -= 360.0;
+				w180[0] = MIN (w180[0], (x >= 180.0) ? x - 360.0 : x);
+				w180[1] = MAX (w180[1], (x >= 180.0) ? x - 360.0 : x);
+			}
+			wesn[XLO] = MIN (wesn[XLO], x);	wesn[XHI] = MAX (wesn[XHI], x);
+			wesn[YLO] = MIN (wesn[YLO], y);	wesn[YHI] = MAX (wesn[YHI], y);
+		}
+	}
+	if (geo && (w180[1] - w180[0]) < (wesn[XHI] - wesn[XLO])) {	/* Data straddle Greenwich */
+		wesn[XLO] = w180[0];	wesn[XHI] = w180[1];
+	}
+
+	I = GMT_memory (GMT, NULL, 1, struct GMT_DIST_INDEX);
+	I->T = T;
+	I->lines = lines;
+	I->geo = geo;
+	I->periodic = (geo && (wesn[XHI] - wesn[XLO]) > 180.0);
+	if (I->periodic) {	/* Let the cells go all the way around */
+		wesn[XLO] = 0.0;	wesn[XHI] = 360.0;
+	}
+	width = wesn[XHI] - wesn[XLO];	height = wesn[YHI] - wesn[YLO];
+
+	/* Pick the cell size so there are a few points per cell, but no smaller than the search radius */
+	n_cells = MIN (MAX (T->n_records / 2, 1), GMT_DIST_INDEX_MAX_CELLS);
+	h = sqrt (width * height / n_cells);
+	if (h == 0.0) h = MAX (width, height) / n_cells;	/* All points are on a line */
+	h = MAX (h, reach);
+	if (h == 0.0) h = 1.0;	/* A single point with zero distance */
+	while (((width / h) + 1.0) * ((height / h) + 1.0) > GMT_DIST_INDEX_MAX_CELLS) h *= 2.0;
+	if (I->periodic) {	/* Make the cells fit exactly around the globe */
+		I->nx = MAX (1U, (unsigned int)floor (360.0 / h));
+		h = 360.0 / I->nx;
+	}
+	else
+		I->nx = (unsigned int)floor (width / h) + 1;
+	I->ny = (unsigned int)floor (height / h) + 1;
+	I->inc = h;	I->r_inc = 1.0 / h;
+	GMT_memcpy (I->wesn, wesn, 4, double);
+	I->reach = (lines) ? reach + 0.5 * h : reach;	/* Line items are sampled every cell size */
+	if (geo && I->reach > 180.0) I->reach = 180.0;
+
+	/* Count the items per cell, turn the counts into offsets, then store the items */
+	n_cells = (uint64_t)I->nx * I->ny;
+	I->start = GMT_memory (GMT, NULL, n_cells + 1, uint64_t);
+	gmt_dist_index_register (GMT, I, NULL);
+	for (cell = 0; cell < n_cells; cell++) I->start[cell+1] += I->start[cell];
+	I->item = GMT_memory (GMT, NULL, MAX (I->start[n_cells], 1), struct GMT_DIST_ITEM);
+	next = GMT_memory (GMT, NULL, n_cells, uint64_t);
+	GMT_memcpy (next, I->start, n_cells, uint64_t);
+	gmt_dist_index_register (GMT, I, next);
+	GMT_free (GMT, next);
+
+	GMT_Report (GMT->parent, GMT_MSG_LONG_VERBOSE, "Indexed %" PRIu64 " %s items in %u x %u cells of size %g\n",
+		I->start[n_cells], (lines) ? "line" : "point", I->nx, I->ny, h);
+	return (I);
+}
+
+void GMT_free_dist_index (struct GMT_CTRL *GMT, struct GMT_DIST_INDEX **I)
+{	/* Free an index created by GMT_create_dist_index */
+	if (!(*I)) return;
+	GMT_free (GMT, (*I)->start);
+	GMT_free (GMT, (*I)->item);
+	GMT_free (GMT, *I);
+}
+
+unsigned int gmt_dist_index_range (struct GMT_DIST_INDEX *I, double x, double y, int row[], int col[])
+{	/* Find the rows row[0]-row[1] and the one or two column ranges col[0]-col[1] (and col[2]-col[3]) of
+	 * the cells that may hold items within reach of (x,y).  Returns the number of column ranges. */
+	int c0, c1, nx = I->nx;
+	double dx = I->reach;
+
+	row[0] = gmt_dist_index_row (I, y - I->reach);
+	row[1] = gmt_dist_index_row (I, y + I->reach);
+	col[0] = 0;	col[1] = nx - 1;	/* Default is all columns */
+
+	if (I->geo) {
+		if ((fabs (y) + I->reach) >= 90.0)	/* Reach extends over a pole, so all longitudes are possible */
+			return (1);
+		dx = d_asind (sind (I->reach) / cosd (y));	/* Largest longitude difference within reach */
+		dx *= (1.0 + GMT_CONV8_LIMIT);
+		if (dx >= 180.0) return (1);
+		x = gmt_dist_index_frame (I, x);
+		if (!I->periodic) {
+			double west = gmt_dist_index_west (I);
+			if ((x - dx) < west || (x + dx) >= (west + 360.0)) return (1);	/* Range wraps across the frame boundary */
+		}
+	}
+	c0 = (int)floor ((x - dx - I->wesn[XLO]) * I->r_inc);
+	c1 = (int)floor ((x + dx - I->wesn[XLO]) * I->r_inc);
+	if (I->periodic) {	/* Wrap around */
+		if ((c1 - c0 + 1) >= nx) return (1);
+		if (c0 < 0) {
+			col[0] = c0 + nx;	col[1] = nx - 1;
+			col[2] = 0;	col[3] = c1;
+			return (2);
+		}
+		if (c1 >= nx) {
+			col[0] = c0;	col[1] = nx - 1;
+			col[2] = 0;	col[3] = c1 - nx;
+			return (2);
+		}
+	}
+	col[0] = gmt_dist_index_col (I, x - dx);
+	col[1] = gmt_dist_index_col (I, x + dx);
+	return (1);
+}
+
+bool GMT_near_a_point_indexed (struct GMT_CTRL *GMT, double x, double y, struct GMT_DIST_INDEX *I, double dist)
+{	/* Same as GMT_near_a_point but only the points in cells near (x,y) are examined */
+	bool cartesian = (GMT->current.map.near_point_func == &gmt_near_a_point_cartesian), each_point_has_distance;
+	int row[2], col[4], r, c;
+	unsigned int k, n_ranges;
+	uint64_t j, cell;
+	double x0, y0, d0 = dist;
+	struct GMT_DATASEGMENT *S = NULL;
+
+	each_point_has_distance = (dist <= 0.0 && I->T->segment[0]->n_columns > 2);
+	n_ranges = gmt_dist_index_range (I, x, y, row, col);
+	for (r = row[0]; r <= row[1]; r++) {
+		for (k = 0; k < n_ranges; k++) {
+			for (c = col[2*k], cell = (uint64_t)r * I->nx + c; c <= col[2*k+1]; c++, cell++) {
+				for (j = I->start[cell]; j < I->start[cell+1]; j++) {
+					S = I->T->segment[I->item[j].seg];
+					x0 = S->coord[GMT_X][I->item[j].row];	y0 = S->coord[GMT_Y][I->item[j].row];
+					if (each_point_has_distance) d0 = S->coord[GMT_Z][I->item[j].row];
+					if (cartesian) {	/* GMT_distance returns distances^2 */
+						if (fabs (x - x0) > d0 || fabs (y - y0) > d0) continue;
+						if (GMT_distance (GMT, x, y, x0, y0) <= d0 * d0) return (true);
+					}
+					else if (GMT_distance (GMT, x, y, x0, y0) <= d0)
+						return (true);
+				}
+			}
+		}
+	}
+	return (false);
+}
+
+bool GMT_near_lines_indexed (struct GMT_CTRL *GMT, double lon, double lat, struct GMT_DIST_INDEX *I, unsigned int end_mode)
+{	/* Same as GMT_near_lines with return_mindist = end_mode (0 or 10) but only the line segments in cells
+	 * near (lon,lat) are examined.  Each candidate line segment is tested by passing a two-point segment
+	 * to near_a_line_func with the end points excluded; the end points themselves are tested here so
+	 * that only the true end points of the line are skipped when end_mode is 10. */
+	bool perpendicular_only = (end_mode >= 10);
+	int row[2], col[4], r, c;
+	unsigned int k, n_ranges;
+	uint64_t j, cell, row0, p;
+	double *coord[2];
+	struct GMT_DATASEGMENT *S = NULL, E;
+
+	GMT_memset (&E, 1, struct GMT_DATASEGMENT);
+	E.coord = coord;
+	E.n_rows = 2;
+	n_ranges = gmt_dist_index_range (I, lon, lat, row, col);
+	for (r = row[0]; r <= row[1]; r++) {
+		for (k = 0; k < n_ranges; k++) {
+			for (c = col[2*k], cell = (uint64_t)r * I->nx + c; c <= col[2*k+1]; c++, cell++) {
+				for (j = I->start[cell]; j < I->start[cell+1]; j++) {
+					S = I->T->segment[I->item[j].seg];
+					row0 = I->item[j].row;
+					for (p = row0; p <= row0 + 1 && p < S->n_rows; p++) {	/* Check the nodes */
+						if (perpendicular_only && (p == 0 || p == S->n_rows - 1)) continue;	/* Skip line end points */
+						if (GMT_distance (GMT, lon, lat, S->coord[GMT_X][p], S->coord[GMT_Y][p]) <= S->dist) return (true);
+					}
+					if (row0 + 1 >= S->n_rows) continue;	/* Single point, no line segment */
+					coord[GMT_X] = &S->coord[GMT_X][row0];	coord[GMT_Y] = &S->coord[GMT_Y][row0];
+					E.dist = S->dist;
+					if (GMT->current.map.near_a_line_func (GMT, lon, lat, I->item[j].seg, &E, 10, NULL, NULL, NULL)) return (true);
+				}
+			}
+		}
+	}
+	return (false);
+}
+
 int GMT_great_circle_intersection (struct GMT_CTRL *GMT, double A[], double B[], double C[], double X[], double *CX_dist)
 {
 	/* A, B, C are 3-D Cartesian unit vectors, i.e., points on the sphere.
@@ -6482,18 +6870,22 @@ uint64_t GMT_geo_to_xy_line (struct GMT_CTRL *GMT, double *lon, double *lat, uin
 	unsigned int sides[4];
 	unsigned int nx;
 	double xlon[4], xlat[4], xx[4], yy[4];
-	double this_x, this_y, last_x, last_y, dummy[4];
+	double this_x, this_y, last_x, last_y, dummy[4], *xp = NULL, *yp = NULL;
 
 	while (n > GMT->current.plot.n_alloc) GMT_get_plot_array (GMT);
 
+	/* Project all points up front, then trace the line */
+	GMT_malloc2 (GMT, xp, yp, n, NULL, double);
+	GMT_geo_to_xy_n (GMT, lon, lat, xp, yp, n);
+
 	np = 0;
-	GMT_geo_to_xy (GMT, lon[0], lat[0], &last_x, &last_y);
+	last_x = xp[0];	last_y = yp[0];
 	if (!GMT_map_outside (GMT, lon[0], lat[0])) {
 		GMT->current.plot.x[0] = last_x;	GMT->current.plot.y[0] = last_y;
 		GMT->current.plot.pen[np++] = PSL_MOVE;
 	}
 	for (j = 1; j < n; j++) {
-		GMT_geo_to_xy (GMT, lon[j], lat[j], &this_x, &this_y);
+		this_x = xp[j];	this_y = yp[j];
 		inside = !GMT_map_outside (GMT, lon[j], lat[j]);
 		if (GMT_is_dnan (lon[j]) || GMT_is_dnan (lat[j])) continue;	/* Skip NaN point now */
 		if (GMT_is_dnan (lon[j-1]) || GMT_is_dnan (lat[j-1])) {		/* Point after NaN needs a move */
@@ -6531,6 +6923,8 @@ uint64_t GMT_geo_to_xy_line (struct GMT_CTRL *GMT, double *lon, double *lat, uin
 		}
 		last_x = this_x;	last_y = this_y;
 	}
+	GMT_free (GMT, xp);
+	GMT_free (GMT, yp);
 	if (np) GMT->current.plot.pen[0] = PSL_MOVE;	/* Sanity override: Gotta start off with new start point */
 
 	/* When a line that starts and ends inside the domain exits and reenters, we end up with two pieces.
@@ -6638,6 +7032,78 @@ int GMT_project_init (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, doub
 }
 
 
+/* Lookup tables for GMT_grd_project.  Finding which output node each input node falls on
+ * (antialias pass) and which input coordinates each output node maps to (interpolation pass)
+ * means a projection call per node.  When the tables are small enough we keep those from the
+ * last call, so repeated projections of grids with the same geometry (e.g., the r, g, b grids
+ * in grdimage) skip all projection calls. */
+
+#define GMT_GRDPROJ_BAND	1048576U	/* Input nodes mapped per band in the antialias pass */
+#define GMT_GRDPROJ_CACHE_MAX	268435456U	/* Max bytes of lookup tables kept for reuse [256 MiB] */
+#define GMT_GRDPROJ_SKIP	-1	/* Input node falls outside the output grid */
+#define GMT_GRDPROJ_OUTSIDE	-2	/* Input node is outside the map region */
+
+struct GMT_GRDPROJ_KEY {	/* Everything the lookup tables depend on */
+	double pars[10], scale[2], origin[2], central_meridian, pole, EQ_RAD, ECC2, scale_factor;
+	double R_wesn[4], in_wesn[4], out_wesn[4];
+	unsigned int in_nx, in_ny, out_nx, out_ny, out_mx, out_pad[4], in_reg, out_reg;
+	double xyz_pow[3];
+	int projection, aux_latitude;
+	unsigned int xyz_projection[3], xyz_pos[3];
+	unsigned int inverse, antialias, north_pole, convert_latitudes, lon_wrap, x_is_lon;
+};
+
+struct GMT_GRDPROJ_CACHE {	/* Lookup tables of the last GMT_grd_project call */
+	struct GMT_GRDPROJ_KEY key;
+	int64_t *ij_out;		/* Output node for each input node, or GMT_GRDPROJ_SKIP|OUTSIDE [antialias only] */
+	double *x_proj, *y_proj;	/* Input grid coordinates of each output node */
+};
+
+void GMT_grd_project_free_cache (struct GMT_CTRL *GMT)
+{	/* Free the lookup tables kept by GMT_grd_project, if any */
+	struct GMT_GRDPROJ_CACHE *C = GMT->current.grdproj_cache;
+	if (C == NULL) return;
+	if (C->ij_out) free (C->ij_out);
+	free (C->x_proj);
+	free (C->y_proj);
+	free (C);
+	GMT->current.grdproj_cache = NULL;
+}
+
+static void gmt_grdproj_key (struct GMT_CTRL *GMT, struct GMT_GRID *I, struct GMT_GRID *O, bool inverse, struct GMT_GRDPROJ_KEY *key)
+{	/* Fill the key that identifies the lookup tables for this projection and grid geometry */
+	unsigned int k;
+	GMT_memset (key, 1, struct GMT_GRDPROJ_KEY);	/* So any padding compares equal too */
+	GMT_memcpy (key->pars, GMT->current.proj.pars, 10, double);
+	GMT_memcpy (key->scale, GMT->current.proj.scale, 2, double);
+	GMT_memcpy (key->origin, GMT->current.proj.origin, 2, double);
+	key->central_meridian = GMT->current.proj.central_meridian;
+	key->pole = GMT->current.proj.pole;
+	key->EQ_RAD = GMT->current.proj.EQ_RAD;
+	key->ECC2 = GMT->current.proj.ECC2;
+	key->scale_factor = GMT->current.setting.proj_scale_factor;	/* Read by several projections when they are set up */
+	key->aux_latitude = GMT->current.setting.proj_aux_latitude;
+	GMT_memcpy (key->R_wesn, GMT->common.R.wesn, 4, double);
+	GMT_memcpy (key->in_wesn, I->header->wesn, 4, double);
+	GMT_memcpy (key->out_wesn, O->header->wesn, 4, double);
+	key->in_nx = I->header->nx;	key->in_ny = I->header->ny;	key->in_reg = I->header->registration;
+	key->out_nx = O->header->nx;	key->out_ny = O->header->ny;	key->out_reg = O->header->registration;
+	key->out_mx = O->header->mx;
+	GMT_memcpy (key->out_pad, O->header->pad, 4, unsigned int);
+	key->projection = GMT->current.proj.projection;
+	for (k = 0; k < 3; k++) {	/* Linear, log10 or power axes of -Jx|X */
+		key->xyz_projection[k] = GMT->current.proj.xyz_projection[k];
+		key->xyz_pos[k] = GMT->current.proj.xyz_pos[k];
+		key->xyz_pow[k] = GMT->current.proj.xyz_pow[k];
+	}
+	key->inverse = inverse;
+	key->antialias = GMT->common.n.antialias;
+	key->north_pole = GMT->current.proj.north_pole;
+	key->convert_latitudes = GMT->current.proj.GMT_convert_latitudes;
+	key->lon_wrap = GMT->current.map.lon_wrap;
+	key->x_is_lon = GMT_x_is_lon (GMT, GMT_IN);
+}
+
 int GMT_grd_project (struct GMT_CTRL *GMT, struct GMT_GRID *I, struct GMT_GRID *O, bool inverse)
 {
 	/* Generalized grid projection that deals with both interpolation and averaging effects.
@@ -6657,14 +7123,22 @@ int GMT_grd_project (struct GMT_CTRL *GMT, struct GMT_GRID *I, struct GMT_GRID *
 	 *
 	 * Changed 10-Sep-07 to include the argument "antialias" and "threshold" and
 	 * made "interpolant" an integer (was int bilinear).
+	 *
+	 * Both passes run in parallel over rows when the projection is reentrant (or the graticule
+	 * is rectangular so no projection calls are needed).  The antialias sums are still added
+	 * up on one thread in input order, so results do not depend on the number of threads.
 	 */
 
-	int col_in, row_in, col_out, row_out;
- 	uint64_t ij_in, ij_out;
+	bool rect, parallel, check_outside, hit = false, keep = false;
+	int col_in, row_in, col_out, row_out, nx_in, ny_in, nx_out, ny_out, row0, row1, band_rows;
+ 	uint64_t ij_in, ij_out, k, n_bytes;
+	int64_t *map = NULL;
 	short int *nz = NULL;
 	double x_proj = 0.0, y_proj = 0.0, z_int, inv_nz;
 	double *x_in = NULL, *x_out = NULL, *x_in_proj = NULL, *x_out_proj = NULL;
 	double *y_in = NULL, *y_out = NULL, *y_in_proj = NULL, *y_out_proj = NULL;
+	struct GMT_GRDPROJ_KEY key;
+	struct GMT_GRDPROJ_CACHE *C = NULL;
 
 	/* Only input grid MUST have at least 2 rows/cols padding */
 	if (I->header->pad[XLO] < 2 || I->header->pad[XHI] < 2 || I->header->pad[YLO] < 2 || I->header->pad[YHI] < 2) {
@@ -6672,6 +7146,40 @@ int GMT_grd_project (struct GMT_CTRL *GMT, struct GMT_GRID *I, struct GMT_GRID *
 		GMT_exit (GMT, EXIT_FAILURE); return EXIT_FAILURE;
 	}
 
+	nx_in  = I->header->nx;	ny_in  = I->header->ny;
+	nx_out = O->header->nx;	ny_out = O->header->ny;
+	rect = GMT_IS_RECT_GRATICULE (GMT);
+	parallel = (rect || GMT_proj_is_reentrant (GMT));
+	check_outside = (!inverse && !rect);	/* Input nodes may be beyond the horizon */
+
+	/* See if we can reuse, or should keep, the lookup tables */
+
+	gmt_grdproj_key (GMT, I, O, inverse, &key);
+	if ((C = GMT->current.grdproj_cache) && !memcmp (&C->key, &key, sizeof (struct GMT_GRDPROJ_KEY)))
+		hit = true;
+	else {
+		n_bytes = 2 * O->header->nm * sizeof (double);
+		if (GMT->common.n.antialias) n_bytes += I->header->nm * sizeof (int64_t);
+		if (n_bytes <= GMT_GRDPROJ_CACHE_MAX && GMT->current.proj.projection != GMT_GENPER) {	/* Small enough to keep */
+			GMT_grd_project_free_cache (GMT);
+			C = calloc (1U, sizeof (struct GMT_GRDPROJ_CACHE));
+			C->x_proj = malloc (O->header->nm * sizeof (double));
+			C->y_proj = malloc (O->header->nm * sizeof (double));
+			if (GMT->common.n.antialias) C->ij_out = malloc (I->header->nm * sizeof (int64_t));
+			if (C->x_proj == NULL || C->y_proj == NULL || (GMT->common.n.antialias && C->ij_out == NULL)) {	/* Just do without */
+				GMT->current.grdproj_cache = C;
+				GMT_grd_project_free_cache (GMT);
+				C = NULL;
+			}
+			else {
+				C->key = key;
+				keep = true;
+			}
+		}
+	}
+	GMT_Report (GMT->parent, GMT_MSG_DEBUG, "GMT_grd_project: %s lookup tables, %s\n", hit ? "Reusing" : (keep ? "Building" : "Not keeping"),
+		parallel ? "multi-threaded" : "single-threaded");
+
 	/* Precalculate grid coordinates */
 
 	x_in  = GMT_grd_coord (GMT, I->header, GMT_X);
@@ -6679,7 +7187,7 @@ int GMT_grd_project (struct GMT_CTRL *GMT, struct GMT_GRID *I, struct GMT_GRID *
 	x_out = GMT_grd_coord (GMT, O->header, GMT_X);
 	y_out = GMT_grd_coord (GMT, O->header, GMT_Y);
 
-	if (GMT_IS_RECT_GRATICULE (GMT)) {	/* Since lon/lat parallels x/y it pays to precalculate projected grid coordinates up front */
+	if (rect && !hit) {	/* Since lon/lat parallels x/y it pays to precalculate projected grid coordinates up front */
 		x_in_proj  = GMT_memory (GMT, NULL, I->header->nx, double);
 		y_in_proj  = GMT_memory (GMT, NULL, I->header->ny, double);
 		x_out_proj = GMT_memory (GMT, NULL, O->header->nx, double);
@@ -6708,62 +7216,101 @@ int GMT_grd_project (struct GMT_CTRL *GMT, struct GMT_GRID *I, struct GMT_GRID *
 
 	/* PART 1: Project input grid points and do a blockmean operation */
 
-	O->header->z_min = FLT_MAX; O->header->z_max = -FLT_MAX;	/* Min/max for out */
 	if (GMT->common.n.antialias) {	/* Blockaverage repeat pixels, at least the first ~32767 of them... */
-		int nx = O->header->nx, ny = O->header->ny;
 		nz = GMT_memory (GMT, NULL, O->header->size, short int);
-		GMT_row_loop (GMT, I, row_in) {	/* Loop over the input grid row coordinates */
-			if (GMT_IS_RECT_GRATICULE (GMT)) y_proj = y_in_proj[row_in];
-			GMT_col_loop (GMT, I, row_in, col_in, ij_in) {	/* Loop over the input grid col coordinates */
-				if (GMT_IS_RECT_GRATICULE (GMT))
-					x_proj = x_in_proj[col_in];
-				else if (inverse)
-					GMT_xy_to_geo (GMT, &x_proj, &y_proj, x_in[col_in], y_in[row_in]);
-				else {
-					if (GMT->current.map.outside (GMT, x_in[col_in], y_in[row_in])) continue;	/* Quite possible we are beyond the horizon */
-					GMT_geo_to_xy (GMT, x_in[col_in], y_in[row_in], &x_proj, &y_proj);
+		if (hit || keep) {	/* Map (or look up) all input nodes at once */
+			map = C->ij_out;
+			band_rows = ny_in;
+		}
+		else {	/* Map input nodes in bands of rows to limit memory use */
+			band_rows = MAX (1, (int)(GMT_GRDPROJ_BAND / nx_in));
+			map = GMT_memory (GMT, NULL, (size_t)MIN (band_rows, ny_in) * nx_in, int64_t);
+		}
+		for (row0 = 0; row0 < ny_in; row0 = row1) {
+			row1 = MIN (row0 + band_rows, ny_in);
+			if (!hit) {	/* Find the output node of each input node in this band */
+				if (check_outside) {	/* The map region test is not reentrant but cheap, so do it first on a single thread */
+					for (row_in = row0, k = 0; row_in < row1; row_in++) for (col_in = 0; col_in < nx_in; col_in++, k++)
+						map[k] = (GMT->current.map.outside (GMT, x_in[col_in], y_in[row_in])) ? GMT_GRDPROJ_OUTSIDE : 0;	/* Quite possible we are beyond the horizon */
 				}
-
-				/* Here, (x_proj, y_proj) is the projected grid point.  Now find nearest node on the output grid */
-
-				row_out = GMT_grd_y_to_row (GMT, y_proj, O->header);
-				if (row_out < 0 || row_out >= ny) continue;	/* Outside our grid region */
-				col_out = GMT_grd_x_to_col (GMT, x_proj, O->header);
-				if (col_out < 0 || col_out >= nx) continue;	/* Outside our grid region */
-
-				/* OK, this projected point falls inside the projected grid's rectangular domain */
-
-				ij_out = GMT_IJP (O->header, row_out, col_out);	/* The output node */
-				if (nz[ij_out] == 0) O->data[ij_out] = 0.0f;	/* First time, override the initial value */
-				if (nz[ij_out] < SHRT_MAX) {			/* Avoid overflow */
-					O->data[ij_out] += I->data[ij_in];	/* Add up the z-sum inside this rect... */
-					nz[ij_out]++;				/* ..and how many points there were */
+#ifdef _OPENMP
+#pragma omp parallel for private(row_in,col_in,k,x_proj,y_proj,row_out,col_out) shared(GMT,I,O,map,row0,row1,nx_in,nx_out,ny_out,rect,inverse,check_outside,x_in,y_in,x_in_proj,y_in_proj) if (parallel)
+#endif
+				for (row_in = row0; row_in < row1; row_in++) {	/* Loop over the input grid row coordinates */
+					k = (uint64_t)(row_in - row0) * nx_in;
+					for (col_in = 0; col_in < nx_in; col_in++, k++) {	/* Loop over the input grid col coordinates */
+						if (check_outside && map[k] == GMT_GRDPROJ_OUTSIDE) continue;
+						if (rect) {
+							x_proj = x_in_proj[col_in];
+							y_proj = y_in_proj[row_in];
+						}
+						else if (inverse)
+							GMT_xy_to_geo (GMT, &x_proj, &y_proj, x_in[col_in], y_in[row_in]);
+						else
+							GMT_geo_to_xy (GMT, x_in[col_in], y_in[row_in], &x_proj, &y_proj);
+
+						/* Here, (x_proj, y_proj) is the projected grid point.  Now find nearest node on the output grid */
+
+						row_out = GMT_grd_y_to_row (GMT, y_proj, O->header);
+						col_out = GMT_grd_x_to_col (GMT, x_proj, O->header);
+						if (row_out < 0 || row_out >= ny_out || col_out < 0 || col_out >= nx_out)
+							map[k] = GMT_GRDPROJ_SKIP;	/* Outside our grid region */
+						else
+							map[k] = (int64_t)GMT_IJP (O->header, row_out, col_out);	/* The output node */
+					}
 				}
-				if (GMT_is_fnan (O->data[ij_out])) continue;
-				if (O->data[ij_out] < O->header->z_min) O->header->z_min = O->data[ij_out];
-				if (O->data[ij_out] > O->header->z_max) O->header->z_max = O->data[ij_out];
 			}
+			/* Add up the input nodes on a single thread and in order, as they may share output nodes */
+			for (row_in = row0, k = 0; row_in < row1; row_in++) {
+				GMT_col_loop (GMT, I, row_in, col_in, ij_in) {
+					if (map[k] < 0) {k++; continue;}	/* Not inside the output grid's rectangular domain */
+					ij_out = map[k++];
+					if (nz[ij_out] == 0) O->data[ij_out] = 0.0f;	/* First time, override the initial value */
+					if (nz[ij_out] < SHRT_MAX) {			/* Avoid overflow */
+						O->data[ij_out] += I->data[ij_in];	/* Add up the z-sum inside this rect... */
+						nz[ij_out]++;				/* ..and how many points there were */
+					}
+				}
+			}
+			if (hit || keep) map += (uint64_t)(row1 - row0) * nx_in;	/* No-op since there is only one band */
 		}
+		if (!(hit || keep)) GMT_free (GMT, map);
 	}
 
 	/* PART 2: Create weighted average of interpolated and observed points */
 
-	GMT_row_loop (GMT, O, row_out) {	/* Loop over the output grid row coordinates */
-		if (GMT_IS_RECT_GRATICULE (GMT)) y_proj = y_out_proj[row_out];
-		GMT_col_loop (GMT, O, row_out, col_out, ij_out) {	/* Loop over the output grid col coordinates */
-			if (GMT_IS_RECT_GRATICULE (GMT))
-				x_proj = x_out_proj[col_out];
-			else if (inverse)
-				GMT_geo_to_xy (GMT, x_out[col_out], y_out[row_out], &x_proj, &y_proj);
+#ifdef _OPENMP
+#pragma omp parallel for private(row_out,col_out,ij_out,k,x_proj,y_proj,z_int,inv_nz) shared(GMT,I,O,C,nz,nx_out,ny_out,rect,inverse,hit,keep,x_out,y_out,x_out_proj,y_out_proj) if (parallel)
+#endif
+	for (row_out = 0; row_out < ny_out; row_out++) {	/* Loop over the output grid row coordinates */
+		k = (uint64_t)row_out * nx_out;
+		ij_out = GMT_IJP (O->header, row_out, 0);
+		for (col_out = 0; col_out < nx_out; col_out++, ij_out++, k++) {	/* Loop over the output grid col coordinates */
+			if (hit) {
+				x_proj = C->x_proj[k];
+				y_proj = C->y_proj[k];
+			}
 			else {
-				GMT_xy_to_geo (GMT, &x_proj, &y_proj, x_out[col_out], y_out[row_out]);
-				if (GMT->current.proj.projection == GMT_GENPER && GMT->current.proj.g_outside) continue;	/* We are beyond the horizon */
-
-				/* On 17-Sep-2007 the slack of GMT_CONV4_LIMIT was added to allow for round-off
-				   errors in the grid limits. */
-				if (GMT_x_is_lon (GMT, GMT_IN) && !GMT_is_dnan (x_proj)) {
-					while (x_proj < I->header->wesn[XLO] - GMT_CONV4_LIMIT) x_proj += 360.0;
-					while (x_proj > I->header->wesn[XHI] + GMT_CONV4_LIMIT) x_proj -= 360.0;
+				if (rect) {
+					x_proj = x_out_proj[col_out];
+					y_proj = y_out_proj[row_out];
+				}
+				else if (inverse)
+					GMT_geo_to_xy (GMT, x_out[col_out], y_out[row_out], &x_proj, &y_proj);
+				else {
+					GMT_xy_to_geo (GMT, &x_proj, &y_proj, x_out[col_out], y_out[row_out]);
+					if (GMT->current.proj.projection == GMT_GENPER && GMT->current.proj.g_outside) continue;	/* We are beyond the horizon */
+
+					/* On 17-Sep-2007 the slack of GMT_CONV4_LIMIT was added to allow for round-off
+					   errors in the grid limits. */
+					if (GMT_x_is_lon (GMT, GMT_IN) && !GMT_is_dnan (x_proj)) {
+						while (x_proj < I->header->wesn[XLO] - GMT_CONV4_LIMIT) x_proj += 360.0;
+						while (x_proj > I->header->wesn[XHI] + GMT_CONV4_LIMIT) x_proj -= 360.0;
+					}
+				}
+				if (keep) {
+					C->x_proj[k] = x_proj;
+					C->y_proj[k] = y_proj;
 				}
 			}
 
@@ -6779,11 +7326,18 @@ int GMT_grd_project (struct GMT_CTRL *GMT, struct GMT_GRID *I, struct GMT_GRID *
 				inv_nz = 1.0 / nz[ij_out];
 				O->data[ij_out] = (float) ((O->data[ij_out] + z_int * inv_nz) / (nz[ij_out] + inv_nz));
 			}
-			if (O->data[ij_out] < O->header->z_min) O->header->z_min = O->data[ij_out];
-			if (O->data[ij_out] > O->header->z_max) O->header->z_max = O->data[ij_out];
 		}
 	}
 
+	/* Min/max for out, determined once all threads are done */
+
+	O->header->z_min = FLT_MAX; O->header->z_max = -FLT_MAX;
+	GMT_grd_loop (GMT, O, row_out, col_out, ij_out) {
+		if (GMT_is_fnan (O->data[ij_out])) continue;
+		if (O->data[ij_out] < O->header->z_min) O->header->z_min = O->data[ij_out];
+		if (O->data[ij_out] > O->header->z_max) O->header->z_max = O->data[ij_out];
+	}
+
 	if (O->header->z_min < I->header->z_min || O->header->z_max > I->header->z_max) {	/* Truncate output to input extrama */
 		GMT_Report (GMT->parent, GMT_MSG_VERBOSE, "GMT_grd_project: Output grid extrema [%g/%g] exceed extrema of input grid [%g/%g]\n",
 			O->header->z_min, O->header->z_max, I->header->z_min, I->header->z_max);
@@ -6797,13 +7351,15 @@ int GMT_grd_project (struct GMT_CTRL *GMT, struct GMT_GRID *I, struct GMT_GRID *
 		}
 	}
 
+	if (keep) GMT->current.grdproj_cache = C;	/* Tables are complete; keep them for next time */
+
 	/* Time to clean up our mess */
 
 	GMT_free (GMT, x_in);
 	GMT_free (GMT, y_in);
 	GMT_free (GMT, x_out);
 	GMT_free (GMT, y_out);
-	if (GMT_IS_RECT_GRATICULE(GMT)) {
+	if (rect && !hit) {
 		GMT_free (GMT, x_in_proj);
 		GMT_free (GMT, y_in_proj);
 		GMT_free (GMT, x_out_proj);
@@ -8205,6 +8761,7 @@ void gmt_set_distaz (struct GMT_CTRL *GMT, unsigned int mode, unsigned int type)
 	char *rad[5] = {"mean (R_1)", "authalic (R_2)", "volumetric (R_3)", "meridional", "quadratic"};
 	int choice = (GMT->current.setting.proj_aux_latitude == GMT_LATSWAP_NONE) ? 0 : 1 + GMT->current.setting.proj_aux_latitude/2;
 	GMT->current.map.dist[type].scale = 1.0;	/* Default scale */
+	GMT->current.map.dist[type].mode = mode;	/* So GMT_create_dist_index knows the distance mode */
 
 	switch (mode) {	/* Set pointers to distance functions */
 		case GMT_CARTESIAN_DIST:	/* Cartesian 2-D x,y data */
@@ -61,8 +61,27 @@ enum GMT_enum_sph {GMT_DIST_M = 10,	/* 2-D lon, lat data, convert distance to me
 struct GMT_DIST {	/* Holds info for a particular distance calculation */
 	bool init;	/* true if we have initialized settings for this type via GMT_init_distaz */
 	bool arc;	/* true if distances are in deg/min/sec or arc; otherwise they are e|f|k|M|n or Cartesian */
+	unsigned int mode;	/* The distance mode passed to gmt_set_distaz (GMT_enum_cdist or GMT_enum_sph + GMT_enum_mdist) */
 	double (*func) (struct GMT_CTRL *, double, double, double, double);	/* pointer to function returning distance between two points points */
 	double scale;	/* Scale to convert function output to desired unit */
 };
 
+struct GMT_DIST_ITEM {	/* One point or line segment registered in a GMT_DIST_INDEX cell */
+	uint64_t seg;	/* Segment number in the table */
+	uint64_t row;	/* Row of the point, or first row of the line segment */
+};
+
+struct GMT_DIST_INDEX {	/* Uniform grid of cells over a table to speed up the near point/line tests */
+	struct GMT_DATATABLE *T;	/* The table that was indexed */
+	bool lines;	/* true if items are line segments, false if they are points */
+	bool geo;	/* true if x,y are lon,lat and cell sizes and reach are in degrees */
+	bool periodic;	/* true if the cells wrap around 360 degrees of longitude */
+	unsigned int nx, ny;	/* Number of cells in x and y */
+	double wesn[4];	/* Region covered by the cells */
+	double inc, r_inc;	/* Cell size and its inverse */
+	double reach;	/* Search radius (x,y units or degrees) guaranteed to capture all items within the distance */
+	uint64_t *start;	/* Offset to the first item in each cell; start[nx*ny] is the total number of items */
+	struct GMT_DIST_ITEM *item;	/* Items sorted by cell */
+};
+
 #endif /* _GMT_MAP_H */
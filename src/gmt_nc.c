@@ -41,6 +41,9 @@
  *  GMT_nc_update_grd_info: Update header in existing file
  *  GMT_nc_write_grd_info:  Write header to new file
  *  GMT_nc_write_grd:       Write header and data set to new file
+ *  GMT_nc_tile_open:       Set up a tile cache for row-by-row reading
+ *  GMT_nc_tile_read_row:   Read one row via the tile cache
+ *  GMT_nc_tile_close:      Free the tile cache
  *
  * Private functions:
  *  setup_chunk_cache:      Change the default HDF5 chunk cache settings
@@ -51,8 +54,12 @@
  *  grid_flip_vertical      Reverses the grid vertically
  *  n_chunked_rows_in_cache Determines how many chunks to read at once
  *  io_nc_grid              Does the actual netcdf I/O
+ *  io_nc_band              Gets or puts one band of rows
+ *  nc_band_get_stats       Replaces NaN-values and finds z-range of rows read
+ *  nc_band_put_prep        Replaces NaNs, rounds, and finds z-range of rows to write
  *  netcdf_libvers          returns the netCDF library version
  *  set_optimal_chunksize   Determines the optimal chunksize
+ *  nc_tile_get             Returns a cached tile, reading it if needed
  *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -*/
 
@@ -866,26 +873,34 @@ void unpad_grid(void *gridp, const unsigned n_cols, const unsigned n_rows,
 /* Reverses the grid vertically, that is, from north up to south up or vice versa. */
 void grid_flip_vertical (void *gridp, const unsigned n_cols, const unsigned n_rows, const unsigned n_stride, size_t cell_size) {
 	/* Note: when grid is complex, pass 2x n_rows */
-	unsigned rows_over_2 = (unsigned) floor (n_rows / 2.0);
-	unsigned row;
-	unsigned stride = n_cols; /* stride is the distance between rows. defaults to n_cols */
+	int row, rows_over_2 = (int) floor (n_rows / 2.0);
+	size_t stride = n_cols; /* stride is the distance between rows. defaults to n_cols */
 	char *grid = (char*)gridp;
-	char *tmp = malloc (n_cols * cell_size);
-	char *top, *bottom;
 
 	if (n_stride != 0)
 		stride = n_stride;
 
-	for (row = 0; row < rows_over_2; ++row) {
-		/* pointer to top row: */
-		top = grid + row * stride * cell_size;
-		/* pointer to bottom row: */
-		bottom = grid + ( (n_rows - row) * stride - stride ) * cell_size;
-		memcpy (tmp, top, n_cols * cell_size);    /* save top row */
-		memcpy (top, bottom, n_cols * cell_size); /* copy bottom to top */
-		memcpy (bottom, tmp, n_cols * cell_size); /* copy tmp to bottom */
+#ifdef _OPENMP
+#pragma omp parallel private(row) shared(grid,stride,rows_over_2)
+#endif
+	{
+		/* Row pairs are independent, so each thread swaps its share with its own buffer */
+		char *tmp = malloc (n_cols * cell_size);
+		char *top, *bottom;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+		for (row = 0; row < rows_over_2; ++row) {
+			/* pointer to top row: */
+			top = grid + row * stride * cell_size;
+			/* pointer to bottom row: */
+			bottom = grid + ( (n_rows - row) * stride - stride ) * cell_size;
+			memcpy (tmp, top, n_cols * cell_size);    /* save top row */
+			memcpy (top, bottom, n_cols * cell_size); /* copy bottom to top */
+			memcpy (bottom, tmp, n_cols * cell_size); /* copy tmp to bottom */
+		}
+		free (tmp);
 	}
-	free (tmp);
 }
 
 /* Ensure that repeating columns in geographic gridline registered grids
@@ -984,13 +999,89 @@ static inline int io_nc_varm_float (int ncid, int varid, const size_t *startp,
 	return nc_get_varm_float (ncid, varid, startp, countp, stridep, imapp, fp);
 }
 
+/* Work done on a band of rows while netCDF reads the next band or writes the previous one */
+struct NC_BAND_JOB {
+	void (*func) (struct NC_BAND_JOB *job, float *band, unsigned n_rows);
+	unsigned width;      /* Number of values per row */
+	size_t stride;       /* Distance between rows in memory */
+	bool adj_nan_value;  /* true if nan_value is not NaN */
+	bool do_round;       /* true if values must be rounded to integral (output only) */
+	float nan_value;     /* Value that represents NaN in the file */
+	double z_min, z_max; /* Accumulated range of valid values */
+};
+
+static void nc_band_job_init (struct NC_BAND_JOB *job, struct GMT_GRID_HEADER *header, unsigned width, size_t stride, bool do_round,
+	void (*func) (struct NC_BAND_JOB *job, float *band, unsigned n_rows)) {
+	job->func = func;
+	job->width = width;
+	job->stride = (stride == 0) ? width : stride;
+	job->adj_nan_value = !isnan (header->nan_value);
+	job->do_round = do_round;
+	job->nan_value = header->nan_value;
+	job->z_min = DBL_MAX;
+	job->z_max = -DBL_MAX;
+}
+
+/* After reading: replace the NaN-value by NaN and update the z-range */
+static void nc_band_get_stats (struct NC_BAND_JOB *job, float *band, unsigned n_rows) {
+	unsigned row, col;
+	for (row = 0; row < n_rows; ++row) {
+		float *p_data = band + row * job->stride;
+		for (col = 0; col < job->width; col ++) {
+			if (job->adj_nan_value && p_data[col] == job->nan_value) {
+				p_data[col] = (float)NAN;
+				continue;
+			}
+			else if (!isnan (p_data[col])) {
+				job->z_min = MIN (job->z_min, p_data[col]);
+				job->z_max = MAX (job->z_max, p_data[col]);
+			}
+		}
+	}
+}
+
+/* Before writing: replace NaN by the NaN-value, round if needed, and update the z-range */
+static void nc_band_put_prep (struct NC_BAND_JOB *job, float *band, unsigned n_rows) {
+	unsigned row, col;
+	for (row = 0; row < n_rows; ++row) {
+		float *p_data = band + row * job->stride;
+		for (col = 0; col < job->width; col ++) {
+			if (job->adj_nan_value && isnan (p_data[col]))
+				p_data[col] = job->nan_value;
+			else if (!isnan (p_data[col])) {
+				if (job->do_round)
+					p_data[col] = rintf (p_data[col]); /* round to int */
+				job->z_min = MIN (job->z_min, p_data[col]);
+				job->z_max = MAX (job->z_max, p_data[col]);
+			}
+		}
+	}
+}
+
+/* Get/put rows [row0,row1) of the file from/to grid, which holds the rows starting at file row first */
+static inline int io_nc_band (struct GMT_GRID_HEADER *header, unsigned yx_dim[], size_t start[], size_t count[], ptrdiff_t imap[],
+	unsigned row0, unsigned row1, unsigned first, size_t stride, unsigned width, unsigned io_mode, float *grid) {
+	start[yx_dim[0]] = row0;
+	count[yx_dim[0]] = row1 - row0;
+	grid += (size_t)(row0 - first) * (stride == 0 ? width : stride);
+	if (stride)
+		return io_nc_varm_float (header->ncid, header->z_id, start, count, NULL, imap, grid, io_mode);
+	return io_nc_vara_float (header->ncid, header->z_id, start, count, grid, io_mode);
+}
+
 /* Read and write classic or chunked netcdf files */
-int io_nc_grid (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, unsigned dim[], unsigned origin[], size_t stride, unsigned io_mode, float* grid) {
+int io_nc_grid (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, unsigned dim[], unsigned origin[], size_t stride, unsigned io_mode, float* grid, struct NC_BAND_JOB *job) {
 	/* io_mode = k_get_netcdf: read a netcdf file to grid
-	 * io_mode = k_put_netcdf: write a grid to netcdf */
+	 * io_mode = k_put_netcdf: write a grid to netcdf
+	 * job:     if not NULL, job->func is applied to every band of rows, after it was read
+	 *          or before it is written.  The netCDF library is not thread-safe, so all
+	 *          get/put calls (including the (de)compression of chunks they do) stay on one
+	 *          thread, but with OpenMP the band work runs concurrently on a second thread:
+	 *          band k is processed while band k+1 is read, or band k-1 is written. */
 	int status = NC_NOERR;
 	unsigned width = dim[1], height = dim[0];
 	unsigned yx_dim[2];  /* because xy_dim is not row major! */
+	unsigned first, last, band_height, row0, row1, prev0, prev1;
 	size_t chunksize[5]; /* chunksize of z */
 	size_t start[5] = {0,0,0,0,0}, count[5] = {1,1,1,1,1};
 	size_t n_contiguous_chunk_rows;  /* that are processed at once, 0 = all */
@@ -1009,8 +1100,8 @@ int io_nc_grid (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, unsigned d
 	/* set index of input origin */
 	yx_dim[0] = header->xy_dim[1], yx_dim[1] = header->xy_dim[0]; /* xy_dim not row major */
 	memcpy (start, header->t_index, 3 * sizeof(size_t)); /* set lower dimensions first (e.g. layer) */
-	start[yx_dim[0]] = origin[0]; /* first row */
 	start[yx_dim[1]] = origin[1]; /* first col */
+	count[yx_dim[1]] = width;
 
 	/* set mapping of complex grids or if reading a part of a grid */
 	imap[yx_dim[0]] = (stride == 0 ? width : stride); /* distance between each row */
@@ -1019,63 +1110,64 @@ int io_nc_grid (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, unsigned d
 	/* determine how many chunks to process at once */
 	n_chunked_rows_in_cache (GMT, header, width, height, &n_contiguous_chunk_rows, chunksize);
 
-	if (n_contiguous_chunk_rows) {
-		/* read/write grid in chunks to keep memory footprint low */
-		unsigned remainder;
+	first = origin[0];
+	last = origin[0] + height;
+	if (n_contiguous_chunk_rows)	/* read/write grid in chunks to keep memory footprint low */
+		band_height = (unsigned)(chunksize[yx_dim[0]] * n_contiguous_chunk_rows);
+	else if (job && chunksize[yx_dim[0]] < height)	/* one row of chunks at a time so band work can overlap the I/O */
+		band_height = (unsigned)chunksize[yx_dim[0]];
+	else	/* get/put whole grid contiguous */
+		band_height = last;
+
+	/* Bands end on the bottom of a chunk */
+#define nc_band_end(row) MIN (((row) / band_height + 1) * band_height, last)
+
+	if (job == NULL) {
+		for (row0 = first; row0 < last && status == NC_NOERR; row0 = row1) {
+			row1 = nc_band_end (row0);
 #ifdef NC4_DEBUG
-		unsigned row_num = 0;
-			GMT_Report (GMT->parent, GMT_MSG_NORMAL, "stride: %u width: %u\n",
-					stride, width);
+			GMT_Report (GMT->parent, GMT_MSG_NORMAL, "chunked rows start-y:%u height:%u\n", row0, row1 - row0);
 #endif
+			status = io_nc_band (header, yx_dim, start, count, imap, row0, row1, first, stride, width, io_mode, grid);
+		}
+		return status;
+	}
 
-		/* adjust row count, so that it ends on the bottom of a chunk */
-		count[yx_dim[0]] = chunksize[yx_dim[0]] * n_contiguous_chunk_rows;
-		remainder = (unsigned int)(start[yx_dim[0]] % chunksize[yx_dim[0]]);
-		count[yx_dim[0]] -= remainder;
-
-		count[yx_dim[1]] = width;
-		while ( start[yx_dim[0]] + count[yx_dim[0]] <= height && status == NC_NOERR) {
-#ifdef NC4_DEBUG
-			GMT_Report (GMT->parent, GMT_MSG_NORMAL, "chunked row #%u start-y:%" PRIuS " height:%" PRIuS "\n",
-					++row_num, start[yx_dim[0]], count[yx_dim[0]]);
+	/* Pipeline: the current band [row0,row1) and the previous band [prev0,prev1) are handled
+	 * concurrently.  Reading: get current band while processing previous band.
+	 * Writing: prepare current band while putting previous band. */
+	prev0 = prev1 = row0 = first;
+	while ((row0 < last || prev1 > prev0) && status == NC_NOERR) {
+		float *cur_band = grid + (size_t)(row0 - first) * job->stride;
+		float *prev_band = grid + (size_t)(prev0 - first) * job->stride;
+		row1 = (row0 < last) ? nc_band_end (row0) : row0;
+#ifdef _OPENMP
+#pragma omp parallel sections if (prev1 > prev0 && row1 > row0)
 #endif
-			/* get/put chunked rows */
-			if (stride)
-				status = io_nc_varm_float (header->ncid, header->z_id, start, count, NULL, imap, grid, io_mode);
-			else
-				status = io_nc_vara_float (header->ncid, header->z_id, start, count, grid, io_mode);
-
-			/* advance grid location and set new origin */
-			grid += count[yx_dim[0]] * (stride == 0 ? width : stride);
-			start[yx_dim[0]] += count[yx_dim[0]];
-			if (remainder) {
-				/* reset count to full chunk height */
-				count[yx_dim[0]] += remainder;
-				remainder = 0;
+		{
+#ifdef _OPENMP
+#pragma omp section
+#endif
+			{
+				if (io_mode == k_get_netcdf && row1 > row0)
+					status = io_nc_band (header, yx_dim, start, count, imap, row0, row1, first, stride, width, io_mode, grid);
+				else if (io_mode == k_put_netcdf && prev1 > prev0)
+					status = io_nc_band (header, yx_dim, start, count, imap, prev0, prev1, first, stride, width, io_mode, grid);
 			}
-		}
-		if ( start[yx_dim[0]] != height && status == NC_NOERR ) {
-			/* get/put last chunked row */
-			count[yx_dim[0]] = height - start[yx_dim[0]] + origin[0];
-#ifdef NC4_DEBUG
-			GMT_Report (GMT->parent, GMT_MSG_NORMAL, "chunked row #%u start-y:%" PRIuS " height:%" PRIuS "\n",
-					++row_num, start[yx_dim[0]], count[yx_dim[0]]);
+#ifdef _OPENMP
+#pragma omp section
 #endif
-			if (stride)
-				status = io_nc_varm_float (header->ncid, header->z_id, start, count, NULL, imap, grid, io_mode);
-			else
-				status = io_nc_vara_float (header->ncid, header->z_id, start, count, grid, io_mode);
+			{
+				if (io_mode == k_get_netcdf && prev1 > prev0)
+					job->func (job, prev_band, prev1 - prev0);
+				else if (io_mode == k_put_netcdf && row1 > row0)
+					job->func (job, cur_band, row1 - row0);
+			}
 		}
+		prev0 = row0;	prev1 = row1;
+		row0 = row1;
 	}
-	else {
-		/* get/put whole grid contiguous */
-		count[yx_dim[0]] = height;
-		count[yx_dim[1]] = width;
-		if (stride)
-			status = io_nc_varm_float (header->ncid, header->z_id, start, count, NULL, imap, grid, io_mode);
-		else
-			status = io_nc_vara_float (header->ncid, header->z_id, start, count, grid, io_mode);
-	}
+#undef nc_band_end
 	return status;
 }
 
@@ -1208,13 +1300,14 @@ int GMT_nc_read_grd (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, float
 	 * not the physical size (i.e., the padding is not counted in nx and ny)
 	 */
 
-	bool adj_nan_value; /* if we need to change the fill value */
+	bool overlap;       /* if z-range is determined while reading */
 	int err;            /* netcdf errors */
 	int n_shift;
 	unsigned dim[2], dim2[2], origin[2], origin2[2]; /* dimension and origin {y,x} of subset to read from netcdf */
-	unsigned width, height, row;
+	unsigned width, height;
 	uint64_t imag_offset;
 	float *pgrid = NULL;
+	struct NC_BAND_JOB job;
 
 	/* Check type: is file in old NetCDF format or not at all? */
 	if (GMT->session.grdformat[header->type][0] == 'c')
@@ -1250,14 +1343,18 @@ int GMT_nc_read_grd (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, float
 	setup_chunk_cache();
 	GMT_err_trap (nc_open (header->name, NC_NOWRITE, &header->ncid));
 
+	/* When the rows are read as they are stored, the z-range is determined while the next rows are read */
+	nc_band_job_init (&job, header, width, header->stride, false, nc_band_get_stats);
+	overlap = (dim2[1] == 0 && n_shift == 0 && width == dim[1] && header->data_offset == 0);
+
 	/* read grid */
 	if (dim2[1] == 0)
-		io_nc_grid (GMT, header, dim, origin, header->stride, k_get_netcdf, pgrid + header->data_offset);
+		io_nc_grid (GMT, header, dim, origin, header->stride, k_get_netcdf, pgrid + header->data_offset, overlap ? &job : NULL);
 	else {
 		/* read grid in two parts */
 		unsigned int stride_or_width = header->stride != 0 ? header->stride : width;
-		io_nc_grid (GMT, header, dim, origin, stride_or_width, k_get_netcdf, pgrid + header->data_offset);
-		io_nc_grid (GMT, header, dim2, origin2, stride_or_width, k_get_netcdf, pgrid + header->data_offset + dim[1]);
+		io_nc_grid (GMT, header, dim, origin, stride_or_width, k_get_netcdf, pgrid + header->data_offset, NULL);
+		io_nc_grid (GMT, header, dim2, origin2, stride_or_width, k_get_netcdf, pgrid + header->data_offset + dim[1], NULL);
 	}
 
 	/* if we need to shift grid */
@@ -1278,23 +1375,10 @@ int GMT_nc_read_grd (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, float
 		assert (width == dim[1] + dim2[1]);
 
 	/* get stats */
-	header->z_min = DBL_MAX;
-	header->z_max = -DBL_MAX;
-	adj_nan_value = !isnan (header->nan_value);
-	for (row = 0; row < height; ++row) {
-		float *p_data = pgrid + row * (header->stride ? header->stride : width);
-		unsigned col;
-		for (col = 0; col < width; col ++) {
-			if (adj_nan_value && p_data[col] == header->nan_value) {
-				p_data[col] = (float)NAN;
-				continue;
-			}
-			else if (!isnan (p_data[col])) {
-				header->z_min = MIN (header->z_min, p_data[col]);
-				header->z_max = MAX (header->z_max, p_data[col]);
-			}
-		}
-	}
+	if (!overlap)
+		nc_band_get_stats (&job, pgrid, height);
+	header->z_min = job.z_min;
+	header->z_max = job.z_max;
 	/* check limits */
 	if (header->z_min > header->z_max) {
 		header->z_min = NAN;
@@ -1358,14 +1442,14 @@ int GMT_nc_write_grd (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, floa
 	 */
 
 	int status = NC_NOERR;
-	bool adj_nan_value;   /* if we need to change the fill value */
 	bool do_round = true; /* if we need to round to integral */
-	unsigned n, width, height, *actual_col = NULL;
+	unsigned width, height, *actual_col = NULL;
 	unsigned dim[2], origin[2]; /* dimension and origin {y,x} of subset to write to netcdf */
 	int first_col, last_col, first_row, last_row;
 	uint64_t imag_offset;
 	double limit[2];      /* minmax of z variable */
 	float *pgrid = NULL;
+	struct NC_BAND_JOB job;
 
 	/* Determine the value to be assigned to missing data, if not already done so */
 	switch (header->type) {
@@ -1421,27 +1505,13 @@ int GMT_nc_write_grd (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, floa
 	if (header->row_order == k_nc_start_south)
 		grid_flip_vertical (pgrid, width, height, 0, sizeof(grid[0]));
 
-	/* get stats */
-	header->z_min = DBL_MAX;
-	header->z_max = -DBL_MAX;
-	adj_nan_value = !isnan (header->nan_value);
-	n = 0;
-	while (n < width * height) {
-		if (adj_nan_value && isnan (pgrid[n]))
-			pgrid[n] = header->nan_value;
-		else if (!isnan (pgrid[n])) {
-			if (do_round)
-				pgrid[n] = rintf (pgrid[n]); /* round to int */
-			header->z_min = MIN (header->z_min, pgrid[n]);
-			header->z_max = MAX (header->z_max, pgrid[n]);
-		}
-		n++;
-	}
-
-	/* write grid */
+	/* write grid; NaN-values, rounding and stats are done for each band of rows while the previous band is written */
+	nc_band_job_init (&job, header, width, 0, do_round, nc_band_put_prep);
 	dim[0]    = height,    dim[1]    = width;
 	origin[0] = first_row, origin[1] = first_col;
-	status = io_nc_grid (GMT, header, dim, origin, 0, k_put_netcdf, pgrid);
+	status = io_nc_grid (GMT, header, dim, origin, 0, k_put_netcdf, pgrid, &job);
+	header->z_min = job.z_min;
+	header->z_max = job.z_max;
 	if (status != NC_NOERR)
 		goto nc_err;
 
@@ -1491,3 +1561,154 @@ nc_err:
 	}
 	return status;
 }
+
+/* Tile cache for row-by-row access to chunked netCDF-4 grids.
+ * Each tile is one netCDF chunk of the z variable.  Tiles are read on demand
+ * and kept in memory until the memory budget is used up, after which the least
+ * recently used tile is evicted.  This lets modules that process a grid row by
+ * row work on grids larger than memory, while each compressed chunk is only
+ * read and inflated once per sweep. */
+
+struct GMT_GRID_TILE {	/* One cached tile (netCDF chunk) of a grid */
+	unsigned int id;			/* Tile number, i.e., tile_row * n_tile_cols + tile_col */
+	float *data;				/* Tile values in file order; edge tiles may be narrower than tile_nx */
+	struct GMT_GRID_TILE *prev, *next;	/* Neighbors in the least-recently-used list */
+};
+
+struct GMT_GRID_TILECACHE {	/* Book-keeping for the tiles of one grid */
+	int ncid, z_id;			/* NetCDF file and z variable ids */
+	unsigned int yx_dim[2];		/* Position of the y and x dimension of z */
+	unsigned int nx, ny;		/* Grid dimensions */
+	unsigned int tile_nx, tile_ny;	/* Tile dimensions, equal to the chunk size */
+	unsigned int n_tile_cols, n_tile_rows;	/* Number of tiles in x and y */
+	unsigned int n_max, n_used;	/* Max tiles allowed by the memory budget and tiles in use */
+	bool flip;			/* true if file rows go from south to north */
+	size_t t_index[3];		/* Index of higher coordinates */
+	uint64_t n_hits, n_misses;	/* Statistics */
+	struct GMT_GRID_TILE **tile;	/* Array of n_tile_rows * n_tile_cols pointers, NULL if tile is not loaded */
+	struct GMT_GRID_TILE *head, *tail;	/* Most and least recently used tiles */
+};
+
+struct GMT_GRID_TILECACHE * GMT_nc_tile_open (struct GMT_CTRL *GMT, int ncid, struct GMT_GRID_HEADER *header, size_t budget) {
+	/* Set up a tile cache using at most budget bytes for grid header in open file ncid.
+	 * Returns NULL if the grid is not chunked, in which case rows are best read directly */
+	int storage, n_dims;
+	size_t chunksize[5], tile_bytes;
+	struct GMT_GRID_TILECACHE *C = NULL;
+
+	if (nc_inq_varndims (ncid, header->z_id, &n_dims) || n_dims > 5) return (NULL);
+	if (nc_inq_var_chunking (ncid, header->z_id, &storage, chunksize) || storage != NC_CHUNKED) return (NULL);
+	if (header->xy_dim[1] > header->xy_dim[0]) return (NULL);	/* Transposed storage (x varies slowest) not supported */
+
+	C = GMT_memory (GMT, NULL, 1, struct GMT_GRID_TILECACHE);
+	C->ncid = ncid;
+	C->z_id = header->z_id;
+	C->yx_dim[0] = header->xy_dim[1];	C->yx_dim[1] = header->xy_dim[0];	/* xy_dim not row major */
+	C->nx = header->nx;	C->ny = header->ny;
+	C->tile_ny = (unsigned int)MIN (chunksize[C->yx_dim[0]], C->ny);
+	C->tile_nx = (unsigned int)MIN (chunksize[C->yx_dim[1]], C->nx);
+	C->n_tile_rows = (C->ny + C->tile_ny - 1) / C->tile_ny;
+	C->n_tile_cols = (C->nx + C->tile_nx - 1) / C->tile_nx;
+	C->flip = (header->row_order == k_nc_start_south);
+	GMT_memcpy (C->t_index, header->t_index, 3, size_t);
+
+	/* Must at least hold one row of tiles, else every row read would evict the tiles needed by the next row */
+	tile_bytes = (size_t)C->tile_nx * C->tile_ny * sizeof (float);
+	C->n_max = (unsigned int)MIN (budget / tile_bytes, (size_t)C->n_tile_rows * C->n_tile_cols);
+	if (C->n_max < C->n_tile_cols) {
+		GMT_Report (GMT->parent, GMT_MSG_VERBOSE, "Tile cache of %.1lf MiB cannot hold one row of chunks for %s; using %.1lf MiB instead\n",
+			budget / 1048576.0, header->name, C->n_tile_cols * tile_bytes / 1048576.0);
+		C->n_max = C->n_tile_cols;
+	}
+	C->tile = GMT_memory (GMT, NULL, (size_t)C->n_tile_rows * C->n_tile_cols, struct GMT_GRID_TILE *);
+	GMT_Report (GMT->parent, GMT_MSG_LONG_VERBOSE, "Caching up to %u tiles of %u x %u nodes for %s\n", C->n_max, C->tile_ny, C->tile_nx, header->name);
+	return (C);
+}
+
+static inline void nc_tile_unlink (struct GMT_GRID_TILECACHE *C, struct GMT_GRID_TILE *T) {
+	/* Remove tile T from the least-recently-used list */
+	if (T->prev) T->prev->next = T->next; else C->head = T->next;
+	if (T->next) T->next->prev = T->prev; else C->tail = T->prev;
+	T->prev = T->next = NULL;
+}
+
+static int nc_tile_get (struct GMT_CTRL *GMT, struct GMT_GRID_TILECACHE *C, unsigned int tile_row, unsigned int tile_col, struct GMT_GRID_TILE **T_out) {
+	/* Return the requested tile, reading it from file if it is not cached */
+	int err;
+	unsigned int id = tile_row * C->n_tile_cols + tile_col;
+	size_t start[5] = {0,0,0,0,0}, count[5] = {1,1,1,1,1};
+	struct GMT_GRID_TILE *T = C->tile[id];
+
+	if (T) {	/* Cached; just move it to the front */
+		C->n_hits++;
+		if (T != C->head) {
+			nc_tile_unlink (C, T);
+			T->next = C->head;	C->head->prev = T;	C->head = T;
+		}
+		*T_out = T;
+		return (GMT_NOERROR);
+	}
+	C->n_misses++;
+	if (C->n_used == C->n_max) {	/* Full, recycle the least recently used tile */
+		T = C->tail;
+		nc_tile_unlink (C, T);
+		C->tile[T->id] = NULL;
+	}
+	else {	/* Room for another tile */
+		T = GMT_memory (GMT, NULL, 1, struct GMT_GRID_TILE);
+		T->data = GMT_memory (GMT, NULL, (size_t)C->tile_nx * C->tile_ny, float);
+		C->n_used++;
+	}
+	GMT_memcpy (start, C->t_index, 3, size_t);	/* Set lower dimensions first (e.g. layer) */
+	start[C->yx_dim[0]] = (size_t)tile_row * C->tile_ny;
+	start[C->yx_dim[1]] = (size_t)tile_col * C->tile_nx;
+	count[C->yx_dim[0]] = MIN (C->tile_ny, C->ny - start[C->yx_dim[0]]);
+	count[C->yx_dim[1]] = MIN (C->tile_nx, C->nx - start[C->yx_dim[1]]);
+	if ((err = nc_get_vara_float (C->ncid, C->z_id, start, count, T->data)) != NC_NOERR) {	/* Leave tile out of the cache */
+		GMT_free (GMT, T->data);
+		GMT_free (GMT, T);
+		C->n_used--;
+		return (err);
+	}
+	T->id = id;
+	T->next = C->head;
+	if (C->head) C->head->prev = T;
+	C->head = T;
+	if (!C->tail) C->tail = T;
+	C->tile[id] = T;
+	*T_out = T;
+	return (GMT_NOERROR);
+}
+
+int GMT_nc_tile_read_row (struct GMT_CTRL *GMT, struct GMT_GRID_TILECACHE *C, unsigned int row, float *z) {
+	/* Assemble grid row (0 is the north row) from the tiles that hold it */
+	int err;
+	unsigned int file_row, tile_row, tile_col, width;
+	struct GMT_GRID_TILE *T = NULL;
+
+	if (row >= C->ny) return (GMT_GRDIO_READ_FAILED);
+	file_row = (C->flip) ? C->ny - 1 - row : row;
+	tile_row = file_row / C->tile_ny;
+	file_row -= tile_row * C->tile_ny;	/* Row within the tile */
+	for (tile_col = 0; tile_col < C->n_tile_cols; tile_col++) {
+		if ((err = nc_tile_get (GMT, C, tile_row, tile_col, &T))) return (err);
+		width = MIN (C->tile_nx, C->nx - tile_col * C->tile_nx);
+		GMT_memcpy (&z[tile_col * C->tile_nx], &T->data[(size_t)file_row * width], width, float);
+	}
+	return (GMT_NOERROR);
+}
+
+void GMT_nc_tile_close (struct GMT_CTRL *GMT, struct GMT_GRID_TILECACHE **C) {
+	/* Free all tiles and the cache itself */
+	struct GMT_GRID_TILE *T = NULL, *next = NULL;
+
+	if (*C == NULL) return;
+	GMT_Report (GMT->parent, GMT_MSG_LONG_VERBOSE, "Tile cache: %" PRIu64 " hits, %" PRIu64 " reads\n", (*C)->n_hits, (*C)->n_misses);
+	for (T = (*C)->head; T; T = next) {
+		next = T->next;
+		GMT_free (GMT, T->data);
+		GMT_free (GMT, T);
+	}
+	GMT_free (GMT, (*C)->tile);
+	GMT_free (GMT, *C);
+}
@@ -2939,3 +2939,87 @@ double GMT_right_polyconic (struct GMT_CTRL *GMT, double y)
 	gmt_ipolyconic_sub (GMT, y, GMT->common.R.wesn[XHI], &x);
 	return (x * GMT->current.proj.scale[GMT_X] + GMT->current.proj.origin[GMT_X]);
 }
+
+/* ARRAY VERSIONS OF THE COMMON PROJECTIONS
+ *
+ * GMT_proj_fwd_n and GMT_proj_inv_n project n points at once, without the shift and scale
+ * to plot units (as GMT_geo_to_xy_noshift and GMT_xy_to_geo_noshift do for one point).
+ * The projections listed in gmt_reentrant_proj only read the parameters set up by their
+ * GMT_v* function, so their points are projected in parallel.  Input and output arrays may
+ * be the same.  Both return false, and do nothing, if the current projection is not in the
+ * list; callers should then loop over the single-point functions. */
+
+#define GMT_PROJ_N_THREADED	4096	/* Fewer points are not worth spreading over threads */
+
+struct GMT_PROJ_PAIR {	/* Forward and inverse functions of one projection */
+	void (*fwd) (struct GMT_CTRL *, double, double, double *, double *);
+	void (*inv) (struct GMT_CTRL *, double *, double *, double, double);
+};
+
+static struct GMT_PROJ_PAIR gmt_reentrant_proj[] = {
+	{GMT_merc_sph,   GMT_imerc_sph},
+	{GMT_tm,         GMT_itm},
+	{GMT_tm_sph,     GMT_itm_sph},
+	{GMT_utm,        GMT_iutm},
+	{GMT_utm_sph,    GMT_iutm_sph},
+	{GMT_lamb,       GMT_ilamb},
+	{GMT_lamb_sph,   GMT_ilamb_sph},
+	{GMT_albers,     GMT_ialbers},
+	{GMT_albers_sph, GMT_ialbers_sph},
+	{GMT_plrs_sph,   GMT_iplrs_sph},
+	{gmt_linearxy,   gmt_ilinearxy},	/* Includes linear geographic (-Jx with lon/lat) */
+	{NULL, NULL}
+};
+
+static inline bool gmt_proj_fwd_reentrant (struct GMT_CTRL *GMT) {
+	unsigned int k;
+	for (k = 0; gmt_reentrant_proj[k].fwd; k++) if (GMT->current.proj.fwd == gmt_reentrant_proj[k].fwd) return (true);
+	return (false);
+}
+
+static inline bool gmt_proj_inv_reentrant (struct GMT_CTRL *GMT) {
+	unsigned int k;
+	for (k = 0; gmt_reentrant_proj[k].inv; k++) if (GMT->current.proj.inv == gmt_reentrant_proj[k].inv) return (true);
+	return (false);
+}
+
+bool GMT_proj_is_reentrant (struct GMT_CTRL *GMT)
+{	/* Returns true if the current forward and inverse projections may be called from several threads at once */
+	return (gmt_proj_fwd_reentrant (GMT) && gmt_proj_inv_reentrant (GMT));
+}
+
+bool GMT_proj_fwd_n (struct GMT_CTRL *GMT, double *lon, double *lat, double *x, double *y, uint64_t n)
+{	/* Convert n lon/lat points to x/y using the current projection, if supported */
+	int64_t k, np = (int64_t)n;
+	void (*fwd) (struct GMT_CTRL *, double, double, double *, double *) = GMT->current.proj.fwd;
+
+	if (!gmt_proj_fwd_reentrant (GMT)) return (false);
+#ifdef _OPENMP
+#pragma omp parallel for private(k) shared(GMT,fwd,lon,lat,x,y,np) if (np > GMT_PROJ_N_THREADED)
+#endif
+	for (k = 0; k < np; k++) {
+		if (GMT_is_dnan (lon[k]) || GMT_is_dnan (lat[k]))
+			x[k] = y[k] = GMT->session.d_NaN;
+		else
+			fwd (GMT, lon[k], lat[k], &x[k], &y[k]);
+	}
+	return (true);
+}
+
+bool GMT_proj_inv_n (struct GMT_CTRL *GMT, double *lon, double *lat, double *x, double *y, uint64_t n)
+{	/* Convert n x/y points to lon/lat using the current projection, if supported */
+	int64_t k, np = (int64_t)n;
+	void (*inv) (struct GMT_CTRL *, double *, double *, double, double) = GMT->current.proj.inv;
+
+	if (!gmt_proj_inv_reentrant (GMT)) return (false);
+#ifdef _OPENMP
+#pragma omp parallel for private(k) shared(GMT,inv,lon,lat,x,y,np) if (np > GMT_PROJ_N_THREADED)
+#endif
+	for (k = 0; k < np; k++) {
+		if (GMT_is_dnan (x[k]) || GMT_is_dnan (y[k]))
+			lon[k] = lat[k] = GMT->session.d_NaN;
+		else
+			inv (GMT, &lon[k], &lat[k], x[k], y[k]);
+	}
+	return (true);
+}
@@ -37,6 +37,8 @@ EXTERN_MSC char *GMT_strdup (struct GMT_CTRL *GMT, const char *s);
 
 /* gmt_bcr.c: */
 EXTERN_MSC double GMT_get_bcr_z (struct GMT_CTRL *GMT, struct GMT_GRID *G, double xx, double yy);		/* Compute z(x,y) from bcr structure and grid */
+EXTERN_MSC unsigned int GMT_get_bcr_weights (struct GMT_GRID_HEADER *h, double xx, double yy, uint64_t *ij, double wx[], double wy[]);	/* Compute kernel node and weights for (x,y) */
+EXTERN_MSC double GMT_get_bcr_z_weights (struct GMT_CTRL *GMT, struct GMT_GRID *G, uint64_t ij, double wx[], double wy[]);	/* Compute z from precomputed kernel node and weights */
 EXTERN_MSC int GMT_get_bcr_img (struct GMT_CTRL *GMT, struct GMT_IMAGE *G, double xx, double yy, unsigned char *z);		/* Compute z(x,y) from bcr structure and image */
 
 /* gmt_customio.c: */
@@ -302,6 +304,7 @@ EXTERN_MSC uint64_t GMT_map_clip_path (struct GMT_CTRL *GMT, double **x, double
 EXTERN_MSC bool GMT_map_outside (struct GMT_CTRL *GMT, double lon, double lat);
 EXTERN_MSC bool GMT_geo_to_xy (struct GMT_CTRL *GMT, double lon, double lat, double *x, double *y);
 EXTERN_MSC bool GMT_geo_to_xy_noshift (struct GMT_CTRL *GMT, double lon, double lat, double *x, double *y);
+EXTERN_MSC void GMT_geo_to_xy_n (struct GMT_CTRL *GMT, double *lon, double *lat, double *x, double *y, uint64_t n);
 EXTERN_MSC void GMT_geoz_to_xy (struct GMT_CTRL *GMT, double x, double y, double z, double *x_out, double *y_out);
 EXTERN_MSC int GMT_project_init (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *header, double *inc, unsigned int nx, unsigned int ny, unsigned int dpi, unsigned int offset);
 EXTERN_MSC int GMT_map_setup (struct GMT_CTRL *GMT, double wesn[]);
@@ -310,6 +313,7 @@ EXTERN_MSC double GMT_y_to_yy (struct GMT_CTRL *GMT, double y);
 EXTERN_MSC double GMT_z_to_zz (struct GMT_CTRL *GMT, double z);
 EXTERN_MSC void GMT_xy_to_geo (struct GMT_CTRL *GMT, double *lon, double *lat, double x, double y);
 EXTERN_MSC void GMT_xy_to_geo_noshift (struct GMT_CTRL *GMT, double *lon, double *lat, double x, double y);
+EXTERN_MSC void GMT_xy_to_geo_n (struct GMT_CTRL *GMT, double *lon, double *lat, double *x, double *y, uint64_t n);
 EXTERN_MSC void GMT_xyz_to_xy (struct GMT_CTRL *GMT, double x, double y, double z, double *x_out, double *y_out);
 EXTERN_MSC void GMT_xyz_to_xy_n (struct GMT_CTRL *GMT, double *x, double *y, double z, uint64_t n);
 EXTERN_MSC double * GMT_dist_array (struct GMT_CTRL *GMT, double x[], double y[], uint64_t n, bool cumulative);
@@ -319,6 +323,10 @@ EXTERN_MSC unsigned int GMT_init_distaz (struct GMT_CTRL *GMT, char c, unsigned
 EXTERN_MSC bool GMT_near_lines (struct GMT_CTRL *GMT, double lon, double lat, struct GMT_DATATABLE *T, unsigned int return_mindist, double *dist_min, double *x_near, double *y_near);
 EXTERN_MSC bool GMT_near_a_line (struct GMT_CTRL *GMT, double lon, double lat, uint64_t seg, struct GMT_DATASEGMENT *S, unsigned int return_mindist, double *dist_min, double *x_near, double *y_near);
 EXTERN_MSC bool GMT_near_a_point (struct GMT_CTRL *GMT, double x, double y, struct GMT_DATATABLE *T, double dist);
+EXTERN_MSC bool GMT_near_a_point_indexed (struct GMT_CTRL *GMT, double x, double y, struct GMT_DIST_INDEX *I, double dist);
+EXTERN_MSC bool GMT_near_lines_indexed (struct GMT_CTRL *GMT, double lon, double lat, struct GMT_DIST_INDEX *I, unsigned int end_mode);
+EXTERN_MSC struct GMT_DIST_INDEX * GMT_create_dist_index (struct GMT_CTRL *GMT, struct GMT_DATATABLE *T, bool lines, double dist);
+EXTERN_MSC void GMT_free_dist_index (struct GMT_CTRL *GMT, struct GMT_DIST_INDEX **I);
 EXTERN_MSC double GMT_great_circle_dist_meter (struct GMT_CTRL *GMT, double x0, double y0, double x1, double y1);
 EXTERN_MSC double GMT_lat_swap_quick (struct GMT_CTRL *GMT, double lat, double c[]);
 EXTERN_MSC double GMT_lat_swap (struct GMT_CTRL *GMT, double lat, unsigned int itype);
@@ -373,6 +381,9 @@ EXTERN_MSC int GMT_get_format (struct GMT_CTRL *GMT, double interval, char *unit
 EXTERN_MSC int GMT_get_index (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, double value);
 EXTERN_MSC int GMT_get_rgb_from_z (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, double value, double *rgb);
 EXTERN_MSC int GMT_get_fill_from_z (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, double value, struct GMT_FILL *fill);
+EXTERN_MSC struct GMT_ZLUT * GMT_get_zlut (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, unsigned int n);
+EXTERN_MSC void GMT_free_zlut (struct GMT_CTRL *GMT, struct GMT_ZLUT **Z);
+EXTERN_MSC int GMT_get_rgb_from_zlut (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, struct GMT_ZLUT *Z, double value, double *rgb);
 EXTERN_MSC bool GMT_getfill (struct GMT_CTRL *GMT, char *line, struct GMT_FILL *fill);
 EXTERN_MSC bool GMT_getinc (struct GMT_CTRL *GMT, char *line, double inc[]);
 EXTERN_MSC int GMT_getincn (struct GMT_CTRL *GMT, char *line, double inc[], unsigned int n);
@@ -387,6 +398,11 @@ EXTERN_MSC char * GMT_putfont (struct GMT_CTRL *GMT, struct GMT_FONT F);
 EXTERN_MSC char * GMT_putpen (struct GMT_CTRL *GMT, struct GMT_PEN pen);
 EXTERN_MSC unsigned int GMT_inonout (struct GMT_CTRL *GMT, double x, double y, const struct GMT_DATASEGMENT *S);
 EXTERN_MSC unsigned int GMT_inonout_sphpol (struct GMT_CTRL *GMT, double plon, double plat, const struct GMT_DATASEGMENT *P);
+EXTERN_MSC unsigned int GMT_inonout_prepared (struct GMT_CTRL *GMT, double x, double y, struct GMT_PREPARED_POLYGON *P);
+EXTERN_MSC uint64_t GMT_inonout_row (struct GMT_CTRL *GMT, struct GMT_PREPARED_POLYGON *P, double y, double *x, uint64_t n, unsigned int *side);
+EXTERN_MSC struct GMT_PREPARED_POLYGON * GMT_prepare_polygon (struct GMT_CTRL *GMT, double *x, double *y, uint64_t n);
+EXTERN_MSC struct GMT_PREPARED_POLYGON * GMT_prepare_segment (struct GMT_CTRL *GMT, const struct GMT_DATASEGMENT *S);
+EXTERN_MSC void GMT_free_prepared_polygon (struct GMT_CTRL *GMT, struct GMT_PREPARED_POLYGON **P);
 EXTERN_MSC int GMT_intpol (struct GMT_CTRL *GMT, double *x, double *y, uint64_t n, uint64_t m, double *u, double *v, int mode);
 EXTERN_MSC int GMT_just_decode (struct GMT_CTRL *GMT, char *key, unsigned int def);
 EXTERN_MSC unsigned int GMT_minmaxinc_verify (struct GMT_CTRL *GMT, double min, double max, double inc, double slop);
@@ -433,6 +449,8 @@ EXTERN_MSC void GMT_normalize2v (struct GMT_CTRL *GMT, double *a);
 EXTERN_MSC uint64_t GMT_fix_up_path (struct GMT_CTRL *GMT, double **a_lon, double **a_lat, uint64_t n, double step, unsigned int mode);
 EXTERN_MSC int GMT_jacobi (struct GMT_CTRL *GMT, double *a, unsigned int n, unsigned int m, double *d, double *v, double *b, double *z, unsigned int *nrots);
 EXTERN_MSC int GMT_gauss (struct GMT_CTRL *GMT, double *a, double *vec, unsigned int n, unsigned int nstore, bool itriag);
+EXTERN_MSC int GMT_lu_dcmp (struct GMT_CTRL *GMT, double *a, unsigned int n, unsigned int ndim, int *ipiv);
+EXTERN_MSC void GMT_lu_solv (struct GMT_CTRL *GMT, double *a, unsigned int n, unsigned int ndim, int *ipiv, double *b, unsigned int m, unsigned int mdim);
 EXTERN_MSC int GMT_gaussjordan (struct GMT_CTRL *GMT, double *a, unsigned int n, unsigned int ndim, double *b, unsigned int m, unsigned int mdim);
 EXTERN_MSC int GMT_svdcmp (struct GMT_CTRL *GMT, double *a, unsigned int m, unsigned int n, double *w, double *v);
 EXTERN_MSC int GMT_solve_svd (struct GMT_CTRL *GMT, double *u, unsigned int m, unsigned int n, double *v, double *w, double *b, unsigned int k, double *x, double *cutoff, unsigned int mode);
@@ -19,6 +19,9 @@
 #include "gmt_dev.h"
 #include "gmt_internals.h"
 #include "gshhg_version.h"
+#ifdef HAVE_SYS_MMAN_H_
+#	include <sys/mman.h>
+#endif
 /*
  * These functions simplifies the access to the GMT shoreline, border, and river
  * databases.
@@ -34,7 +37,7 @@
  * GMT_assemble_br :		Creates lines from border or river segments
  * GMT_free_shore :		Frees up memory used by shorelines for this bin
  * GMT_free_br :		Frees up memory used by shorelines for this bin
- * GMT_shore_cleanup :		Frees up main shoreline structure memory
+ * GMT_shore_cleanup :		Frees up main shoreline structure memory (or unmaps the cache)
  * GMT_br_cleanup :		Frees up main river/border structure memory
  *
  * Author:	Paul Wessel
@@ -327,6 +330,263 @@ char *gmt_shore_getpathname (struct GMT_CTRL *GMT, char *stem, char *path) {
 	return (NULL); /* never reached */
 }
 
+/* ---------- MEMORY-MAPPED CACHE OF THE SHORELINE DATABASE ------------ */
+
+/* If the environment variable GMT_GSHHG_CACHEDIR names a writable directory, the first GMT_init_shore
+ * for a given resolution copies every variable of binned_GSHHS_<res>.nc into the flat binary file
+ * binned_GSHHS_<res>.cache in that directory.  Later calls map that file read-only instead of opening
+ * the netCDF file: the arrays are shared by all processes through the page cache, and GMT_get_shore_bin
+ * points the segments straight into the mapping instead of reading and allocating them.  The points
+ * are kept as the relative dx/dy shorts since the bin assembly works on those.  The cache records the
+ * path, size, modification time and version of the netCDF file it was built from and is rebuilt if any
+ * of these no longer match.  Before the mapping is used every array is checked to lie inside the file and
+ * the bin, segment, point and polygon indices to be in range. */
+
+#define GSHHG_CACHE_MAGIC	"GSHHGC02"	/* Change if the layout of GMT_SHORE_CACHE changes */
+#define GSHHG_CACHE_ENDIAN	0x01020304U
+
+static inline void * gmt_shore_cache_array (struct GMT_SHORE *c, unsigned int k)
+{	/* Return pointer to the k'th array in the mapped cache */
+	return ((char *)c->cache + ((struct GMT_SHORE_CACHE *)c->cache)->offset[k]);
+}
+
+#ifdef HAVE_SYS_MMAN_H_
+bool gmt_shore_cache_layout (struct GMT_SHORE_CACHE *H, size_t n_items[], size_t width[])
+{	/* Get the number of items and the item size of each array from the dimensions in the header.
+	 * Returns false if a dimension is negative. */
+	unsigned int k;
+	size_t item_width[GSHHG_CACHE_N_ARRAYS] = {sizeof (short), sizeof (short), sizeof (int), sizeof (int), sizeof (int), sizeof (int),
+		sizeof (short), sizeof (short), sizeof (int), sizeof (double), sizeof (int), sizeof (int)};
+
+	if (H->n_bin < 0 || H->n_seg < 0 || H->n_pt < 0 || H->n_poly < 0 || H->n_nodes < 0) return (false);
+	n_items[GSHHG_CACHE_BIN_INFO] = n_items[GSHHG_CACHE_BIN_NSEG] = n_items[GSHHG_CACHE_BIN_FIRSTSEG] = H->n_bin;
+	n_items[GSHHG_CACHE_SEG_INFO] = n_items[GSHHG_CACHE_SEG_START] = n_items[GSHHG_CACHE_SEG_ID] = H->n_seg;
+	n_items[GSHHG_CACHE_PT_DX] = n_items[GSHHG_CACHE_PT_DY] = H->n_pt;
+	n_items[GSHHG_CACHE_PARENT] = n_items[GSHHG_CACHE_AREA] = n_items[GSHHG_CACHE_AREA_FRACTION] = H->n_poly;
+	n_items[GSHHG_CACHE_NODE] = H->n_nodes;
+	for (k = 0; k < GSHHG_CACHE_N_ARRAYS; k++) width[k] = item_width[k];
+	return (true);
+}
+
+int gmt_shore_cache_build (struct GMT_CTRL *GMT, char *path, struct stat *nc_buf, char *cache_path)
+{	/* Read all the variables of the netCDF shoreline file and write them to cache_path, together with
+	 * the path, size and modification time in nc_buf of the netCDF file so the cache can be validated.
+	 * The file is written under a temporary name and renamed so other processes never see a partial cache. */
+	int k, cdfid, varid, err;
+	bool int_areas = false;
+	uint64_t offset, pos, pad = 0;
+	size_t i;
+	size_t start[1] = {0}, count[1], n_items[GSHHG_CACHE_N_ARRAYS], width[GSHHG_CACHE_N_ARRAYS];
+	char *name[GSHHG_CACHE_N_ARRAYS] = {"Embedded_node_levels_in_a_bin", "N_segments_in_a_bin", "Id_of_first_segment_in_a_bin",
+		"Embedded_npts_levels_exit_entry_for_a_segment", "Id_of_first_point_in_a_segment", "Id_of_GSHHS_ID",
+		"Relative_longitude_from_SW_corner_of_bin", "Relative_latitude_from_SW_corner_of_bin", "Id_of_parent_polygons",
+		"The_km_squared_area_of_polygons", "Micro_fraction_of_full_resolution_area", "Id_of_node_polygons"};
+	char *dim_name[8] = {"Bin_size_in_minutes", "N_bins_in_360_longitude_range", "N_bins_in_180_degree_latitude_range",
+		"N_bins_in_file", "N_segments_in_file", "N_points_in_file", "N_polygons_in_file", "N_nodes_in_file"};
+	char tmp_path[GMT_BUFSIZ] = {""};
+	void *array = NULL;
+	struct GMT_SHORE_CACHE H;
+	FILE *fp = NULL;
+	int *dim[8];
+
+	GMT_memset (&H, 1, struct GMT_SHORE_CACHE);
+	dim[0] = &H.bin_size;	dim[1] = &H.bin_nx;	dim[2] = &H.bin_ny;	dim[3] = &H.n_bin;
+	dim[4] = &H.n_seg;	dim[5] = &H.n_pt;	dim[6] = &H.n_poly;	dim[7] = &H.n_nodes;
+
+	if ((err = nc_open (path, NC_NOWRITE, &cdfid)) != NC_NOERR) return (err);
+
+	/* Get attributes and dimensions, as in GMT_init_shore */
+	if ((err = nc_get_att_text (cdfid, NC_GLOBAL, "version", H.version)) == NC_NOERR &&
+	    (err = nc_get_att_text (cdfid, NC_GLOBAL, "title", H.title)) == NC_NOERR &&
+	    (err = nc_get_att_text (cdfid, NC_GLOBAL, "source", H.source)) == NC_NOERR &&
+	    (err = nc_inq_varid (cdfid, name[GSHHG_CACHE_PT_DX], &varid)) == NC_NOERR)
+		err = nc_get_att_text (cdfid, varid, "units", H.units);
+	for (k = 0; err == NC_NOERR && k < 8; k++) {
+		if ((err = nc_inq_varid (cdfid, dim_name[k], &varid)) == NC_NOERR)
+			err = nc_get_var1_int (cdfid, varid, start, dim[k]);
+	}
+	if (err != NC_NOERR) {
+		nc_close (cdfid);
+		return (err);
+	}
+	if (nc_inq_varid (cdfid, "Ten_times_the_km_squared_area_of_polygons", &varid) == NC_NOERR) {	/* Old file with 1/10 km^2 areas in int format */
+		name[GSHHG_CACHE_AREA] = "Ten_times_the_km_squared_area_of_polygons";
+		int_areas = true;
+	}
+
+	/* Lay out the arrays after the header, each aligned on 8 bytes */
+	if (!gmt_shore_cache_layout (&H, n_items, width)) {
+		nc_close (cdfid);
+		return (GMT_GRDIO_READ_FAILED);
+	}
+	offset = (sizeof (struct GMT_SHORE_CACHE) + 7) & ~7ULL;
+	for (k = 0; k < GSHHG_CACHE_N_ARRAYS; k++) {
+		H.offset[k] = offset;
+		offset += (n_items[k] * width[k] + 7) & ~7ULL;
+	}
+	H.size = offset;
+	GMT_memcpy (H.magic, GSHHG_CACHE_MAGIC, 8, char);
+	H.endian = GSHHG_CACHE_ENDIAN;
+	strncpy (H.nc_path, path, GMT_BUFSIZ - 1);
+	H.nc_size = (uint64_t)nc_buf->st_size;
+	H.nc_mtime = (int64_t)nc_buf->st_mtime;
+
+	sprintf (tmp_path, "%s.%d", cache_path, (int)getpid ());
+	if ((fp = fopen (tmp_path, "wb")) == NULL) {
+		nc_close (cdfid);
+		return (GMT_GRDIO_CREATE_FAILED);
+	}
+	if (fwrite (&H, sizeof (struct GMT_SHORE_CACHE), 1U, fp) != 1U) err = GMT_GRDIO_WRITE_FAILED;
+	pos = sizeof (struct GMT_SHORE_CACHE);
+	for (k = 0; err == NC_NOERR && k < GSHHG_CACHE_N_ARRAYS; k++) {
+		if (pos < H.offset[k] && fwrite (&pad, 1U, H.offset[k] - pos, fp) != H.offset[k] - pos) err = GMT_GRDIO_WRITE_FAILED;
+		pos = H.offset[k];
+		if (err != NC_NOERR || n_items[k] == 0) continue;
+		array = GMT_memory (GMT, NULL, n_items[k] * width[k], char);
+		count[0] = n_items[k];
+		if ((err = nc_inq_varid (cdfid, name[k], &varid)) == NC_NOERR) {
+			if (width[k] == sizeof (short))
+				err = nc_get_vara_short (cdfid, varid, start, count, array);
+			else if (width[k] == sizeof (int))
+				err = nc_get_vara_int (cdfid, varid, start, count, array);
+			else	/* The areas; netCDF converts old integer areas for us */
+				err = nc_get_vara_double (cdfid, varid, start, count, array);
+		}
+		if (err == NC_NOERR && k == GSHHG_CACHE_AREA && int_areas) {	/* Since they were stored as 10 * km^2 using integers */
+			double *area = array;
+			for (i = 0; i < n_items[k]; i++) area[i] *= 0.1;
+		}
+		if (err == NC_NOERR && fwrite (array, width[k], n_items[k], fp) != n_items[k]) err = GMT_GRDIO_WRITE_FAILED;
+		pos += n_items[k] * width[k];
+		GMT_free (GMT, array);
+	}
+	if (err == NC_NOERR && pos < H.size && fwrite (&pad, 1U, H.size - pos, fp) != H.size - pos) err = GMT_GRDIO_WRITE_FAILED;
+	nc_close (cdfid);
+	if (fclose (fp) && err == NC_NOERR) err = GMT_GRDIO_WRITE_FAILED;
+	if (err == NC_NOERR && rename (tmp_path, cache_path)) err = GMT_GRDIO_CREATE_FAILED;
+	if (err != NC_NOERR) remove (tmp_path);	/* Do not leave a partial file behind */
+	return (err);
+}
+
+bool gmt_shore_cache_ranges (struct GMT_SHORE_CACHE *H)
+{	/* Check that the segments of every bin and the points and polygon of every segment are inside
+	 * their arrays, since GMT_get_shore_bin uses these indices into the mapping without checking */
+	int k, *bin_firstseg = NULL, *seg_info = NULL, *seg_start = NULL, *seg_id = NULL;
+	short *bin_nseg = NULL;
+	char *base = (char *)H;
+
+	bin_nseg = (short *)(base + H->offset[GSHHG_CACHE_BIN_NSEG]);
+	bin_firstseg = (int *)(base + H->offset[GSHHG_CACHE_BIN_FIRSTSEG]);
+	for (k = 0; k < H->n_bin; k++)
+		if (bin_nseg[k] < 0 || bin_firstseg[k] < 0 || (int64_t)bin_firstseg[k] + bin_nseg[k] > H->n_seg) return (false);
+	seg_info = (int *)(base + H->offset[GSHHG_CACHE_SEG_INFO]);
+	seg_start = (int *)(base + H->offset[GSHHG_CACHE_SEG_START]);
+	seg_id = (int *)(base + H->offset[GSHHG_CACHE_SEG_ID]);
+	for (k = 0; k < H->n_seg; k++)	/* The number of points is in the top bits of seg_info */
+		if (seg_info[k] < 0 || seg_start[k] < 0 || (int64_t)seg_start[k] + (seg_info[k] >> 9) > H->n_pt || seg_id[k] < 0 || seg_id[k] >= H->n_poly) return (false);
+	return (true);
+}
+
+void * gmt_shore_cache_map (struct GMT_CTRL *GMT, char *cache_path, size_t *size)
+{	/* Map the cache file read-only and check that its header is valid, that every array lies
+	 * inside the file and that the indices between the arrays are in range; return NULL if not */
+	int fd;
+	unsigned int k;
+	bool valid;
+	size_t n_items[GSHHG_CACHE_N_ARRAYS], width[GSHHG_CACHE_N_ARRAYS];
+	void *map = NULL;
+	struct stat buf;
+	struct GMT_SHORE_CACHE *H = NULL;
+
+	if ((fd = open (cache_path, O_RDONLY)) < 0) return (NULL);
+	if (fstat (fd, &buf) || (size_t)buf.st_size < sizeof (struct GMT_SHORE_CACHE)) {
+		close (fd);
+		return (NULL);
+	}
+	map = mmap (NULL, (size_t)buf.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close (fd);	/* The mapping stays valid after the file is closed */
+	if (map == MAP_FAILED) return (NULL);
+
+	H = map;
+	valid = (!strncmp (H->magic, GSHHG_CACHE_MAGIC, 8U) && H->endian == GSHHG_CACHE_ENDIAN && H->size == (uint64_t)buf.st_size);
+	if (valid) valid = gmt_shore_cache_layout (H, n_items, width);
+	for (k = 0; valid && k < GSHHG_CACHE_N_ARRAYS; k++) {	/* Each array must be aligned and end inside the file */
+		if (H->offset[k] < sizeof (struct GMT_SHORE_CACHE) || (H->offset[k] & 7ULL) || H->offset[k] > H->size || n_items[k] > (H->size - H->offset[k]) / width[k])
+			valid = false;
+	}
+	if (valid) valid = gmt_shore_cache_ranges (H);
+	if (!valid) {
+		GMT_Report (GMT->parent, GMT_MSG_VERBOSE, "GSHHG cache %s is damaged or not valid for this system; ignored\n", cache_path);
+		munmap (map, (size_t)buf.st_size);
+		return (NULL);
+	}
+	*size = (size_t)buf.st_size;
+	return (map);
+}
+
+int gmt_shore_nc_version (char *path, char version[8])
+{	/* Get the version attribute of the netCDF shoreline file path without reading any data */
+	int cdfid, err;
+	size_t len;
+
+	if ((err = nc_open (path, NC_NOWRITE, &cdfid)) != NC_NOERR) return (err);
+	if ((err = nc_inq_attlen (cdfid, NC_GLOBAL, "version", &len)) == NC_NOERR) {
+		if (len > 8U)	/* Would not fit, as in GMT_SHORE */
+			err = NC_EINVAL;
+		else
+			err = nc_get_att_text (cdfid, NC_GLOBAL, "version", version);
+	}
+	nc_close (cdfid);
+	return (err);
+}
+
+bool gmt_shore_cache_current (struct GMT_SHORE_CACHE *H, char *path, struct stat *nc_buf, char version[8])
+{	/* Return true if the cache H was built from the netCDF file path as it is now */
+	if (strncmp (H->nc_path, path, GMT_BUFSIZ)) return (false);	/* Built from another file */
+	if (H->nc_size != (uint64_t)nc_buf->st_size || H->nc_mtime != (int64_t)nc_buf->st_mtime) return (false);	/* File has changed since */
+	return (!strncmp (H->version, version, 8U));
+}
+
+bool gmt_shore_cache_open (struct GMT_CTRL *GMT, struct GMT_SHORE *c, char *path, char res)
+{	/* Map the cache for the netCDF shoreline file path, building it first if missing, damaged or out of date.
+	 * Returns false if caching is not enabled or fails, and the netCDF file must be read instead. */
+	int err;
+	char *dir = NULL, cache_path[GMT_BUFSIZ] = {""}, version[8] = {""};
+	struct stat nc_buf;
+
+	if ((dir = getenv ("GMT_GSHHG_CACHEDIR")) == NULL || dir[0] == '\0') return (false);	/* Caching not requested */
+	if (stat (path, &nc_buf) || gmt_shore_nc_version (path, version) != NC_NOERR) return (false);
+
+	sprintf (cache_path, "%s/binned_GSHHS_%c.cache", dir, res);
+	if ((c->cache = gmt_shore_cache_map (GMT, cache_path, &c->cache_size)) && !gmt_shore_cache_current (c->cache, path, &nc_buf, version)) {
+		GMT_Report (GMT->parent, GMT_MSG_VERBOSE, "GSHHG cache %s does not match %s\n", cache_path, path);
+		munmap (c->cache, c->cache_size);
+		c->cache = NULL;
+	}
+	if (c->cache == NULL) {	/* Missing, damaged or out of date, so (re)build it */
+		GMT_Report (GMT->parent, GMT_MSG_VERBOSE, "Building GSHHG cache %s\n", cache_path);
+		if ((err = gmt_shore_cache_build (GMT, path, &nc_buf, cache_path))) {
+			GMT_Report (GMT->parent, GMT_MSG_VERBOSE, "Could not build GSHHG cache %s [%s]; reading %s instead\n", cache_path, GMT_strerror (err), path);
+			return (false);
+		}
+		if ((c->cache = gmt_shore_cache_map (GMT, cache_path, &c->cache_size)) == NULL) return (false);
+		if (!gmt_shore_cache_current (c->cache, path, &nc_buf, version)) {	/* Replaced by another process in the meantime */
+			munmap (c->cache, c->cache_size);
+			c->cache = NULL;
+			return (false);
+		}
+	}
+	GMT_Report (GMT->parent, GMT_MSG_DEBUG, "GSHHG: Using cache %s\n", cache_path);
+	return (true);
+}
+#else
+bool gmt_shore_cache_open (struct GMT_CTRL *GMT, struct GMT_SHORE *c, char *path, char res)
+{	/* No mmap on this system, so always read the netCDF file */
+	GMT_UNUSED(GMT); GMT_UNUSED(c); GMT_UNUSED(path); GMT_UNUSED(res);
+	return (false);
+}
+#endif /* HAVE_SYS_MMAN_H_ */
+
 void gmt_shore_check (struct GMT_CTRL *GMT, bool ok[5])
 /* Sets ok to true for those resolutions available in share for
  * resolution (f, h, i, l, c) */
@@ -429,7 +689,7 @@ int GMT_init_shore (struct GMT_CTRL *GMT, char res, struct GMT_SHORE *c, double
 	bool int_areas = false;
 	short *stmp = NULL;
 	int *itmp = NULL;
-	size_t start[1], count[1];
+	size_t start[1] = {0}, count[1];
 	char stem[GMT_LEN64] = {""}, path[GMT_BUFSIZ] = {""};
 
 	sprintf (stem, "binned_GSHHS_%c", res);
@@ -440,56 +700,68 @@ int GMT_init_shore (struct GMT_CTRL *GMT, char res, struct GMT_SHORE *c, double
 		/* zap structure (nc_get_att_text does not null-terminate strings!) */
 		GMT_memset (c, 1, struct GMT_SHORE);
 
-	/* Open shoreline file */
-	GMT_err_trap (nc_open (path, NC_NOWRITE, &c->cdfid));
-
-	/* Get global attributes */
-	GMT_err_trap (nc_get_att_text (c->cdfid, NC_GLOBAL, "version", c->version));
-	GMT_err_trap (nc_get_att_text (c->cdfid, NC_GLOBAL, "title", c->title));
-	GMT_err_trap (nc_get_att_text (c->cdfid, NC_GLOBAL, "source", c->source));
-
-	/* Get all id tags */
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Bin_size_in_minutes", &c->bin_size_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "N_bins_in_360_longitude_range", &c->bin_nx_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "N_bins_in_180_degree_latitude_range", &c->bin_ny_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "N_bins_in_file", &c->n_bin_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "N_segments_in_file", &c->n_seg_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "N_points_in_file", &c->n_pt_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Id_of_first_segment_in_a_bin", &c->bin_firstseg_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Embedded_node_levels_in_a_bin", &c->bin_info_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "N_segments_in_a_bin", &c->bin_nseg_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Embedded_npts_levels_exit_entry_for_a_segment", &c->seg_info_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Id_of_first_point_in_a_segment", &c->seg_start_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Relative_longitude_from_SW_corner_of_bin", &c->pt_dx_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Relative_latitude_from_SW_corner_of_bin", &c->pt_dy_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Micro_fraction_of_full_resolution_area", &c->GSHHS_areafrac_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "N_polygons_in_file", &c->n_poly_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "N_nodes_in_file", &c->n_node_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Id_of_parent_polygons", &c->GSHHS_parent_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Id_of_node_polygons", &c->GSHHS_node_id));
-	GMT_err_trap (nc_inq_varid (c->cdfid, "Id_of_GSHHS_ID", &c->seg_GSHHS_ID_id));
-
-	if (nc_inq_varid (c->cdfid, "Ten_times_the_km_squared_area_of_polygons", &c->GSHHS_area_id) == NC_NOERR) {	/* Old file with 1/10 km^2 areas in int format*/
-		GMT_Report (GMT->parent, GMT_MSG_LONG_VERBOSE, "GSHHS: Areas not accurate for small lakes and islands.  Consider updating GSHHG.\n");
-		int_areas = true;
-	}
-	else if (nc_inq_varid (c->cdfid, "The_km_squared_area_of_polygons", &c->GSHHS_area_id) != NC_NOERR) {	/* New file with km^2 areas as doubles */
-		GMT_Report (GMT->parent, GMT_MSG_NORMAL, "GSHHS: Unable to determine how polygon areas were stored.\n");
+	if (gmt_shore_cache_open (GMT, c, path, res)) {	/* Get everything from the mapped cache instead */
+		struct GMT_SHORE_CACHE *H = c->cache;
+		GMT_memcpy (c->version, H->version, 8, char);
+		GMT_memcpy (c->title, H->title, 80, char);
+		GMT_memcpy (c->source, H->source, 80, char);
+		GMT_memcpy (c->units, H->units, 80, char);
+		c->bin_size = H->bin_size;	c->bin_nx = H->bin_nx;	c->bin_ny = H->bin_ny;
+		c->n_bin = H->n_bin;	c->n_seg = H->n_seg;	c->n_pt = H->n_pt;
+		c->n_poly = H->n_poly;	c->n_nodes = H->n_nodes;
 	}
+	else {
+		/* Open shoreline file */
+		GMT_err_trap (nc_open (path, NC_NOWRITE, &c->cdfid));
+
+		/* Get global attributes */
+		GMT_err_trap (nc_get_att_text (c->cdfid, NC_GLOBAL, "version", c->version));
+		GMT_err_trap (nc_get_att_text (c->cdfid, NC_GLOBAL, "title", c->title));
+		GMT_err_trap (nc_get_att_text (c->cdfid, NC_GLOBAL, "source", c->source));
+
+		/* Get all id tags */
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Bin_size_in_minutes", &c->bin_size_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "N_bins_in_360_longitude_range", &c->bin_nx_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "N_bins_in_180_degree_latitude_range", &c->bin_ny_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "N_bins_in_file", &c->n_bin_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "N_segments_in_file", &c->n_seg_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "N_points_in_file", &c->n_pt_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Id_of_first_segment_in_a_bin", &c->bin_firstseg_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Embedded_node_levels_in_a_bin", &c->bin_info_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "N_segments_in_a_bin", &c->bin_nseg_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Embedded_npts_levels_exit_entry_for_a_segment", &c->seg_info_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Id_of_first_point_in_a_segment", &c->seg_start_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Relative_longitude_from_SW_corner_of_bin", &c->pt_dx_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Relative_latitude_from_SW_corner_of_bin", &c->pt_dy_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Micro_fraction_of_full_resolution_area", &c->GSHHS_areafrac_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "N_polygons_in_file", &c->n_poly_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "N_nodes_in_file", &c->n_node_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Id_of_parent_polygons", &c->GSHHS_parent_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Id_of_node_polygons", &c->GSHHS_node_id));
+		GMT_err_trap (nc_inq_varid (c->cdfid, "Id_of_GSHHS_ID", &c->seg_GSHHS_ID_id));
+
+		if (nc_inq_varid (c->cdfid, "Ten_times_the_km_squared_area_of_polygons", &c->GSHHS_area_id) == NC_NOERR) {	/* Old file with 1/10 km^2 areas in int format*/
+			GMT_Report (GMT->parent, GMT_MSG_LONG_VERBOSE, "GSHHS: Areas not accurate for small lakes and islands.  Consider updating GSHHG.\n");
+			int_areas = true;
+		}
+		else if (nc_inq_varid (c->cdfid, "The_km_squared_area_of_polygons", &c->GSHHS_area_id) != NC_NOERR) {	/* New file with km^2 areas as doubles */
+			GMT_Report (GMT->parent, GMT_MSG_NORMAL, "GSHHS: Unable to determine how polygon areas were stored.\n");
+		}
 
-	/* Get attributes */
-	GMT_err_trap (nc_get_att_text (c->cdfid, c->pt_dx_id, "units", c->units));
+		/* Get attributes */
+		GMT_err_trap (nc_get_att_text (c->cdfid, c->pt_dx_id, "units", c->units));
 
-	/* Get global variables */
+		/* Get global variables */
 
-	start[0] = 0;
+		start[0] = 0;
 
-	GMT_err_trap (nc_get_var1_int (c->cdfid, c->bin_size_id, start, &c->bin_size));
-	GMT_err_trap (nc_get_var1_int (c->cdfid, c->bin_nx_id, start, &c->bin_nx));
-	GMT_err_trap (nc_get_var1_int (c->cdfid, c->bin_ny_id, start, &c->bin_ny));
-	GMT_err_trap (nc_get_var1_int (c->cdfid, c->n_bin_id, start, &c->n_bin));
-	GMT_err_trap (nc_get_var1_int (c->cdfid, c->n_seg_id, start, &c->n_seg));
-	GMT_err_trap (nc_get_var1_int (c->cdfid, c->n_pt_id, start, &c->n_pt));
+		GMT_err_trap (nc_get_var1_int (c->cdfid, c->bin_size_id, start, &c->bin_size));
+		GMT_err_trap (nc_get_var1_int (c->cdfid, c->bin_nx_id, start, &c->bin_nx));
+		GMT_err_trap (nc_get_var1_int (c->cdfid, c->bin_ny_id, start, &c->bin_ny));
+		GMT_err_trap (nc_get_var1_int (c->cdfid, c->n_bin_id, start, &c->n_bin));
+		GMT_err_trap (nc_get_var1_int (c->cdfid, c->n_seg_id, start, &c->n_seg));
+		GMT_err_trap (nc_get_var1_int (c->cdfid, c->n_pt_id, start, &c->n_pt));
+	}
 
 	c->fraction = info->fraction;
 	c->skip_feature = info->flag;
@@ -529,20 +801,28 @@ int GMT_init_shore (struct GMT_CTRL *GMT, char res, struct GMT_SHORE *c, double
 
 	/* Get polygon variables if they are needed */
 
-	GMT_err_trap (nc_get_var1_int (c->cdfid, c->n_poly_id, start, &c->n_poly));
-	count[0] = c->n_poly;
-	c->GSHHS_parent = GMT_memory (GMT, NULL, c->n_poly, int);
-	GMT_err_trap (nc_get_vara_int (c->cdfid, c->GSHHS_parent_id, start, count, c->GSHHS_parent));
-	c->GSHHS_area = GMT_memory (GMT, NULL, c->n_poly, double);
-	GMT_err_trap (nc_get_vara_double (c->cdfid, c->GSHHS_area_id, start, count, c->GSHHS_area));
-	if (int_areas) for (i = 0; i < c->n_poly; i++) c->GSHHS_area[i] *= 0.1;	/* Since they were stored as 10 * km^2 using integers */
-	c->GSHHS_area_fraction = GMT_memory (GMT, NULL, c->n_poly, int);
-	GMT_err_trap (nc_get_vara_int (c->cdfid, c->GSHHS_areafrac_id, start, count, c->GSHHS_area_fraction));
-	if (c->min_area > 0.0) {	/* Want to exclude small polygons so we need info about the node polygons */
-	        GMT_err_trap (nc_get_var1_int (c->cdfid, c->n_node_id, start, &c->n_nodes));
-		c->GSHHS_node = GMT_memory (GMT, NULL, c->n_nodes, int);
-		count[0] = c->n_nodes;
-		GMT_err_trap (nc_get_vara_int (c->cdfid, c->GSHHS_node_id, start, count, c->GSHHS_node));
+	if (c->cache) {	/* Point straight into the mapped cache; areas were already scaled when it was built */
+		c->GSHHS_parent = gmt_shore_cache_array (c, GSHHG_CACHE_PARENT);
+		c->GSHHS_area = gmt_shore_cache_array (c, GSHHG_CACHE_AREA);
+		c->GSHHS_area_fraction = gmt_shore_cache_array (c, GSHHG_CACHE_AREA_FRACTION);
+		if (c->min_area > 0.0) c->GSHHS_node = gmt_shore_cache_array (c, GSHHG_CACHE_NODE);
+	}
+	else {
+		GMT_err_trap (nc_get_var1_int (c->cdfid, c->n_poly_id, start, &c->n_poly));
+		count[0] = c->n_poly;
+		c->GSHHS_parent = GMT_memory (GMT, NULL, c->n_poly, int);
+		GMT_err_trap (nc_get_vara_int (c->cdfid, c->GSHHS_parent_id, start, count, c->GSHHS_parent));
+		c->GSHHS_area = GMT_memory (GMT, NULL, c->n_poly, double);
+		GMT_err_trap (nc_get_vara_double (c->cdfid, c->GSHHS_area_id, start, count, c->GSHHS_area));
+		if (int_areas) for (i = 0; i < c->n_poly; i++) c->GSHHS_area[i] *= 0.1;	/* Since they were stored as 10 * km^2 using integers */
+		c->GSHHS_area_fraction = GMT_memory (GMT, NULL, c->n_poly, int);
+		GMT_err_trap (nc_get_vara_int (c->cdfid, c->GSHHS_areafrac_id, start, count, c->GSHHS_area_fraction));
+		if (c->min_area > 0.0) {	/* Want to exclude small polygons so we need info about the node polygons */
+		        GMT_err_trap (nc_get_var1_int (c->cdfid, c->n_node_id, start, &c->n_nodes));
+			c->GSHHS_node = GMT_memory (GMT, NULL, c->n_nodes, int);
+			count[0] = c->n_nodes;
+			GMT_err_trap (nc_get_vara_int (c->cdfid, c->GSHHS_node_id, start, count, c->GSHHS_node));
+		}
 	}
 
 	/* Get bin variables, then extract only those corresponding to the bins to use */
@@ -553,6 +833,17 @@ int GMT_init_shore (struct GMT_CTRL *GMT, char res, struct GMT_SHORE *c, double
 	c->bin_nseg      = GMT_memory (GMT, NULL, nb, short);
 	c->bin_firstseg  = GMT_memory (GMT, NULL, nb, int);
 
+	if (c->cache) {	/* Just pick the entries for our bins from the mapped arrays */
+		short *bin_info = gmt_shore_cache_array (c, GSHHG_CACHE_BIN_INFO), *bin_nseg = gmt_shore_cache_array (c, GSHHG_CACHE_BIN_NSEG);
+		int *bin_firstseg = gmt_shore_cache_array (c, GSHHG_CACHE_BIN_FIRSTSEG);
+		for (i = 0; i < c->nb; i++) {
+			c->bin_info[i] = bin_info[c->bins[i]];
+			c->bin_nseg[i] = bin_nseg[c->bins[i]];
+			c->bin_firstseg[i] = bin_firstseg[c->bins[i]];
+		}
+		return (GMT_NOERROR);
+	}
+
 	count[0] = c->n_bin;
 	stmp = GMT_memory (GMT, NULL, c->n_bin, short);
 
@@ -627,9 +918,16 @@ int GMT_get_shore_bin (struct GMT_CTRL *GMT, unsigned int b, struct GMT_SHORE *c
 	seg_start = GMT_memory (GMT, NULL, c->bin_nseg[b], int);
 	seg_ID = GMT_memory (GMT, NULL, c->bin_nseg[b], int);
 
-	GMT_err_trap (nc_get_vara_int (c->cdfid, c->seg_info_id, start, count, seg_info));
-	GMT_err_trap (nc_get_vara_int (c->cdfid, c->seg_start_id, start, count, seg_start));
-	GMT_err_trap (nc_get_vara_int (c->cdfid, c->seg_GSHHS_ID_id, start, count, seg_ID));
+	if (c->cache) {	/* Copy from the mapped cache since these arrays are edited below */
+		GMT_memcpy (seg_info, (int *)gmt_shore_cache_array (c, GSHHG_CACHE_SEG_INFO) + start[0], count[0], int);
+		GMT_memcpy (seg_start, (int *)gmt_shore_cache_array (c, GSHHG_CACHE_SEG_START) + start[0], count[0], int);
+		GMT_memcpy (seg_ID, (int *)gmt_shore_cache_array (c, GSHHG_CACHE_SEG_ID) + start[0], count[0], int);
+	}
+	else {
+		GMT_err_trap (nc_get_vara_int (c->cdfid, c->seg_info_id, start, count, seg_info));
+		GMT_err_trap (nc_get_vara_int (c->cdfid, c->seg_start_id, start, count, seg_start));
+		GMT_err_trap (nc_get_vara_int (c->cdfid, c->seg_GSHHS_ID_id, start, count, seg_ID));
+	}
 
 	/* First tally how many useful segments */
 
@@ -700,6 +998,11 @@ int GMT_get_shore_bin (struct GMT_CTRL *GMT, unsigned int b, struct GMT_SHORE *c
 		c->seg[s].entry = (seg_info[s] >> 3) & 7;
 		c->seg[s].exit = seg_info[s] & 7;
 		c->seg[s].fid = (c->GSHHS_area[seg_ID[s]] < 0) ? RIVERLAKE : c->seg[s].level;
+		if (c->cache) {	/* The points are used in place; they are only read */
+			c->seg[s].dx = (short *)gmt_shore_cache_array (c, GSHHG_CACHE_PT_DX) + seg_start[s];
+			c->seg[s].dy = (short *)gmt_shore_cache_array (c, GSHHG_CACHE_PT_DY) + seg_start[s];
+			continue;
+		}
 		c->seg[s].dx = GMT_memory (GMT, NULL, c->seg[s].n, short);
 		c->seg[s].dy = GMT_memory (GMT, NULL, c->seg[s].n, short);
 		start[0] = seg_start[s];
@@ -1117,7 +1420,7 @@ void GMT_free_shore (struct GMT_CTRL *GMT, struct GMT_SHORE *c)
 {	/* Removes allocated variables for this block only */
 	int i;
 
-	for (i = 0; i < c->ns; i++) {
+	for (i = 0; !c->cache && i < c->ns; i++) {	/* Cached points live in the mapping */
 		GMT_free (GMT, c->seg[i].dx);
 		GMT_free (GMT, c->seg[i].dy);
 	}
@@ -1142,6 +1445,13 @@ void GMT_shore_cleanup (struct GMT_CTRL *GMT, struct GMT_SHORE *c)
 	GMT_free (GMT, c->bin_info);
 	GMT_free (GMT, c->bin_nseg);
 	GMT_free (GMT, c->bin_firstseg);
+	if (c->cache) {	/* The polygon arrays live in the mapping and there is no netCDF file to close */
+#ifdef HAVE_SYS_MMAN_H_
+		munmap (c->cache, c->cache_size);
+#endif
+		c->cache = NULL;
+		return;
+	}
 	GMT_free (GMT, c->GSHHS_area);
 	GMT_free (GMT, c->GSHHS_area_fraction);
 	if (c->min_area > 0.0) GMT_free (GMT, c->GSHHS_node);
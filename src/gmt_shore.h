@@ -52,6 +52,36 @@ enum GMT_enum_gshhs {GSHHS_MAX_DELTA = 65535,	/* Largest value to store in a uns
 	GSHHS_ANTARCTICA_SKIP		= 2,	/* Skip Antarctica coastline */
 	GSHHS_ANTARCTICA_LIMIT		= -60};	/* Data below 60S is Antarctica */
 
+enum GMT_enum_gshhg_cache {	/* Arrays stored in a GSHHG cache file, in file order */
+	GSHHG_CACHE_BIN_INFO = 0,	/* short [n_bin]: Embedded node levels */
+	GSHHG_CACHE_BIN_NSEG,		/* short [n_bin]: Number of segments per bin */
+	GSHHG_CACHE_BIN_FIRSTSEG,	/* int [n_bin]: Id of first segment per bin */
+	GSHHG_CACHE_SEG_INFO,		/* int [n_seg]: Embedded npts, level, exit, entry */
+	GSHHG_CACHE_SEG_START,		/* int [n_seg]: Id of first point per segment */
+	GSHHG_CACHE_SEG_ID,		/* int [n_seg]: GSHHS polygon id per segment */
+	GSHHG_CACHE_PT_DX,		/* short [n_pt]: Relative longitudes */
+	GSHHG_CACHE_PT_DY,		/* short [n_pt]: Relative latitudes */
+	GSHHG_CACHE_PARENT,		/* int [n_poly]: Parent polygon ids */
+	GSHHG_CACHE_AREA,		/* double [n_poly]: Polygon areas in km^2 */
+	GSHHG_CACHE_AREA_FRACTION,	/* int [n_poly]: Micro-fraction of full resolution area */
+	GSHHG_CACHE_NODE,		/* int [n_nodes]: Id of polygon determining each node level */
+	GSHHG_CACHE_N_ARRAYS};
+
+struct GMT_SHORE_CACHE {	/* Header of a memory-mappable GSHHG cache file; the arrays follow at the given byte offsets */
+	char magic[8];		/* Identifies the file format and its version */
+	uint32_t endian;	/* Byte-order mark so caches written on other architectures are rejected */
+	int bin_size, bin_nx, bin_ny, n_bin, n_seg, n_pt, n_poly, n_nodes;	/* Same as in GMT_SHORE */
+	char units[80];		/* Units of lon/lat */
+	char title[80];		/* Title of data set */
+	char source[80];	/* Source of data set */
+	char version[8];	/* Version of data set */
+	char nc_path[GMT_BUFSIZ];	/* Full path of the netCDF file the cache was built from */
+	uint64_t nc_size;	/* Size of that netCDF file in bytes when the cache was built */
+	int64_t nc_mtime;	/* Modification time of that netCDF file when the cache was built */
+	uint64_t size;		/* Total size of the file in bytes */
+	uint64_t offset[GSHHG_CACHE_N_ARRAYS];	/* Byte offset of each array from the start of the file */
+};
+
 struct GMT_SHORE_SELECT {	/* Information on levels and min area to use */
 	int low;	/* Lowest hierarchical level to use [0] */
 	int high;	/* Highest hierarchical level to use [4] */
@@ -125,6 +155,11 @@ struct GMT_SHORE {	/* Struct used by pscoast and others */
 	char version[8];	/* Version of data set */
 	char res;		/* Resolution f,g,i,l,c */
 
+	/* Memory-mapped cache used instead of the netCDF file, if any */
+
+	void *cache;		/* Start of the mapped GMT_SHORE_CACHE file, or NULL */
+	size_t cache_size;	/* Length of the mapping */
+
 	/* netCDF ID variables */
 	
 	int cdfid;		/* netCDF File id for coastbin file */
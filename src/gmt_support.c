@@ -47,7 +47,9 @@
  *  GMT_get_fill_from_z     Return fill type for given z
  *  GMT_get_format          Find # of decimals and create format string
  *  GMT_get_rgb_from_z      Return rgb for given z
+ *  GMT_get_rgb_from_zlut   Return rgb for given z via a precomputed lookup table
  *  GMT_get_plot_array      Allocate memory for plotting arrays
+ *  GMT_get_zlut            Build lookup table of CPT slices for quantized z
  *  GMT_getfill             Decipher and check fill argument
  *  GMT_getinc              Decipher and check increment argument
  *  GMT_getpen              Decipher and check pen argument
@@ -60,6 +62,8 @@
  *  gmt_lab_to_rgb          Corvert CIELAB LAB to RGB
  *  gmt_lab_to_xyz          Convert CIELAB LAB to XYZ
  *  GMT_non_zero_winding    Finds if a point is inside/outside a polygon
+ *  GMT_prepare_polygon     Bin polygon edges into slabs for fast in/on/out tests
+ *  GMT_inonout_row         Finds in/on/out status of all nodes along a row via a prepared polygon
  *  GMT_putpen              Encode pen argument into textstring
  *  GMT_read_cpt            Read color palette file
  *  gmt_rgb_to_cmyk         Convert RGB to CMYK
@@ -2983,30 +2987,35 @@ int GMT_get_index (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, double value)
 	return (index);
 }
 
-void GMT_get_rgb_lookup (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, int index, double value, double *rgb)
-{
+bool gmt_get_rgb_index (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, int index, double value, double *rgb)
+{	/* Set rgb for value in slice index (or the NaN, foreground or background patch if index < 0) and
+	 * return true if the slice is to be skipped.  P is not changed, so threads may share it */
 	unsigned int i;
 	double rel, hsv[4];
 
 	if (index < 0) {	/* NaN, Foreground, Background */
 		GMT_rgb_copy (rgb, P->patch[index+3].rgb);
-		P->skip = P->patch[index+3].skip;
+		return (P->patch[index+3].skip);
 	}
-	else if (P->range[index].skip) {		/* Set to page color for now */
+	if (P->range[index].skip) {		/* Set to page color for now */
 		GMT_rgb_copy (rgb, GMT->current.setting.ps_page_rgb);
-		P->skip = true;
+		return (true);
 	}
-	else {	/* Do linear interpolation between low and high colors */
-		rel = (value - P->range[index].z_low) * P->range[index].i_dz;
-		if (GMT->current.setting.color_model == GMT_HSV + GMT_COLORINT) {	/* Interpolation in HSV space */
-			for (i = 0; i < 4; i++) hsv[i] = P->range[index].hsv_low[i] + rel * P->range[index].hsv_diff[i];
-			gmt_hsv_to_rgb (rgb, hsv);
-		}
-		else {	/* Interpolation in RGB space */
-			for (i = 0; i < 4; i++) rgb[i] = P->range[index].rgb_low[i] + rel * P->range[index].rgb_diff[i];
-		}
-		P->skip = false;
+	/* Do linear interpolation between low and high colors */
+	rel = (value - P->range[index].z_low) * P->range[index].i_dz;
+	if (GMT->current.setting.color_model == GMT_HSV + GMT_COLORINT) {	/* Interpolation in HSV space */
+		for (i = 0; i < 4; i++) hsv[i] = P->range[index].hsv_low[i] + rel * P->range[index].hsv_diff[i];
+		gmt_hsv_to_rgb (rgb, hsv);
 	}
+	else {	/* Interpolation in RGB space */
+		for (i = 0; i < 4; i++) rgb[i] = P->range[index].rgb_low[i] + rel * P->range[index].rgb_diff[i];
+	}
+	return (false);
+}
+
+void GMT_get_rgb_lookup (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, int index, double value, double *rgb)
+{
+	P->skip = gmt_get_rgb_index (GMT, P, index, value, rgb);
 }
 
 int GMT_get_rgb_from_z (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, double value, double *rgb)
@@ -3016,6 +3025,60 @@ int GMT_get_rgb_from_z (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, double valu
 	return (index);
 }
 
+struct GMT_ZLUT * GMT_get_zlut (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, unsigned int n)
+{	/* Split the z-range of the palette into n equal bins and record which CPT slice
+	 * each bin falls in.  This lets GMT_get_rgb_from_zlut find the slice for a z-value with
+	 * a single multiplication instead of a search, which matters when millions of pixels
+	 * must be colored.  Bins straddling a slice boundary are flagged and searched as before. */
+	unsigned int bin;
+	int lo, hi;
+	double z_min, z_max, dz, z0, z1;
+	struct GMT_ZLUT *Z = NULL;
+
+	if (n == 0 || P->n_colors == 0) return (NULL);
+	z_min = P->range[0].z_low;	z_max = P->range[P->n_colors-1].z_high;
+	if (!(z_max > z_min)) return (NULL);	/* Cannot quantize an empty range */
+
+	Z = GMT_memory (GMT, NULL, 1, struct GMT_ZLUT);
+	Z->index = GMT_memory (GMT, NULL, n, int);
+	Z->n = n;
+	Z->z_low = z_min;
+	dz = (z_max - z_min) / n;
+	Z->i_dz = 1.0 / dz;
+	for (bin = 0; bin < n; bin++) {
+		z0 = z_min + bin * dz;
+		z1 = (bin == n - 1) ? z_max : z_min + (bin + 1) * dz;
+		lo = GMT_get_index (GMT, P, z0);
+		hi = GMT_get_index (GMT, P, z1);
+		/* The bin is inside slice lo if the slice covers all of [z0,z1] */
+		Z->index[bin] = (lo >= 0 && (lo == hi || z1 <= P->range[lo].z_high)) ? lo : -1;
+	}
+	return (Z);
+}
+
+void GMT_free_zlut (struct GMT_CTRL *GMT, struct GMT_ZLUT **Z)
+{	/* Free a lookup table created by GMT_get_zlut */
+	if (*Z == NULL) return;
+	GMT_free (GMT, (*Z)->index);
+	GMT_free (GMT, *Z);
+	*Z = NULL;
+}
+
+int GMT_get_rgb_from_zlut (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, struct GMT_ZLUT *Z, double value, double *rgb)
+{	/* Same as GMT_get_rgb_from_z but finds the slice via the lookup table Z, if given.
+	 * Unlike GMT_get_rgb_from_z it does not update P->skip, so it may be called by several threads at once. */
+	int index = -1, bin;
+
+	if (Z && !GMT_is_dnan (value) && value >= Z->z_low) {	/* Try the table first */
+		bin = (int)((value - Z->z_low) * Z->i_dz);
+		if (bin < (int)Z->n && (index = Z->index[bin]) >= 0 && !(value >= P->range[index].z_low && value < P->range[index].z_high))
+			index = -1;	/* Round-off put us in the wrong bin; do the full search instead */
+	}
+	if (index < 0) index = GMT_get_index (GMT, P, value);
+	(void)gmt_get_rgb_index (GMT, P, index, value, rgb);
+	return (index);
+}
+
 int GMT_get_fill_from_z (struct GMT_CTRL *GMT, struct GMT_PALETTE *P, double value, struct GMT_FILL *fill)
 {
 	int index;
@@ -5962,6 +6025,291 @@ unsigned int GMT_inonout (struct GMT_CTRL *GMT, double x, double y, const struct
 	return (side);
 }
 
+/* The next functions build and query a GMT_PREPARED_POLYGON, which is used when many points or whole
+ * grid rows must be tested against the same Cartesian polygon.  The edges are binned into horizontal
+ * slabs so a test only visits the edges at the y of the point, and a horizontal ray is used so that
+ * a grid row can be classified with one bisection per edge and a single sweep.  Points strictly inside
+ * or outside get the same answer as GMT_non_zero_winding since the winding number does not depend
+ * on the ray direction.  Whether a point is on an edge, and on which side of an edge it is, is
+ * decided with the same arithmetic as in GMT_non_zero_winding so the edge nodes agree as well. */
+
+#define GMT_PREPARED_MAX_SLABS	1048576U	/* Upper limit on the number of slabs in a prepared polygon */
+
+static inline unsigned int gmt_prepared_slab (struct GMT_PREPARED_POLYGON *P, double y)
+{	/* Return the slab holding y, which must be inside the y-range of P */
+	unsigned int s = (unsigned int)floor ((y - P->wesn[YLO]) * P->r_dy);
+	return ((s >= P->n_slabs) ? P->n_slabs - 1 : s);
+}
+
+static inline double gmt_edge_slack (struct GMT_POLYGON_EDGE *E)
+{	/* How far beyond the end points of a sloped edge the rounding in GMT_non_zero_winding may still put a point on it */
+	if (E->dir == 0 || E->x[0] == E->x[1]) return (0.0);	/* Horizontal and vertical edges are exact */
+	return (4.0 * DBL_EPSILON * MAX (fabs (E->y[0]), fabs (E->y[1])));
+}
+
+static inline int gmt_edge_side (struct GMT_POLYGON_EDGE *E, double x, double y)
+{	/* Return -1 if (x,y) is west of the non-horizontal edge E (which should reach y), +1 if east, and 0 if on it.
+	 * As in GMT_non_zero_winding, a point at the x of a vertex is only on E if it is that vertex (or if E is
+	 * vertical), and otherwise the y of the edge at x, computed from the edge start in path order, is compared with y */
+	double x_min, x_max, y_sect;
+
+	x_min = MIN (E->x[0], E->x[1]);	x_max = MAX (E->x[0], E->x[1]);
+	if (x < x_min) return (-1);
+	if (x > x_max) return (+1);
+	if (x_min == x_max) return (0);	/* On a vertical edge */
+	if (x == E->x[0]) return ((y == E->y[0]) ? 0 : ((E->x[1] > E->x[0]) ? -1 : +1));	/* Above the lower vertex the edge leans away from it */
+	if (x == E->x[1]) return ((y == E->y[1]) ? 0 : ((E->x[1] > E->x[0]) ? +1 : -1));	/* Below the upper vertex likewise */
+	if (E->dir > 0)	/* Path goes from E->x[0],E->y[0] to E->x[1],E->y[1] */
+		y_sect = E->y[0] + (E->y[1] - E->y[0]) * ((x - E->x[0]) / (E->x[1] - E->x[0]));
+	else		/* Path goes the other way */
+		y_sect = E->y[1] + (E->y[0] - E->y[1]) * ((x - E->x[1]) / (E->x[0] - E->x[1]));
+	if (y_sect == y) return (0);
+	return (((E->x[1] > E->x[0]) == (y > y_sect)) ? -1 : +1);	/* Above an edge that leans east means we are west of it */
+}
+
+static inline void gmt_prepared_slabs (struct GMT_PREPARED_POLYGON *P, struct GMT_POLYGON_EDGE *E, unsigned int *s0, unsigned int *s1)
+{	/* Return the range of slabs that edge E overlaps */
+	double slack = gmt_edge_slack (E);
+	*s0 = gmt_prepared_slab (P, MAX (E->y[0] - slack, P->wesn[YLO]));
+	*s1 = gmt_prepared_slab (P, MIN (E->y[1] + slack, P->wesn[YHI]));
+}
+
+struct GMT_PREPARED_POLYGON * gmt_prepare_polygon_sub (struct GMT_CTRL *GMT, double *x, double *y, uint64_t n)
+{	/* Build the edge list and slab index for a single polygon perimeter */
+	uint64_t i, j, k, *next = NULL;
+	unsigned int s, s0, s1;
+	double height, sum_dy = 0.0, n_slabs;
+	struct GMT_POLYGON_EDGE *E = NULL;
+	struct GMT_PREPARED_POLYGON *P = GMT_memory (GMT, NULL, 1, struct GMT_PREPARED_POLYGON);
+
+	if (n && x[n-1] == x[0] && y[n-1] == y[0]) n--;	/* Skip the repeated first point; the closing edge is added below */
+	P->n_edges = (n < 2) ? 0 : n;	/* n unique points make n edges when the path is closed */
+	P->n_slabs = 1;
+	if (P->n_edges == 0) {	/* Cannot be inside a null set or a point */
+		P->start = GMT_memory (GMT, NULL, 2, uint64_t);
+		return (P);
+	}
+
+	P->wesn[XLO] = P->wesn[XHI] = x[0];	P->wesn[YLO] = P->wesn[YHI] = y[0];
+	P->edge = GMT_memory (GMT, NULL, P->n_edges, struct GMT_POLYGON_EDGE);
+	for (i = 0; i < n; i++) {
+		if (x[i] < P->wesn[XLO]) P->wesn[XLO] = x[i];
+		if (x[i] > P->wesn[XHI]) P->wesn[XHI] = x[i];
+		if (y[i] < P->wesn[YLO]) P->wesn[YLO] = y[i];
+		if (y[i] > P->wesn[YHI]) P->wesn[YHI] = y[i];
+		j = (i == n - 1) ? 0 : i + 1;	/* End point of this edge */
+		E = &P->edge[i];
+		if (y[i] == y[j]) {	/* Horizontal edge; store with x increasing */
+			E->x[0] = MIN (x[i], x[j]);	E->x[1] = MAX (x[i], x[j]);
+			E->y[0] = E->y[1] = y[i];
+			E->dir = 0;
+		}
+		else if (y[i] < y[j]) {	/* Path goes up */
+			E->x[0] = x[i];	E->y[0] = y[i];	E->x[1] = x[j];	E->y[1] = y[j];
+			E->dir = +1;
+		}
+		else {	/* Path goes down */
+			E->x[0] = x[j];	E->y[0] = y[j];	E->x[1] = x[i];	E->y[1] = y[i];
+			E->dir = -1;
+		}
+		sum_dy += E->y[1] - E->y[0];
+	}
+
+	/* Choose the slab height so that each edge lands in about two slabs on average, regardless of how
+	 * ragged the polygon is; a horizontal line crosses about sum_dy/height edges anyway */
+	height = P->wesn[YHI] - P->wesn[YLO];
+	if (height > 0.0) {
+		n_slabs = floor (P->n_edges * height / (sum_dy + height));
+		P->n_slabs = (n_slabs < 1.0) ? 1 : ((n_slabs > GMT_PREPARED_MAX_SLABS) ? GMT_PREPARED_MAX_SLABS : (unsigned int)n_slabs);
+		P->r_dy = P->n_slabs / height;
+	}
+
+	/* Count, then list the edges that overlap each slab, including the slack of sloped edges */
+	P->start = GMT_memory (GMT, NULL, P->n_slabs + 1, uint64_t);
+	for (i = 0; i < P->n_edges; i++) {
+		gmt_prepared_slabs (P, &P->edge[i], &s0, &s1);
+		for (s = s0; s <= s1; s++) P->start[s+1]++;
+	}
+	for (s = 0; s < P->n_slabs; s++) P->start[s+1] += P->start[s];
+	P->item = GMT_memory (GMT, NULL, P->start[P->n_slabs], uint64_t);
+	next = GMT_memory (GMT, NULL, P->n_slabs, uint64_t);
+	GMT_memcpy (next, P->start, P->n_slabs, uint64_t);
+	for (i = 0; i < P->n_edges; i++) {
+		gmt_prepared_slabs (P, &P->edge[i], &s0, &s1);
+		for (s = s0; s <= s1; s++) {
+			k = next[s]++;
+			P->item[k] = i;
+		}
+	}
+	GMT_free (GMT, next);
+	return (P);
+}
+
+struct GMT_PREPARED_POLYGON * GMT_prepare_polygon (struct GMT_CTRL *GMT, double *x, double *y, uint64_t n)
+{	/* Prepare the Cartesian polygon x[n],y[n] for repeated use with GMT_inonout_prepared and GMT_inonout_row.
+	 * The path is closed implicitly if the last point does not repeat the first. */
+	return (gmt_prepare_polygon_sub (GMT, x, y, n));
+}
+
+struct GMT_PREPARED_POLYGON * GMT_prepare_segment (struct GMT_CTRL *GMT, const struct GMT_DATASEGMENT *S)
+{	/* Same as GMT_prepare_polygon for a Cartesian polygon segment, but also prepares any OGR holes
+	 * that follow the perimeter, so that the tests give the same answers as GMT_inonout */
+	struct GMT_PREPARED_POLYGON *P = NULL, *last = NULL;
+	struct GMT_DATASEGMENT *H = NULL;
+
+	last = P = gmt_prepare_polygon_sub (GMT, S->coord[GMT_X], S->coord[GMT_Y], S->n_rows);
+	if (GMT->current.io.OGR) {	/* Must also prepare the holes */
+		for (H = S->next; H && H->ogr && H->ogr->pol_mode == GMT_IS_HOLE; H = H->next) {
+			last->next = gmt_prepare_polygon_sub (GMT, H->coord[GMT_X], H->coord[GMT_Y], H->n_rows);
+			last = last->next;
+		}
+	}
+	return (P);
+}
+
+void GMT_free_prepared_polygon (struct GMT_CTRL *GMT, struct GMT_PREPARED_POLYGON **P)
+{	/* Free a prepared polygon and its holes */
+	struct GMT_PREPARED_POLYGON *this_P = *P, *next_P = NULL;
+
+	while (this_P) {
+		next_P = this_P->next;
+		GMT_free (GMT, this_P->start);
+		if (this_P->item) GMT_free (GMT, this_P->item);
+		if (this_P->edge) GMT_free (GMT, this_P->edge);
+		GMT_free (GMT, this_P);
+		this_P = next_P;
+	}
+	*P = NULL;
+}
+
+unsigned int gmt_inonout_prepared_sub (struct GMT_PREPARED_POLYGON *P, double x, double y)
+{	/* Count the windings of the polygon around (x,y) using the ray going east from the point */
+	int winding = 0, where;
+	double slack;
+	uint64_t k;
+	unsigned int s;
+	struct GMT_POLYGON_EDGE *E = NULL;
+
+	if (P->n_edges == 0) return (GMT_OUTSIDE);
+	if (x < P->wesn[XLO] || x > P->wesn[XHI] || y < P->wesn[YLO] || y > P->wesn[YHI]) return (GMT_OUTSIDE);
+
+	s = gmt_prepared_slab (P, y);
+	for (k = P->start[s]; k < P->start[s+1]; k++) {
+		E = &P->edge[P->item[k]];
+		if (y < E->y[0] || y > E->y[1]) {	/* Edge does not reach this y, but with rounding we may still be on it */
+			if ((slack = gmt_edge_slack (E)) > 0.0 && y >= E->y[0] - slack && y <= E->y[1] + slack && gmt_edge_side (E, x, y) == 0) return (GMT_ONEDGE);
+			continue;
+		}
+		if (E->dir == 0) {	/* Horizontal edge: only matters if we are on it */
+			if (x >= E->x[0] && x <= E->x[1]) return (GMT_ONEDGE);
+			continue;
+		}
+		if ((where = gmt_edge_side (E, x, y)) == 0) return (GMT_ONEDGE);
+		if (where < 0 && y < E->y[1]) winding += E->dir;	/* Top end points are not counted so a vertex on the ray only counts once */
+	}
+	return ((winding) ? GMT_INSIDE : GMT_OUTSIDE);
+}
+
+unsigned int GMT_inonout_prepared (struct GMT_CTRL *GMT, double x, double y, struct GMT_PREPARED_POLYGON *P)
+{	/* Same as GMT_inonout for a Cartesian polygon prepared by GMT_prepare_segment.
+	 * P is not modified so several threads may test points against it at once. */
+	unsigned int side, side_h = GMT_OUTSIDE;
+	struct GMT_PREPARED_POLYGON *H = NULL;
+	GMT_UNUSED(GMT);
+
+	if ((side = gmt_inonout_prepared_sub (P, x, y)) <= GMT_ONEDGE) return (side);	/* Outside polygon or on perimeter, we are done */
+
+	for (H = P->next; side_h == GMT_OUTSIDE && H; H = H->next)	/* Must check if point is inside a hole */
+		side_h = gmt_inonout_prepared_sub (H, x, y);
+	if (side_h == GMT_INSIDE) side = GMT_OUTSIDE;	/* Inside one of the holes, hence outside polygon */
+	if (side_h == GMT_ONEDGE) side = GMT_ONEDGE;	/* On path of one of the holes, hence on polygon path */
+	return (side);
+}
+
+uint64_t gmt_inonout_row_sub (struct GMT_CTRL *GMT, struct GMT_PREPARED_POLYGON *P, double y, double *x, uint64_t n, unsigned int *side)
+{	/* Classify all the nodes x[n] (increasing) along the horizontal line at y.  For each edge at y we bisect
+	 * for the first node that is not west of it and then step over the nodes that are on it; the winding
+	 * contributions and on-edge flags of these node ranges are accumulated in difference arrays and then
+	 * summed in one sweep along the row.  gmt_edge_side does not change sign more than once along a row,
+	 * so every node gets the same answer as from gmt_inonout_prepared_sub */
+	int *wind = NULL, *on = NULL, winding = 0, n_on = 0;
+	uint64_t k, lo, hi, mid, col, n_set = 0;
+	unsigned int s;
+	bool reach;
+	double slack;
+	struct GMT_POLYGON_EDGE *E = NULL;
+
+	GMT_memset (side, n, unsigned int);	/* Initialize to GMT_OUTSIDE */
+	if (n == 0 || P->n_edges == 0 || y < P->wesn[YLO] || y > P->wesn[YHI]) return (0);
+
+	s = gmt_prepared_slab (P, y);
+	if (P->start[s+1] == P->start[s]) return (0);
+	wind = GMT_memory (GMT, NULL, n + 1, int);
+	on = GMT_memory (GMT, NULL, n + 1, int);
+	for (k = P->start[s]; k < P->start[s+1]; k++) {
+		E = &P->edge[P->item[k]];
+		reach = (y >= E->y[0] && y <= E->y[1]);
+		if (!reach && ((slack = gmt_edge_slack (E)) == 0.0 || y < E->y[0] - slack || y > E->y[1] + slack)) continue;	/* Edge does not reach this y */
+		if (E->dir == 0) {	/* Horizontal edge: the nodes from E->x[0] to E->x[1] are on the path */
+			for (lo = 0, hi = n; lo < hi;) {	/* First node at or east of E->x[0] */
+				mid = (lo + hi) / 2;
+				if (x[mid] < E->x[0]) lo = mid + 1; else hi = mid;
+			}
+			for (col = lo, hi = n; col < hi;) {	/* First node east of E->x[1] */
+				mid = (col + hi) / 2;
+				if (x[mid] <= E->x[1]) col = mid + 1; else hi = mid;
+			}
+			if (lo < col) {on[lo]++;	on[col]--;}
+			continue;
+		}
+		for (lo = 0, hi = n; lo < hi;) {	/* First node that is on or east of the edge */
+			mid = (lo + hi) / 2;
+			if (gmt_edge_side (E, x[mid], y) < 0) lo = mid + 1; else hi = mid;
+		}
+		if (reach && y < E->y[1]) {wind[0] += E->dir;	wind[lo] -= E->dir;}	/* Top end points are not counted, as in gmt_inonout_prepared_sub */
+		for (col = lo; col < n && gmt_edge_side (E, x[col], y) == 0; col++);	/* Step over the nodes on the edge */
+		if (lo < col) {on[lo]++;	on[col]--;}
+	}
+	for (col = 0; col < n; col++) {
+		winding += wind[col];
+		n_on += on[col];
+		if (n_on)
+			side[col] = GMT_ONEDGE;
+		else if (winding)
+			side[col] = GMT_INSIDE;
+		else
+			continue;
+		n_set++;
+	}
+	GMT_free (GMT, wind);
+	GMT_free (GMT, on);
+	return (n_set);
+}
+
+uint64_t GMT_inonout_row (struct GMT_CTRL *GMT, struct GMT_PREPARED_POLYGON *P, double y, double *x, uint64_t n, unsigned int *side)
+{	/* Set side[col] to GMT_OUTSIDE, GMT_ONEDGE or GMT_INSIDE for each of the nodes (x[col],y), with x[] increasing.
+	 * This gives the same answers as calling GMT_inonout_prepared for each node, but fills whole spans between
+	 * edge crossings at once.  Returns the number of nodes that are not outside. */
+	uint64_t col, n_set;
+	unsigned int *side_h = NULL;
+	struct GMT_PREPARED_POLYGON *H = NULL;
+
+	if ((n_set = gmt_inonout_row_sub (GMT, P, y, x, n, side)) == 0 || P->next == NULL) return (n_set);
+
+	/* Nodes inside the perimeter must be checked against the holes */
+	side_h = GMT_memory (GMT, NULL, n, unsigned int);
+	for (H = P->next; H; H = H->next) {
+		if (gmt_inonout_row_sub (GMT, H, y, x, n, side_h) == 0) continue;	/* This hole does not reach any nodes */
+		for (col = 0; col < n; col++) {	/* Only nodes still inside are affected, as in GMT_inonout_prepared */
+			if (side[col] != GMT_INSIDE || side_h[col] == GMT_OUTSIDE) continue;
+			side[col] = (side_h[col] == GMT_INSIDE) ? GMT_OUTSIDE : GMT_ONEDGE;
+			if (side[col] == GMT_OUTSIDE) n_set--;
+		}
+	}
+	GMT_free (GMT, side_h);
+	return (n_set);
+}
+
 /* GMT always compiles the standard Delaunay triangulation routine
  * based on the work by Dave Watson.  You may also link with the triangle.o
  * module from Jonathan Shewchuk, Berkeley U. by passing the compiler
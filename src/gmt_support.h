@@ -58,4 +58,29 @@ struct GMT_TEXT_SELECTION {	/* Used to hold array with items (0-n) that have bee
 	bool ogr_match;		/* Compare pattern to an OGR item */
 };
 
+/* Definition of structure used for fast z-to-color lookup in a palette (see GMT_get_zlut) */
+struct GMT_ZLUT {	/* Quantizes the CPT z-range into bins that each know their CPT slice */
+	double z_low;		/* z-value at the start of the first bin */
+	double i_dz;		/* Number of bins per z-unit */
+	unsigned int n;		/* Number of bins */
+	int *index;		/* CPT slice for each bin, or -1 if a slice boundary falls inside the bin */
+};
+
+/* Definition of structures used for repeated in/on/out tests against the same Cartesian polygon (see GMT_prepare_polygon) */
+struct GMT_POLYGON_EDGE {	/* One polygon edge, stored with its lower-y end point first */
+	double x[2], y[2];	/* End points, sorted so that y[0] <= y[1] */
+	int dir;		/* +1 if the path goes up along this edge, -1 if down, 0 if horizontal */
+};
+
+struct GMT_PREPARED_POLYGON {	/* Polygon edges binned into horizontal slabs, plus its holes */
+	double wesn[4];		/* Bounding box of the polygon */
+	double r_dy;		/* Number of slabs per y-unit */
+	unsigned int n_slabs;	/* Number of slabs spanning wesn[YLO] to wesn[YHI] */
+	uint64_t n_edges;	/* Number of edges */
+	uint64_t *start;	/* Offset to the first edge index of each slab; start[n_slabs] is the total */
+	uint64_t *item;		/* Edge indices sorted by slab */
+	struct GMT_POLYGON_EDGE *edge;	/* Array of edges */
+	struct GMT_PREPARED_POLYGON *next;	/* Next hole in this polygon, or NULL */
+};
+
 #endif /* _GMT_SUPPORT_H */
@@ -111,6 +111,8 @@ struct GMT_PLOT {		/* Holds all plotting-related parameters */
 	char format[3][2][GMT_LEN256];	/* Keeps the 6 formats for dd:mm:ss plot output */
 };
 
+struct GMT_GRDPROJ_CACHE;	/* Opaque; defined in gmt_map.c */
+
 struct GMT_CURRENT {
 	/* These are internal parameters that need to be passed around between
 	 * many GMT functions.  These values may change by user interaction. */
@@ -123,6 +125,7 @@ struct GMT_CURRENT {
 	struct GMT_PS ps;		/* Hold parameters related to PS setup */
 	struct GMT_OPTION *options;	/* Pointer to current program's options */
 	struct GMT_FFT_HIDDEN fft;	/* Structure with info that must survive between FFT calls */
+	struct GMT_GRDPROJ_CACHE *grdproj_cache;	/* Lookup tables that GMT_grd_project keeps between calls [NULL] */
 };
 
 struct GMT_INTERNAL {
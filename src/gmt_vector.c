@@ -27,6 +27,22 @@
 
 #define MAX_SWEEPS 50
 
+#define GMT_LU_NB		64	/* Width of the column panels in the blocked LU decomposition */
+#define GMT_LU_TB		256	/* Width of column tiles in trailing matrix updates and solves */
+#define GMT_SVD_JACOBI_MIN	64	/* Use the one-sided Jacobi SVD for matrices with at least this many columns */
+#define GMT_SVD_JACOBI_THREADS	8	/* ...and when at least this many threads are available */
+#define GMT_SVD_JACOBI_SWEEPS	60	/* Give up if the one-sided Jacobi SVD has not converged after this many sweeps */
+#define GMT_MM_RB		32	/* Row block for tiled matrix multiplication */
+#define GMT_MM_KB		128	/* Inner dimension block for tiled matrix multiplication */
+#define GMT_MM_CB		512	/* Column block for tiled matrix multiplication */
+
+#ifdef HAVE_LAPACK
+/* System LAPACK routines (Fortran calling convention, column-major storage) */
+extern void dgetrf_ (int *m, int *n, double *a, int *lda, int *ipiv, int *info);
+extern void dgetrs_ (char *trans, int *n, int *nrhs, double *a, int *lda, int *ipiv, double *b, int *ldb, int *info);
+extern void dgesvd_ (char *jobu, char *jobvt, int *m, int *n, double *a, int *lda, double *s, double *u, int *ldu, double *vt, int *ldvt, double *work, int *lwork, int *info);
+#endif
+
 struct GMT_SINGULAR_VALUE {	/* Used for sorting of eigenvalues in the SVD functions */
 	double value;
 	unsigned int order;
@@ -400,91 +416,161 @@ int GMT_gauss (struct GMT_CTRL *GMT, double *a, double *vec, unsigned int n, uns
 	return (iet + ieb);   /* Return final error flag*/
 }
 
-/* Modified from similar function in Numerical Recipes */
-
-int GMT_gaussjordan (struct GMT_CTRL *GMT, double *a, unsigned int n_in, unsigned int ndim, double *b, unsigned int m_in, unsigned int mdim)
+int GMT_lu_dcmp (struct GMT_CTRL *GMT, double *a, unsigned int n_in, unsigned int ndim, int *ipiv)
 {
-	int i, j, k, l, ll, *ipiv = NULL, *indxc = NULL, *indxr = NULL, irow = 0, icol = 0;
-	int n = n_in, m = m_in;
-	double big, dum, pivinv;
-	
-	ipiv  = GMT_memory (GMT, NULL, n, int);
-	indxc = GMT_memory (GMT, NULL, n, int);
-	indxr = GMT_memory (GMT, NULL, n, int);
-	
-	for (i = 0; i < n; i++) {
-		big = 0.0;
-		for (j = 0; j < n; j++) {
-			if (ipiv[j] != 1) {
-				for (k = 0; k < n; k++) {
-					if (ipiv[k] == 0) {
-						if ((dum = fabs (a[j*ndim+k])) >= big) {
-							big = dum;
-							irow = j;
-							icol = k;
-						}
-					}
-					else if (ipiv[k] > 1) {
-						GMT_Report (GMT->parent, GMT_MSG_NORMAL, "GMT_gaussjordan: Singular matrix!\n");
-						GMT_free (GMT, ipiv);
-						GMT_free (GMT, indxc);
-						GMT_free (GMT, indxr);
-						return (1);
-					}
-				}
+	/* LU decomposition with partial pivoting of the n x n matrix a with row dimension ndim.
+	 * On return, a and ipiv[0..n-1] hold the factors in the form expected by GMT_lu_solv.
+	 * The factorization is done in panels of GMT_LU_NB columns: each panel is factored
+	 * with the classic row-by-row elimination, after which the remainder of the matrix
+	 * is updated with one big matrix product whose cache-sized tiles are shared among
+	 * threads.  If built with LAPACK we let dgetrf do the work instead.
+	 * Returns 1 if the matrix is singular, 0 otherwise. */
+#ifdef HAVE_LAPACK
+	int n = n_in, lda = ndim, info = 0;
+	dgetrf_ (&n, &n, a, &lda, ipiv, &info);	/* Row-major a is seen as A transposed, which GMT_lu_solv accounts for */
+	if (info > 0) {
+		GMT_Report (GMT->parent, GMT_MSG_NORMAL, "GMT_lu_dcmp: Singular matrix!\n");
+		return (1);
+	}
+	return (0);
+#else
+	int64_t n = n_in, ld = ndim, k0, k1, i, j, p, c, t, n_ct, n_rt;
+	double big, piv, l, tmp, *row_i = NULL, *row_j = NULL;
+
+	for (k0 = 0; k0 < n; k0 = k1) {	/* For each panel of columns k0 <= j < k1 */
+		k1 = MIN (k0 + GMT_LU_NB, n);
+
+		/* 1. Unblocked factorization of the panel, i.e., columns k0 to k1-1 in rows k0 and below */
+		for (j = k0; j < k1; j++) {
+			row_j = &a[j*ld];
+			big = fabs (row_j[j]);	p = j;
+			for (i = j + 1; i < n; i++) if ((tmp = fabs (a[i*ld+j])) > big) { big = tmp; p = i; }
+			if (big == 0.0) {
+				GMT_Report (GMT->parent, GMT_MSG_NORMAL, "GMT_lu_dcmp: Singular matrix!\n");
+				return (1);
 			}
-		}
-		ipiv[icol]++;
-		
-		if (irow != icol) {
-			for (l = 0; l < n; l++) {
-				dum = a[irow*ndim+l];
-				a[irow*ndim+l] = a[icol*ndim+l];
-				a[icol*ndim+l] = dum;
+			ipiv[j] = (int)p;
+			if (p != j) {	/* Swap the entire rows j and p */
+				row_i = &a[p*ld];
+				for (c = 0; c < n; c++) { tmp = row_j[c]; row_j[c] = row_i[c]; row_i[c] = tmp; }
 			}
-			for (l = 0; l < m; l++) {
-				dum = b[irow*mdim+l];
-				b[irow*mdim+l] = b[icol*mdim+l];
-				b[icol*mdim+l] = dum;
+			piv = 1.0 / row_j[j];
+			for (i = j + 1; i < n; i++) {	/* Eliminate below the pivot, but only within the panel */
+				row_i = &a[i*ld];
+				l = (row_i[j] *= piv);
+				if (l == 0.0) continue;
+				for (c = j + 1; c < k1; c++) row_i[c] -= l * row_j[c];
 			}
 		}
-		
-		indxr[i] = irow;
-		indxc[i] = icol;
-		if (a[icol*ndim+icol] == 0.0) {
-			GMT_Report (GMT->parent, GMT_MSG_NORMAL, "GMT_gaussjordan: Singular matrix!\n");
-			GMT_free (GMT, ipiv);
-			GMT_free (GMT, indxc);
-			GMT_free (GMT, indxr);
-			return (1);
+		if (k1 == n) break;	/* Last panel; we are done */
+
+		/* 2. Block row of U to the right of the panel: solve L11 * U12 = A12, one column tile per thread */
+		n_ct = (n - k1 + GMT_LU_TB - 1) / GMT_LU_TB;
+#ifdef _OPENMP
+#pragma omp parallel for private(t,i,j,c,l) shared(a,n,ld,k0,k1,n_ct) schedule(static)
+#endif
+		for (t = 0; t < n_ct; t++) {
+			int64_t c0 = k1 + t * GMT_LU_TB, c1 = MIN (c0 + GMT_LU_TB, n);
+			for (i = k0 + 1; i < k1; i++) {
+				for (j = k0; j < i; j++) {
+					if ((l = a[i*ld+j]) == 0.0) continue;
+					for (c = c0; c < c1; c++) a[i*ld+c] -= l * a[j*ld+c];
+				}
+			}
 		}
-		pivinv = 1.0 / a[icol*ndim+icol];
-		a[icol*ndim+icol] = 1.0;
-		for (l = 0; l < n; l++) a[icol*ndim+l] *= pivinv;
-		for (l = 0; l < m; l++)  b[icol*mdim+l] *= pivinv;
-		for (ll = 0; ll < n; ll++) {
-			if (ll != icol) {
-				dum = a[ll*ndim+icol];
-				a[ll*ndim+icol] = 0.0;
-				for (l = 0; l < n; l++) a[ll*ndim+l] -= a[icol*ndim+l] * dum;
-				for (l = 0; l < m; l++) b[ll*mdim+l] -= b[icol*mdim+l] * dum;
+
+		/* 3. Trailing matrix update A22 -= L21 * U12, in tiles of GMT_LU_NB rows by GMT_LU_TB columns */
+		n_rt = (n - k1 + GMT_LU_NB - 1) / GMT_LU_NB;
+#ifdef _OPENMP
+#pragma omp parallel for private(t,i,j,c,l) shared(a,n,ld,k0,k1,n_ct,n_rt) schedule(static)
+#endif
+		for (t = 0; t < n_rt * n_ct; t++) {
+			int64_t r0 = k1 + (t / n_ct) * GMT_LU_NB, r1 = MIN (r0 + GMT_LU_NB, n);
+			int64_t c0 = k1 + (t % n_ct) * GMT_LU_TB, c1 = MIN (c0 + GMT_LU_TB, n);
+			for (i = r0; i < r1; i++) {
+				double *row = &a[i*ld];
+				for (j = k0; j < k1; j++) {
+					const double *u = &a[j*ld];
+					if ((l = row[j]) == 0.0) continue;
+					for (c = c0; c < c1; c++) row[c] -= l * u[c];
+				}
 			}
 		}
 	}
-	for (l = n-1; l >= 0; l--) {
-		if (indxr[l] != indxc[l]) {
-			for (k = 0; k < n; k++) {
-				dum = a[k*ndim+indxr[l]];
-				a[k*ndim+indxr[l]] = a[k*ndim+indxc[l]];
-				a[k*ndim+indxc[l]] = dum;
+	return (0);
+#endif
+}
+
+void GMT_lu_solv (struct GMT_CTRL *GMT, double *a, unsigned int n_in, unsigned int ndim, int *ipiv, double *b, unsigned int m_in, unsigned int mdim)
+{
+	/* Solve A * x = b given the factorization of A from GMT_lu_dcmp.  b holds m right-hand
+	 * sides as its columns (row dimension mdim) and is replaced by the solutions.  Many
+	 * right-hand sides are split into tiles of GMT_LU_TB columns solved in parallel. */
+#ifdef HAVE_LAPACK
+	int n = n_in, m = m_in, lda = ndim, info = 0;
+	unsigned int i, j;
+	char trans[2] = "T";	/* Since LAPACK factored the transpose of our row-major matrix */
+	double *bt = GMT_memory (GMT, NULL, n_in * m_in, double);	/* Right-hand sides in column-major order */
+	for (i = 0; i < n_in; i++) for (j = 0; j < m_in; j++) bt[j*n_in+i] = b[i*mdim+j];
+	dgetrs_ (trans, &n, &m, a, &lda, ipiv, bt, &n, &info);
+	for (i = 0; i < n_in; i++) for (j = 0; j < m_in; j++) b[i*mdim+j] = bt[j*n_in+i];
+	GMT_free (GMT, bt);
+#else
+	int64_t n = n_in, m = m_in, ld = ndim, bd = mdim, t, n_ct, i, j, c;
+	GMT_UNUSED(GMT);
+
+	n_ct = (m + GMT_LU_TB - 1) / GMT_LU_TB;
+#ifdef _OPENMP
+#pragma omp parallel for private(t,i,j,c) shared(a,b,ipiv,n,m,ld,bd,n_ct) schedule(static) if (n_ct > 1)
+#endif
+	for (t = 0; t < n_ct; t++) {
+		int64_t c0 = t * GMT_LU_TB, c1 = MIN (c0 + GMT_LU_TB, m);
+		double l, tmp;
+		for (i = 0; i < n; i++) {	/* Apply the row interchanges in the order they were made */
+			if (ipiv[i] == i) continue;
+			for (c = c0; c < c1; c++) { tmp = b[i*bd+c]; b[i*bd+c] = b[ipiv[i]*bd+c]; b[ipiv[i]*bd+c] = tmp; }
+		}
+		for (i = 1; i < n; i++) {	/* Forward substitution with the unit lower triangle L */
+			for (j = 0; j < i; j++) {
+				if ((l = a[i*ld+j]) == 0.0) continue;
+				for (c = c0; c < c1; c++) b[i*bd+c] -= l * b[j*bd+c];
 			}
 		}
+		for (i = n - 1; i >= 0; i--) {	/* Back substitution with the upper triangle U */
+			for (j = i + 1; j < n; j++) {
+				if ((l = a[i*ld+j]) == 0.0) continue;
+				for (c = c0; c < c1; c++) b[i*bd+c] -= l * b[j*bd+c];
+			}
+			l = 1.0 / a[i*ld+i];
+			for (c = c0; c < c1; c++) b[i*bd+c] *= l;
+		}
 	}
-	
+#endif
+}
+
+int GMT_gaussjordan (struct GMT_CTRL *GMT, double *a, unsigned int n, unsigned int ndim, double *b, unsigned int m, unsigned int mdim)
+{
+	/* Solve A * x = b for the m right-hand sides in b (row dimension mdim) and replace a
+	 * by its inverse.  This used to be the Gauss-Jordan elimination from Numerical Recipes;
+	 * we now get the same results via the blocked LU decomposition and solve the identity
+	 * matrix for the inverse.  Callers that have no use for the inverse should call
+	 * GMT_lu_dcmp and GMT_lu_solv directly as that is about three times less work. */
+	unsigned int i;
+	int *ipiv = GMT_memory (GMT, NULL, n, int);
+	double *inv = NULL;
+
+	if (GMT_lu_dcmp (GMT, a, n, ndim, ipiv)) {
+		GMT_free (GMT, ipiv);
+		return (1);
+	}
+	GMT_lu_solv (GMT, a, n, ndim, ipiv, b, m, mdim);
+	inv = GMT_memory (GMT, NULL, n * n, double);
+	for (i = 0; i < n; i++) inv[i*n+i] = 1.0;
+	GMT_lu_solv (GMT, a, n, ndim, ipiv, inv, n, n);
+	for (i = 0; i < n; i++) GMT_memcpy (&a[i*ndim], &inv[i*n], n, double);
+	GMT_free (GMT, inv);
 	GMT_free (GMT, ipiv);
-	GMT_free (GMT, indxc);
-	GMT_free (GMT, indxr);
-	
+
 	return (0);
 }
 
@@ -500,7 +586,7 @@ int GMT_gaussjordan (struct GMT_CTRL *GMT, double *a, unsigned int n_in, unsigne
 
 #define SIGN(a,b) ((b) >= 0.0 ? fabs(a) : -fabs(a))
 
-int GMT_svdcmp (struct GMT_CTRL *GMT, double *a, unsigned int m_in, unsigned int n_in, double *w, double *v)
+int gmt_svdcmp_nr (struct GMT_CTRL *GMT, double *a, unsigned int m_in, unsigned int n_in, double *w, double *v)
 {
 	/* void svdcmp(double *a,int m,int n,double *w,double *v) */
 	
@@ -716,24 +802,205 @@ int GMT_svdcmp (struct GMT_CTRL *GMT, double *a, unsigned int m_in, unsigned int
 	return (GMT_NOERROR);
 }
 
+unsigned int gmt_jacobi_rotate (double *x, double *y, int64_t m, double *vx, double *vy, int64_t n, double *x2, double *y2, double tol)
+{
+	/* Rotate the pair of vectors x,y (length m) in their plane so they become orthogonal,
+	 * and apply the same rotation to vx,vy (length n).  x2,y2 are the squared lengths of
+	 * x and y and are updated as well.  Returns 1 if a rotation was made and 0 if x and y
+	 * were already orthogonal to within the relative tolerance tol */
+	int64_t i;
+	double alpha = *x2, beta = *y2, gamma = 0.0, zeta, t, c, s, xi, yi;
+
+	if (alpha == 0.0 || beta == 0.0) return (0);
+	for (i = 0; i < m; i++) gamma += x[i] * y[i];
+	if (fabs (gamma) <= tol * sqrt (alpha * beta)) return (0);
+	zeta = (beta - alpha) / (2.0 * gamma);
+	t = SIGN (1.0, zeta) / (fabs (zeta) + sqrt (1.0 + zeta * zeta));	/* The smaller root of t^2 + 2*zeta*t - 1 = 0 */
+	c = 1.0 / sqrt (1.0 + t * t);
+	s = c * t;
+	*x2 = alpha - t * gamma;	/* The new squared lengths */
+	*y2 = beta  + t * gamma;
+	for (i = 0; i < m; i++) {
+		xi = x[i];	yi = y[i];
+		x[i] = c * xi - s * yi;
+		y[i] = s * xi + c * yi;
+	}
+	for (i = 0; i < n; i++) {
+		xi = vx[i];	yi = vy[i];
+		vx[i] = c * xi - s * yi;
+		vy[i] = s * xi + c * yi;
+	}
+	return (1);
+}
+
+int gmt_svdcmp_jacobi (struct GMT_CTRL *GMT, double *a, unsigned int m_in, unsigned int n_in, double *w, double *v)
+{
+	/* One-sided Jacobi SVD (Hestenes' method).  Pairs of columns of A are rotated until
+	 * all columns are mutually orthogonal; their lengths are then the singular values, the
+	 * normalized columns make up U, and the product of all the rotations is V.  We work on
+	 * the transposes so the columns are contiguous in memory.  Each sweep visits all column
+	 * pairs in round-robin order, in which each round consists of n/2 disjoint pairs that
+	 * can be rotated in parallel.  Results are the same as from gmt_svdcmp_nr except that
+	 * the order and signs of singular vectors may differ, which does not affect solutions. */
+	int64_t m = m_in, n = n_in, n_even = n + (n & 1), n_half = n_even / 2, k, i, j, round;
+	unsigned int sweep;
+	uint64_t n_rot = 1;
+	int64_t *player = NULL;
+	double *at = NULL, *vt = NULL, *norm2 = NULL, tol = sqrt ((double)m) * DBL_EPSILON;
+
+	at = GMT_memory (GMT, NULL, n * m, double);
+	vt = GMT_memory (GMT, NULL, n * n, double);
+	player = GMT_memory (GMT, NULL, n_even, int64_t);
+	norm2 = GMT_memory (GMT, NULL, n, double);
+#ifdef _OPENMP
+#pragma omp parallel for private(j,i) shared(a,at,vt,m,n)
+#endif
+	for (j = 0; j < n; j++) {	/* Row j of at is column j of a; vt starts as the identity */
+		for (i = 0; i < m; i++) at[j*m+i] = a[i*n+j];
+		vt[j*n+j] = 1.0;
+	}
+	for (k = 0; k < n_even; k++) player[k] = k;	/* Index n (if n is odd) is a dummy that sits out */
+
+	for (sweep = 0; n_rot && sweep < GMT_SVD_JACOBI_SWEEPS; sweep++) {
+		n_rot = 0;
+#ifdef _OPENMP
+#pragma omp parallel for private(j,i) shared(at,norm2,m,n)
+#endif
+		for (j = 0; j < n; j++) {	/* Fresh squared column lengths each sweep so round-off does not accumulate */
+			norm2[j] = 0.0;
+			for (i = 0; i < m; i++) norm2[j] += at[j*m+i] * at[j*m+i];
+		}
+		for (round = 0; round < n_even - 1; round++) {
+#ifdef _OPENMP
+#pragma omp parallel for private(k,i,j) shared(at,vt,norm2,player,m,n,n_even,n_half,tol) reduction(+:n_rot) schedule(dynamic,1)
+#endif
+			for (k = 0; k < n_half; k++) {
+				i = MIN (player[k], player[n_even-1-k]);
+				j = MAX (player[k], player[n_even-1-k]);
+				if (j >= n) continue;	/* Paired with the dummy */
+				n_rot += gmt_jacobi_rotate (&at[i*m], &at[j*m], m, &vt[i*n], &vt[j*n], n, &norm2[i], &norm2[j], tol);
+			}
+			/* Next round: keep player[0] in place and rotate all the others one position */
+			k = player[n_even-1];
+			for (i = n_even - 1; i > 1; i--) player[i] = player[i-1];
+			player[1] = k;
+		}
+		GMT_Report (GMT->parent, GMT_MSG_DEBUG, "GMT_svdcmp: Sweep %u needed %" PRIu64 " rotations\n", sweep, n_rot);
+	}
+	GMT_free (GMT, player);
+	GMT_free (GMT, norm2);
+	if (n_rot) {
+		GMT_Report (GMT->parent, GMT_MSG_NORMAL, "Error in GMT_svdcmp: No convergence in %d sweeps\n", GMT_SVD_JACOBI_SWEEPS);
+		GMT_free (GMT, at);
+		GMT_free (GMT, vt);
+		return (EXIT_FAILURE);
+	}
+
+#ifdef _OPENMP
+#pragma omp parallel for private(j,i) shared(a,at,vt,w,v,m,n)
+#endif
+	for (j = 0; j < n; j++) {	/* Singular values are the column norms; normalize columns to get U */
+		double norm = 0.0, scale;
+		for (i = 0; i < m; i++) norm += at[j*m+i] * at[j*m+i];
+		w[j] = sqrt (norm);
+		scale = (w[j] > 0.0) ? 1.0 / w[j] : 0.0;
+		for (i = 0; i < m; i++) a[i*n+j] = at[j*m+i] * scale;
+		for (i = 0; i < n; i++) v[i*n+j] = vt[j*n+i];
+	}
+	GMT_free (GMT, at);
+	GMT_free (GMT, vt);
+	return (GMT_NOERROR);
+}
+
+#ifdef HAVE_LAPACK
+int gmt_svdcmp_lapack (struct GMT_CTRL *GMT, double *a, unsigned int m_in, unsigned int n_in, double *w, double *v)
+{
+	/* Our row-major m x n matrix a is LAPACK's column-major n x m matrix A' = V * W * U'.
+	 * Hence dgesvd's left singular vectors are our V and its right singular vectors are
+	 * our U, which it can write straight back into a in the row-major layout we need. */
+	int m = m_in, n = n_in, lwork = -1, info = 0;
+	unsigned int i, k;
+	char jobu[2] = "A", jobvt[2] = "S";
+	double size, *at = NULL, *u = NULL, *work = NULL;
+
+	at = GMT_memory (GMT, NULL, m_in * n_in, double);
+	u  = GMT_memory (GMT, NULL, n_in * n_in, double);
+	GMT_memcpy (at, a, m_in * n_in, double);
+	dgesvd_ (jobu, jobvt, &n, &m, at, &n, w, u, &n, a, &n, &size, &lwork, &info);	/* Workspace query */
+	lwork = (int)size;
+	work = GMT_memory (GMT, NULL, lwork, double);
+	dgesvd_ (jobu, jobvt, &n, &m, at, &n, w, u, &n, a, &n, work, &lwork, &info);
+	for (i = 0; i < n_in; i++) for (k = 0; k < n_in; k++) v[i*n_in+k] = u[k*n_in+i];
+	GMT_free (GMT, work);
+	GMT_free (GMT, u);
+	GMT_free (GMT, at);
+	if (info) {
+		GMT_Report (GMT->parent, GMT_MSG_NORMAL, "Error in GMT_svdcmp: dgesvd returned error %d\n", info);
+		return (EXIT_FAILURE);
+	}
+	return (GMT_NOERROR);
+}
+#endif
+
+int GMT_svdcmp (struct GMT_CTRL *GMT, double *a, unsigned int m, unsigned int n, double *w, double *v)
+{
+	/* Compute the singular value decomposition A = U * W * V' of the m x n matrix a, with
+	 * m >= n.  U replaces a, the singular values are returned in w[0..n-1] (not sorted), and
+	 * V (not V transpose) is returned in v[0..n-1][0..n-1].  We use LAPACK if available,
+	 * else the multithreaded one-sided Jacobi method for large matrices when we have the
+	 * threads, and otherwise the serial Golub-Reinsch algorithm from Numerical Recipes. */
+	if (m < n) {
+		GMT_Report (GMT->parent, GMT_MSG_NORMAL, "Error in GMT_svdcmp: m < n augment A with additional rows\n");
+		return (EXIT_FAILURE);
+	}
+#ifdef HAVE_LAPACK
+	return (gmt_svdcmp_lapack (GMT, a, m, n, w, v));
+#else
+#ifdef _OPENMP
+	/* Jacobi does several times the work of the serial algorithm, so only use it with enough threads */
+	if (n >= GMT_SVD_JACOBI_MIN && omp_get_max_threads () >= GMT_SVD_JACOBI_THREADS) return (gmt_svdcmp_jacobi (GMT, a, m, n, w, v));
+#endif
+	return (gmt_svdcmp_nr (GMT, a, m, n, w, v));
+#endif
+}
+
 void gmt_mat_trans (double a[], unsigned int mrow, unsigned int ncol, double at[])
 {
 	/* Return the transpose of a */
-	unsigned int i, j;
-	for (i = 0; i < ncol; i++) for (j = 0; j < mrow; j++) at[mrow*i+j] = a[ncol*j+i];
+	int64_t i, j;
+#ifdef _OPENMP
+#pragma omp parallel for private(i,j) shared(a,at,mrow,ncol)
+#endif
+	for (i = 0; i < (int64_t)ncol; i++) for (j = 0; j < (int64_t)mrow; j++) at[mrow*i+j] = a[ncol*j+i];
 }
 
 void gmt_mat_mult (double a[], unsigned int mrow, unsigned int ncol, double b[], unsigned int kcol, double c[])
 {
-	/* Matrix multiplication a * b = c */
-	
-	unsigned int i, j, k, ij;
-	
-	for (i = 0; i < kcol; i++) {
-		for (j = 0; j < mrow; j++) {
-			ij = j * kcol + i;
-			c[ij] = 0.0;
-			for (k = 0; k < ncol; k++) c[ij] += a[j * ncol + k] * b[k * kcol + i];
+	/* Matrix multiplication a * b = c.  Done in tiles that fit in cache, with each thread
+	 * handling a block of rows of c.  Each c element still gets its terms added in the
+	 * order k = 0, 1, ..., so results are identical to the plain triple loop. */
+
+	int64_t j0, j, k0, k, i0, i, m = mrow, n = ncol, p = kcol;
+
+#ifdef _OPENMP
+#pragma omp parallel for private(j0,j,k0,k,i0,i) shared(a,b,c,m,n,p) schedule(dynamic,1)
+#endif
+	for (j0 = 0; j0 < m; j0 += GMT_MM_RB) {
+		int64_t j1 = MIN (j0 + GMT_MM_RB, m);
+		for (j = j0; j < j1; j++) for (i = 0; i < p; i++) c[j*p+i] = 0.0;
+		for (k0 = 0; k0 < n; k0 += GMT_MM_KB) {
+			int64_t k1 = MIN (k0 + GMT_MM_KB, n);
+			for (i0 = 0; i0 < p; i0 += GMT_MM_CB) {
+				int64_t i1 = MIN (i0 + GMT_MM_CB, p);
+				for (j = j0; j < j1; j++) {
+					double *c_row = &c[j*p];
+					for (k = k0; k < k1; k++) {
+						double a_jk = a[j*n+k];
+						const double *b_row = &b[k*p];
+						for (i = i0; i < i1; i++) c_row[i] += a_jk * b_row[i];
+					}
+				}
+			}
 		}
 	}
 }
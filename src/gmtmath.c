@@ -34,6 +34,9 @@
 #define THIS_MODULE_PURPOSE	"Reverse Polish Notation (RPN) calculator for data tables"
 
 #include "gmt_dev.h"
+#ifdef HAVE_SYS_TIME_H_
+#include <sys/time.h>
+#endif
 
 #define GMT_PROG_OPTIONS "-:>Vbfghios" GMT_OPT("HMm")
 
@@ -75,6 +78,9 @@ EXTERN_MSC struct GMT_OPTION * gmt_substitute_macros (struct GMT_CTRL *GMT, stru
 
 #define DOUBLE_BIT_MASK (~(1023ULL << 54ULL))	/* This will be 00000000 00111111 11111111 .... and sets to 0 anything larger than 2^53 which is max integer in double */
 
+#define GMTMATH_CHUNK_ROWS	65536U	/* Max rows in a chunk (512 kb per double column) */
+#define GMTMATH_MAX_ARGS	3U	/* Max operands consumed by a chunked operator */
+
 struct GMTMATH_CTRL {	/* All control options for this program (except common args) */
 	/* active is true if the option has been activated */
 	struct Out {	/* = <filename> */
@@ -119,6 +125,12 @@ struct GMTMATH_CTRL {	/* All control options for this program (except common arg
 	} T;
 };
 
+struct GMTMATH_CHUNK {	/* A range of rows within one segment, the unit of work for threads */
+	uint64_t seg;		/* Segment number */
+	uint64_t row;		/* First row in this segment */
+	uint64_t n_rows;	/* Number of rows */
+};
+
 struct GMTMATH_INFO {
 	bool irregular;	/* true if t_inc varies */
 	bool roots_found;	/* true if roots have been solved for */
@@ -129,6 +141,9 @@ struct GMTMATH_INFO {
 	uint64_t r_col;	/* The column used to find roots */
 	uint64_t n_col;	/* Number of columns */
 	double t_min, t_max, t_inc;
+	uint64_t n_chunks;	/* Number of row chunks */
+	struct GMTMATH_CHUNK *chunk;	/* Array of row chunks, none of which straddle a segment boundary */
+	double **coord;		/* Work space for chunk views, GMTMATH_MAX_ARGS+1 sets of n_col pointers per chunk */
 	struct GMT_DATATABLE *T;	/* Table with all time information */
 };
 
@@ -594,6 +609,35 @@ unsigned int gmt_assign_ptrs (struct GMT_CTRL *GMT, unsigned int last, struct GM
 	return prev;
 }
 
+/* Operators that reduce a whole column (or segment) work on chunks of rows in parallel.  Partial
+ * results are combined serially in chunk order, so results do not depend on the number of threads. */
+
+#define gmtmath_chunk_starts_segment(info,k) ((k) == 0 || (info)->chunk[k].seg != (info)->chunk[(k)-1].seg)
+#define gmtmath_chunk_ends_segment(info,k) ((k) + 1 == (info)->n_chunks || (info)->chunk[k].seg != (info)->chunk[(k)+1].seg)
+
+void gmtmath_fill_chunks (struct GMTMATH_INFO *info, struct GMT_DATATABLE *T, unsigned int col, double *value)
+{	/* Set all rows of chunk k in column col to value[k] */
+	int64_t k;
+	uint64_t row;
+	struct GMTMATH_CHUNK *C = NULL;
+
+#ifdef _OPENMP
+#pragma omp parallel for private(k,row,C) shared(info,T,col,value) schedule(static)
+#endif
+	for (k = 0; k < (int64_t)info->n_chunks; k++) {
+		C = &info->chunk[k];
+		for (row = C->row; row < C->row + C->n_rows; row++) T->segment[C->seg]->coord[col][row] = value[k];
+	}
+}
+
+void gmtmath_set_chunk_result (struct GMTMATH_INFO *info, uint64_t k, double *value, double result)
+{	/* Assign result to chunk k and all earlier chunks of the same segment (or all earlier chunks if global) */
+	uint64_t c = k + 1;
+	do {
+		value[--c] = result;
+	} while (c > 0 && !(info->local && gmtmath_chunk_starts_segment (info, c)));
+}
+
 /* -----------------------------------------------------------------
  *              Definitions of all operator functions
  * -----------------------------------------------------------------*/
@@ -2331,30 +2375,40 @@ int table_MAX (struct GMT_CTRL *GMT, struct GMTMATH_INFO *info, struct GMTMATH_S
 int table_MEAN (struct GMT_CTRL *GMT, struct GMTMATH_INFO *info, struct GMTMATH_STACK *S[], unsigned int last, unsigned int col)
 /*OPERATOR: MEAN 1 1 Mean value of A.  */
 {
-	uint64_t s, row, n_a = 0;
-	double sum_a = 0.0;
+	int64_t k;
+	uint64_t s, row, c, n_a = 0, *n = NULL;
+	double sum_a = 0.0, *sum = NULL;
 	struct GMT_DATATABLE *T = S[last]->D->table[0];
+	struct GMTMATH_CHUNK *C = NULL;
 
 	if (S[last]->constant) {	/* Trivial case */
 		for (s = 0; s < info->T->n_segments; s++) for (row = 0; row < info->T->segment[s]->n_rows; row++) T->segment[s]->coord[col][row] = S[last]->factor;
 		return 0;
 	}
 
-	for (s = 0; s < info->T->n_segments; s++) {
-		if (info->local) {sum_a = 0.0; n_a = 0;}
-		for (row = 0; row < info->T->segment[s]->n_rows; row++) {
-			if (GMT_is_dnan (T->segment[s]->coord[col][row])) continue;
-			sum_a += T->segment[s]->coord[col][row];
-			n_a++;
-		}
-		if (info->local) {
-			sum_a = (n_a) ? sum_a / n_a : GMT->session.d_NaN;
-			for (row = 0; row < info->T->segment[s]->n_rows; row++) T->segment[s]->coord[col][row] = sum_a;
+	sum = GMT_memory (GMT, NULL, info->n_chunks, double);
+	n = GMT_memory (GMT, NULL, info->n_chunks, uint64_t);
+#ifdef _OPENMP
+#pragma omp parallel for private(k,row,C) shared(info,T,col,sum,n) schedule(static)
+#endif
+	for (k = 0; k < (int64_t)info->n_chunks; k++) {	/* Partial sums per chunk */
+		C = &info->chunk[k];
+		for (row = C->row; row < C->row + C->n_rows; row++) {
+			if (GMT_is_dnan (T->segment[C->seg]->coord[col][row])) continue;
+			sum[k] += T->segment[C->seg]->coord[col][row];
+			n[k]++;
 		}
 	}
-	if (info->local) return 0;	/* Done with local */
-	sum_a = (n_a) ? sum_a / n_a : GMT->session.d_NaN;
-	for (s = 0; s < info->T->n_segments; s++) for (row = 0; row < info->T->segment[s]->n_rows; row++) T->segment[s]->coord[col][row] = sum_a;
+	for (c = 0; c < info->n_chunks; c++) {
+		if (info->local && gmtmath_chunk_starts_segment (info, c)) {sum_a = 0.0; n_a = 0;}
+		sum_a += sum[c];
+		n_a += n[c];
+		if ((info->local && gmtmath_chunk_ends_segment (info, c)) || c + 1 == info->n_chunks)
+			gmtmath_set_chunk_result (info, c, sum, (n_a) ? sum_a / n_a : GMT->session.d_NaN);
+	}
+	gmtmath_fill_chunks (info, T, col, sum);
+	GMT_free (GMT, sum);
+	GMT_free (GMT, n);
 	return 0;
 }
 
@@ -3115,33 +3169,55 @@ int table_SQRT (struct GMT_CTRL *GMT, struct GMTMATH_INFO *info, struct GMTMATH_
 int table_STD (struct GMT_CTRL *GMT, struct GMTMATH_INFO *info, struct GMTMATH_STACK *S[], unsigned int last, unsigned int col)
 /*OPERATOR: STD 1 1 Standard deviation of A.  */
 {
-	uint64_t s, row, n = 0;
-	double mean = 0.0, sum2 = 0.0, delta;
+	int64_t k;
+	uint64_t s, c, row, n_all = 0, *n = NULL;
+	double mean_all = 0.0, sum2_all = 0.0, delta, *mean = NULL, *sum2 = NULL;
 	struct GMT_DATATABLE *T = S[last]->D->table[0];
+	struct GMTMATH_CHUNK *C = NULL;
 
 	if (S[last]->constant) {	/* Trivial case */
 		for (s = 0; s < info->T->n_segments; s++) GMT_memset (T->segment[s]->coord[col], info->T->segment[s]->n_rows, double);
 		return 0;
 	}
 
-	/* Use Welford (1962) algorithm to compute mean and corrected sum of squares */
-	for (s = 0; s < info->T->n_segments; s++) {
-		if (info->local) {n = 0; mean = sum2 = 0.0;}	/* Start anew for each segment */
-		for (row = 0; row < info->T->segment[s]->n_rows; row++) {
-			if (GMT_is_dnan (T->segment[s]->coord[col][row])) continue;
-			n++;
-			delta = T->segment[s]->coord[col][row] - mean;
-			mean += delta / n;
-			sum2 += delta * (T->segment[s]->coord[col][row] - mean);
+	/* Use Welford (1962) algorithm to compute mean and corrected sum of squares per chunk,
+	 * then merge the chunks with the pairwise update of Chan et al. (1979) */
+	n = GMT_memory (GMT, NULL, info->n_chunks, uint64_t);
+	mean = GMT_memory (GMT, NULL, info->n_chunks, double);
+	sum2 = GMT_memory (GMT, NULL, info->n_chunks, double);
+#ifdef _OPENMP
+#pragma omp parallel for private(k,row,C,delta) shared(info,T,col,n,mean,sum2) schedule(static)
+#endif
+	for (k = 0; k < (int64_t)info->n_chunks; k++) {
+		C = &info->chunk[k];
+		for (row = C->row; row < C->row + C->n_rows; row++) {
+			if (GMT_is_dnan (T->segment[C->seg]->coord[col][row])) continue;
+			n[k]++;
+			delta = T->segment[C->seg]->coord[col][row] - mean[k];
+			mean[k] += delta / n[k];
+			sum2[k] += delta * (T->segment[C->seg]->coord[col][row] - mean[k]);
 		}
-		if (info->local) {
-			sum2 = (n > 1) ? sqrt (sum2 / (n - 1)) : 0.0;
-			for (row = 0; row < info->T->segment[s]->n_rows; row++) T->segment[s]->coord[col][row] = sum2;
+	}
+	for (c = 0; c < info->n_chunks; c++) {
+		if (info->local && gmtmath_chunk_starts_segment (info, c)) {n_all = 0; mean_all = sum2_all = 0.0;}	/* Start anew for each segment */
+		if (n_all == 0) {	/* First chunk with data */
+			n_all = n[c];	mean_all = mean[c];	sum2_all = sum2[c];
+		}
+		else if (n[c]) {
+			delta = mean[c] - mean_all;
+			n_all += n[c];
+			mean_all += delta * n[c] / n_all;
+			sum2_all += sum2[c] + delta * delta * (double)n[c] * (double)(n_all - n[c]) / n_all;
 		}
+		if (info->local && gmtmath_chunk_ends_segment (info, c))
+			gmtmath_set_chunk_result (info, c, mean, (n_all > 1) ? sqrt (sum2_all / (n_all - 1)) : 0.0);
+		else if (!info->local && c + 1 == info->n_chunks)
+			gmtmath_set_chunk_result (info, c, mean, (n_all > 1) ? sqrt (sum2_all / (n_all - 1)) : GMT->session.d_NaN);
 	}
-	if (info->local) return 0;	/* Done with local */
-	sum2 = (n > 1) ? sqrt (sum2 / (n - 1)) : GMT->session.d_NaN;
-	for (s = 0; s < info->T->n_segments; s++) for (row = 0; row < info->T->segment[s]->n_rows; row++) T->segment[s]->coord[col][row] = sum2;
+	gmtmath_fill_chunks (info, T, col, mean);
+	GMT_free (GMT, n);
+	GMT_free (GMT, mean);
+	GMT_free (GMT, sum2);
 	return 0;
 }
 
@@ -3204,20 +3280,44 @@ int table_SUB (struct GMT_CTRL *GMT, struct GMTMATH_INFO *info, struct GMTMATH_S
 int table_SUM (struct GMT_CTRL *GMT, struct GMTMATH_INFO *info, struct GMTMATH_STACK *S[], unsigned int last, unsigned int col)
 /*OPERATOR: SUM 1 1 Cumulative sum of A.  */
 {
-	uint64_t s, row;
-	double a = 0.0, sum = 0.0;
+	int64_t k;
+	uint64_t c, row;
+	double a = 0.0, sum = 0.0, running = 0.0, *offset = NULL;
 	struct GMT_DATATABLE *T = S[last]->D->table[0];
-	GMT_UNUSED(GMT);
+	struct GMTMATH_CHUNK *C = NULL;
 
+	/* Get the sum of each chunk, turn them into the starting offset of each chunk, then accumulate within chunks */
+	offset = GMT_memory (GMT, NULL, info->n_chunks, double);
 	if (S[last]->constant) a = S[last]->factor;
-	for (s = 0; s < info->T->n_segments; s++) {
-		if (info->local) sum = 0.0;	/* Reset for each segment */
-		for (row = 0; row < info->T->segment[s]->n_rows; row++) {
-			if (!S[last]->constant) a = T->segment[s]->coord[col][row];
+#ifdef _OPENMP
+#pragma omp parallel for private(k,row,C) firstprivate(a) shared(info,S,last,T,col,offset) schedule(static)
+#endif
+	for (k = 0; k < (int64_t)info->n_chunks; k++) {
+		C = &info->chunk[k];
+		for (row = C->row; row < C->row + C->n_rows; row++) {
+			if (!S[last]->constant) a = T->segment[C->seg]->coord[col][row];
+			if (!GMT_is_dnan (a)) offset[k] += a;
+		}
+	}
+	for (c = 0; c < info->n_chunks; c++) {
+		if (info->local && gmtmath_chunk_starts_segment (info, c)) running = 0.0;	/* Reset for each segment */
+		sum = offset[c];
+		offset[c] = running;
+		running += sum;
+	}
+#ifdef _OPENMP
+#pragma omp parallel for private(k,row,C,sum) firstprivate(a) shared(info,S,last,T,col,offset) schedule(static)
+#endif
+	for (k = 0; k < (int64_t)info->n_chunks; k++) {
+		C = &info->chunk[k];
+		sum = offset[k];
+		for (row = C->row; row < C->row + C->n_rows; row++) {
+			if (!S[last]->constant) a = T->segment[C->seg]->coord[col][row];
 			if (!GMT_is_dnan (a)) sum += a;
-			T->segment[s]->coord[col][row] = sum;
+			T->segment[C->seg]->coord[col][row] = sum;
 		}
 	}
+	GMT_free (GMT, offset);
 	return 0;
 }
 
@@ -3573,7 +3673,138 @@ void Free_Store (struct GMTAPI_CTRL *API, struct GMTMATH_STORED **recall)
 	}
 }
 
-#define Free_Misc {if (T_in) GMT_Destroy_Data (API, &T_in); GMT_Destroy_Data (API, &Template); GMT_Destroy_Data (API, &Time); if (read_stdin) GMT_Destroy_Data (API, &D_stdin); }
+/* Most operators simply combine values row by row.  For long tables we apply such operators to
+ * chunks of rows, running the chunks in parallel on separate threads.  The operator functions are
+ * called unchanged on one-segment views of their operand tables that only hold the rows of one
+ * chunk, hence results are identical to processing the whole table at once.  Operators that need
+ * neighboring rows, whole columns, random numbers, or report data-dependent warnings are not
+ * chunked this way. */
+
+static char *gmtmath_chunk_ops[] = {"ABS", "ACOS", "ACOSH", "ACOT", "ACSC", "ADD", "AND", "ASEC", "ASIN", "ASINH", "ATAN",
+	"ATAN2", "ATANH", "BEI", "BER", "CEIL", "COS", "COSD", "COSH", "COT", "COTD", "CSC", "CSCD", "D2R", "DILOG", "DIV",
+	"EQ", "ERF", "ERFC", "ERFINV", "EXP", "FLOOR", "FMOD", "GE", "GT", "HYPOT", "I0", "I1", "IFELSE", "INRANGE", "INV",
+	"ISFINITE", "ISNAN", "J0", "J1", "K0", "K1", "KEI", "KER", "LE", "LOG", "LOG10", "LOG1P", "LOG2", "LT", "MAX", "MIN",
+	"MOD", "MUL", "NAN", "NEG", "NEQ", "NOT", "OR", "R2", "R2D", "RINT", "SEC", "SECD", "SIGN", "SIN", "SINC", "SIND",
+	"SINH", "SQR", "SQRT", "STEP", "STEPT", "SUB", "TAN", "TAND", "TANH", "XOR", "Y0", "Y1", "ZCRIT", "ZDIST", NULL};
+
+struct GMTMATH_VIEW {	/* Stack items and tables restricted to the rows of one chunk */
+	struct GMTMATH_STACK item[GMTMATH_MAX_ARGS], *S[GMTMATH_MAX_ARGS];
+	struct GMT_DATASET D[GMTMATH_MAX_ARGS];
+	struct GMT_DATATABLE T[GMTMATH_MAX_ARGS+1], *T_ptr[GMTMATH_MAX_ARGS];	/* Last one is for the time table */
+	struct GMT_DATASEGMENT seg[GMTMATH_MAX_ARGS+1], *seg_ptr[GMTMATH_MAX_ARGS+1];
+};
+
+void gmtmath_set_chunk_ops (char *operator[], unsigned int consumed[], unsigned int produced[], bool chunk_op[])
+{	/* Flag the operators that may be applied chunk by chunk */
+	unsigned int op, k;
+	for (op = 0; op < GMTMATH_N_OPERATORS; op++) {
+		chunk_op[op] = false;
+		if (consumed[op] == 0 || consumed[op] > GMTMATH_MAX_ARGS || produced[op] != 1) continue;
+		for (k = 0; gmtmath_chunk_ops[k] && strcmp (operator[op], gmtmath_chunk_ops[k]); k++);
+		chunk_op[op] = (gmtmath_chunk_ops[k] != NULL);
+	}
+}
+
+void gmtmath_set_chunks (struct GMT_CTRL *GMT, struct GMTMATH_INFO *info)
+{	/* Split the rows of each segment into chunks of at most GMTMATH_CHUNK_ROWS rows */
+	uint64_t s, row, k = 0, n_view = MAX (info->n_col, 2);
+
+	for (s = info->n_chunks = 0; s < info->T->n_segments; s++) info->n_chunks += (info->T->segment[s]->n_rows + GMTMATH_CHUNK_ROWS - 1) / GMTMATH_CHUNK_ROWS;
+	if (info->n_chunks == 0) return;
+	info->chunk = GMT_memory (GMT, NULL, info->n_chunks, struct GMTMATH_CHUNK);
+	info->coord = GMT_memory (GMT, NULL, info->n_chunks * (GMTMATH_MAX_ARGS + 1) * n_view, double *);
+	for (s = 0; s < info->T->n_segments; s++) {
+		for (row = 0; row < info->T->segment[s]->n_rows; row += GMTMATH_CHUNK_ROWS, k++) {
+			info->chunk[k].seg = s;
+			info->chunk[k].row = row;
+			info->chunk[k].n_rows = MIN (GMTMATH_CHUNK_ROWS, info->T->segment[s]->n_rows - row);
+		}
+	}
+}
+
+void gmtmath_set_view (struct GMT_DATATABLE *in, struct GMTMATH_CHUNK *C, uint64_t n_col, double **coord, struct GMT_DATASEGMENT *S, struct GMT_DATASEGMENT **S_ptr, struct GMT_DATATABLE *T)
+{	/* Make T a one-segment table whose columns point to the rows of chunk C in table in */
+	uint64_t col;
+
+	n_col = MIN (n_col, in->n_columns);
+	for (col = 0; col < n_col; col++) coord[col] = (in->segment[C->seg]->coord[col]) ? in->segment[C->seg]->coord[col] + C->row : NULL;
+	GMT_memset (S, 1, struct GMT_DATASEGMENT);
+	GMT_memset (T, 1, struct GMT_DATATABLE);
+	S->n_rows = C->n_rows;
+	S->n_columns = n_col;
+	S->coord = coord;
+	*S_ptr = S;
+	T->n_columns = n_col;
+	T->n_segments = 1;
+	T->n_records = C->n_rows;
+	T->segment = S_ptr;
+}
+
+int gmtmath_run_chunk (struct GMT_CTRL *GMT, struct GMTMATH_INFO *info, struct GMTMATH_STACK *S[], unsigned int n_args, unsigned int op, bool skip[], uint64_t n_columns, int (*call_operator[]) (struct GMT_CTRL *, struct GMTMATH_INFO *, struct GMTMATH_STACK **, unsigned int, unsigned int), uint64_t k)
+{	/* Apply operator op to the rows of chunk k in all active columns.  S points to the first of the n_args operands */
+	int status = 0;
+	unsigned int arg;
+	uint64_t col, n_view = MAX (info->n_col, 2);
+	double **coord = &info->coord[k * (GMTMATH_MAX_ARGS + 1) * n_view];
+	struct GMTMATH_INFO chunk_info = *info;
+	struct GMTMATH_VIEW V;
+
+	gmtmath_set_view (info->T, &info->chunk[k], 2, coord, &V.seg[GMTMATH_MAX_ARGS], &V.seg_ptr[GMTMATH_MAX_ARGS], &V.T[GMTMATH_MAX_ARGS]);
+	chunk_info.T = &V.T[GMTMATH_MAX_ARGS];
+	for (arg = 0; arg < n_args; arg++) {	/* Operands are copied since some operators temporarily change them */
+		V.item[arg] = *S[arg];
+		V.S[arg] = &V.item[arg];
+		if (!S[arg]->D) continue;
+		coord += n_view;
+		gmtmath_set_view (S[arg]->D->table[0], &info->chunk[k], n_view, coord, &V.seg[arg], &V.seg_ptr[arg], &V.T[arg]);
+		GMT_memset (&V.D[arg], 1, struct GMT_DATASET);
+		V.T_ptr[arg] = &V.T[arg];
+		V.D[arg].n_tables = 1;
+		V.D[arg].n_columns = V.T[arg].n_columns;
+		V.D[arg].table = &V.T_ptr[arg];
+		V.item[arg].D = &V.D[arg];
+	}
+	for (col = 0; col < n_columns && status == 0; col++) {
+		if (skip[col]) continue;
+		status = (*call_operator[op]) (GMT, &chunk_info, V.S, n_args - 1, (unsigned int)col);
+	}
+	return (status);
+}
+
+int gmtmath_run_chunks (struct GMT_CTRL *GMT, struct GMTMATH_INFO *info, struct GMTMATH_STACK *S[], unsigned int n_args, unsigned int op, bool skip[], uint64_t n_columns, int (*call_operator[]) (struct GMT_CTRL *, struct GMTMATH_INFO *, struct GMTMATH_STACK **, unsigned int, unsigned int))
+{	/* Apply operator op chunk by chunk, in parallel if possible */
+	int status, n_errors = 0;
+	int64_t k;
+	unsigned int verbose[2];
+
+	/* Do the first chunk alone so any warnings about constant operands are issued once, then silence the rest */
+	if ((status = gmtmath_run_chunk (GMT, info, S, n_args, op, skip, n_columns, call_operator, 0))) return (status);
+	verbose[0] = GMT->current.setting.verbose;	verbose[1] = GMT->parent->verbose;
+	GMT->current.setting.verbose = GMT->parent->verbose = GMT_MSG_QUIET;
+#ifdef _OPENMP
+#pragma omp parallel for private(k) shared(GMT,info,S,n_args,op,skip,n_columns,call_operator) reduction(+:n_errors) schedule(static)
+#endif
+	for (k = 1; k < (int64_t)info->n_chunks; k++) {
+		if (gmtmath_run_chunk (GMT, info, S, n_args, op, skip, n_columns, call_operator, (uint64_t)k)) n_errors++;
+	}
+	GMT->current.setting.verbose = verbose[0];	GMT->parent->verbose = verbose[1];
+	return ((n_errors) ? -1 : 0);
+}
+
+double gmtmath_wall_time (void)
+{	/* Elapsed wall-clock time in seconds, used to time operators */
+#ifdef _OPENMP
+	return (omp_get_wtime ());
+#elif defined HAVE_SYS_TIME_H_
+	struct timeval tv;
+	gettimeofday (&tv, NULL);
+	return ((double)tv.tv_sec + 1.0e-6 * tv.tv_usec);
+#else	/* Only whole seconds, but clock () would give CPU time */
+	return ((double)time (NULL));
+#endif
+}
+
+#define Free_Misc {if (T_in) GMT_Destroy_Data (API, &T_in); GMT_Destroy_Data (API, &Template); GMT_Destroy_Data (API, &Time); if (read_stdin) GMT_Destroy_Data (API, &D_stdin); if (info.chunk) GMT_free (GMT, info.chunk); if (info.coord) GMT_free (GMT, info.coord); }
 #define bailout(code) {GMT_Free_Options (mode); return (code);}
 #define Return1(code) {GMT_Destroy_Options (API, &list); Free_gmtmath_Ctrl (GMT, Ctrl); GMT_end_module (GMT, GMT_cpy); bailout (code); }
 #define Return(code) {GMT_Destroy_Options (API, &list); Free_gmtmath_Ctrl (GMT, Ctrl); Free_Stack(API,stack); Free_Store(API,recall); Free_Misc;  GMT_end_module (GMT, GMT_cpy); bailout (code); }
@@ -3658,12 +3889,15 @@ int GMT_gmtmath (void *V_API, int mode, void *args)
 	unsigned int consumed_operands[GMTMATH_N_OPERATORS], produced_operands[GMTMATH_N_OPERATORS], new_stack = INT_MAX;
 	unsigned int j, nstack = 0, n_stored = 0, kk;
 	bool error = false, set_equidistant_t = false, got_t_from_file = false, free_time = false;
-	bool read_stdin = false, t_check_required = true, touched_t_col = false, done, no_C = true;
+	bool read_stdin = false, t_check_required = true, touched_t_col = false, done, no_C = true, timing;
+	bool chunk_op[GMTMATH_N_OPERATORS];
 	uint64_t use_t_col = 0, row, n_records, n_rows = 0, n_columns = 0, seg;
 	
 	uint64_t dim[4] = {1, 1, 0, 0};
 
 	double t_noise = 0.0, value, off, scale, special_symbol[GMTMATH_ARG_IS_PI-GMTMATH_ARG_IS_N+1];
+	double tic = 0.0, op_time[GMTMATH_N_OPERATORS];
+	unsigned int op_count[GMTMATH_N_OPERATORS];
 
 	char *label = NULL;
 #include "gmtmath_op.h"
@@ -3888,6 +4122,7 @@ int GMT_gmtmath (void *V_API, int mode, void *args)
 	info.n_col = n_columns;		info.local = Ctrl->L.active;
 	info.notime = Ctrl->T.notime;
 	GMT_set_tbl_minmax (GMT, info.T);
+	gmtmath_set_chunks (GMT, &info);
 
 	if (Ctrl->A.active) {
 		if (!stack[0]->D) {
@@ -3912,6 +4147,11 @@ int GMT_gmtmath (void *V_API, int mode, void *args)
 	special_symbol[GMTMATH_ARG_IS_PI-GMTMATH_ARG_IS_N] = (double)n_records;
 
 	gmtmath_init (call_operator, consumed_operands, produced_operands);
+	gmtmath_set_chunk_ops (operator, consumed_operands, produced_operands, chunk_op);
+	if ((timing = GMT_is_verbose (GMT, GMT_MSG_TICTOC))) {	/* Report time spent in each operator */
+		GMT_memset (op_time, GMTMATH_N_OPERATORS, double);
+		GMT_memset (op_count, GMTMATH_N_OPERATORS, unsigned int);
+	}
 	op = decode_gmt_argument (GMT, "EXCH", &value, localhashnode);
 	consumed_operands[op] = produced_operands[op] = 0;	/* Modify items since we simply swap pointers */
 
@@ -4132,13 +4372,22 @@ int GMT_gmtmath (void *V_API, int mode, void *args)
 			Return (EXIT_SUCCESS);
 		}
 
-		for (j = 0; j < n_columns; j++) {
-			if (Ctrl->C.cols[j]) continue;
-			status = (*call_operator[op]) (GMT, &info, stack, nstack - 1, j);	/* Do it */
-			if (status == -1) {	/* Serious problem, need to bail */
-				GMT_exit (GMT, EXIT_FAILURE); Return (EXIT_FAILURE);
+		if (timing) tic = gmtmath_wall_time ();
+		if (chunk_op[op] && info.n_chunks > 1)	/* Row by row operator on a long table; do chunks of rows in parallel */
+			status = gmtmath_run_chunks (GMT, &info, &stack[nstack-consumed_operands[op]], consumed_operands[op], op, Ctrl->C.cols, n_columns, call_operator);
+		else {
+			for (j = 0, status = 0; j < n_columns && status != -1; j++) {
+				if (Ctrl->C.cols[j]) continue;
+				status = (*call_operator[op]) (GMT, &info, stack, nstack - 1, j);	/* Do it */
 			}
 		}
+		if (status == -1) {	/* Serious problem, need to bail */
+			GMT_exit (GMT, EXIT_FAILURE); Return (EXIT_FAILURE);
+		}
+		if (timing) {
+			op_time[op] += gmtmath_wall_time () - tic;
+			op_count[op]++;
+		}
 
 		nstack = new_stack;
 
@@ -4165,6 +4414,15 @@ int GMT_gmtmath (void *V_API, int mode, void *args)
 
 	if (GMT_is_verbose (GMT, GMT_MSG_VERBOSE)) GMT_Message (API, GMT_TIME_NONE, "\n");
 
+	if (timing) {	/* Report operator throughput in column values processed per second */
+		for (j = 0, kk = 0; j < n_columns; j++) if (!Ctrl->C.cols[j]) kk++;
+		for (k = 0; k < GMTMATH_N_OPERATORS; k++) {
+			if (op_count[k] == 0) continue;
+			GMT_Report (API, GMT_MSG_TICTOC, "%-10s %4u calls %12.6f s %12.4g values/s\n", operator[k], op_count[k], op_time[k],
+				(op_time[k] > 0.0) ? (double)op_count[k] * n_records * kk / op_time[k] : 0.0);
+		}
+	}
+
 	if (info.roots_found) {	/* Special treatment of root finding */
 		struct GMT_DATASEGMENT *S = stack[0]->D->table[0]->segment[0];
 		uint64_t dim[4] = {1, 1, 0, 1};
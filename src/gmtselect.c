@@ -55,10 +55,20 @@
 #define F_ITEM	0
 #define N_ITEM	1
 
+#define GMTSELECT_N_BUF	65536U	/* Number of input records tested together */
+
 struct GMTSELECT_DATA {	/* Used for temporary storage when sorting data on x coordinate */
 	double x, y, d;
 };
 
+struct GMTSELECT_RECORD {	/* Buffered input record */
+	double *in;		/* Copy of the numerical columns */
+	char *text;		/* Copy of the ascii record (plus any aspatial fields) if we just copy records */
+	double x, y;		/* Coordinates used by the -C -L -F tests (projected if -J was given) */
+	unsigned int n_alloc;	/* Allocated length of in */
+	bool keep;		/* false once the record has failed one of the tests */
+};
+
 struct GMTSELECT_ZLIMIT {	/* Used to hold info for each -Z option given */
 	unsigned int col;	/* Column to test */
 	bool equal;	/* Just check if z == min withing 5 ULps */
@@ -486,20 +496,24 @@ int GMT_gmtselect (void *V_API, int mode, void *args)
 {
 	int err;	/* Required by GMT_err_fail */
 	unsigned int base = 3, np[2] = {0, 0}, r_mode;
-	unsigned int side, col, id;
+	unsigned int side, col, id, got;
 	int n_fields, ind, wd[2] = {0, 0}, n_minimum = 2, bin, last_bin = INT_MAX, error = 0;
 	bool inside = false, need_header = false, shuffle, just_copy_record = false, pt_cartesian = false;
-	bool output_header = false, do_project = false, no_resample = false, keep;
+	bool output_header = false, do_project = false, no_resample = false, keep, bad_record = false;
 
-	uint64_t k, row, seg, n_read = 0, n_pass = 0, n_output = 0;
+	uint64_t k, row, seg, n_read = 0, n_pass = 0, n_output = 0, n_buf, n_copy;
+	int64_t b;
 
 	double xx, yy, *in = NULL;
 	double west_border = 0.0, east_border = 0.0, xmin, xmax, ymin, ymax, lon;
 
 	char *shore_resolution[5] = {"full", "high", "intermediate", "low", "crude"};
-	char extra[GMT_BUFSIZ] = {""};
+	char extra[GMT_BUFSIZ] = {""}, segment_header[GMT_BUFSIZ] = {""};
 
 	struct GMT_DATATABLE *pol = NULL, *line = NULL, *point = NULL;
+	struct GMT_DIST_INDEX *point_index = NULL, *line_index = NULL;
+	struct GMT_PREPARED_POLYGON **pol_prep = NULL;
+	struct GMTSELECT_RECORD *R = NULL;
 	struct GMT_GSHHS_POL *p[2] = {NULL, NULL};
 	struct GMT_SHORE c;
 	struct GMT_DATASET *Cin = NULL, *Lin = NULL, *Fin = NULL;
@@ -641,6 +655,7 @@ int GMT_gmtselect (void *V_API, int mode, void *args)
 			}
 			GMT_free (GMT, data);
 		}
+		point_index = GMT_create_dist_index (GMT, point, false, Ctrl->C.dist);	/* NULL if the distance mode cannot be indexed */
 	}
 
 	if (Ctrl->L.active) {	/* Initialize lines structure used in test for proximity to lines [use Ctrl->L.dist, ] */
@@ -662,6 +677,7 @@ int GMT_gmtselect (void *V_API, int mode, void *args)
 				}
 			}
 		}
+		line_index = GMT_create_dist_index (GMT, line, true, 0.0);	/* NULL if the distance mode cannot be indexed */
 	}
 	if (Ctrl->F.active) {	/* Initialize polygon structure used in test for polygon in/out test */
 		GMT_skip_xy_duplicates (GMT, true);	/* Avoid repeating x/y points in polygons */
@@ -683,6 +699,13 @@ int GMT_gmtselect (void *V_API, int mode, void *args)
 				}
 			}
 		}
+		if (do_project || !GMT_is_geographic (GMT, GMT_IN)) {	/* Cartesian polygons: bin their edges for faster in/out tests */
+			pol_prep = GMT_memory (GMT, NULL, pol->n_segments, struct GMT_PREPARED_POLYGON *);
+			for (seg = 0; seg < pol->n_segments; seg++) {
+				if (GMT_polygon_is_hole (pol->segment[seg])) continue;	/* Holes are prepared along with their perimeter */
+				pol_prep[seg] = GMT_prepare_segment (GMT, pol->segment[seg]);
+			}
+		}
 	}
 	
 	/* Specify input and output expected columns */
@@ -710,177 +733,237 @@ int GMT_gmtselect (void *V_API, int mode, void *args)
 	r_mode = (just_copy_record) ? GMT_READ_MIXED : GMT_READ_DOUBLE;
 	GMT_set_segmentheader (GMT, GMT_OUT, false);	/* Since processing of -C|L|F files might have turned it on [should be determined below] */
 	
+	R = GMT_memory (GMT, NULL, GMTSELECT_N_BUF, struct GMTSELECT_RECORD);
+
 	do {	/* Keep returning records until we reach EOF */
-		if ((in = GMT_Get_Record (API, r_mode, &n_fields)) == NULL) {	/* Read next record, get NULL if special case */
-			if (GMT_REC_IS_ERROR (GMT)) 		/* Bail if there are any read errors */
-				Return (GMT_RUNTIME_ERROR);
-			if (GMT_REC_IS_TABLE_HEADER (GMT)) {	/* Echo table headers */
-				GMT_Put_Record (API, GMT_WRITE_TABLE_HEADER, NULL);
-				continue;
-			}
-			if (GMT_REC_IS_EOF (GMT)) 		/* Reached end of file */
-				break;
-			else if (GMT_REC_IS_SEGMENT_HEADER (GMT)) {
-				output_header = true;
-				need_header = GMT->current.io.multi_segments[GMT_OUT];	/* Only need to break up segments */
+		/* Buffer up to GMTSELECT_N_BUF data records, stopping early at headers or EOF so these are handled in order.
+		 * The cheap -Z and -R tests are done as records are read, the -C, -L, and -F tests are then done for
+		 * all buffered records in parallel, and finally the -N tests and output follow in the original order. */
+		got = GMT_IO_DATA_RECORD;
+		n_buf = 0;
+		while (n_buf < GMTSELECT_N_BUF) {
+			if ((in = GMT_Get_Record (API, r_mode, &n_fields)) == NULL) {	/* Read next record, get NULL if special case */
+				if (GMT_REC_IS_ERROR (GMT)) 		/* Bail if there are any read errors */
+					Return (GMT_RUNTIME_ERROR);
+				if (GMT_REC_IS_TABLE_HEADER (GMT)) {	/* Echo table headers after the buffered records */
+					got = GMT_IO_TABLE_HEADER;
+					break;
+				}
+				if (GMT_REC_IS_EOF (GMT)) {		/* Reached end of file */
+					got = GMT_IO_EOF;
+					break;
+				}
+				else if (GMT_REC_IS_SEGMENT_HEADER (GMT)) {	/* Handle segment headers after the buffered records */
+					got = GMT_IO_SEGMENT_HEADER;
+					break;
+				}
 				continue;
 			}
-		}
-		
-		/* Data record to process */
 
-		if (n_output == 0) {
-			GMT_set_cols (GMT, GMT_OUT, GMT_get_cols (GMT, GMT_IN));
-			n_output = GMT_get_cols (GMT, GMT_OUT);
-		}
+			/* Data record to buffer */
 
-		n_read++;
-		if (n_read%1000 == 0) GMT_Report (API, GMT_MSG_LONG_VERBOSE, "Read %" PRIu64 " records, passed %" PRIu64 "records\r", n_read, n_pass);
+			if (n_output == 0) {
+				GMT_set_cols (GMT, GMT_OUT, GMT_get_cols (GMT, GMT_IN));
+				n_output = GMT_get_cols (GMT, GMT_OUT);
+			}
 
-		if (n_fields < n_minimum) {	/* Bad number of columns */
-			if (Ctrl->Z.active)
-				GMT_Report (API, GMT_MSG_NORMAL, "-Z requires a data file with at least %u columns; this file only has %d near line %" PRIu64 ". Exiting.\n", n_minimum, n_fields, n_read);
-			else
-				GMT_Report (API, GMT_MSG_NORMAL, "Data file must have at least 2 columns; this file only has %d near line %" PRIu64 ". Exiting.\n", n_fields, n_read);
-			Return (EXIT_FAILURE);
-		}
+			n_read++;
+			if (n_read%1000 == 0) GMT_Report (API, GMT_MSG_LONG_VERBOSE, "Read %" PRIu64 " records, passed %" PRIu64 "records\r", n_read, n_pass);
 
-		if (Ctrl->Z.active) {	/* Apply z-range test(s) */
-			for (k = 0, keep = true; keep && k < Ctrl->Z.n_tests; k++) {
-				col = Ctrl->Z.limit[k].col;			/* Shorthand notation */
-				if (GMT_is_dnan (in[col]))
-					keep = true;		/* Make no decision on NaNs here; see -s instead */
-				else if (Ctrl->Z.limit[k].equal)
-					inside = doubleAlmostEqualZero (in[col], Ctrl->Z.limit[k].min);
+			if (n_fields < n_minimum) {	/* Bad number of columns */
+				if (Ctrl->Z.active)
+					GMT_Report (API, GMT_MSG_NORMAL, "-Z requires a data file with at least %u columns; this file only has %d near line %" PRIu64 ". Exiting.\n", n_minimum, n_fields, n_read);
 				else
-					inside = (in[col] >= Ctrl->Z.limit[k].min && in[col] <= Ctrl->Z.limit[k].max); 
-				if (inside != Ctrl->I.pass[5]) keep = false;
+					GMT_Report (API, GMT_MSG_NORMAL, "Data file must have at least 2 columns; this file only has %d near line %" PRIu64 ". Exiting.\n", n_fields, n_read);
+				bad_record = true;	/* Finish the records we already have, then exit */
+				got = GMT_IO_EOF;
+				break;
 			}
-			if (!keep) { output_header = need_header; continue;}
-		}
 
-		lon = in[GMT_X];	/* Use copy since we may have to wrap 360 */
-		if (GMT->common.R.active) {	/* Apply region test */
-			inside = !GMT_map_outside (GMT, lon, in[GMT_Y]);
-			if (inside != Ctrl->I.pass[0]) { output_header = need_header; continue;}
-		}
+			n_copy = MAX ((uint64_t)n_fields, n_output);
+			if (n_copy > R[n_buf].n_alloc) {
+				R[n_buf].n_alloc = (unsigned int)n_copy;
+				R[n_buf].in = GMT_memory (GMT, R[n_buf].in, R[n_buf].n_alloc, double);
+			}
+			GMT_memcpy (R[n_buf].in, in, n_copy, double);
+			if (just_copy_record) {	/* Want to (or can) do text output */
+				if (GMT->common.a.active) {	/* Add selected aspatial fields to output record */
+					gmt_ogr_to_text (GMT, GMT->current.io.OGR, extra);
+					strcat (API->GMT->current.io.current_record, extra);
+				}
+				R[n_buf].text = strdup (API->GMT->current.io.current_record);
+			}
+			R[n_buf].keep = true;
+
+			if (Ctrl->Z.active) {	/* Apply z-range test(s) */
+				for (k = 0, keep = true; keep && k < Ctrl->Z.n_tests; k++) {
+					col = Ctrl->Z.limit[k].col;			/* Shorthand notation */
+					if (GMT_is_dnan (in[col]))
+						keep = true;		/* Make no decision on NaNs here; see -s instead */
+					else if (Ctrl->Z.limit[k].equal)
+						inside = doubleAlmostEqualZero (in[col], Ctrl->Z.limit[k].min);
+					else
+						inside = (in[col] >= Ctrl->Z.limit[k].min && in[col] <= Ctrl->Z.limit[k].max); 
+					if (inside != Ctrl->I.pass[5]) keep = false;
+				}
+				R[n_buf].keep = keep;
+			}
 
-		if (do_project)	/* First project the input point */
-			GMT_geo_to_xy (GMT, lon, in[GMT_Y], &xx, &yy);
-		else {
-			xx = lon;
-			yy = in[GMT_Y];
-		}
-		
-		if (Ctrl->C.active) {	/* Check for distance to points */
-			inside = GMT_near_a_point (GMT, xx, yy, point, Ctrl->C.dist); 
-			if (inside != Ctrl->I.pass[1]) { output_header = need_header; continue;}
-		}
+			lon = in[GMT_X];	/* Use copy since we may have to wrap 360 */
+			if (R[n_buf].keep && GMT->common.R.active) {	/* Apply region test */
+				inside = !GMT_map_outside (GMT, lon, in[GMT_Y]);
+				if (inside != Ctrl->I.pass[0]) R[n_buf].keep = false;
+			}
 
-		if (Ctrl->L.active) {	/* Check for distance to lines */
-			inside = GMT_near_lines (GMT, xx, yy, line, Ctrl->L.end_mode, NULL, NULL, NULL);
-			if (inside != Ctrl->I.pass[2]) { output_header = need_header; continue;}
-		}
-		if (Ctrl->F.active) {	/* Check if we are in/out-side polygons */
-			if (do_project)	/* Projected lon/lat; temporary reset input type for GMT_inonout to do Cartesian mode */
-				GMT_set_cartesian (GMT, GMT_IN);
-			inside = 0;
-			for (seg = 0; seg < pol->n_segments && !inside; seg++) {	/* Check each polygon until we find that our point is inside */
-				if (GMT_polygon_is_hole (pol->segment[seg])) continue;	/* Holes are handled within GMT_inonout */
-				inside = (GMT_inonout (GMT, xx, yy, pol->segment[seg]) >= Ctrl->E.inside[F_ITEM]);
+			if (!R[n_buf].keep)	/* No need to project */
+				R[n_buf].x = R[n_buf].y = 0.0;
+			else if (do_project)	/* First project the input point */
+				GMT_geo_to_xy (GMT, lon, in[GMT_Y], &R[n_buf].x, &R[n_buf].y);
+			else {
+				R[n_buf].x = lon;
+				R[n_buf].y = in[GMT_Y];
 			}
-			if (do_project)	/* Reset input type for GMT_inonout to do Cartesian mode */
-				GMT_set_geographic (GMT, GMT_IN);
-			if (inside != Ctrl->I.pass[3]) { output_header = need_header; continue;}
+			n_buf++;
 		}
 
-		if (Ctrl->N.active) {	/* Check if on land or not */
-			int brow, i, this_node;
-			xx = lon;
-			while (xx < 0.0) xx += 360.0;
-			brow = irint (floor ((90.0 - in[GMT_Y]) / c.bsize));
-			if (brow >= c.bin_ny) brow = c.bin_ny - 1;	/* Presumably only kicks in for south pole */
-			col = urint (floor (xx / c.bsize));
-			bin = brow * c.bin_nx + col;
-			if (bin != last_bin) {	/* Do this upon entering new bin */
-				ind = 0;
-				while (ind < c.nb && c.bins[ind] != bin) ind++;	/* Set ind to right bin */
-				if (ind == c.nb) continue;			/* Bin not among the chosen ones */
-				last_bin = bin;
-				GMT_free_shore (GMT, &c);	/* Free previously allocated arrays */
-				if ((err = GMT_get_shore_bin (GMT, ind, &c))) {
-					GMT_Report (API, GMT_MSG_NORMAL, "%s [%s resolution shoreline]\n", GMT_strerror(err), shore_resolution[base]);
-					Return (EXIT_FAILURE);
-				}
+		/* Apply the distance and polygon tests to the buffered records in parallel */
 
-				/* Must use polygons.  Go in both directions to cover both land and sea */
-				for (id = 0; id < 2; id++) {
-					GMT_free_shore_polygons (GMT, p[id], np[id]);
-					if (np[id]) GMT_free (GMT, p[id]);
-					np[id] = GMT_assemble_shore (GMT, &c, wd[id], true, west_border, east_border, &p[id]);
-					np[id] = GMT_prep_shore_polygons (GMT, &p[id], np[id], !no_resample, Ctrl->dbg.step, -1);
+		if (Ctrl->F.active && do_project)	/* Projected lon/lat; temporary reset input type for GMT_inonout to do Cartesian mode */
+			GMT_set_cartesian (GMT, GMT_IN);
+#ifdef _OPENMP
+		/* Only the projected case needs the (not thread-safe) map projection machinery in GMT_distance */
+#pragma omp parallel for private(b,seg,inside) shared(GMT,Ctrl,R,n_buf,point,line,pol,pol_prep,point_index,line_index) schedule(dynamic,256) if (!do_project)
+#endif
+		for (b = 0; b < (int64_t)n_buf; b++) {
+			if (!R[b].keep) continue;
+			if (Ctrl->C.active) {	/* Check for distance to points */
+				if (point_index)
+					inside = GMT_near_a_point_indexed (GMT, R[b].x, R[b].y, point_index, Ctrl->C.dist);
+				else
+					inside = GMT_near_a_point (GMT, R[b].x, R[b].y, point, Ctrl->C.dist);
+				if (inside != Ctrl->I.pass[1]) { R[b].keep = false; continue;}
+			}
+			if (Ctrl->L.active) {	/* Check for distance to lines */
+				if (line_index)
+					inside = GMT_near_lines_indexed (GMT, R[b].x, R[b].y, line_index, Ctrl->L.end_mode);
+				else
+					inside = GMT_near_lines (GMT, R[b].x, R[b].y, line, Ctrl->L.end_mode, NULL, NULL, NULL);
+				if (inside != Ctrl->I.pass[2]) { R[b].keep = false; continue;}
+			}
+			if (Ctrl->F.active) {	/* Check if we are in/out-side polygons */
+				inside = 0;
+				for (seg = 0; seg < pol->n_segments && !inside; seg++) {	/* Check each polygon until we find that our point is inside */
+					if (GMT_polygon_is_hole (pol->segment[seg])) continue;	/* Holes are handled within GMT_inonout */
+					if (pol_prep)
+						inside = (GMT_inonout_prepared (GMT, R[b].x, R[b].y, pol_prep[seg]) >= Ctrl->E.inside[F_ITEM]);
+					else
+						inside = (GMT_inonout (GMT, R[b].x, R[b].y, pol->segment[seg]) >= Ctrl->E.inside[F_ITEM]);
 				}
+				if (inside != Ctrl->I.pass[3]) R[b].keep = false;
 			}
+		}
+		if (Ctrl->F.active && do_project)	/* Reset input type for GMT_inonout to do Cartesian mode */
+			GMT_set_geographic (GMT, GMT_IN);
+
+		for (b = 0; b < (int64_t)n_buf; b++) {	/* Finish and output the records in the original order */
+			if (!R[b].keep) { output_header = need_header; continue;}
+			in = R[b].in;
+			lon = in[GMT_X];
+
+			if (Ctrl->N.active) {	/* Check if on land or not */
+				int brow, i, this_node;
+				xx = lon;
+				while (xx < 0.0) xx += 360.0;
+				brow = irint (floor ((90.0 - in[GMT_Y]) / c.bsize));
+				if (brow >= c.bin_ny) brow = c.bin_ny - 1;	/* Presumably only kicks in for south pole */
+				col = urint (floor (xx / c.bsize));
+				bin = brow * c.bin_nx + col;
+				if (bin != last_bin) {	/* Do this upon entering new bin */
+					ind = 0;
+					while (ind < c.nb && c.bins[ind] != bin) ind++;	/* Set ind to right bin */
+					if (ind == c.nb) continue;			/* Bin not among the chosen ones */
+					last_bin = bin;
+					GMT_free_shore (GMT, &c);	/* Free previously allocated arrays */
+					if ((err = GMT_get_shore_bin (GMT, ind, &c))) {
+						GMT_Report (API, GMT_MSG_NORMAL, "%s [%s resolution shoreline]\n", GMT_strerror(err), shore_resolution[base]);
+						Return (EXIT_FAILURE);
+					}
 
-			if (c.ns == 0) {	/* No lines go through, check node level */
-				this_node = MIN (MIN (c.node_level[0], c.node_level[1]) , MIN (c.node_level[2], c.node_level[3]));
-			}
-			else {
-				this_node = 0;
-				GMT_geo_to_xy (GMT, lon, in[GMT_Y], &xx, &yy);
-				for (id = 0; id < 2; id++) {
+					/* Must use polygons.  Go in both directions to cover both land and sea */
+					for (id = 0; id < 2; id++) {
+						GMT_free_shore_polygons (GMT, p[id], np[id]);
+						if (np[id]) GMT_free (GMT, p[id]);
+						np[id] = GMT_assemble_shore (GMT, &c, wd[id], true, west_border, east_border, &p[id]);
+						np[id] = GMT_prep_shore_polygons (GMT, &p[id], np[id], !no_resample, Ctrl->dbg.step, -1);
+					}
+				}
 
-					for (k = 0; k < np[id]; k++) {
+				if (c.ns == 0) {	/* No lines go through, check node level */
+					this_node = MIN (MIN (c.node_level[0], c.node_level[1]) , MIN (c.node_level[2], c.node_level[3]));
+				}
+				else {
+					this_node = 0;
+					GMT_geo_to_xy (GMT, lon, in[GMT_Y], &xx, &yy);
+					for (id = 0; id < 2; id++) {
 
-						if (p[id][k].n == 0) continue;
+						for (k = 0; k < np[id]; k++) {
 
-						/* Find min/max of polygon */
+							if (p[id][k].n == 0) continue;
 
-						xmin = xmax = p[id][k].lon[0];
-						ymin = ymax = p[id][k].lat[0];
+							/* Find min/max of polygon */
 
-						for (i = 1; i < p[id][k].n; i++) {
-							if (p[id][k].lon[i] < xmin) xmin = p[id][k].lon[i];
-							if (p[id][k].lon[i] > xmax) xmax = p[id][k].lon[i];
-							if (p[id][k].lat[i] < ymin) ymin = p[id][k].lat[i];
-							if (p[id][k].lat[i] > ymax) ymax = p[id][k].lat[i];
-						}
+							xmin = xmax = p[id][k].lon[0];
+							ymin = ymax = p[id][k].lat[0];
 
-						if (yy < ymin || yy > ymax) continue;
-						if (xx < xmin || xx > xmax) continue;
+							for (i = 1; i < p[id][k].n; i++) {
+								if (p[id][k].lon[i] < xmin) xmin = p[id][k].lon[i];
+								if (p[id][k].lon[i] > xmax) xmax = p[id][k].lon[i];
+								if (p[id][k].lat[i] < ymin) ymin = p[id][k].lat[i];
+								if (p[id][k].lat[i] > ymax) ymax = p[id][k].lat[i];
+							}
 
-						/* Must compare with polygon; holes are handled explicitly via the levels */
+							if (yy < ymin || yy > ymax) continue;
+							if (xx < xmin || xx > xmax) continue;
 
-						if ((side = GMT_non_zero_winding (GMT, xx, yy, p[id][k].lon, p[id][k].lat, p[id][k].n)) < Ctrl->E.inside[N_ITEM]) continue;	/* Outside polygon */
+							/* Must compare with polygon; holes are handled explicitly via the levels */
 
-						/* Here, point is inside, we must assign value */
+							if ((side = GMT_non_zero_winding (GMT, xx, yy, p[id][k].lon, p[id][k].lat, p[id][k].n)) < Ctrl->E.inside[N_ITEM]) continue;	/* Outside polygon */
 
-						if (p[id][k].level > this_node) this_node = p[id][k].level;
+							/* Here, point is inside, we must assign value */
+
+							if (p[id][k].level > this_node) this_node = p[id][k].level;
+						}
 					}
 				}
+				inside = Ctrl->N.mask[this_node];
+				if (inside != Ctrl->I.pass[4]) { output_header = need_header; continue;}
 			}
-			inside = Ctrl->N.mask[this_node];
-			if (inside != Ctrl->I.pass[4]) { output_header = need_header; continue;}
-		}
 
-		/* Here, we have passed all active test and the point is to be output */
+			/* Here, we have passed all active test and the point is to be output */
 
-		if (output_header) {	/* First output point for this segment - write the header */
-			GMT_Put_Record (API, GMT_WRITE_SEGMENT_HEADER, NULL);
-			output_header = false;
-		}
-
-		if (just_copy_record) {	/* Want to (or can) do text output */
-			if (GMT->common.a.active) {	/* Add selected aspatial fields to output record */
-				gmt_ogr_to_text (GMT, GMT->current.io.OGR, extra);
-				strcat (API->GMT->current.io.current_record, extra);
+			if (output_header) {	/* First output point for this segment - write the header */
+				strncpy (GMT->current.io.segment_header, segment_header, GMT_BUFSIZ);	/* By now the reader may hold the next header */
+				GMT_Put_Record (API, GMT_WRITE_SEGMENT_HEADER, NULL);
+				output_header = false;
 			}
-			GMT_Put_Record (API, GMT_WRITE_TEXT, NULL);
+
+			if (just_copy_record)	/* Want to (or can) do text output */
+				GMT_Put_Record (API, GMT_WRITE_TEXT, R[b].text);
+			else
+				GMT_Put_Record (API, GMT_WRITE_DOUBLE, in);
+			n_pass++;
 		}
-		else
-			GMT_Put_Record (API, GMT_WRITE_DOUBLE, in);
-		n_pass++;
-	} while (true);
+		for (b = 0; b < (int64_t)n_buf; b++) if (R[b].text) { free (R[b].text); R[b].text = NULL; }
+
+		if (bad_record) Return (EXIT_FAILURE);
+		if (got == GMT_IO_TABLE_HEADER)	/* Echo table headers */
+			GMT_Put_Record (API, GMT_WRITE_TABLE_HEADER, NULL);
+		else if (got == GMT_IO_SEGMENT_HEADER) {	/* Keep the header for the records in the next block */
+			strncpy (segment_header, GMT->current.io.segment_header, GMT_BUFSIZ);
+			output_header = true;
+			need_header = GMT->current.io.multi_segments[GMT_OUT];	/* Only need to break up segments */
+		}
+	} while (got != GMT_IO_EOF);
 	
 	if (GMT_End_IO (API, GMT_IN,  0) != GMT_OK) {	/* Disables further data input */
 		Return (API->error);
@@ -891,6 +974,15 @@ int GMT_gmtselect (void *V_API, int mode, void *args)
 
 	GMT_Report (API, GMT_MSG_VERBOSE, "Read %" PRIu64 " records, passed %" PRIu64" records\n", n_read, n_pass);
 
+	for (k = 0; k < GMTSELECT_N_BUF; k++) if (R[k].n_alloc) GMT_free (GMT, R[k].in);
+	GMT_free (GMT, R);
+	GMT_free_dist_index (GMT, &point_index);
+	GMT_free_dist_index (GMT, &line_index);
+	if (pol_prep) {
+		for (seg = 0; seg < pol->n_segments; seg++) GMT_free_prepared_polygon (GMT, &pol_prep[seg]);
+		GMT_free (GMT, pol_prep);
+	}
+
 	if (Ctrl->N.active) {
 		GMT_free_shore (GMT, &c);
 		GMT_shore_cleanup (GMT, &c);
@@ -69,6 +69,9 @@ struct GRDBLEND_CTRL {
 		bool active;
 		double inc[2];
 	} I;
+	struct M {	/* -M */
+		bool active;
+	} M;
 	struct N {	/* -N<nodata> */
 		bool active;
 		double nodata;
@@ -97,12 +100,15 @@ struct GRDBLEND_INFO {	/* Structure with info about each input grid file */
 	bool invert;					/* true if weight was given as negative and we want to taper to zero INSIDE the grid region */
 	bool open;					/* true if file is currently open */
 	bool delete;					/* true if file was produced by grdsample to deal with different registration/increments */
+	bool resample;					/* true if -M and grid must be resampled on the fly onto the output lattice */
 	char file[GMT_LEN256];			/* Name of grid file */
 	double weight, wt_y, wxr, wxl, wyu, wyd;	/* Various weighting factors used for cosine-taper weights */
 	double wesn[4];					/* Boundaries of inner region */
-	float *z;					/* Row vector holding the current row from this file */
+	float *z;					/* Row vector holding the current row from this file (NULL if -M) */
 };
 
+#define GRDBLEND_BAND	64	/* Number of output rows computed in parallel in -M mode */
+
 #define N_NOT_SUPPORTED	8
 
 int found_unsupported_format (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *h, char *file)
@@ -172,12 +178,13 @@ bool overlap_check (struct GMT_CTRL *GMT, struct GRDBLEND_INFO *B, struct GMT_GR
 	return false;
 }
 
-int init_blend_job (struct GMT_CTRL *GMT, char **files, unsigned int n_files, struct GMT_GRID_HEADER *h, struct GRDBLEND_INFO **blend) {
+int init_blend_job (struct GMT_CTRL *GMT, char **files, unsigned int n_files, struct GMT_GRID_HEADER *h, bool in_memory, struct GRDBLEND_INFO **blend) {
 	int type, status;
 	bool do_sample, not_supported;
 	unsigned int one_or_zero = !h->registration, n = 0, nr;
 	struct GRDBLEND_INFO *B = NULL;
 	char *sense[2] = {"normal", "inverse"}, *V_level = "qncvld", buffer[GMT_BUFSIZ] = {""};
+	double wesn[4];
 	char Targs[GMT_LEN256] = {""}, Iargs[GMT_LEN256] = {""}, Rargs[GMT_LEN256] = {""}, cmd[GMT_BUFSIZ] = {""};
 	struct BLEND_LIST {
 		char *file;
@@ -280,7 +287,7 @@ int init_blend_job (struct GMT_CTRL *GMT, char **files, unsigned int n_files, st
 			do_sample |= 1;
 		}
 		if (out_of_phase (B[n].G->header, h)) {	/* Set explicit -R for resampling that is multiple of desired increments AND inside both original grid and desired grid */
-			double wesn[4];	/* Make sure wesn is equal to or larger than B[n].G->header->wesn so all points are included */
+			/* Make sure wesn is equal to or larger than B[n].G->header->wesn so all points are included */
 			unsigned int k;
 			k = (unsigned int)floor ((MAX (h->wesn[XLO], B[n].G->header->wesn[XLO]) - h->wesn[XLO]) / h->inc[GMT_X] - h->xy_off);
 			wesn[XLO] = GMT_grd_col_to_x (GMT, k, h);
@@ -295,7 +302,6 @@ int init_blend_job (struct GMT_CTRL *GMT, char **files, unsigned int n_files, st
 			do_sample |= 1;
 		}
 		else if (do_sample) {	/* Set explicit -R to handle possible subsetting */
-			double wesn[4];
 			GMT_memcpy (wesn, h->wesn, 4, double);
 			if (wesn[XLO] < B[n].G->header->wesn[XLO]) wesn[XLO] = B[n].G->header->wesn[XLO];
 			if (wesn[XHI] > B[n].G->header->wesn[XHI]) wesn[XHI] = B[n].G->header->wesn[XHI];
@@ -304,7 +310,15 @@ int init_blend_job (struct GMT_CTRL *GMT, char **files, unsigned int n_files, st
 			sprintf (Rargs, "-R%.12g/%.12g/%.12g/%.12g", wesn[XLO], wesn[XHI], wesn[YLO], wesn[YHI]);
 			GMT_Report (GMT->parent, GMT_MSG_DEBUG, "File %s is sampled using region %s\n", B[n].file, Rargs);
 		}
-		if (do_sample) {	/* One or more reasons to call grdsample before using this grid */
+		if (do_sample && in_memory) {	/* -M: Entire grid will be read into memory so any format will do, and resampling is done on the fly */
+			if (do_sample & 1) {	/* Use the lattice that grdsample would have produced to set the indices below */
+				B[n].resample = true;
+				GMT_memcpy (B[n].G->header->wesn, wesn, 4, double);
+				B[n].G->header->registration = h->registration;
+				GMT_Report (GMT->parent, GMT_MSG_LONG_VERBOSE, "File %s will be resampled in memory onto region %s\n", B[n].file, Rargs);
+			}
+		}
+		else if (do_sample) {	/* One or more reasons to call grdsample before using this grid */
 			if (do_sample & 1) {	/* Resampling of the grid */
 				sprintf (buffer, "/tmp/grdblend_resampled_%d_%d.nc", (int)getpid(), n);
 				sprintf (cmd, "%s %s %s %s -G%s -V%c", B[n].file, Targs, Iargs, Rargs, buffer, V_level[GMT->current.setting.verbose]);
@@ -337,8 +351,10 @@ int init_blend_job (struct GMT_CTRL *GMT, char **files, unsigned int n_files, st
 			B[n].weight = fabs (B[n].weight);
 			B[n].invert = true;
 		}
-		B[n].RbR = GMT_memory (GMT, NULL, 1, struct GMT_GRID_ROWBYROW);		/* Allocate structure */
-		GMT_memcpy (B[n].RbR, B[n].G->extra, 1, struct GMT_GRID_ROWBYROW);	/* Duplicate, since GMT_Destroy_Data will free the header->extra */
+		if (!in_memory) {	/* Row-by-row reading */
+			B[n].RbR = GMT_memory (GMT, NULL, 1, struct GMT_GRID_ROWBYROW);		/* Allocate structure */
+			GMT_memcpy (B[n].RbR, B[n].G->extra, 1, struct GMT_GRID_ROWBYROW);	/* Duplicate, since GMT_Destroy_Data will free the header->extra */
+		}
 
 		/* Here, i0, j0 is the very first col, row to read, while i1, j1 is the very last col, row to read .
 		 * Weights at the outside i,j should be 0, and reach 1 at the edge of the inside block */
@@ -360,7 +376,7 @@ int init_blend_job (struct GMT_CTRL *GMT, char **files, unsigned int n_files, st
 		B[n].wyu = M_PI * h->inc[GMT_Y] / (B[n].G->header->wesn[YHI] - B[n].wesn[YHI]);
 		B[n].wyd = M_PI * h->inc[GMT_Y] / (B[n].wesn[YLO] - B[n].G->header->wesn[YLO]);
 
-		if (B[n].out_j0 < 0) {	/* Must skip to first row inside the present -R */
+		if (B[n].out_j0 < 0 && !in_memory) {	/* Must skip to first row inside the present -R */
 			type = GMT->session.grdformat[B[n].G->header->type][0];
 			if (type == 'c')	/* Old-style, 1-D netcdf grid */
 				B[n].offset = B[n].G->header->nx * abs (B[n].out_j0);
@@ -372,7 +388,7 @@ int init_blend_job (struct GMT_CTRL *GMT, char **files, unsigned int n_files, st
 
 		/* Allocate space for one entire row */
 
-		B[n].z = GMT_memory (GMT, NULL, B[n].G->header->nx, float);
+		if (!in_memory) B[n].z = GMT_memory (GMT, NULL, B[n].G->header->nx, float);
 		GMT_Report (GMT->parent, GMT_MSG_VERBOSE, "Blend file %s in %g/%g/%g/%g with %s weight %g [%d-%d]\n",
 			B[n].G->header->name, B[n].wesn[XLO], B[n].wesn[XHI], B[n].wesn[YLO], B[n].wesn[YHI], sense[B[n].invert], B[n].weight, B[n].out_j0, B[n].out_j1);
 
@@ -389,6 +405,18 @@ int init_blend_job (struct GMT_CTRL *GMT, char **files, unsigned int n_files, st
 	return (n_files);
 }
 
+double blend_wt_y (struct GRDBLEND_INFO *B, int row, double half) {
+	/* Return the y-weight of this grid for the given output row */
+	double wt_y;
+	if (row <= B->in_j0)		/* Top cosine taper weight */
+		wt_y = 0.5 * (1.0 - cos ((row - B->out_j0 + half) * B->wyu));
+	else if (row >= B->in_j1)	/* Bottom cosine taper weight */
+		wt_y = 0.5 * (1.0 - cos ((B->out_j1 - row + half) * B->wyd));
+	else				/* We are inside the inner region; y-weight = 1 */
+		wt_y = 1.0;
+	return (wt_y * B->weight);
+}
+
 int sync_input_rows (struct GMT_CTRL *GMT, int row, struct GRDBLEND_INFO *B, unsigned int n_blend, double half) {
 	unsigned int k;
 
@@ -406,13 +434,7 @@ int sync_input_rows (struct GMT_CTRL *GMT, int row, struct GRDBLEND_INFO *B, uns
 			continue;
 		}
 		B[k].outside = false;
-		if (row <= B[k].in_j0)		/* Top cosine taper weight */
-			B[k].wt_y = 0.5 * (1.0 - cos ((row - B[k].out_j0 + half) * B[k].wyu));
-		else if (row >= B[k].in_j1)	/* Bottom cosine taper weight */
-			B[k].wt_y = 0.5 * (1.0 - cos ((B[k].out_j1 - row + half) * B[k].wyd));
-		else				/* We are inside the inner region; y-weight = 1 */
-			B[k].wt_y = 1.0;
-		B[k].wt_y *= B[k].weight;
+		B[k].wt_y = blend_wt_y (&B[k], row, half);
 
 		if (!B[k].open) {
 			if ((B[k].G = GMT_Read_Data (GMT->parent, GMT_IS_GRID, GMT_IS_FILE, GMT_IS_SURFACE, GMT_GRID_HEADER_ONLY|GMT_GRID_ROW_BY_ROW, NULL, B[k].file, NULL)) == NULL) {
@@ -427,6 +449,124 @@ int sync_input_rows (struct GMT_CTRL *GMT, int row, struct GRDBLEND_INFO *B, uns
 	return GMT_OK;
 }
 
+int load_blend_grid (struct GMT_CTRL *GMT, struct GRDBLEND_INFO *B) {
+	/* -M: Read the entire grid into memory */
+	if ((B->G = GMT_Read_Data (GMT->parent, GMT_IS_GRID, GMT_IS_FILE, GMT_IS_SURFACE, GMT_GRID_ALL, NULL, B->file, NULL)) == NULL)
+		return (GMT_GRID_READ_ERROR);
+	B->open = true;
+	return (GMT_OK);
+}
+
+int free_blend_grid (struct GMT_CTRL *GMT, struct GRDBLEND_INFO *B) {
+	/* Release the grid and any temporary file once we are done with it */
+	if (!B->open) return (GMT_OK);
+	B->open = false;
+	if (B->z) GMT_free (GMT, B->z);
+	if (B->RbR) GMT_free (GMT, B->RbR);
+	if (B->delete) remove (B->file);	/* Delete the temporary resampled file */
+	return (GMT_Destroy_Data (GMT->parent, &B->G));
+}
+
+unsigned int blend_list (struct GRDBLEND_INFO *B, unsigned int n_blend, int row0, int row1, unsigned int *list) {
+	/* Return the number of grids (and their indices in list) that overlap output rows row0-row1 */
+	unsigned int k, n = 0;
+	for (k = 0; k < n_blend; k++) {
+		if (B[k].ignore || row1 < B[k].out_j0 || row0 > B[k].out_j1) continue;
+		list[n++] = k;
+	}
+	return (n);
+}
+
+uint64_t blend_row (struct GMT_CTRL *GMT, struct GRDBLEND_CTRL *Ctrl, struct GRDBLEND_INFO *blend, unsigned int *list, unsigned int n_list, struct GMT_GRID_HEADER *h, int row, bool wrap_x, bool geo, unsigned int nx_360, float *z, double *z_min, double *z_max)
+{
+	/* Compute one output row from the grids in list.  The input values either come from the
+	 * current row buffer of each grid (row-by-row mode) or from the grid in memory (-M), in which
+	 * case the grid is resampled on the fly if needed.  geo is true for geographic input; it is
+	 * passed in since the -M prefetch may reset the column types while rows are computed.
+	 * Returns the number of nodes filled */
+	unsigned int col, kk, k, m, j;
+	int pcol;
+	uint64_t n_fill = 0;
+	double wt_x, w, wt, wt_y, x, y = 0.0;
+	float no_data_f = (float)Ctrl->N.nodata, v;
+	struct GRDBLEND_INFO *B = NULL;
+
+	if (Ctrl->M.active) y = GMT_grd_row_to_y (GMT, row, h);
+	GMT_memset (z, h->nx, float);	/* Start from scratch */
+	for (col = 0; col < h->nx; col++) {	/* For each output node on the current row */
+
+		w = 0.0;	/* Reset weight */
+		for (j = m = 0; j < n_list; j++) {	/* Loop over every input grid; m will be the number of contributing grids to this node  */
+			k = list[j];
+			B = &blend[k];
+			if (row < B->out_j0 || row > B->out_j1) continue;	/* This grid is currently outside the s/n range */
+			if (wrap_x) {	/* Special testing for periodic x coordinates */
+				pcol = col + nx_360;
+				while (pcol > B->out_i1) pcol -= nx_360;
+				if (pcol < B->out_i0) continue;	/* This grid is currently outside the w/e range */
+			}
+			else {	/* Not periodic */
+				pcol = col;
+				if (pcol < B->out_i0 || pcol > B->out_i1) continue;	/* This grid is currently outside the xmin/xmax range */
+			}
+			kk = pcol - B->out_i0;					/* kk is the local column variable for this grid */
+			if (B->z)	/* Row-by-row mode: get value from current row */
+				v = B->z[kk];
+			else if (!B->resample)	/* -M and grid is co-registered with the output grid */
+				v = B->G->data[GMT_IJP (B->G->header, row - B->out_j0, kk)];
+			else {	/* -M: Resample on the fly at the output node */
+				x = GMT_grd_col_to_x (GMT, pcol, h);
+				if (geo) {	/* Wind longitude to fit the grid's own range */
+					while (x > B->G->header->wesn[XHI]) x -= 360.0;
+					while (x < B->G->header->wesn[XLO]) x += 360.0;
+				}
+				v = (float)GMT_get_bcr_z (GMT, B->G, x, y);
+			}
+			if (GMT_is_fnan (v)) continue;			/* NaNs do not contribute */
+			if (Ctrl->C.active) {	/* Clobber; update z[col] according to selected mode */
+				switch (Ctrl->C.mode) {
+					case BLEND_FIRST: if (m) continue; break;	/* Already set */
+					case BLEND_UPPER: if (m && v <= z[col]) continue; break;	/* Already has a higher value; else set below */
+					case BLEND_LOWER: if (m && v >- z[col]) continue; break;	/* Already has a lower value; else set below */
+					/* Last case BLEND_LAST is always true in that we always update z[col] */
+				}
+				z[col] = v;							/* Just pick this grid's value */
+				w = 1.0;							/* Set weights to 1 */
+				m = 1;								/* Pretend only one grid came here */
+			}
+			else {	/* Do the weighted blending */ 
+				if (pcol <= B->in_i0)					/* Left cosine-taper weight */
+					wt_x = 0.5 * (1.0 - cos ((pcol - B->out_i0 + h->xy_off) * B->wxl));
+				else if (pcol >= B->in_i1)					/* Right cosine-taper weight */
+					wt_x = 0.5 * (1.0 - cos ((B->out_i1 - pcol + h->xy_off) * B->wxr));
+				else								/* Inside inner region, weight = 1 */
+					wt_x = 1.0;
+				wt_y = (B->z) ? B->wt_y : blend_wt_y (B, row, h->xy_off);	/* Row-by-row mode has this set by sync_input_rows */
+				wt = wt_x * wt_y;						/* Actual weight is 2-D cosine taper */
+				if (B->invert) wt = B->weight - wt;			/* Invert the sense of the tapering */
+				z[col] += (float)(wt * v);					/* Add up weighted z*w sum */
+				w += wt;							/* Add up the weight sum */
+				m++;								/* Add up the number of contributing grids */
+			}
+		}
+
+		if (m) {	/* OK, at least one grid contributed to an output value */
+			if (!Ctrl->W.active) {		/* Want output z blend */
+				z[col] = (float)((w == 0.0) ? 0.0 : z[col] / w);	/* Get weighted average z */
+				if (Ctrl->Z.active) z[col] *= (float)Ctrl->Z.scale;		/* Apply the global scale here */
+			}
+			else		/* Get the weight only */
+				z[col] = (float)w;				/* Only interested in the weights */
+			n_fill++;						/* One more cell filled */
+			if (z[col] < *z_min) *z_min = z[col];	/* Update the extrema for output grid */
+			if (z[col] > *z_max) *z_max = z[col];
+		}
+		else			/* No grids covered this node, defaults to the no_data value */
+			z[col] = no_data_f;
+	}
+	return (n_fill);
+}
+
 void *New_grdblend_Ctrl (struct GMT_CTRL *GMT) {	/* Allocate and initialize a new control structure */
 	struct GRDBLEND_CTRL *C = NULL;
 	
@@ -451,7 +591,7 @@ int GMT_grdblend_usage (struct GMTAPI_CTRL *API, int level)
 	GMT_show_name_and_purpose (API, THIS_MODULE_LIB, THIS_MODULE_NAME, THIS_MODULE_PURPOSE);
 	if (level == GMT_MODULE_PURPOSE) return (GMT_NOERROR);
 	GMT_Message (API, GMT_TIME_NONE, "usage: grdblend [<blendfile> | <grid1> <grid2> ...] -G<outgrid>\n");
-	GMT_Message (API, GMT_TIME_NONE, "\t%s %s [-Cf|l|o|u]\n\t[-N<nodata>] [-Q] [%s] [-W] [-Z<scale>] [%s] [%s]\n", GMT_I_OPT, GMT_Rgeo_OPT, GMT_V_OPT, GMT_f_OPT, GMT_r_OPT);
+	GMT_Message (API, GMT_TIME_NONE, "\t%s %s [-Cf|l|o|u]\n\t[-M] [-N<nodata>] [-Q] [%s] [-W] [-Z<scale>] [%s] [%s]\n", GMT_I_OPT, GMT_Rgeo_OPT, GMT_V_OPT, GMT_f_OPT, GMT_r_OPT);
 
 	if (level == GMT_SYNOPSIS) return (EXIT_FAILURE);
 
@@ -476,6 +616,9 @@ int GMT_grdblend_usage (struct GMTAPI_CTRL *API, int level)
 	GMT_Message (API, GMT_TIME_NONE, "\t   l The lowest input grid value determines the final value.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   o The last input grid overrides any previous value.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   u The highest input grid value determines the final value.\n");
+	GMT_Message (API, GMT_TIME_NONE, "\t-M Read each input grid into memory while it overlaps the rows being computed.  Grids not\n");
+	GMT_Message (API, GMT_TIME_NONE, "\t   coregistered with the output -R -I are then resampled on the fly instead of via temporary\n");
+	GMT_Message (API, GMT_TIME_NONE, "\t   files, and bands of output rows are computed in parallel [Default reads all grids row by row].\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t-N Set value for nodes without constraints [Default is NaN].\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t-Q Grdraster-compatible output without leading grd header [Default writes GMT grid file].\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   Output grid must be in one of the native binary formats.\n");
@@ -540,6 +683,9 @@ int GMT_grdblend_parse (struct GMT_CTRL *GMT, struct GRDBLEND_CTRL *Ctrl, struct
 					n_errors++;
 				}
 				break;
+			case 'M':	/* Hold input grids in memory */
+				Ctrl->M.active = true;
+				break;
 			case 'N':	/* NaN-value */
 				Ctrl->N.active = true;
 				if (opt->arg[0])
@@ -579,14 +725,12 @@ int GMT_grdblend_parse (struct GMT_CTRL *GMT, struct GRDBLEND_CTRL *Ctrl, struct
 
 int GMT_grdblend (void *V_API, int mode, void *args)
 {
-	unsigned int col, row, nx_360 = 0, k, kk, m, n_blend, nx_final, ny_final;
-	int status, pcol, err, error;
-	bool reformat, wrap_x, write_all_at_once = false;
+	unsigned int row, nx_360 = 0, k, n_blend, nx_final, ny_final, *list = NULL;
+	int status, err, error;
+	bool reformat, wrap_x, geo, write_all_at_once = false;
 	
 	uint64_t ij, n_fill, n_tot;
 	
-	double wt_x, w, wt;
-	
 	float *z = NULL, no_data_f;
 	
 	char type;
@@ -647,7 +791,7 @@ int GMT_grdblend (void *V_API, int mode, void *args)
 		}
 	}
 
-	status = init_blend_job (GMT, Ctrl->In.file, Ctrl->In.n, Grid->header, &blend);
+	status = init_blend_job (GMT, Ctrl->In.file, Ctrl->In.n, Grid->header, Ctrl->M.active, &blend);
 
 	if (Ctrl->In.n <= 1 && GMT_End_IO (API, GMT_IN, 0) != GMT_OK) {	/* Disables further data input */
 		Return (API->error);
@@ -698,81 +842,92 @@ int GMT_grdblend (void *V_API, int mode, void *args)
 
 	Grid->header->z_min = DBL_MAX;	Grid->header->z_max = -DBL_MAX;	/* These will be updated in the loop below */
 	wrap_x = (GMT_is_geographic (GMT, GMT_OUT));	/* Periodic geographic grid */
+	geo = (GMT_is_geographic (GMT, GMT_IN));	/* Fixed here since reading grids may change the column types */
 	if (wrap_x) nx_360 = urint (360.0 * Grid->header->r_inc[GMT_X]);
 
-	for (row = 0; row < Grid->header->ny; row++) {	/* For every output row */
-
-		GMT_memset (z, Grid->header->nx, float);	/* Start from scratch */
-
-		sync_input_rows (GMT, row, blend, n_blend, Grid->header->xy_off);	/* Wind each input file to current record and read each of the overlapping rows */
-
-		for (col = 0; col < Grid->header->nx; col++) {	/* For each output node on the current row */
-
-			w = 0.0;	/* Reset weight */
-			for (k = m = 0; k < n_blend; k++) {	/* Loop over every input grid; m will be the number of contributing grids to this node  */
-				if (blend[k].ignore) continue;					/* This grid is entirely outside the s/n range */
-				if (blend[k].outside) continue;					/* This grid is currently outside the s/n range */
-				if (wrap_x) {	/* Special testing for periodic x coordinates */
-					pcol = col + nx_360;
-					while (pcol > blend[k].out_i1) pcol -= nx_360;
-					if (pcol < blend[k].out_i0) continue;	/* This grid is currently outside the w/e range */
-				}
-				else {	/* Not periodic */
-					pcol = col;
-					if (pcol < blend[k].out_i0 || pcol > blend[k].out_i1) continue;	/* This grid is currently outside the xmin/xmax range */
-				}
-				kk = pcol - blend[k].out_i0;					/* kk is the local column variable for this grid */
-				if (GMT_is_fnan (blend[k].z[kk])) continue;			/* NaNs do not contribute */
-				if (Ctrl->C.active) {	/* Clobber; update z[col] according to selected mode */
-					switch (Ctrl->C.mode) {
-						case BLEND_FIRST: if (m) continue; break;	/* Already set */
-						case BLEND_UPPER: if (m && blend[k].z[kk] <= z[col]) continue; break;	/* Already has a higher value; else set below */
-						case BLEND_LOWER: if (m && blend[k].z[kk] >- z[col]) continue; break;	/* Already has a lower value; else set below */
-						/* Last case BLEND_LAST is always true in that we always update z[col] */
+	list = GMT_memory (GMT, NULL, n_blend, unsigned int);
+	if (Ctrl->M.active) {	/* Compute bands of output rows in parallel from grids held in memory */
+		unsigned int n_list, n_band, b;
+		int r0, r1, n0, n1;
+		uint64_t *band_fill = NULL;
+		double *band_min = NULL, *band_max = NULL;
+		float *band = NULL;
+
+		band = GMT_memory (GMT, NULL, (size_t)GRDBLEND_BAND * Grid->header->nx, float);
+		band_fill = GMT_memory (GMT, NULL, GRDBLEND_BAND, uint64_t);
+		band_min = GMT_memory (GMT, NULL, GRDBLEND_BAND, double);
+		band_max = GMT_memory (GMT, NULL, GRDBLEND_BAND, double);
+		n_list = blend_list (blend, n_blend, 0, MIN (GRDBLEND_BAND, Grid->header->ny) - 1, list);
+		for (k = 0; k < n_list; k++) if (!blend[list[k]].open && (error = load_blend_grid (GMT, &blend[list[k]]))) Return (error);
+		for (row = 0; row < Grid->header->ny; row += n_band) {	/* For every band of output rows */
+			n_band = MIN (GRDBLEND_BAND, Grid->header->ny - row);
+			r0 = row;	r1 = row + n_band - 1;
+			n0 = r1 + 1;	n1 = MIN (n0 + GRDBLEND_BAND, (int)Grid->header->ny) - 1;	/* Rows in the next band */
+			for (k = 0; k < n_blend; k++) if (blend[k].open && blend[k].out_j1 < r0 && (error = free_blend_grid (GMT, &blend[k]))) Return (error);	/* Done with these */
+			n_list = blend_list (blend, n_blend, r0, r1, list);	/* All of these have been loaded */
+			error = GMT_OK;
+#ifdef _OPENMP
+#pragma omp parallel private(b) shared(GMT,Ctrl,blend,n_blend,list,n_list,Grid,r0,n0,n1,n_band,band,band_fill,band_min,band_max,wrap_x,geo,nx_360,error)
+#endif
+			{
+#ifdef _OPENMP
+#pragma omp master
+#endif
+				{	/* Read the grids first needed by the next band while the other threads start on this band */
+					unsigned int kn;
+					if (n0 < (int)Grid->header->ny) {
+						for (kn = 0; kn < n_blend; kn++) {
+							if (blend[kn].ignore || blend[kn].open || n1 < blend[kn].out_j0 || n0 > blend[kn].out_j1) continue;
+							if (load_blend_grid (GMT, &blend[kn])) { error = GMT_GRID_READ_ERROR; break; }
+						}
 					}
-					z[col] = blend[k].z[kk];					/* Just pick this grid's value */
-					w = 1.0;							/* Set weights to 1 */
-					m = 1;								/* Pretend only one grid came here */
 				}
-				else {	/* Do the weighted blending */ 
-					if (pcol <= blend[k].in_i0)					/* Left cosine-taper weight */
-						wt_x = 0.5 * (1.0 - cos ((pcol - blend[k].out_i0 + Grid->header->xy_off) * blend[k].wxl));
-					else if (pcol >= blend[k].in_i1)					/* Right cosine-taper weight */
-						wt_x = 0.5 * (1.0 - cos ((blend[k].out_i1 - pcol + Grid->header->xy_off) * blend[k].wxr));
-					else								/* Inside inner region, weight = 1 */
-						wt_x = 1.0;
-					wt = wt_x * blend[k].wt_y;					/* Actual weight is 2-D cosine taper */
-					if (blend[k].invert) wt = blend[k].weight - wt;			/* Invert the sense of the tapering */
-					z[col] += (float)(wt * blend[k].z[kk]);				/* Add up weighted z*w sum */
-					w += wt;							/* Add up the weight sum */
-					m++;								/* Add up the number of contributing grids */
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,1)
+#endif
+				for (b = 0; b < n_band; b++) {	/* Each thread computes whole rows in this band */
+					band_min[b] = DBL_MAX;	band_max[b] = -DBL_MAX;
+					band_fill[b] = blend_row (GMT, Ctrl, blend, list, n_list, Grid->header, r0 + b, wrap_x, geo, nx_360, &band[(size_t)b*Grid->header->nx], &band_min[b], &band_max[b]);
 				}
 			}
-
-			if (m) {	/* OK, at least one grid contributed to an output value */
-				if (!Ctrl->W.active) {		/* Want output z blend */
-					z[col] = (float)((w == 0.0) ? 0.0 : z[col] / w);	/* Get weighted average z */
-					if (Ctrl->Z.active) z[col] *= (float)Ctrl->Z.scale;		/* Apply the global scale here */
+			if (error) Return (error);
+			for (b = 0; b < n_band; b++) {	/* Output the band in order and update the extrema */
+				n_fill += band_fill[b];
+				if (band_min[b] < Grid->header->z_min) Grid->header->z_min = band_min[b];
+				if (band_max[b] > Grid->header->z_max) Grid->header->z_max = band_max[b];
+				if (write_all_at_once) {	/* Must copy entire row to grid */
+					ij = GMT_IJP (Grid->header, r0 + b, 0);
+					GMT_memcpy (&(Grid->data[ij]), &band[(size_t)b*Grid->header->nx], Grid->header->nx, float);
 				}
-				else		/* Get the weight only */
-					z[col] = (float)w;				/* Only interested in the weights */
-				n_fill++;						/* One more cell filled */
-				if (z[col] < Grid->header->z_min) Grid->header->z_min = z[col];	/* Update the extrema for output grid */
-				if (z[col] > Grid->header->z_max) Grid->header->z_max = z[col];
+				else
+					GMT_Put_Row (API, r0 + b, Grid, &band[(size_t)b*Grid->header->nx]);
 			}
-			else			/* No grids covered this node, defaults to the no_data value */
-				z[col] = no_data_f;
-		}
-		if (write_all_at_once) {	/* Must copy entire row to grid */
-			ij = GMT_IJP (Grid->header, row, 0);
-			GMT_memcpy (&(Grid->data[ij]), z, Grid->header->nx, float);
+			GMT_Report (API, GMT_MSG_VERBOSE, "Processed row %7d of %d\r", r1, Grid->header->ny);
 		}
-		else
-			GMT_Put_Row (API, row, Grid, z);
+		GMT_free (GMT, band);
+		GMT_free (GMT, band_fill);
+		GMT_free (GMT, band_min);
+		GMT_free (GMT, band_max);
+	}
+	else {	/* Row-by-row on a single thread */
+		unsigned int n_list;
+		for (row = 0; row < Grid->header->ny; row++) {	/* For every output row */
+
+			sync_input_rows (GMT, row, blend, n_blend, Grid->header->xy_off);	/* Wind each input file to current record and read each of the overlapping rows */
+			n_list = blend_list (blend, n_blend, row, row, list);
+			n_fill += blend_row (GMT, Ctrl, blend, list, n_list, Grid->header, row, wrap_x, geo, nx_360, z, &Grid->header->z_min, &Grid->header->z_max);
 
-		if (row%10 == 0)  GMT_Report (API, GMT_MSG_VERBOSE, "Processed row %7ld of %d\r", row, Grid->header->ny);
+			if (write_all_at_once) {	/* Must copy entire row to grid */
+				ij = GMT_IJP (Grid->header, row, 0);
+				GMT_memcpy (&(Grid->data[ij]), z, Grid->header->nx, float);
+			}
+			else
+				GMT_Put_Row (API, row, Grid, z);
 
+			if (row%10 == 0)  GMT_Report (API, GMT_MSG_VERBOSE, "Processed row %7ld of %d\r", row, Grid->header->ny);
+		}
 	}
+	GMT_free (GMT, list);
 	GMT_Report (API, GMT_MSG_VERBOSE, "Processed row %7ld\n", row);
 	nx_final = Grid->header->nx;	ny_final = Grid->header->ny;
 
@@ -791,12 +946,7 @@ int GMT_grdblend (void *V_API, int mode, void *args)
 	}
 	GMT_free (GMT, z);
 
-	for (k = 0; k < n_blend; k++) if (blend[k].open) {
-		GMT_free (GMT, blend[k].z);
-		GMT_free (GMT, blend[k].RbR);
-		if (blend[k].delete) remove (blend[k].file);	/* Delete the temporary resampled file */
-		if ((error = GMT_Destroy_Data (API, &blend[k].G)) != GMT_OK) Return (error);
-	}
+	for (k = 0; k < n_blend; k++) if (blend[k].open && (error = free_blend_grid (GMT, &blend[k])) != GMT_OK) Return (error);
 
 	if (GMT_is_verbose (GMT, GMT_MSG_VERBOSE)) {
 		char empty[GMT_LEN64] = {""};
@@ -25,9 +25,6 @@
  * Version:	5 API
 */
 
-/* OpenMP breaks grdfilter; currently disabled */
-#undef _OPENMP
-
 #define THIS_MODULE_NAME	"grdfilter"
 #define THIS_MODULE_LIB		"core"
 #define THIS_MODULE_PURPOSE	"Filter a grid in the space (or time) domain"
@@ -561,13 +558,13 @@ int GMT_grdfilter (void *V_API, int mode, void *args)
 	bool spherical = false, full_360, visit_check = false, go_on, get_weight_sum = true;
 	unsigned int n_in_median, n_nan = 0, col_out, row_out, effort_level;
 	unsigned int filter_type, one_or_zero = 1, GMT_n_multiples = 0;
-	int tid = 0, col_in, row_in, ii, jj, *col_origin = NULL, row_origin, nx_wrap = 0, error = 0;
+	int col_in, row_in, ii, jj, *col_origin = NULL, row_origin, nx_wrap = 0, error = 0;
 #ifdef DEBUG
 	unsigned int n_conv = 0;
 #endif
 	uint64_t ij_in, ij_out, ij_wt;
 	double x_scale = 1.0, y_scale = 1.0, x_width, y_width, y, par[GRDFILTER_N_PARS];
-	double x_out, y_out, wt_sum, value, last_median = 0.0, this_estimate = 0.0;
+	double x_out, y_out, wt_sum, value, last_median = 0.0, median_guess = 0.0, this_estimate = 0.0;
 	double y_shift = 0.0, x_fix = 0.0, y_fix = 0.0, max_lat, lat_out, w;
 	double merc_range, *weight = NULL, *work_array = NULL, *x_shift = NULL;
 	double wesn[4], inc[2];
@@ -691,11 +688,6 @@ int GMT_grdfilter (void *V_API, int mode, void *args)
 	GMT_memset (&F, 1, struct FILTER_INFO);
 
 	/* Set up the distance scalings for lon and lat, and assign pointer to distance function  */
-#ifdef _OPENMP
-#pragma omp parallel shared(fast_way,x_shift,col_origin) private(F,par,x_width,y_width,effort_level,tid,weight,work_array,work_data) firstprivate(x_scale,y_scale,filter_type,spherical,visit_check,go_on,max_lat,merc_range,slow,slower,x_fix,y_fix) reduction(+:n_nan)
-{
-	tid = omp_get_thread_num ();
-#endif
 
 	if (Ctrl->F.custom) {	/* Get filter-weight grid rather than compute one */
 		if ((Fin = GMT_Read_Data (API, GMT_IS_GRID, GMT_IS_FILE, GMT_IS_SURFACE, GMT_GRID_ALL, NULL, Ctrl->F.file, NULL)) == NULL) {	/* Get filter-weight grid */
@@ -793,11 +785,26 @@ int GMT_grdfilter (void *V_API, int mode, void *args)
 	visit_check = ((2 * F.x_half_width + 1) >= (int)Gin->header->nx);	/* Must make sure we only visit each node once along a row */
 	F.x = GMT_memory (GMT, NULL, F.x_half_width+1, double);
 	F.y = GMT_memory (GMT, NULL, F.y_half_width+1, double);
-	if (visit_check) F.visit = GMT_memory (GMT, NULL, Gin->header->nx, char);
 	for (ii = 0; ii <= F.x_half_width; ii++) F.x[ii] = ii * F.dx;
 	for (jj = 0; jj <= F.y_half_width; jj++) F.y[jj] = jj * F.dy;
 	
-	weight = GMT_memory (GMT, NULL, F.nx*F.ny, double);	/* Allocate space for convolution grid */
+	/* Determine how much effort to compute weights:
+		0 = Weights read from custom weight grid
+		1 = Compute weights once for entire grid
+		2 = Compute weights once per scanline [slow]
+		3 = Compute weights for every output point [slower]
+	*/
+
+	if (Ctrl->F.custom)
+		effort_level = 0;
+	else if (fast_way && Ctrl->D.mode <= GRDFILTER_GEO_FLATEARTH1)
+		effort_level = 1;
+	else if (fast_way && Ctrl->D.mode >= GRDFILTER_GEO_FLATEARTH2)
+		effort_level = 2;
+	else 
+		effort_level = 3;
+	
+	if (effort_level <= 1) weight = GMT_memory (GMT, NULL, F.nx*F.ny, double);	/* Allocate space for convolution grid shared by all rows; else each thread has its own */
 	
 	if (Ctrl->F.custom) {	/* Read convolution grid from file */
 		ij_wt = 0;	wt_sum = 0.0;
@@ -821,30 +828,26 @@ int GMT_grdfilter (void *V_API, int mode, void *args)
 		if (Ctrl->D.mode > GRDFILTER_XY_CARTESIAN && (filter_type == GRDFILTER_MEDIAN || filter_type == GRDFILTER_MODE)) {	/* Spherical (weighted) median/modes requires even more work */
 			slower = true;
 			filter_type = (filter_type == GRDFILTER_MEDIAN) ? GRDFILTER_MEDIAN_SPH : GRDFILTER_MODE_SPH;	/* Set to the weighted versions */
-			work_data = GMT_memory (GMT, NULL, F.nx*F.ny, struct OBSERVATION);
 		}
-		else
-			work_array = GMT_memory (GMT, NULL, F.nx*F.ny, double);
 	}
+	median_guess = last_median;
 
-	if (tid == 0) {	/* First or only thread */
-		GMT_Report (API, GMT_MSG_VERBOSE, "Input nx,ny = (%d %d), output nx,ny = (%d %d), filter (max)nx,ny = (%d %d)\n", Gin->header->nx, Gin->header->ny, Gout->header->nx, Gout->header->ny);
-		GMT_Report (API, GMT_MSG_LONG_VERBOSE, "Filter nx,ny = (%d %d) [These are maximum dimensions of weight array]\n", F.nx, F.ny);
-		if (Ctrl->F.quantile != 0.5)
-			GMT_Report (API, GMT_MSG_VERBOSE, "Filter type is %s [using %g%% quantile].\n", filter_name[filter_type], 100.0 * Ctrl->F.quantile);
-		else
-			GMT_Report (API, GMT_MSG_VERBOSE, "Filter type is %s.\n", filter_name[filter_type]);
+	GMT_Report (API, GMT_MSG_VERBOSE, "Input nx,ny = (%d %d), output nx,ny = (%d %d), filter (max)nx,ny = (%d %d)\n", Gin->header->nx, Gin->header->ny, Gout->header->nx, Gout->header->ny);
+	GMT_Report (API, GMT_MSG_LONG_VERBOSE, "Filter nx,ny = (%d %d) [These are maximum dimensions of weight array]\n", F.nx, F.ny);
+	if (Ctrl->F.quantile != 0.5)
+		GMT_Report (API, GMT_MSG_VERBOSE, "Filter type is %s [using %g%% quantile].\n", filter_name[filter_type], 100.0 * Ctrl->F.quantile);
+	else
+		GMT_Report (API, GMT_MSG_VERBOSE, "Filter type is %s.\n", filter_name[filter_type]);
 #ifdef _OPENMP
-		GMT_Report (API, GMT_MSG_VERBOSE, "Calculations will be distributed over %d threads.\n", omp_get_num_threads ());
+	GMT_Report (API, GMT_MSG_VERBOSE, "Calculations will be distributed over %d threads.\n", omp_get_max_threads ());
 #endif
-	}
 
 #ifdef DEBUG
 	if (Ctrl->A.active) {	/* Picked a point to examine filter weights etc */
 		Ctrl->A.COL = GMT_grd_x_to_col (GMT, Ctrl->A.x, Gout->header);
 		Ctrl->A.ROW = GMT_grd_y_to_row (GMT, Ctrl->A.y, Gout->header);
 		if (Ctrl->A.mode == 'r') F.debug = true;	/* In order to return radii instead of weights */
-		if (tid == 0) GMT_Report (API, GMT_MSG_LONG_VERBOSE, "ROW = %d COL = %d\n", Ctrl->A.ROW, Ctrl->A.COL);
+		GMT_Report (API, GMT_MSG_LONG_VERBOSE, "ROW = %d COL = %d\n", Ctrl->A.ROW, Ctrl->A.COL);
 	}
 #endif
 	/* Compute nearest xoutput i-indices and shifts once */
@@ -855,30 +858,34 @@ int GMT_grdfilter (void *V_API, int mode, void *args)
 		if (!fast_way) x_shift[col_out] = x_out - GMT_grd_col_to_x (GMT, col_origin[col_out], Gin->header);
 	}
 
-	/* Determine how much effort to compute weights:
-		0 = Weights read from custom weight grid
-		1 = Compute weights once for entire grid
-		2 = Compute weights once per scanline [slow]
-		3 = Compute weights for every output point [slower]
-	*/
-
-	if (Ctrl->F.custom)
-		effort_level = 0;
-	else if (fast_way && Ctrl->D.mode <= GRDFILTER_GEO_FLATEARTH1)
-		effort_level = 1;
-	else if (fast_way && Ctrl->D.mode >= GRDFILTER_GEO_FLATEARTH2)
-		effort_level = 2;
-	else 
-		effort_level = 3;
-	
 	if (effort_level == 1) set_weight_matrix (GMT, &F, weight, 0.0, par, x_fix, y_fix);
 	
 #ifdef DEBUG
 	if (Ctrl->A.active) for (ij_in = 0; ij_in < Gin->header->size; ij_in++) Gin->data[ij_in] = 0.0f;	/* We are using Gin to store filter weights etc instead */
 #endif
 
+	/* Rows are filtered in parallel.  Each thread has its own copy of the filter info (since the
+	 * x half-width may change with latitude), its own visit array and work arrays, and its own
+	 * weight matrix unless the weights are computed once for the entire grid.  The median starts
+	 * from the same initial guess on every row so the output does not depend on how rows are
+	 * distributed over the threads. */
+#ifdef _OPENMP
+#pragma omp parallel firstprivate(F,par,weight,visit_check,y_shift) private(row_out,y_out,lat_out,row_origin,y,col_out,wt_sum,value,n_in_median,ij_out,ii,col_in,jj,row_in,ij_in,ij_wt,w,go_on,last_median,this_estimate,work_array,work_data) reduction(+:n_nan,GMT_n_multiples)
+#endif
+{
+#ifdef _OPENMP
+	int tid = omp_get_thread_num ();
+#endif
+	F.visit = GMT_memory (GMT, NULL, Gin->header->nx, char);
+	if (effort_level > 1) weight = GMT_memory (GMT, NULL, F.nx*F.ny, double);	/* Weights are recomputed per row or node */
+	work_array = NULL;	work_data = NULL;
+	if (slower)
+		work_data = GMT_memory (GMT, NULL, F.nx*F.ny, struct OBSERVATION);
+	else if (slow)
+		work_array = GMT_memory (GMT, NULL, F.nx*F.ny, double);
+
 #ifdef _OPENMP
-#pragma omp for schedule(dynamic,1) private(row_out,y_out,lat_out,row_origin,y,col_out,wt_sum,value,n_in_median,ij_out,ii,col_in,jj,row_in,ij_in,ij_wt) firstprivate(y_shift) nowait
+#pragma omp for schedule(dynamic,1)
 #endif
 	for (row_out = 0; row_out < Gout->header->ny; row_out++) {
 
@@ -887,6 +894,7 @@ int GMT_grdfilter (void *V_API, int mode, void *args)
 #else
 		GMT_Report (API, GMT_MSG_VERBOSE, "Processing output line %d\r", row_out);
 #endif
+		last_median = median_guess;	/* Same initial median guess for each row */
 #ifdef DEBUG
 		if (Ctrl->A.active && row_out != Ctrl->A.ROW) continue;	/* Not at our selected row for testing */
 #endif
@@ -1032,22 +1040,16 @@ int GMT_grdfilter (void *V_API, int mode, void *args)
 		}
 	}
 
-#ifdef _OPENMP
-	GMT_Report (API, GMT_MSG_VERBOSE, " Thread %d Processing output line %d\n", tid, row_out);
-#else
-	GMT_Report (API, GMT_MSG_VERBOSE, "Processing output line %d\n", row_out);
-#endif
-	GMT_free (GMT, weight);
+	GMT_free (GMT, F.visit);
+	if (effort_level > 1) GMT_free (GMT, weight);
+	if (slower) GMT_free (GMT, work_data);
+	else if (slow) GMT_free (GMT, work_array);
+}  /* end of parallel region */
+
+	GMT_Report (API, GMT_MSG_VERBOSE, "Processing output line %d\n", Gout->header->ny);
+	if (effort_level <= 1) GMT_free (GMT, weight);
 	GMT_free (GMT, F.x);
 	GMT_free (GMT, F.y);
-	if (visit_check) GMT_free (GMT, F.visit);
-	if (slow) {
-		if (slower) GMT_free (GMT, work_data);
-		else GMT_free (GMT, work_array);
-	}
-#ifdef _OPENMP
-}  /* end of parallel region */
-#endif
 
 	GMT_free (GMT, col_origin);
 	if (!fast_way) GMT_free (GMT, x_shift);
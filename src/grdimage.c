@@ -33,6 +33,8 @@
 
 #define GMT_PROG_OPTIONS "->BJKOPRUVXYcfnptxy" GMT_OPT("S")
 
+#define GRDIMAGE_N_ZLUT	65536U	/* Number of z-bins in the color lookup table */
+
 /* Control structure for grdimage */
 
 struct GRDIMAGE_CTRL {
@@ -373,7 +375,7 @@ void GMT_set_proj_limits (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *r, struc
 int GMT_grdimage (void *V_API, int mode, void *args)
 {
 	bool done, need_to_project, normal_x, normal_y, resampled = false, gray_only = false;
-	bool nothing_inside = false, use_intensity_grid;
+	bool nothing_inside = false, use_intensity_grid, parallel;
 	unsigned int k, nx = 0, ny = 0, grid_registration = GMT_GRID_NODE_REG, n_grids;
 	unsigned int colormask_offset = 0, try, row, actual_row, col;
 	uint64_t node_RGBA = 0;		/* uint64_t for the RGB(A) image array. */
@@ -388,6 +390,7 @@ int GMT_grdimage (void *V_API, int mode, void *args)
 	struct GMT_GRID *Grid_orig[3] = {NULL, NULL, NULL}, *Grid_proj[3] = {NULL, NULL, NULL};
 	struct GMT_GRID *Intens_orig = NULL, *Intens_proj = NULL;
 	struct GMT_PALETTE *P = NULL;
+	struct GMT_ZLUT *zlut = NULL;
 	struct GRDIMAGE_CTRL *Ctrl = NULL;
 	struct GMT_CTRL *GMT = NULL, *GMT_cpy = NULL;	/* General GMT interal parameters */
 	struct GMT_OPTION *options = NULL;
@@ -768,9 +771,17 @@ int GMT_grdimage (void *V_API, int mode, void *args)
 	normal_x = !(GMT->current.proj.projection == GMT_LINEAR && !GMT->current.proj.xyz_pos[0] && !resampled);
 	normal_y = !(GMT->current.proj.projection == GMT_LINEAR && !GMT->current.proj.xyz_pos[1] && !resampled);
 
+	if (P && !Ctrl->In.do_rgb) zlut = GMT_get_zlut (GMT, P, GRDIMAGE_N_ZLUT);	/* So each pixel's CPT slice is found in one step */
+	/* Rows are colored in parallel unless the GDAL image counter or the -Q color tally must be visited in order */
+	parallel = !(Ctrl->D.active || Ctrl->Q.active);
+
 	for (try = 0, done = false; !done && try < 2; try++) {	/* Evaluate colors at least once, or twice if -Q and we need to select another NaN color */
-		for (row = 0, byte = colormask_offset; row < ny; row++) {
+#ifdef _OPENMP
+#pragma omp parallel for private(row,actual_row,kk,col,node,byte,k,rgb,i_rgb,index) shared(GMT,Ctrl,P,zlut,Grid_proj,Intens_proj,header_work,bitimage_8,bitimage_24,rgb_used,NaN_rgb,nx,ny,n_grids,normal_x,normal_y,gray_only,use_intensity_grid,colormask_offset,node_RGBA) if (parallel)
+#endif
+		for (row = 0; row < ny; row++) {
 			actual_row = (normal_y) ? row : ny - row - 1;
+			byte = colormask_offset + (uint64_t)row * nx * ((Ctrl->M.active || gray_only) ? 1 : 3);	/* Start of this row in the bitimage */
 			kk = GMT_IJPGI (header_work, actual_row, 0);
 			if (Ctrl->D.active && row == 0) node_RGBA = kk;		/* First time per row equals 'node', after grows alone */
 			for (col = 0; col < nx; col++) {	/* Compute rgb for each pixel */
@@ -806,7 +817,7 @@ int GMT_grdimage (void *V_API, int mode, void *args)
 					}
 				}
 				else
-					index = GMT_get_rgb_from_z (GMT, P, Grid_proj[0]->data[node], rgb);
+					index = GMT_get_rgb_from_zlut (GMT, P, zlut, Grid_proj[0]->data[node], rgb);
 
 				if (Ctrl->I.active && index != GMT_NAN - 3) {
 					if (!n_grids) {		/* Here we are illuminating an image. Must recompute "node" with the GMT_IJP macro */
@@ -854,6 +865,7 @@ int GMT_grdimage (void *V_API, int mode, void *args)
 			done = true;
 	}
 	if (Ctrl->Q.active) GMT_free (GMT, rgb_used);
+	GMT_free_zlut (GMT, &zlut);
 	
 	for (k = 1; k < n_grids; k++) {	/* Not done with Grid_proj[0] yet, hence we start loop at k = 1 */
 		if (need_to_project && GMT_Destroy_Data (API, &Grid_proj[k]) != GMT_OK) {
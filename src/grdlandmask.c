@@ -35,6 +35,14 @@
 #define GMT_PROG_OPTIONS "-VRr" GMT_OPT("F")
 
 #define GRDLANDMASK_N_CLASSES	(GSHHS_MAX_LEVEL + 1)	/* Number of bands separated by the levels */
+#define GRDLANDMASK_BANDS_PER_THREAD	8	/* Row bands per thread when rasterizing in parallel */
+#define GRDLANDMASK_MAX_EDGES	2097152U	/* Rasterize the queued polygons once they hold this many edges */
+
+struct GRDLANDMASK_POLYGON {	/* A clipped shoreline polygon queued for rasterization */
+	struct GMT_PREPARED_POLYGON *P;	/* Its edges, binned by y */
+	int level;	/* Its GSHHG level */
+	int row_min, row_max, col_min, col_max;	/* Grid nodes inside its bounding box */
+};
 
 struct GRDLANDMASK_CTRL {	/* All control options for this program (except common args) */
 	/* ctive is true if the option has been activated */
@@ -221,16 +229,72 @@ int GMT_grdlandmask_parse (struct GMT_CTRL *GMT, struct GRDLANDMASK_CTRL *Ctrl,
 	return (n_errors ? GMT_PARSE_ERROR : GMT_OK);
 }
 
+void grdlandmask_fill (struct GMT_CTRL *GMT, struct GMT_GRID *Grid, struct GRDLANDMASK_POLYGON *L, unsigned int n_pol, double *x, double *y, unsigned int inside)
+{	/* Rasterize the queued polygons by filling the spans between their crossings with each row, keeping the
+	 * highest level found at each node.  The rows are split into bands that are filled in parallel; since a
+	 * band only writes to its own rows, the max-merge of overlapping polygons needs no locking. */
+	int band, n_bands = 1, band_h, ny = Grid->header->ny;
+	unsigned int k;
+	uint64_t p, *b_start = NULL, *b_next = NULL, *b_list = NULL;
+
+	if (n_pol == 0) return;
+	band_h = ny;
+#ifdef _OPENMP
+	{
+		int n_threads = omp_get_max_threads ();
+		band_h = (ny + GRDLANDMASK_BANDS_PER_THREAD * n_threads - 1) / (GRDLANDMASK_BANDS_PER_THREAD * n_threads);
+		n_bands = (ny + band_h - 1) / band_h;
+	}
+#endif
+	b_start = GMT_memory (GMT, NULL, n_bands + 1, uint64_t);
+	b_next  = GMT_memory (GMT, NULL, n_bands, uint64_t);
+	for (k = 0; k < n_pol; k++)	/* Count polygons per band */
+		for (band = L[k].row_min / band_h; band <= L[k].row_max / band_h; band++) b_start[band+1]++;
+	for (band = 0; band < n_bands; band++) b_start[band+1] += b_start[band];
+	for (band = 0; band < n_bands; band++) b_next[band] = b_start[band];
+	b_list = GMT_memory (GMT, NULL, b_start[n_bands], uint64_t);
+	for (k = 0; k < n_pol; k++)	/* Fill band lists */
+		for (band = L[k].row_min / band_h; band <= L[k].row_max / band_h; band++) b_list[b_next[band]++] = k;
+
+#ifdef _OPENMP
+#pragma omp parallel for private(band,p,k) shared(GMT,Grid,L,x,y,inside,b_start,b_list,band_h,n_bands,ny) schedule(dynamic,1)
+#endif
+	for (band = 0; band < n_bands; band++) {
+		int row, col, r0 = band * band_h, r1 = MIN (r0 + band_h, ny) - 1;
+		unsigned int *side = GMT_memory (GMT, NULL, Grid->header->nx, unsigned int);
+		uint64_t ij;
+		for (p = b_start[band]; p < b_start[band+1]; p++) {
+			k = (unsigned int)b_list[p];
+			for (row = MAX (L[k].row_min, r0); row <= MIN (L[k].row_max, r1); row++) {
+				if (GMT_inonout_row (GMT, L[k].P, y[row], &x[L[k].col_min], L[k].col_max - L[k].col_min + 1, side) == 0) continue;	/* Row misses the polygon */
+				for (col = L[k].col_min; col <= L[k].col_max; col++) {
+					if (side[col-L[k].col_min] < inside) continue;	/* Outside */
+					/* Here, point is inside, we must assign value */
+					ij = GMT_IJP (Grid->header, row, col);
+					if (L[k].level > Grid->data[ij]) Grid->data[ij] = (float)L[k].level;
+				}
+			}
+		}
+		GMT_free (GMT, side);
+	}
+
+	for (k = 0; k < n_pol; k++) GMT_free_prepared_polygon (GMT, &L[k].P);
+	GMT_free (GMT, b_start);
+	GMT_free (GMT, b_next);
+	GMT_free (GMT, b_list);
+}
+
 #define bailout(code) {GMT_Free_Options (mode); return (code);}
 #define Return(code) {Free_grdlandmask_Ctrl (GMT, Ctrl); GMT_end_module (GMT, GMT_cpy); bailout (code);}
 
 int GMT_grdlandmask (void *V_API, int mode, void *args)
 {
 	bool temp_shift = false, wrap, used_polygons;
-	unsigned int base = 3, k, bin, np, side, np_new;
+	unsigned int base = 3, k, bin, np, np_new, n_queued = 0;
 	int row, row_min, row_max, ii, col, col_min, col_max, i, direction, err, ind, nx1, ny1, error = 0;
 	
-	uint64_t ij;
+	uint64_t ij, n_queued_edges = 0;
+	size_t n_alloc = 0;
 
 	char line[GMT_LEN256] = {""};
 	char *shore_resolution[5] = {"full", "high", "intermediate", "low", "crude"};
@@ -241,6 +305,7 @@ int GMT_grdlandmask (void *V_API, int mode, void *args)
 	struct GMT_SHORE c;
 	struct GMT_GRID *Grid = NULL;
 	struct GMT_GSHHS_POL *p = NULL;
+	struct GRDLANDMASK_POLYGON *L = NULL;
 	struct GRDLANDMASK_CTRL *Ctrl = NULL;
 	struct GMT_CTRL *GMT = NULL, *GMT_cpy = NULL;
 	struct GMT_OPTION *options = NULL;
@@ -388,18 +453,20 @@ int GMT_grdlandmask (void *V_API, int mode, void *args)
 				/* So row_min is in range [0,?] */
 				row_max = MIN (ny1, irint (floor ((GMT->current.proj.rect[YHI] - ymin) * i_dy_inch - Grid->header->xy_off + GMT_CONV8_LIMIT)));
 				/* So row_max is in range [?,ny1] */
-
-				for (row = row_min; row <= row_max; row++) {
-					assert (row >= 0);	/* Just in case we have a logic bug somewhere */
-					for (col = col_min; col <= col_max; col++) {
-
-						if ((side = GMT_non_zero_winding (GMT, x[col], y[row], p[k].lon, p[k].lat, p[k].n)) < Ctrl->E.inside) continue;	/* Outside */
-
-						/* Here, point is inside, we must assign value */
-
-						ij = GMT_IJP (Grid->header, row, col);
-						if (p[k].level > Grid->data[ij]) Grid->data[ij] = (float)p[k].level;
-					}
+				if (row_max < row_min) continue;	/* No rows to scan */
+				assert (row_min >= 0);	/* Just in case we have a logic bug somewhere */
+
+				/* Queue the polygon; the queue is rasterized in parallel by grdlandmask_fill */
+
+				if (n_queued == n_alloc) L = GMT_malloc (GMT, L, n_queued, &n_alloc, struct GRDLANDMASK_POLYGON);
+				L[n_queued].P = GMT_prepare_polygon (GMT, p[k].lon, p[k].lat, p[k].n);
+				L[n_queued].level = p[k].level;
+				L[n_queued].row_min = row_min;	L[n_queued].row_max = row_max;
+				L[n_queued].col_min = col_min;	L[n_queued].col_max = col_max;
+				n_queued++;
+				if ((n_queued_edges += p[k].n) >= GRDLANDMASK_MAX_EDGES) {	/* Limit the memory held by the queue */
+					grdlandmask_fill (GMT, Grid, L, n_queued, x, y, Ctrl->E.inside);
+					n_queued = 0;	n_queued_edges = 0;
 				}
 			}
 
@@ -408,6 +475,9 @@ int GMT_grdlandmask (void *V_API, int mode, void *args)
 		}
 
 		if (!used_polygons) {	/* Lack of polygons or clipping etc resulted in no polygons after all, must deal with background */
+			/* The background overwrites the nodes of this bin, so the polygons queued so far must be done first */
+			grdlandmask_fill (GMT, Grid, L, n_queued, x, y, Ctrl->E.inside);
+			n_queued = 0;	n_queued_edges = 0;
 			k = INT_MAX;	/* Initialize to outside range of levels (4 is highest) */
 			/* Visit each of the 4 nodes, test if it is inside -R, and if so update lowest level found so far */
 
@@ -456,13 +526,21 @@ int GMT_grdlandmask (void *V_API, int mode, void *args)
 		GMT_free_shore (GMT, &c);
 	}
 
+	grdlandmask_fill (GMT, Grid, L, n_queued, x, y, Ctrl->E.inside);	/* Rasterize the remaining polygons */
+	if (L) GMT_free (GMT, L);
+
 	GMT_shore_cleanup (GMT, &c);
 	GMT_free (GMT, x);
 	GMT_free (GMT, y);
 
-	GMT_grd_loop (GMT, Grid, row, col, ij) {	/* Turn levels into mask values */
-		k = urint (Grid->data[ij]);
-		Grid->data[ij] = (float)Ctrl->N.mask[k];
+#ifdef _OPENMP
+#pragma omp parallel for private(row,col,ij,k) shared(GMT,Grid,Ctrl)
+#endif
+	for (row = 0; row < (int)Grid->header->ny; row++) {	/* Turn levels into mask values */
+		for (col = 0, ij = GMT_IJP (Grid->header, row, 0); col < (int)Grid->header->nx; col++, ij++) {
+			k = urint (Grid->data[ij]);
+			Grid->data[ij] = (float)Ctrl->N.mask[k];
+		}
 	}
 
 	if (wrap && Grid->header->registration == GMT_GRID_NODE_REG) { /* Copy over values to the repeating right column */
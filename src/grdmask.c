@@ -235,7 +235,7 @@ int GMT_grdmask_parse (struct GMT_CTRL *GMT, struct GRDMASK_CTRL *Ctrl, struct G
 int GMT_grdmask (void *V_API, int mode, void *args)
 {
 	bool periodic = false, periodic_grid = false, do_test = true;
-	unsigned int side = 0, *d_col = NULL, d_row = 0, col_0, row_0;
+	unsigned int side = 0, *d_col = NULL, d_row = 0, col_0, row_0, *node_side = NULL;
 	unsigned int tbl, gmode, n_pol = 0, max_d_col = 0, n_cols = 2;
 	int row, col, nx, ny, error = 0;
 	
@@ -250,6 +250,7 @@ int GMT_grdmask (void *V_API, int mode, void *args)
 	struct GMT_GRID *Grid = NULL;
 	struct GMT_DATASET *Din = NULL, *D = NULL;
 	struct GMT_DATASEGMENT *S = NULL;
+	struct GMT_PREPARED_POLYGON *P = NULL;
 	struct GRDMASK_CTRL *Ctrl = NULL;
 	struct GMT_CTRL *GMT = NULL, *GMT_cpy = NULL;
 	struct GMT_OPTION *options = NULL;
@@ -322,6 +323,10 @@ int GMT_grdmask (void *V_API, int mode, void *args)
 		char *method[2] = {"Cartesian non-zero winding", "spherical ray-intersection"};
 		int use = GMT_is_geographic (GMT, GMT_IN);
 		GMT_Report (API, GMT_MSG_VERBOSE, "Node status w.r.t. the polygon(s) will be determined using a %s algorithm.\n", method[use]);
+		if (!use) {	/* Cartesian polygons are scanned a whole row at a time */
+			grd_x0 = GMT_grd_coord (GMT, Grid->header, GMT_X);
+			node_side = GMT_memory (GMT, NULL, Grid->header->nx, unsigned int);
+		}
 	}
 	
 	
@@ -413,6 +418,27 @@ int GMT_grdmask (void *V_API, int mode, void *args)
 				else if (Ctrl->N.mode)	/* 3 or 4; Increment running polygon ID */
 					z_value += 1.0;
 
+				if (!periodic) {	/* Cartesian case: Fill the spans between the polygon crossings of each row */
+					P = GMT_prepare_segment (GMT, S);	/* Bin the edges (and those of any holes) by y */
+					for (row = 0; row < ny; row++) {
+						yy = GMT_grd_row_to_y (GMT, row, Grid->header);
+						if (yy < S->min[GMT_Y] || yy > S->max[GMT_Y]) continue;	/* Outside y-range of polygon */
+						if (GMT_inonout_row (GMT, P, yy, grd_x0, Grid->header->nx, node_side) == 0) continue;	/* No nodes inside or on edge */
+						for (col = 0; col < nx; col++) {
+							if ((side = node_side[col]) == GMT_OUTSIDE) continue;	/* Outside polygon, go to next point */
+							/* Here, point is inside or on edge, we must assign value */
+
+							ij = GMT_IJP (Grid->header, row, col);
+
+							if (Ctrl->N.mode%2 && side == GMT_ONEDGE) continue;	/* Not counting the edge as part of polygon for ID tagging for mode 1 | 3 */
+							Grid->data[ij] = (Ctrl->N.mode) ? (float)z_value : mask_val[side];
+						}
+						GMT_Report (API, GMT_MSG_VERBOSE, "Polygon %d scanning row %05d\r", n_pol, row);
+					}
+					GMT_free_prepared_polygon (GMT, &P);
+					continue;
+				}
+
 				for (row = 0; row < ny; row++) {
 
 					yy = GMT_grd_row_to_y (GMT, row, Grid->header);
@@ -466,6 +492,10 @@ int GMT_grdmask (void *V_API, int mode, void *args)
 		GMT_free (GMT, grd_x0);
 		GMT_free (GMT, grd_y0);
 	}
+	else if (node_side) {
+		GMT_free (GMT, grd_x0);
+		GMT_free (GMT, node_side);
+	}
 
 	Return (GMT_OK);
 }
@@ -3315,6 +3315,91 @@ void grd_ZDIST (struct GMT_CTRL *GMT, struct GRDMATH_INFO *info, struct GRDMATH_
 #define Return1(code) {GMT_Destroy_Options (API, &list); Free_grdmath_Ctrl (GMT, Ctrl); GMT_end_module (GMT, GMT_cpy); bailout (code);}
 #define Return(code) {GMT_Destroy_Options (API, &list); Free_grdmath_Ctrl (GMT, Ctrl); grdmath_free (GMT, stack, recall, &info); GMT_end_module (GMT, GMT_cpy); bailout (code);}
 
+/* Most operators are simple node-by-node loops over the grid.  Rather than
+ * sweeping through every full-size stack grid once per operator, we queue
+ * consecutive runs of such operators and later execute the whole run one
+ * cache-sized tile at a time, so that intermediate results stay in cache.
+ * The operator functions are called unchanged on tile-sized views of their
+ * operand grids, hence results are identical to the one-at-a-time path.
+ * Operators that need neighbors, rows/cols, the whole grid or random numbers
+ * (and those reporting data-dependent warnings) are not queued and act as barriers. */
+
+#define GRDMATH_TILE_SIZE	32768U	/* Nodes per tile (128 kb per float grid) */
+#define GRDMATH_MAX_PENDING	256U	/* Max operators queued before forcing a flush */
+#define GRDMATH_MAX_ARGS	3U	/* Max operands consumed by a queued operator */
+
+static char *grdmath_tile_ops[] = {"ACOS", "ACOSH", "ACOT", "ACSC", "ADD", "AND", "ASEC", "ASIN", "ASINH", "ATAN", "ATAN2", "ATANH",
+	"BEI", "BER", "CEIL", "COS", "COSD", "COSH", "COT", "COTD", "CSC", "CSCD", "D2R", "DEG2KM", "DILOG", "DIV", "EQ", "ERF", "ERFC", "ERFINV", "EXP", "FLOOR", "FMOD", "GE", "GT",
+	"HYPOT", "I0", "I1", "IFELSE", "IN", "INRANGE", "ISFINITE", "ISNAN", "J0", "J1", "JN", "K0", "K1", "KM2DEG", "KN", "LE",
+	"LOG", "LOG10", "LOG1P", "LOG2", "LT", "MAX", "MIN", "MOD", "MUL", "NAN", "NEG", "NEQ", "NOT", "OR", "PSI", "R2", "R2D",
+	"RINT", "SEC", "SECD", "SIGN", "SIN", "SINC", "SIND", "SINH", "SQR", "SQRT", "STEP", "SUB", "TAN", "TAND", "TANH", "TN",
+	"XOR", "Y0", "Y1", "YN", "ZCRIT", "ZDIST", NULL};	/* BIT* operators count truncations over the whole grid so are left out */
+
+struct GRDMATH_PENDING {	/* An operator waiting to be applied tile by tile */
+	unsigned int op;				/* Operator id */
+	unsigned int n_args;				/* Number of operands consumed */
+	struct GRDMATH_STACK arg[GRDMATH_MAX_ARGS];	/* Snapshot of the operands at the time of the call */
+};
+
+void grdmath_set_tile_ops (char *operator[], unsigned int consumed[], unsigned int produced[], bool tile_op[]) {
+	/* Flag the operators that may be queued and executed per tile */
+	unsigned int op, k;
+	for (op = 0; op < GRDMATH_N_OPERATORS; op++) {
+		tile_op[op] = false;
+		if (consumed[op] == 0 || consumed[op] > GRDMATH_MAX_ARGS || produced[op] != 1) continue;
+		for (k = 0; grdmath_tile_ops[k] && strcmp (operator[op], grdmath_tile_ops[k]); k++);
+		tile_op[op] = (grdmath_tile_ops[k] != NULL);
+	}
+}
+
+void grdmath_run_tile (struct GMT_CTRL *GMT, struct GRDMATH_INFO *info, struct GRDMATH_PENDING *P, unsigned int n_pending, void (*call_operator[]) (struct GMT_CTRL *, struct GRDMATH_INFO *, struct GRDMATH_STACK **, unsigned int), uint64_t start, uint64_t n) {
+	/* Apply all pending operators to the n nodes starting at node start */
+	unsigned int p, k;
+	struct GRDMATH_INFO tile_info = *info;
+	struct GRDMATH_STACK item[GRDMATH_MAX_ARGS], *tile_stack[GRDMATH_MAX_ARGS];
+	struct GMT_GRID grid[GRDMATH_MAX_ARGS];
+
+	tile_info.size = n;
+	for (p = 0; p < n_pending; p++) {
+		for (k = 0; k < P[p].n_args; k++) {
+			item[k] = P[p].arg[k];
+			if (item[k].G) {	/* Let a local grid struct point to this tile of the operand */
+				grid[k] = *P[p].arg[k].G;
+				grid[k].data = P[p].arg[k].G->data + start;
+				item[k].G = &grid[k];
+			}
+			tile_stack[k] = &item[k];
+		}
+		(*call_operator[P[p].op]) (GMT, &tile_info, tile_stack, P[p].n_args - 1);
+	}
+}
+
+void grdmath_flush (struct GMT_CTRL *GMT, struct GRDMATH_INFO *info, struct GRDMATH_PENDING *P, unsigned int *n_pending, void (*call_operator[]) (struct GMT_CTRL *, struct GRDMATH_INFO *, struct GRDMATH_STACK **, unsigned int)) {
+	/* Execute the queued operators tile by tile, then empty the queue */
+	int64_t tile, n_tiles;
+	unsigned int verbose[2];
+	uint64_t start, n;
+
+	if (*n_pending == 0) return;
+	n_tiles = (int64_t)((info->size + GRDMATH_TILE_SIZE - 1) / GRDMATH_TILE_SIZE);
+
+	/* Do the first tile alone so any warnings about constant operands are issued once, then silence the rest */
+	n = MIN (info->size, GRDMATH_TILE_SIZE);
+	grdmath_run_tile (GMT, info, P, *n_pending, call_operator, 0, n);
+	verbose[0] = GMT->current.setting.verbose;	verbose[1] = GMT->parent->verbose;
+	GMT->current.setting.verbose = GMT->parent->verbose = GMT_MSG_QUIET;
+#ifdef _OPENMP
+#pragma omp parallel for private(tile,start,n) shared(GMT,info,P,n_pending,call_operator,n_tiles) schedule(static) if (n_tiles > 2)
+#endif
+	for (tile = 1; tile < n_tiles; tile++) {
+		start = (uint64_t)tile * GRDMATH_TILE_SIZE;
+		n = MIN (info->size - start, GRDMATH_TILE_SIZE);
+		grdmath_run_tile (GMT, info, P, *n_pending, call_operator, start, n);
+	}
+	GMT->current.setting.verbose = verbose[0];	GMT->parent->verbose = verbose[1];
+	*n_pending = 0;
+}
+
 int decode_grd_argument (struct GMT_CTRL *GMT, struct GMT_OPTION *opt, double *value, struct GMT_HASH *H)
 {
 	int i, expect, check = GMT_IS_NAN;
@@ -3427,15 +3512,16 @@ void grdmath_free (struct GMT_CTRL *GMT, struct GRDMATH_STACK *stack[], struct G
 int GMT_grdmath (void *V_API, int mode, void *args)
 {
 	int k, op = 0, new_stack = -1, rowx, colx, status, start, error = 0;
-	unsigned int kk, nstack = 0, n_stored = 0, n_items = 0, this_stack;
+	unsigned int kk, nstack = 0, n_stored = 0, n_items = 0, this_stack, n_pending = 0;
 	unsigned int consumed_operands[GRDMATH_N_OPERATORS], produced_operands[GRDMATH_N_OPERATORS];
-	bool subset;
+	bool subset, tile_op[GRDMATH_N_OPERATORS];
 	char *in_file = NULL, *label = NULL;
 
 	uint64_t node, row, col;
 
 	struct GRDMATH_STACK *stack[GRDMATH_STACK_SIZE];
 	struct GRDMATH_STORE *recall[GRDMATH_STORE_SIZE];
+	struct GRDMATH_PENDING pending[GRDMATH_MAX_PENDING];
 	struct GMT_GRID *G_in = NULL;
 
 	double value, x_noise, y_noise, off, scale;
@@ -3599,6 +3685,7 @@ int GMT_grdmath (void *V_API, int mode, void *args)
 	}
 
 	grdmath_init (call_operator, consumed_operands, produced_operands);
+	grdmath_set_tile_ops (operator, consumed_operands, produced_operands, tile_op);
 
 	special_symbol[GRDMATH_ARG_IS_PI-GRDMATH_ARG_IS_PI] = M_PI;
 	special_symbol[GRDMATH_ARG_IS_PI-GRDMATH_ARG_IS_E] = M_E;
@@ -3631,6 +3718,7 @@ int GMT_grdmath (void *V_API, int mode, void *args)
 			}
 
 			if (GMT_is_verbose (GMT, GMT_MSG_VERBOSE)) GMT_Message (API, GMT_TIME_NONE, "= %s", opt->arg);
+			grdmath_flush (GMT, &info, pending, &n_pending, call_operator);	/* Finish any queued operators */
 
 			if (n_items && new_stack < 0 && stack[nstack-1]->constant) {	/* Only a constant provided, set grid accordingly */
 				if (!stack[nstack-1]->G) stack[nstack-1]->G = alloc_stack_grid (GMT, info.G);
@@ -3679,7 +3767,10 @@ int GMT_grdmath (void *V_API, int mode, void *args)
 				nstack++;
 				continue;
 			}
-			else if (op == GRDMATH_ARG_IS_STORE) {
+
+			grdmath_flush (GMT, &info, pending, &n_pending, call_operator);	/* Finish queued operators before grids are read, copied or overwritten */
+
+			if (op == GRDMATH_ARG_IS_STORE) {
 				/* Duplicate stack into stored memory location associated with specified label */
 				int last = nstack - 1;
 				bool added_new = false;
@@ -3838,13 +3929,24 @@ int GMT_grdmath (void *V_API, int mode, void *args)
 			}
 		}
 
-		(*call_operator[op]) (GMT, &info, stack, nstack - 1);	/* Do it */
+		if (tile_op[op]) {	/* Queue it for tiled execution; the operand snapshot is taken before stack states are updated below */
+			if (n_pending == GRDMATH_MAX_PENDING) grdmath_flush (GMT, &info, pending, &n_pending, call_operator);
+			pending[n_pending].op = op;
+			pending[n_pending].n_args = consumed_operands[op];
+			for (kk = 0, k = nstack - consumed_operands[op]; kk < consumed_operands[op]; kk++, k++) pending[n_pending].arg[kk] = *stack[k];
+			n_pending++;
+		}
+		else {
+			grdmath_flush (GMT, &info, pending, &n_pending, call_operator);	/* Must finish queued operators first */
+			(*call_operator[op]) (GMT, &info, stack, nstack - 1);	/* Do it */
+		}
 
 		if (info.error) Return (info.error);	/* Got an error inside the operator */
 
 		nstack = new_stack;
 		for (kk = 1; kk <= produced_operands[op]; kk++) stack[nstack-kk]->constant = false;	/* Now filled with grid */
 	}
+	grdmath_flush (GMT, &info, pending, &n_pending, call_operator);	/* In case operators are still queued */
 
 	/* Clean-up time */
 
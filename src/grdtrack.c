@@ -49,9 +49,39 @@ enum grdtrack_enum_opt {STACK_ADD_VAL = 0,	/* +a: Append stacked value(s) at end
 	STACK_ADD_TBL,				/* +s: Write stacked profile to given <file> */
 	STACK_N_OPT};				/* Total number of modifiers */
 
+#define GRDTRACK_N_BUF	65536U	/* Number of input records sampled together in the standard point case */
+#define GRDTRACK_TILE	64	/* Points are sorted by tiles of GRDTRACK_TILE x GRDTRACK_TILE nodes before sampling */
+
 struct GRD_CONTAINER {	/* Keep all the grid and sample parameters together */
 	struct GMT_GRID *G;
 	int type;	/* 0 = regular grid, 1 = img grid */
+	unsigned int group;	/* Index of first grid with identical type and header; these share bcr weights */
+};
+
+struct GRDTRACK_BCR {	/* Kernel node and weights of one point for one group of grids */
+	uint64_t ij;		/* Upper left node of the convolution kernel */
+	double wx[4], wy[4];	/* The bcr weights */
+	bool inside;		/* true if point falls inside this group's domain */
+	bool valid;		/* true if weights were set (i.e., point was not rejected) */
+};
+
+struct GRDTRACK_POINT {	/* Used to sort points by grid tile */
+	uint64_t tile;		/* Tile number in the first grid, or UINT64_MAX if outside */
+	uint64_t rec;		/* Original point number */
+};
+
+struct GRDTRACK_BATCH {	/* Work arrays for sampling many points at once */
+	uint64_t n_alloc;		/* Number of points allocated */
+	double *value;			/* n_alloc * n_grids sampled values, in original point order */
+	int *status;			/* Return value of sample_all_grids per point */
+	struct GRDTRACK_POINT *P;	/* Points in tile order */
+};
+
+struct GRDTRACK_RECORD {	/* Buffered input record in the standard point case */
+	double *in;		/* Copy of the numerical columns */
+	char *text;		/* Trailing text of ascii records, or NULL */
+	int n_fields;		/* Number of fields returned by GMT_Get_Record */
+	unsigned int n_alloc;	/* Allocated length of in */
 };
 
 struct GMT_ZSEARCH {	/* For -T */
@@ -494,43 +524,87 @@ unsigned int get_dist_units (struct GMT_CTRL *GMT, char *args, char *unit, unsig
 	return (error);
 }
 
-int sample_all_grids (struct GMT_CTRL *GMT, struct GRD_CONTAINER *GC, unsigned int n_grids, bool img, double x_in, double y_in, double value[])
+bool grdtrack_same_header (struct GMT_GRID_HEADER *A, struct GMT_GRID_HEADER *B)
+{
+	/* Returns true if two grids have the same layout and interpolant so that
+	   points map to the same kernel node and weights in both */
+	if (A->nx != B->nx || A->ny != B->ny || A->mx != B->mx || A->registration != B->registration) return (false);
+	if (A->bcr_interpolant != B->bcr_interpolant || A->bcr_n != B->bcr_n) return (false);
+	if (A->nxp != B->nxp || A->nyp != B->nyp) return (false);
+	if (memcmp (A->wesn, B->wesn, 4 * sizeof (double)) || memcmp (A->inc, B->inc, 2 * sizeof (double)) || memcmp (A->pad, B->pad, 4 * sizeof (unsigned int))) return (false);
+	return (true);
+}
+
+void grdtrack_set_groups (struct GMT_CTRL *GMT, struct GRD_CONTAINER *GC, unsigned int n_grids)
 {
-	unsigned int g, n_in, n_set;
+	/* Assign each grid to the first grid with identical type and header */
+	unsigned int g, k, n_groups = 0;
+
+	for (g = 0; g < n_grids; g++) {
+		GC[g].group = g;
+		for (k = 0; k < g && GC[g].group == g; k++) {
+			if (GC[k].group == k && GC[k].type == GC[g].type && grdtrack_same_header (GC[k].G->header, GC[g].G->header)) GC[g].group = k;
+		}
+		if (GC[g].group == g) n_groups++;
+	}
+	GMT_Report (GMT->parent, GMT_MSG_LONG_VERBOSE, "%u grids share %u distinct grid layouts\n", n_grids, n_groups);
+}
+
+bool grdtrack_wrap_point (struct GMT_CTRL *GMT, struct GRD_CONTAINER *C, double x_in, double y_in, double x0, double y0, double *x_out, double *y_out)
+{
+	/* Determine the coordinates of the point in this grid's domain.  If point is outside grd area,
+	 * shift it using periodicity or return false if not periodic.  x0,y0 are Mercator coordinates for img grids */
+	double x, y;
+	struct GMT_GRID_HEADER *h = C->G->header;
+
+	y = (C->type == 1) ? y0 : y_in;
+	while ((y < h->wesn[YLO]) && (h->nyp > 0)) y += (h->inc[GMT_Y] * h->nyp);
+	if (y < h->wesn[YLO]) return (false);
+
+	while ((y > h->wesn[YHI]) && (h->nyp > 0)) y -= (h->inc[GMT_Y] * h->nyp);
+	if (y > h->wesn[YHI]) return (false);
+
+	if (C->type == 1) {	/* This grid is in Mercator x/y units - must use Mercator x0, y0 */
+		x = x0;
+		if (x > h->wesn[XHI]) x -= 360.0;
+	}
+	else {	/* Regular Cartesian x,y or lon,lat */
+		x = x_in;
+		if (GMT_is_geographic (GMT, GMT_IN)) {	/* Must wind lonn/lat to fit current grid longitude range */
+			while (x > h->wesn[XHI]) x -= 360.0;
+			while (x < h->wesn[XLO]) x += 360.0;
+		}
+	}
+	while ((x < h->wesn[XLO]) && (h->nxp > 0)) x += (h->inc[GMT_X] * h->nxp);
+	if (x < h->wesn[XLO]) return (false);
+
+	while ((x > h->wesn[XHI]) && (h->nxp > 0)) x -= (h->inc[GMT_X] * h->nxp);
+	if (x > h->wesn[XHI]) return (false);
+
+	*x_out = x;	*y_out = y;
+	return (true);
+}
+
+int sample_all_grids (struct GMT_CTRL *GMT, struct GRD_CONTAINER *GC, unsigned int n_grids, bool img, double x_in, double y_in, double value[], struct GRDTRACK_BCR *B)
+{
+	/* Sample all grids at this point.  The kernel node and weights are only computed
+	 * for the first grid in each group of identical grids; B must hold n_grids items */
+	unsigned int g, k, n_in, n_set;
 	double x, y, x0 = 0.0, y0 = 0.0;
 	
 	if (img) GMT_geo_to_xy (GMT, x_in, y_in, &x0, &y0);	/* At least one Mercator IMG grid in use - get Mercator coordinates x,y */
 
 	for (g = n_in = n_set = 0; g < n_grids; g++) {
-		y = (GC[g].type == 1) ? y0 : y_in;
 		value[g] = GMT->session.d_NaN;	/* In case the point is outside only some of the grids */
-		/* If point is outside grd area, shift it using periodicity or skip if not periodic. */
-
-		while ((y < GC[g].G->header->wesn[YLO]) && (GC[g].G->header->nyp > 0)) y += (GC[g].G->header->inc[GMT_Y] * GC[g].G->header->nyp);
-		if (y < GC[g].G->header->wesn[YLO]) continue;
-
-		while ((y > GC[g].G->header->wesn[YHI]) && (GC[g].G->header->nyp > 0)) y -= (GC[g].G->header->inc[GMT_Y] * GC[g].G->header->nyp);
-		if (y > GC[g].G->header->wesn[YHI]) continue;
-
-		if (GC[g].type == 1) {	/* This grid is in Mercator x/y units - must use Mercator x0, y0 */
-			x = x0;
-			if (x > GC[g].G->header->wesn[XHI]) x -= 360.0;
-		}
-		else {	/* Regular Cartesian x,y or lon,lat */
-			x = x_in;
-			if (GMT_is_geographic (GMT, GMT_IN)) {	/* Must wind lonn/lat to fit current grid longitude range */
-				while (x > GC[g].G->header->wesn[XHI]) x -= 360.0;
-				while (x < GC[g].G->header->wesn[XLO]) x += 360.0;
-			}
+		k = GC[g].group;
+		if (k == g) {	/* First grid in this group; determine location and weights */
+			B[k].inside = grdtrack_wrap_point (GMT, &GC[g], x_in, y_in, x0, y0, &x, &y);
+			B[k].valid = (B[k].inside && GMT_get_bcr_weights (GC[g].G->header, x, y, &B[k].ij, B[k].wx, B[k].wy) == 0);
 		}
-		while ((x < GC[g].G->header->wesn[XLO]) && (GC[g].G->header->nxp > 0)) x += (GC[g].G->header->inc[GMT_X] * GC[g].G->header->nxp);
-		if (x < GC[g].G->header->wesn[XLO]) continue;
-
-		while ((x > GC[g].G->header->wesn[XHI]) && (GC[g].G->header->nxp > 0)) x -= (GC[g].G->header->inc[GMT_X] * GC[g].G->header->nxp);
-		if (x > GC[g].G->header->wesn[XHI]) continue;
+		if (!B[k].inside) continue;
 
 		n_in++;	/* This point is inside the current grid's domain */
-		value[g] = GMT_get_bcr_z (GMT, GC[g].G, x, y);
+		if (B[k].valid) value[g] = GMT_get_bcr_z_weights (GMT, GC[g].G, B[k].ij, B[k].wx, B[k].wy);
 
 		if (!GMT_is_dnan (value[g])) n_set++;	/* Count value results */
 	}
@@ -539,6 +613,98 @@ int sample_all_grids (struct GMT_CTRL *GMT, struct GRD_CONTAINER *GC, unsigned i
 	return (n_set);
 }
 
+int grdtrack_point_comp (const void *p_1, const void *p_2)
+{
+	/* Sort on tile, then on original order */
+	const struct GRDTRACK_POINT *point_1 = p_1, *point_2 = p_2;
+	if (point_1->tile < point_2->tile) return (-1);
+	if (point_1->tile > point_2->tile) return (+1);
+	if (point_1->rec < point_2->rec) return (-1);
+	if (point_1->rec > point_2->rec) return (+1);
+	return (0);
+}
+
+void sample_batch (struct GMT_CTRL *GMT, struct GRD_CONTAINER *GC, unsigned int n_grids, bool img, double *x_in, double *y_in, uint64_t n, struct GRDTRACK_BATCH *W)
+{
+	/* Sample all grids at n points.  Points are first sorted by the tile they fall in
+	 * (in the first grid) so that nearby points are evaluated together, then processed
+	 * in parallel.  Results are stored in W->value and W->status in the original order */
+	int64_t k;
+	uint64_t n_tiles_x;
+	struct GMT_GRID_HEADER *h = GC[0].G->header;
+
+	if (n == 0) return;
+	if (n > W->n_alloc) {
+		W->n_alloc = n;
+		W->value = GMT_memory (GMT, W->value, W->n_alloc * n_grids, double);
+		W->status = GMT_memory (GMT, W->status, W->n_alloc, int);
+		W->P = GMT_memory (GMT, W->P, W->n_alloc, struct GRDTRACK_POINT);
+	}
+	n_tiles_x = (h->mx + GRDTRACK_TILE - 1) / GRDTRACK_TILE;
+
+#ifdef _OPENMP
+#pragma omp parallel for private(k) shared(GMT,GC,img,x_in,y_in,n,W,h,n_tiles_x)
+#endif
+	for (k = 0; k < (int64_t)n; k++) {	/* Determine the tile for each point */
+		int64_t row, col;
+		double x, y, x0 = 0.0, y0 = 0.0;
+		W->P[k].rec = k;
+		W->P[k].tile = UINT64_MAX;
+		if (GC[0].type == 1) GMT_geo_to_xy (GMT, x_in[k], y_in[k], &x0, &y0);
+		if (!grdtrack_wrap_point (GMT, &GC[0], x_in[k], y_in[k], x0, y0, &x, &y)) continue;
+		col = (int64_t)floor ((x - h->wesn[XLO]) * h->r_inc[GMT_X]);
+		row = (int64_t)floor ((h->wesn[YHI] - y) * h->r_inc[GMT_Y]);
+		if (col < 0) col = 0;
+		if (row < 0) row = 0;
+		W->P[k].tile = (row / GRDTRACK_TILE) * n_tiles_x + col / GRDTRACK_TILE;
+	}
+	qsort (W->P, n, sizeof (struct GRDTRACK_POINT), grdtrack_point_comp);
+
+#ifdef _OPENMP
+#pragma omp parallel shared(GMT,GC,n_grids,img,x_in,y_in,n,W)
+#endif
+	{
+		int64_t i;
+		uint64_t rec;
+		struct GRDTRACK_BCR *B = GMT_memory (GMT, NULL, n_grids, struct GRDTRACK_BCR);	/* Per-thread weights */
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,1024)
+#endif
+		for (i = 0; i < (int64_t)n; i++) {	/* Sample in tile order */
+			rec = W->P[i].rec;
+			W->status[rec] = sample_all_grids (GMT, GC, n_grids, img, x_in[rec], y_in[rec], &W->value[rec*n_grids], B);
+		}
+		GMT_free (GMT, B);
+	}
+}
+
+uint64_t sample_segment (struct GMT_CTRL *GMT, struct GRD_CONTAINER *GC, unsigned int n_grids, bool img, struct GMT_DATASEGMENT *S, double **z, struct GRDTRACK_BATCH *W, bool *some_outside)
+{
+	/* Sample all grids along the segment S and place the results in z[0..n_grids-1].
+	 * Returns the number of points inside the domain of at least one grid */
+	unsigned int g;
+	uint64_t row, n_inside = 0;
+
+	sample_batch (GMT, GC, n_grids, img, S->coord[GMT_X], S->coord[GMT_Y], S->n_rows, W);
+	for (row = 0; row < S->n_rows; row++) {
+		for (g = 0; g < n_grids; g++) z[g][row] = W->value[row*n_grids+g];
+		if (W->status[row] < 0)
+			*some_outside = true;
+		else
+			n_inside++;
+	}
+	return (n_inside);
+}
+
+void free_batch (struct GMT_CTRL *GMT, struct GRDTRACK_BATCH *W)
+{
+	if (W->n_alloc == 0) return;
+	GMT_free (GMT, W->value);
+	GMT_free (GMT, W->status);
+	GMT_free (GMT, W->P);
+	W->n_alloc = 0;
+}
+
 /* The following two scanners are used below in the gmt_grdspiral_search */
 
 unsigned int scan_grd_row (struct GMT_CTRL *GMT, int64_t row, int64_t l_col, int64_t r_col, struct GMT_ZSEARCH *S)
@@ -670,8 +836,9 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 	
 	char line[GMT_BUFSIZ] = {""}, run_cmd[BUFSIZ] = {""}, *cmd = NULL;
 
-	double *value, wesn[4];
+	double *value = NULL, wesn[4];
 
+	struct GRDTRACK_BATCH W;
 	struct GRDTRACK_CTRL *Ctrl = NULL;
 	struct GRD_CONTAINER *GC = NULL;
 	struct GMT_DATASET *Din = NULL, *Dout = NULL;
@@ -738,6 +905,8 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 			img_conv_needed = true;
 		}
 	}
+	grdtrack_set_groups (GMT, GC, Ctrl->G.n_grids);	/* Grids with identical headers share the interpolation weights */
+	GMT_memset (&W, 1, struct GRDTRACK_BATCH);
 	
 	if (Ctrl->E.active) {	/* Create profiles rather than read them */
 		double xyz[2][3];
@@ -774,8 +943,6 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 		Din->n_columns = Din->table[0]->n_columns;	/* Since could have changed via +d */
 	}
 	
-	value = GMT_memory (GMT, NULL, Ctrl->G.n_grids, double);
-
 	if (Ctrl->C.active) {	/* Special case of requesting cross-profiles for given line segments */
 		uint64_t tbl, col, row, seg, n_cols = Ctrl->G.n_grids;
 		struct GMT_DATASET *Dtmp = NULL;
@@ -810,11 +977,7 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 				T = Dtmp->table[tbl];
 				for (seg = 0; seg < T->n_segments; seg++) {	/* For each segment to resample */
 					S = T->segment[seg];
-					for (row = 0; row < S->n_rows; row++) {	/* For each row to resample */
-						status = sample_all_grids (GMT, GC, Ctrl->G.n_grids, img_conv_needed, S->coord[GMT_X][row], S->coord[GMT_Y][row], value);
-						if (status < 0) some_outside = true;
-						for (col = 4, k = 0; k < Ctrl->G.n_grids; k++, col++) S->coord[col][row] = value[k];
-					}
+					sample_segment (GMT, GC, Ctrl->G.n_grids, img_conv_needed, S, &S->coord[4], &W, &some_outside);
 				}
 			}
 			if (some_outside) GMT_Report (API, GMT_MSG_VERBOSE, "Some points along your lines were outside the grid domain(s).\n");
@@ -847,14 +1010,7 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 			T = Dout->table[tbl];
 			for (seg = 0; seg < T->n_segments; seg++) {	/* For each segment to resample */
 				S = T->segment[seg];
-				for (row = 0; row < S->n_rows; row++) {	/* For each row to resample */
-					status = sample_all_grids (GMT, GC, Ctrl->G.n_grids, img_conv_needed, S->coord[GMT_X][row], S->coord[GMT_Y][row], value);
-					for (col = 4, k = 0; k < Ctrl->G.n_grids; k++, col++) S->coord[col][row] = value[k];
-					if (status < 0)
-						some_outside = true;
-					else
-						n_points++;
-				}
+				n_points += sample_segment (GMT, GC, Ctrl->G.n_grids, img_conv_needed, S, &S->coord[4], &W, &some_outside);
 			}
 		}
 		if (some_outside) GMT_Report (API, GMT_MSG_VERBOSE, "Some points along your profiles were outside the grid domain(s).\n");
@@ -963,9 +1119,7 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 		}
 	}
 	else if (Ctrl->E.active) {	/* Quick sampling along given lines */
-		int status;
-		unsigned int k;
-		uint64_t col, n_cols = Din->n_columns + Ctrl->G.n_grids, row, seg;
+		uint64_t col, n_cols = Din->n_columns + Ctrl->G.n_grids, seg;
 		struct GMT_DATASEGMENT *Sin = NULL, *Sout = NULL;
 		
 		Din->dim[GMT_COL] = n_cols;	/* State we want a different set of columns on output */
@@ -976,12 +1130,8 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 			Sin  = Din->table[0]->segment[seg];	/* Shorthand */
 			Sout = Dout->table[0]->segment[seg];	/* Shorthand */
 			for (col = 0; col < Din->n_columns; col++) GMT_memcpy (Sout->coord[col], Sin->coord[col], Sin->n_rows, double);
-			for (row = 0; row < Sin->n_rows; row++) {	/* For each row  */
-				status = sample_all_grids (GMT, GC, Ctrl->G.n_grids, img_conv_needed, Sin->coord[GMT_X][row], Sin->coord[GMT_Y][row], value);
-				if (status < 0) some_outside = true;
-				for (col = Din->n_columns, k = 0; k < Ctrl->G.n_grids; k++, col++) Sout->coord[col][row] = value[k];
-				n_points++;
-			}
+			sample_segment (GMT, GC, Ctrl->G.n_grids, img_conv_needed, Sin, &Sout->coord[Din->n_columns], &W, &some_outside);
+			n_points += Sin->n_rows;
 		}
 		if (some_outside) GMT_Report (API, GMT_MSG_VERBOSE, "Some points along your profiles were outside the grid domain(s).\n");
 		T = Dout->table[0];
@@ -995,9 +1145,11 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 	}
 	else {	/* Standard resampling point case */
 		bool pure_ascii = false;
-		int ix, iy, n_fields, rmode;
-		uint64_t n_out = 0;
-		double *in = NULL, *out = NULL;
+		int ix, iy, n_fields, n_copy, rmode;
+		unsigned int got;
+		uint64_t n_out = 0, n_buf, b;
+		double *in = NULL, *out = NULL, *x_buf = NULL, *y_buf = NULL;
+		struct GRDTRACK_RECORD *R = NULL;
 		char record[GMT_BUFSIZ];
 		bool gmt_skip_output (struct GMT_CTRL *C, double *cols, uint64_t n_cols);
 		
@@ -1034,84 +1186,123 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 			Ctrl->T.S->max_radius = (Ctrl->T.radius == 0.0) ? DBL_MAX : Ctrl->T.radius;
 		}
 
+		R = GMT_memory (GMT, NULL, GRDTRACK_N_BUF, struct GRDTRACK_RECORD);
+		x_buf = GMT_memory (GMT, NULL, GRDTRACK_N_BUF, double);
+		y_buf = GMT_memory (GMT, NULL, GRDTRACK_N_BUF, double);
+
 		do {	/* Keep returning records until we reach EOF */
-			if ((in = GMT_Get_Record (API, rmode, &n_fields)) == NULL) {	/* Read next record, get NULL if special case */
-				if (GMT_REC_IS_ERROR (GMT)) 		/* Bail if there are any read errors */
-					Return (GMT_RUNTIME_ERROR);
-				if (GMT_REC_IS_TABLE_HEADER (GMT)) {	/* Echo table headers */
-					GMT_Put_Record (API, GMT_WRITE_TABLE_HEADER, NULL);
-					continue;
-				}
-				if (GMT_REC_IS_SEGMENT_HEADER (GMT)) {			/* Echo segment headers */
-					GMT_Put_Record (API, GMT_WRITE_SEGMENT_HEADER, NULL);
+			/* Buffer up to GRDTRACK_N_BUF data records, stopping early at headers or EOF so these are echoed in order */
+			got = GMT_IO_DATA_RECORD;
+			n_buf = 0;
+			while (n_buf < GRDTRACK_N_BUF) {
+				if ((in = GMT_Get_Record (API, rmode, &n_fields)) == NULL) {	/* Read next record, get NULL if special case */
+					if (GMT_REC_IS_ERROR (GMT)) 		/* Bail if there are any read errors */
+						Return (GMT_RUNTIME_ERROR);
+					if (GMT_REC_IS_TABLE_HEADER (GMT)) {	/* Echo table headers after the buffered records */
+						got = GMT_IO_TABLE_HEADER;
+						break;
+					}
+					if (GMT_REC_IS_SEGMENT_HEADER (GMT)) {	/* Echo segment headers after the buffered records */
+						got = GMT_IO_SEGMENT_HEADER;
+						break;
+					}
+					if (GMT_REC_IS_EOF (GMT)) {		/* Reached end of file */
+						got = GMT_IO_EOF;
+						break;
+					}
 					continue;
 				}
-				if (GMT_REC_IS_EOF (GMT)) 		/* Reached end of file */
-					break;
-			}
 
-			/* Data record to process */
-			if (n_out == 0) {
-				n_out = GMT_get_cols (GMT, GMT_IN) + Ctrl->G.n_grids;	/* Get new # of output cols */
-				if (Ctrl->T.mode == 2) n_out += 3;
-				if ((error = GMT_set_cols (GMT, GMT_OUT, n_out))) Return (error);
+				/* Data record to buffer */
+				if (n_out == 0) {
+					n_out = GMT_get_cols (GMT, GMT_IN) + Ctrl->G.n_grids;	/* Get new # of output cols */
+					if (Ctrl->T.mode == 2) n_out += 3;
+					if ((error = GMT_set_cols (GMT, GMT_OUT, n_out))) Return (error);
+				}
+				n_read++;
+				n_copy = MAX (n_fields, 2);
+				if ((unsigned int)n_copy > R[n_buf].n_alloc) {
+					R[n_buf].n_alloc = n_copy;
+					R[n_buf].in = GMT_memory (GMT, R[n_buf].in, R[n_buf].n_alloc, double);
+				}
+				GMT_memcpy (R[n_buf].in, in, n_copy, double);
+				R[n_buf].n_fields = n_fields;
+				if (pure_ascii && n_fields >= 2 && !Ctrl->Z.active) {	/* Must keep the trailing text */
+					/* First get rid of any commas that may cause grief */
+					for (k = 0; GMT->current.io.current_record[k]; k++) if (GMT->current.io.current_record[k] == ',') GMT->current.io.current_record[k] = ' ';
+					sscanf (GMT->current.io.current_record, "%*s %*s %[^\n]", line);
+					R[n_buf].text = strdup (line);
+				}
+				x_buf[n_buf] = in[GMT_X];
+				y_buf[n_buf] = in[GMT_Y];
+				n_buf++;
 			}
-			n_read++;
 
-			status = sample_all_grids (GMT, GC, Ctrl->G.n_grids, img_conv_needed, in[GMT_X], in[GMT_Y], value);
-			if (status == -1) {	/* Point is outside the region of all grids */
-				some_outside = true;
-				if (!Ctrl->N.active) continue;
-			}
-			else if (Ctrl->T.active && status == 0) {	/* Found a NaN; need to search for nearest non-NaN node */
-				if (gmt_grdspiral_search (GMT, Ctrl->T.S, in[GMT_X], in[GMT_Y])) {	/* Did find a valid node */
-					uint64_t ij = GMT_IJP (GC[0].G->header, Ctrl->T.S->row, Ctrl->T.S->col);
-					value[0] = GC[0].G->data[ij];
-					if (Ctrl->T.mode == 1) {	/* Replace input coordinate with node coordinate */
-						in[ix] = Ctrl->T.S->x[Ctrl->T.S->col];
-						in[iy] = Ctrl->T.S->y[Ctrl->T.S->row];
+			/* Sample all grids for the buffered points in parallel */
+			sample_batch (GMT, GC, Ctrl->G.n_grids, img_conv_needed, x_buf, y_buf, n_buf, &W);
+
+			for (b = 0; b < n_buf; b++) {	/* Write results in the original record order */
+				in = R[b].in;
+				n_fields = R[b].n_fields;
+				value = &W.value[b*Ctrl->G.n_grids];
+				status = W.status[b];
+				if (status == -1) {	/* Point is outside the region of all grids */
+					some_outside = true;
+					if (!Ctrl->N.active) continue;
+				}
+				else if (Ctrl->T.active && status == 0) {	/* Found a NaN; need to search for nearest non-NaN node */
+					if (gmt_grdspiral_search (GMT, Ctrl->T.S, in[GMT_X], in[GMT_Y])) {	/* Did find a valid node */
+						uint64_t ij = GMT_IJP (GC[0].G->header, Ctrl->T.S->row, Ctrl->T.S->col);
+						value[0] = GC[0].G->data[ij];
+						if (Ctrl->T.mode == 1) {	/* Replace input coordinate with node coordinate */
+							in[ix] = Ctrl->T.S->x[Ctrl->T.S->col];
+							in[iy] = Ctrl->T.S->y[Ctrl->T.S->row];
+						}
 					}
 				}
-			}
 
-			if (Ctrl->Z.active)	/* Simply print out values */
-				GMT_Put_Record (API, GMT_WRITE_DOUBLE, value);
-			else if (pure_ascii && n_fields >= 2) {
-				/* Special case: Ascii i/o and at least 3 columns:
-				   Columns beyond first two could be text strings */
-				if (gmt_skip_output (GMT, value, Ctrl->G.n_grids)) continue;	/* Suppress output due to NaNs */
-
-				/* First get rid of any commas that may cause grief */
-				for (k = 0; GMT->current.io.current_record[k]; k++) if (GMT->current.io.current_record[k] == ',') GMT->current.io.current_record[k] = ' ';
-				record[0] = 0;
-				sscanf (GMT->current.io.current_record, "%*s %*s %[^\n]", line);
-				GMT_add_to_record (GMT, record, in[ix], ix, 2);	/* Format our output x value */
-				GMT_add_to_record (GMT, record, in[iy], iy, 2);	/* Format our output y value */
-				strcat (record, line);
-				for (g = 0; g < Ctrl->G.n_grids; g++) {
-					GMT_add_to_record (GMT, record, value[g], GMT_Z+g, 1);	/* Format our output y value */
-				}
-				if (Ctrl->T.mode == 2) {	/* Add extra columns */
-					GMT_add_to_record (GMT, record, Ctrl->T.S->x[Ctrl->T.S->col], GMT_X, 1);	/* Format our output x value */
-					GMT_add_to_record (GMT, record, Ctrl->T.S->y[Ctrl->T.S->row], GMT_Y, 1);	/* Format our output y value */
-					GMT_add_to_record (GMT, record, Ctrl->T.S->radius, GMT_Z, 1);			/* Format our radius */
+				if (Ctrl->Z.active)	/* Simply print out values */
+					GMT_Put_Record (API, GMT_WRITE_DOUBLE, value);
+				else if (pure_ascii && n_fields >= 2) {
+					/* Special case: Ascii i/o and at least 3 columns:
+					   Columns beyond first two could be text strings */
+					if (gmt_skip_output (GMT, value, Ctrl->G.n_grids)) continue;	/* Suppress output due to NaNs */
+
+					record[0] = 0;
+					GMT_add_to_record (GMT, record, in[ix], ix, 2);	/* Format our output x value */
+					GMT_add_to_record (GMT, record, in[iy], iy, 2);	/* Format our output y value */
+					strcat (record, R[b].text);
+					for (g = 0; g < Ctrl->G.n_grids; g++) {
+						GMT_add_to_record (GMT, record, value[g], GMT_Z+g, 1);	/* Format our output y value */
+					}
+					if (Ctrl->T.mode == 2) {	/* Add extra columns */
+						GMT_add_to_record (GMT, record, Ctrl->T.S->x[Ctrl->T.S->col], GMT_X, 1);	/* Format our output x value */
+						GMT_add_to_record (GMT, record, Ctrl->T.S->y[Ctrl->T.S->row], GMT_Y, 1);	/* Format our output y value */
+						GMT_add_to_record (GMT, record, Ctrl->T.S->radius, GMT_Z, 1);			/* Format our radius */
+					}
+					GMT_Put_Record (API, GMT_WRITE_TEXT, record);	/* Write this to output */
 				}
-				GMT_Put_Record (API, GMT_WRITE_TEXT, record);	/* Write this to output */
-			}
-			else {	/* Simply copy other columns, append value, and output */
-				if (!out) out = GMT_memory (GMT, NULL, n_out, double);
-				for (ks = 0; ks < n_fields; ks++) out[ks] = in[ks];
-				for (g = 0; g < Ctrl->G.n_grids; g++, ks++) out[ks] = value[g];
-				if (Ctrl->T.mode == 2) {	/* Add extra columns */
-					out[ks++] = Ctrl->T.S->x[Ctrl->T.S->col];	/* Add our output x value */
-					out[ks++] = Ctrl->T.S->y[Ctrl->T.S->row];	/* Add our output y value */
-					out[ks++] = Ctrl->T.S->radius;			/* Add our radius */
+				else {	/* Simply copy other columns, append value, and output */
+					if (!out) out = GMT_memory (GMT, NULL, n_out, double);
+					for (ks = 0; ks < n_fields; ks++) out[ks] = in[ks];
+					for (g = 0; g < Ctrl->G.n_grids; g++, ks++) out[ks] = value[g];
+					if (Ctrl->T.mode == 2) {	/* Add extra columns */
+						out[ks++] = Ctrl->T.S->x[Ctrl->T.S->col];	/* Add our output x value */
+						out[ks++] = Ctrl->T.S->y[Ctrl->T.S->row];	/* Add our output y value */
+						out[ks++] = Ctrl->T.S->radius;			/* Add our radius */
+					}
+					GMT_Put_Record (API, GMT_WRITE_DOUBLE, out);
 				}
-				GMT_Put_Record (API, GMT_WRITE_DOUBLE, out);
+
+				n_points++;
 			}
+			for (b = 0; b < n_buf; b++) if (R[b].text) { free (R[b].text); R[b].text = NULL; }
 
-			n_points++;
-		} while (true);
+			if (got == GMT_IO_TABLE_HEADER)	/* Echo table header */
+				GMT_Put_Record (API, GMT_WRITE_TABLE_HEADER, NULL);
+			else if (got == GMT_IO_SEGMENT_HEADER)	/* Echo segment header */
+				GMT_Put_Record (API, GMT_WRITE_SEGMENT_HEADER, NULL);
+		} while (got != GMT_IO_EOF);
 		
 		if (GMT_End_IO (API, GMT_IN,  0) != GMT_OK) {	/* Disables further data input */
 			Return (API->error);
@@ -1121,6 +1312,10 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 		}
 
 		if (out) GMT_free (GMT, out);
+		for (b = 0; b < GRDTRACK_N_BUF; b++) if (R[b].n_alloc) GMT_free (GMT, R[b].in);
+		GMT_free (GMT, R);
+		GMT_free (GMT, x_buf);
+		GMT_free (GMT, y_buf);
 	}
 	if (some_outside) GMT_Report (API, GMT_MSG_VERBOSE, "Some input points were outside the grid domain(s).\n");
 	/* Clean up */
@@ -1134,7 +1329,7 @@ int GMT_grdtrack (void *V_API, int mode, void *args) {
 		else
 			GMT_free_grid (GMT, &GC[g].G, true);
 	}
-	GMT_free (GMT, value);
+	free_batch (GMT, &W);
 	GMT_free (GMT, GC);
 	GMT_set_pad (GMT, API->pad);	/* Reset to session default pad */
 
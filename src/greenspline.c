@@ -103,6 +103,7 @@ struct GREENSPLINE_CTRL {
 	} R3;
 	struct S {	/* -S<mode>[<tension][+<mod>[args]] */
 		bool active;
+		bool lookup;	/* true if the Green's function should be tabulated and splined (+n) */
 		unsigned int mode;
 		double value[4];
 		double rval[2];
@@ -150,9 +151,29 @@ struct GREENSPLINE_CTRL {
 
 struct GREENSPLINE_LOOKUP {	/* Used to spline interpolation of precalculated function */
 	uint64_t n;		/* Number of values in the spline setup */
+	double x_min;		/* First argument in the table */
+	double i_dx;		/* Inverse of the equidistant argument spacing */
+	double h2;		/* Spacing squared, needed by csplint */
 	double *y;		/* Function values */
 	double *c;		/* spline  coefficients */
 	double *A, *B, *C;	/* power/ratios of order l terms */
+	/* The exact function, used for arguments outside the table */
+	double (*G) (struct GMT_CTRL *, double, double *, struct GREENSPLINE_LOOKUP *);
+};
+
+struct GREENSPLINE_EVAL {	/* Items needed to evaluate the solution at arbitrary locations */
+	uint64_t nm;		/* Number of constraints */
+	unsigned int dimension;	/* 1, 2, or 3 */
+	bool cartesian;		/* true if distances are Cartesian and can be computed directly */
+	bool derivative;	/* true if we return the directional derivative (-Q) */
+	double **X;		/* Constraint locations */
+	double *xyz[3];		/* Same coordinates as contiguous arrays (only if cartesian) */
+	double *alpha;		/* Spline coefficients */
+	double *par;		/* Green's function parameters */
+	double *dir;		/* Unit vector for the directional derivative */
+	struct GREENSPLINE_LOOKUP *Lz, *Lg;
+	double (*G) (struct GMT_CTRL *, double, double *, struct GREENSPLINE_LOOKUP *);
+	double (*dGdr) (struct GMT_CTRL *, double, double *, struct GREENSPLINE_LOOKUP *);
 };
 
 struct ZGRID {
@@ -218,7 +239,7 @@ int GMT_greenspline_usage (struct GMTAPI_CTRL *API, int level)
 	GMT_Message (API, GMT_TIME_NONE, "\t   A negative cutoff will stop execution after saving the eigenvalues.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   Use -Cn to select only the largest <cut> eigenvalues [all].\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   Use -Cv to select only eigenvalues needed to explain <cut> %% of data variance [all].\n");
-	GMT_Message (API, GMT_TIME_NONE, "\t   [Default uses Gauss-Jordan elimination to solve the linear system]\n");
+	GMT_Message (API, GMT_TIME_NONE, "\t   [Default uses LU decomposition to solve the linear system]\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t-D Distance flag determines how we calculate distances between (x,y) points:\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   Options 0 apples to Cartesian 1-D spline interpolation.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t     -D0 x in user units, Cartesian distances.\n");
@@ -254,6 +275,8 @@ int GMT_greenspline_usage (struct GMTAPI_CTRL *API, int level)
 	GMT_Message (API, GMT_TIME_NONE, "\t   -Sq is a spherical surface spline in tension (Wessel & Becker, 2008); automatically sets -D4.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t      Append +e<error> to change maximum error in series truncation [%g].\n", SQ_TRUNC_ERROR);
 	GMT_Message (API, GMT_TIME_NONE, "\t      Append +n<n> to change the (odd) number of precalculated nodes for spline interpolation [%d].\n", SQ_N_NODES);
+	GMT_Message (API, GMT_TIME_NONE, "\t   For all but -Sl, append +n<n> to tabulate the Green's function at <n> nodes and use spline\n");
+	GMT_Message (API, GMT_TIME_NONE, "\t   interpolation instead of exact evaluation; this speeds up large problems [exact].\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t-T Mask grid file whose values are NaN or 0; its header implicitly sets -R, -I (and -r).\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t-W Expects one extra input column with data weights (e.g., w_i = 1/sigma_i).\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   Note this will only have an effect if -C is used.\n");
@@ -457,7 +480,7 @@ int GMT_greenspline_parse (struct GMT_CTRL *GMT, struct GREENSPLINE_CTRL *Ctrl,
 							while (GMT_strtok (c, "+", &pos, p)) {
 								switch (p[0]) {
 									case 'e':	Ctrl->S.value[2] = atof (&p[1]);	break;	/* Change the truncation error limit */
-									case 'n':	Ctrl->S.value[3] = atof (&p[1]);	break;	/* Change the number of nodes for the spline lookup */
+									case 'n':	Ctrl->S.value[3] = atof (&p[1]);	Ctrl->S.lookup = true;	break;	/* Change the number of nodes for the spline lookup */
 									case 'l':	Ctrl->S.rval[0]  = atof (&p[1]);	break;	/* Min value for spline, undocumented for testing only */
 									case 'u':	Ctrl->S.rval[1]  = atof (&p[1]);	break;	/* Max value for spline, undocumented for testing only */
 									default:
@@ -473,6 +496,10 @@ int GMT_greenspline_parse (struct GMT_CTRL *GMT, struct GREENSPLINE_CTRL *Ctrl,
 						n_errors++;
 					break;
 				}
+				if (opt->arg[0] != 'q' && (c = strstr (opt->arg, "+n"))) {	/* Tabulate the Green's function */
+					Ctrl->S.value[3] = atof (&c[2]);
+					Ctrl->S.lookup = true;
+				}
 				break;
 			case 'T':	/* Input mask grid */
 				if ((Ctrl->T.active = GMT_check_filearg (GMT, 'T', opt->arg, GMT_IN, GMT_IS_GRID))) {	/* Obtain -R -I -r from file */
@@ -521,6 +548,10 @@ int GMT_greenspline_parse (struct GMT_CTRL *GMT, struct GREENSPLINE_CTRL *Ctrl,
 			n_errors++;
 		}
 	}
+	if (Ctrl->S.lookup && Ctrl->S.value[3] < 3.0) {
+		GMT_Report (API, GMT_MSG_NORMAL, "Syntax error -S option +n<N> modifier: <N> must be at least 3\n");
+		n_errors++;
+	}
 	if (Ctrl->S.mode == PARKER_1994 || Ctrl->S.mode == WESSEL_BECKER_2008) Ctrl->D.mode = 4;	/* Automatically set */
 	dimension = (Ctrl->D.mode == 0) ? 1 : ((Ctrl->D.mode == 5) ? 3 : 2);
 	if (dimension == 2 && Ctrl->R3.mode) {	/* Set -R via a gridfile */
@@ -915,6 +946,7 @@ double gradspline2d_Wessel_Becker_Revised (struct GMT_CTRL *GMT, double x, doubl
 
 	L_max = get_L (x, par[0], par[1]);	/* Highest order needed in sum given x, p, and err */
 	sin_theta = sqrt (1.0 - x * x);
+	if (sin_theta == 0.0) return (0.0);	/* Gradient vanishes at the poles, as for Parker */
 	P0 = 1.0;	/* Initialize the P0 and P1 Legendre polynomials */
 	P1 = x;
 	S = 0.0;	/* Initialize sum */
@@ -935,10 +967,11 @@ double gradspline2d_Wessel_Becker_Revised (struct GMT_CTRL *GMT, double x, doubl
 }
 
 /* Given the lookup tables, this is how we use these functions
- * Here, par[7]  is number of points in spline
- *	 par[8]  is spline spacing dx
- *	 par[9]  is inverse, 1/dx
- *	 par[10] is min x
+ * Here, L->n     is number of points in spline
+ *	 L->i_dx  is inverse spline spacing, 1/dx
+ *	 L->h2    is spline spacing squared
+ *	 L->x_min is min x
+ * Arguments outside the table are passed on to the exact function L->G.
  */
 
 double csplint (double *y, double *c, double b, double h2, uint64_t klo)
@@ -958,17 +991,43 @@ double spline2d_lookup (struct GMT_CTRL *GMT, double x, double par[], struct GRE
 {	/* Given x, look up nearest node xx[k] <= x and do cubic spline interpolation */
 	uint64_t k;
 	double f, f0, df, y;
-	GMT_UNUSED(GMT);
 
-	f = (x - par[10]) * par[9];	/* Floating point index */
+	f = (x - L->x_min) * L->i_dx;	/* Floating point index */
+	if (!(f >= 0.0 && f <= (double)(L->n - 1))) return (L->G (GMT, x, par, L));	/* Outside the table */
 	f0 = floor (f);
 	df = f - f0;
 	k = lrint (f0);
 	if (df == 0.0) return (L->y[k]);	/* Right on a node */
-	y = csplint (L->y, L->c, df, par[4], k);	/* Call special cubic spline evaluator */
+	y = csplint (L->y, L->c, df, L->h2, k);	/* Call special cubic spline evaluator */
 	return (y);
 }
 
+void lookup_eval (struct GMT_CTRL *GMT, struct GREENSPLINE_LOOKUP *L, double par[], double *x, double *y, uint64_t n)
+{	/* Same as calling spline2d_lookup for each of the n arguments x, returning the results in y.
+	 * The main loop has no branches so the compiler can vectorize it; the rare arguments
+	 * outside the table are evaluated exactly in a second pass. */
+	uint64_t p, k, last = L->n - 1, n_out = 0;
+	bool out;
+	double f, a, b, f_last = (double)last;
+
+	for (p = 0; p < n; p++) {
+		f = (x[p] - L->x_min) * L->i_dx;	/* Floating point index */
+		out = !(f >= 0.0 && f <= f_last);
+		f = (out) ? 0.0 : f;
+		k = (uint64_t)f;
+		k -= (k == last);	/* So that the last node gives b = 1 */
+		b = f - (double)k;
+		a = 1.0 - b;
+		y[p] = a * L->y[k] + b * L->y[k+1] + ((a*a*a - a) * L->c[k] + (b*b*b - b) * L->c[k+1]) * L->h2 / 6.0;
+		n_out += out;
+	}
+	if (n_out == 0) return;
+	for (p = 0; p < n; p++) {
+		f = (x[p] - L->x_min) * L->i_dx;
+		if (!(f >= 0.0 && f <= f_last)) y[p] = L->G (GMT, x[p], par, L);
+	}
+}
+
 double spline2d_Wessel_Becker_lookup (struct GMT_CTRL *GMT, double x, double par[], struct GREENSPLINE_LOOKUP *L)
 {
 	return (spline2d_lookup (GMT, x, par, L));
@@ -979,47 +1038,51 @@ double gradspline2d_Wessel_Becker_lookup (struct GMT_CTRL *GMT, double x, double
 	return (spline2d_lookup (GMT, x, par, L));
 }
 
-void spline2d_Wessel_Becker_splineinit (struct GMT_CTRL *GMT, double par[], double *x, struct GREENSPLINE_LOOKUP *L)
-{	/* Set up cubic spline interpolation given the precomputed x,y values of the function */
-	GMT_UNUSED(GMT);
-	L->c = GMT_memory (GMT, NULL, 3*L->n, double);
-	GMT_cspline (GMT, x, L->y, L->n, L->c);
+void lookup_init (struct GMT_CTRL *GMT, struct GREENSPLINE_LOOKUP *L, double (*G) (struct GMT_CTRL *, double, double *, struct GREENSPLINE_LOOKUP *), double par[], double x_min, double dx, uint64_t n)
+{	/* Tabulate G at the n equidistant arguments x_min + i * dx and set up the cubic spline interpolation */
+	int64_t i;
+	double *x = NULL;
+
+	L->n = n;
+	L->x_min = x_min;
+	L->i_dx = 1.0 / dx;
+	L->h2 = dx * dx;
+	L->G = G;
+	x = GMT_memory (GMT, NULL, n, double);
+	L->y = GMT_memory (GMT, NULL, n, double);
+	/* Each node is independent; the series for -Sq makes this worthwhile */
+#ifdef _OPENMP
+#pragma omp parallel for private(i) shared(n,x,x_min,dx,L,G,GMT,par) schedule(dynamic,64)
+#endif
+	for (i = 0; i < (int64_t)n; i++) {
+		x[i] = x_min + i * dx;
+		L->y[i] = G (GMT, x[i], par, L);
+	}
+	L->c = GMT_memory (GMT, NULL, 3*n, double);
+	GMT_cspline (GMT, x, L->y, n, L->c);
+	GMT_free (GMT, x);	/* Done with x array */
 }
 
 void spline2d_Wessel_Becker_init (struct GMT_CTRL *GMT, double par[], struct GREENSPLINE_LOOKUP *Lz, struct GREENSPLINE_LOOKUP *Lg)
 {
-	uint64_t i, nx;
-	double *x = NULL;
+	uint64_t nx;
 #ifdef DUMP
 	FILE *fp = NULL;
-	uint64_t n_out;
+	uint64_t i, n_out;
 	double out[3];
 	fp = fopen ("greenspline.b", "wb");
 	n_out = (Lg) ? 3 : 2;
 #endif
 	nx = lrint (par[7]);
-	Lz->n = nx;
-	x = GMT_memory (GMT, NULL, nx, double);
-	Lz->y = GMT_memory (GMT, NULL, nx, double);
-	if (Lg) {
-		Lg->y = GMT_memory (GMT, NULL, nx, double);
-		Lg->n = nx;
-	}
-	for (i = 0; i < nx; i++) {
-		x[i] = par[10] + i * par[8];
-		Lz->y[i] = spline2d_Wessel_Becker_Revised (GMT, x[i], par, Lz);
-		if (Lg) Lg->y[i] = gradspline2d_Wessel_Becker_Revised (GMT, x[i], par, Lg);
+	lookup_init (GMT, Lz, spline2d_Wessel_Becker_Revised, par, par[10], par[8], nx);
+	if (Lg) lookup_init (GMT, Lg, gradspline2d_Wessel_Becker_Revised, par, par[10], par[8], nx);
 #ifdef DUMP
-		out[0] = x[i];	out[1] = Lz->y[i];	if (Lg) out[2] = Lg->y[i];
+	for (i = 0; i < nx; i++) {
+		out[0] = par[10] + i * par[8];	out[1] = Lz->y[i];	if (Lg) out[2] = Lg->y[i];
 		fwrite (out, sizeof (double), n_out, fp);
-#endif
 	}
-#ifdef DUMP
 	fclose (fp);
 #endif
-	spline2d_Wessel_Becker_splineinit (GMT, par, x, Lz);
-	if (Lg) spline2d_Wessel_Becker_splineinit (GMT, par, x, Lg);
-	GMT_free (GMT, x);	/* Done with x array */
 }
 
 /*----------------------  THREE DIMENSIONS ---------------------- */
@@ -1281,15 +1344,61 @@ double get_dircosine (struct GMT_CTRL *GMT, double *D, double *X0, double *X1, u
 	return (C);
 }
 
+double evaluate_spline (struct GMT_CTRL *GMT, struct GREENSPLINE_EVAL *E, double *V, double *work)
+{	/* Evaluate the solution (or its directional derivative) at location V.
+	 * work must have space for 2 * E->nm doubles; it is private to each thread.
+	 * Called from threads, so the azimuth function used by get_dircosine must keep no static state. */
+	unsigned int ii;
+	uint64_t p;
+	double C, part, wp = 0.0, *r = work, *g = &work[E->nm];
+
+	if (E->derivative) {	/* Directional derivative needs the direction to each constraint */
+		for (p = 0; p < E->nm; p++) {
+			r[0] = get_radius (GMT, V, E->X[p], E->dimension);
+			C = get_dircosine (GMT, E->dir, V, E->X[p], E->dimension, false);
+			part = E->dGdr (GMT, r[0], E->par, E->Lg) * C;
+			wp += E->alpha[p] * part;
+		}
+		return (wp);
+	}
+	/* First get all the distances, then all the Green's functions, then the weighted sum */
+	if (E->cartesian) {	/* Simple loops over contiguous coordinates */
+		double d, v = V[GMT_X], *x = E->xyz[GMT_X];
+		for (p = 0; p < E->nm; p++) {
+			d = v - x[p];
+			r[p] = d * d;
+		}
+		for (ii = 1; ii < E->dimension; ii++) {
+			v = V[ii];	x = E->xyz[ii];
+			for (p = 0; p < E->nm; p++) {
+				d = v - x[p];
+				r[p] += d * d;
+			}
+		}
+		for (p = 0; p < E->nm; p++) r[p] = sqrt (r[p]);
+	}
+	else {
+		for (p = 0; p < E->nm; p++) r[p] = get_radius (GMT, V, E->X[p], E->dimension);
+	}
+	if (E->Lz && E->Lz->y)	/* Interpolate in the precalculated table */
+		lookup_eval (GMT, E->Lz, E->par, r, g, E->nm);
+	else {
+		for (p = 0; p < E->nm; p++) g[p] = E->G (GMT, r[p], E->par, E->Lz);
+	}
+	for (p = 0; p < E->nm; p++) wp += E->alpha[p] * g[p];
+	return (wp);
+}
+
 #define bailout(code) {GMT_Free_Options (mode); return (code);}
 #define Return(code) {Free_greenspline_Ctrl (GMT, Ctrl); GMT_end_module (GMT, GMT_cpy); bailout (code);}
 
 int GMT_greenspline (void *V_API, int mode, void *args)
 {
 	uint64_t col, row, n_read, p, k, i, j, seg, m, n, nm, n_ok = 0, ij, ji, ii, n_duplicates = 0, n_skip = 0;
+	int64_t jj;
 	unsigned int dimension = 0, normalize = 1, unit = 0, n_cols, L_Max = 0;
 	size_t old_n_alloc, n_alloc;
-	int error, out_ID, way, nx;
+	int error, out_ID, way, nx, thread = 0, n_threads = 1;
 	bool new_grid = false, delete_grid = false, check_longitude, skip;
 	
 	char *method[N_METHODS] = {"minimum curvature Cartesian spline [1-D]",
@@ -1307,8 +1416,8 @@ int GMT_greenspline (void *V_API, int mode, void *args)
 	char *mem_unit[3] = {"kb", "Mb", "Gb"};
 	
 	double *obs = NULL, **D = NULL, **X = NULL, *alpha = NULL, *in = NULL;
-	double mem, part, C, p_val, r, par[11], norm[7], az, grad, weight_i, weight_j;
-	double *A = NULL, r_min, r_max;
+	double mem, C, p_val, r, par[11], norm[7], az, grad, weight_i, weight_j;
+	double *A = NULL, r_min, r_max, *work = NULL, *value = NULL, V[4], Vt[4];
 #ifdef DEBUG
 	double x0 = 0.0, x1 = 5.0;
 #endif
@@ -1322,6 +1431,7 @@ int GMT_greenspline (void *V_API, int mode, void *args)
 	struct GMT_GRID *Grid = NULL, *Out = NULL;
 	struct ZGRID Z;
 	struct GREENSPLINE_LOOKUP *Lz = NULL, *Lg = NULL;
+	struct GREENSPLINE_EVAL E;
 	struct GMT_DATATABLE *T = NULL;
 	struct GMT_DATASET *Nin = NULL;
 	struct GMT_GRID_INFO info;
@@ -1763,7 +1873,7 @@ int GMT_greenspline (void *V_API, int mode, void *args)
 			if (TEST) Lg = GMT_memory (GMT, NULL, 1, struct GREENSPLINE_LOOKUP);
 			else
 #endif
-			if (Ctrl->A.active) Lg = GMT_memory (GMT, NULL, 1, struct GREENSPLINE_LOOKUP);
+			if (Ctrl->A.active || Ctrl->Q.active) Lg = GMT_memory (GMT, NULL, 1, struct GREENSPLINE_LOOKUP);
 			L_Max = get_max_L (GMT, par[0], par[1]);
 			GMT_Report (API, GMT_MSG_LONG_VERBOSE, "New scheme p = %g, err = %g, L_Max = %u\n", par[0], par[1], L_Max);
 			series_prepare (GMT, par[0], L_Max, Lz, Lg);
@@ -1785,6 +1895,60 @@ int GMT_greenspline (void *V_API, int mode, void *args)
 			break;
 	}
 
+	if (Ctrl->S.lookup && !(Ctrl->S.mode == WESSEL_BECKER_2008 || Ctrl->S.mode == LINEAR_1D || Ctrl->S.mode == LINEAR_2D)) {
+		/* Tabulate G (and dG/dr if needed) over all arguments we may encounter and spline-interpolate instead */
+		uint64_t n_nodes = lrint (Ctrl->S.value[3]);
+		double x_min, dx;
+		if (Ctrl->D.mode == 3) {	/* Argument is the cosine of the spherical distance */
+			x_min = -1.0;
+			dx = 2.0 / (n_nodes - 1);
+		}
+		else {	/* Argument is a distance; start one node away from zero since some G(r) jump at r = 0 */
+			double r_hi = r_max, lo[3], hi[3], Xlo[3], Xhi[3];
+			if (Ctrl->D.mode == 1 || Ctrl->D.mode == 2) {	/* Geographic: Allow for half the globe */
+				GMT_memset (Xlo, 3, double);	GMT_memset (Xhi, 3, double);
+				Xhi[GMT_X] = 180.0;
+				r = get_radius (GMT, Xlo, Xhi, dimension);
+				if (r > r_hi) r_hi = r;
+			}
+			else {	/* Cartesian: No distance can exceed the diagonal of the box holding data and output locations */
+				for (k = 0; k < dimension; k++) lo[k] = DBL_MAX, hi[k] = -DBL_MAX;
+				for (p = 0; p < nm; p++) for (k = 0; k < dimension; k++) {
+					if (X[p][k] < lo[k]) lo[k] = X[p][k];
+					if (X[p][k] > hi[k]) hi[k] = X[p][k];
+				}
+				if (Ctrl->N.active) {
+					for (seg = 0; seg < T->n_segments; seg++) for (row = 0; row < T->segment[seg]->n_rows; row++) for (k = 0; k < dimension; k++) {
+						if (T->segment[seg]->coord[k][row] < lo[k]) lo[k] = T->segment[seg]->coord[k][row];
+						if (T->segment[seg]->coord[k][row] > hi[k]) hi[k] = T->segment[seg]->coord[k][row];
+					}
+				}
+				else {
+					Xlo[GMT_X] = Grid->header->wesn[XLO];	Xhi[GMT_X] = Grid->header->wesn[XHI];
+					Xlo[GMT_Y] = Grid->header->wesn[YLO];	Xhi[GMT_Y] = Grid->header->wesn[YHI];
+					if (dimension == 3) Xlo[GMT_Z] = Z.z_min, Xhi[GMT_Z] = Z.z_max;
+					for (k = 0; k < dimension; k++) {
+						if (Xlo[k] < lo[k]) lo[k] = Xlo[k];
+						if (Xhi[k] > hi[k]) hi[k] = Xhi[k];
+					}
+				}
+				r = get_radius (GMT, lo, hi, dimension);
+				if (r > r_hi) r_hi = r;
+			}
+			dx = r_hi / (n_nodes - 1);
+			x_min = dx;
+		}
+		GMT_Report (API, GMT_MSG_VERBOSE, "Precalculate lookup table with %" PRIu64 " items from %g to %g\n", n_nodes, x_min, x_min + (n_nodes - 1) * dx);
+		Lz = GMT_memory (GMT, NULL, 1, struct GREENSPLINE_LOOKUP);
+		lookup_init (GMT, Lz, G, par, x_min, dx, n_nodes);
+		G = &spline2d_lookup;
+		if (Ctrl->A.active || Ctrl->Q.active) {
+			Lg = GMT_memory (GMT, NULL, 1, struct GREENSPLINE_LOOKUP);
+			lookup_init (GMT, Lg, dGdr, par, x_min, dx, n_nodes);
+			dGdr = &spline2d_lookup;
+		}
+	}
+
 #ifdef DEBUG
 	if (TEST) {
 		GMT_Report (API, GMT_MSG_VERBOSE, "greenspline running in TEST mode for %s\n", method[Ctrl->S.mode]);
@@ -1812,8 +1976,14 @@ int GMT_greenspline (void *V_API, int mode, void *args)
 	
 	GMT_Report (API, GMT_MSG_VERBOSE, "Build linear system using %s\n", method[Ctrl->S.mode]);
 
-	weight_i = weight_j = 1.0;
-	for (j = 0; j < nm; j++) {	/* For each value or slope constraint */
+	/* Each (i,j) pair with i >= j fills A[i][j] and A[j][i] and nothing else, so the rows can be
+	 * shared among threads.  Rows get shorter with j, hence the dynamic schedule. */
+#ifdef _OPENMP
+#pragma omp parallel for private(jj,j,i,ij,ji,r,C,grad,weight_i,weight_j) shared(A,X,D,obs,nm,n,dimension,par,Lz,Lg,G,dGdr,Ctrl,GMT) schedule(dynamic,16)
+#endif
+	for (jj = 0; jj < (int64_t)nm; jj++) {	/* For each value or slope constraint */
+		j = (uint64_t)jj;
+		weight_i = weight_j = 1.0;
 		if (Ctrl->W.active) {
 			weight_j = X[j][dimension];
 			obs[j] *= weight_j;
@@ -1906,24 +2076,51 @@ int GMT_greenspline (void *V_API, int mode, void *args)
 		GMT_free (GMT, v);
 		GMT_free (GMT, b);
 	}
-	else {				/* Gauss-Jordan elimination */
-		int error;
+	else {				/* LU decomposition */
+		int error, *ipiv = GMT_memory (GMT, NULL, nm, int);
 		if (GMT_IS_ZERO (r_min)) {
 			GMT_Report (API, GMT_MSG_NORMAL, "Your matrix is singular because you have duplicate data constraints\n");
 			GMT_Report (API, GMT_MSG_NORMAL, "Preprocess your data with one of the blockm* modules to eliminate them\n");
 			
 		}
-		GMT_Report (API, GMT_MSG_VERBOSE, "Solve linear equations by Gauss-Jordan elimination\n");
-		if ((error = GMT_gaussjordan (GMT, A, (unsigned int)nm, (unsigned int)nm, obs, 1U, 1U))) {
+		GMT_Report (API, GMT_MSG_VERBOSE, "Solve linear equations by LU decomposition\n");
+		if ((error = GMT_lu_dcmp (GMT, A, (unsigned int)nm, (unsigned int)nm, ipiv))) {
 			GMT_Report (API, GMT_MSG_NORMAL, "You probably have nearly duplicate data constraints\n");
 			GMT_Report (API, GMT_MSG_NORMAL, "Preprocess your data with one of the blockm* modules\n");
+			GMT_free (GMT, ipiv);
 			Return (error);
 		}
+		GMT_lu_solv (GMT, A, (unsigned int)nm, (unsigned int)nm, ipiv, obs, 1U, 1U);
+		GMT_free (GMT, ipiv);
 	}
 	alpha = obs;	/* Just a different name since the obs vector now holds the alpha factors */
 		
 	GMT_free (GMT, A);
 
+	/* Set up evaluation of the solution.  Output locations are independent so they are shared among
+	 * threads, each with its own work space for the distances and Green's function values */
+	GMT_memset (&E, 1, struct GREENSPLINE_EVAL);
+	E.nm = nm;
+	E.dimension = dimension;
+	E.cartesian = (Ctrl->D.mode == -1 || Ctrl->D.mode == 0 || Ctrl->D.mode == 4);
+	E.derivative = Ctrl->Q.active;
+	E.X = X;
+	E.alpha = alpha;
+	E.par = par;
+	E.dir = Ctrl->Q.dir;
+	E.Lz = Lz;	E.Lg = Lg;
+	E.G = G;	E.dGdr = dGdr;
+	if (E.cartesian) {
+		for (k = 0; k < dimension; k++) {
+			E.xyz[k] = GMT_memory (GMT, NULL, nm, double);
+			for (p = 0; p < nm; p++) E.xyz[k][p] = X[p][k];
+		}
+	}
+#ifdef _OPENMP
+	n_threads = omp_get_max_threads ();
+#endif
+	work = GMT_memory (GMT, NULL, 2 * nm * n_threads, double);
+
 	if (Ctrl->N.file) {	/* Specified nodes only */
 		unsigned int wmode = GMT_ADD_DEFAULT;
 		double out[4];
@@ -1943,24 +2140,28 @@ int GMT_greenspline (void *V_API, int mode, void *args)
 		GMT->common.b.ncol[GMT_OUT] = dimension + 1;
 		GMT_memset (out, 4, double);
 		GMT_Report (API, GMT_MSG_VERBOSE, "Evaluate spline at %" PRIu64 " given locations\n", T->n_records);
+		for (seg = 0, k = 0; seg < T->n_segments; seg++) if (T->segment[seg]->n_rows > k) k = T->segment[seg]->n_rows;
+		value = GMT_memory (GMT, NULL, k, double);
 		for (seg = 0; seg < T->n_segments; seg++) {
-			for (row = 0; row < T->segment[seg]->n_rows; row++) {
-				for (ii = 0; ii < dimension; ii++) out[ii] = T->segment[seg]->coord[ii][row];
-				out[dimension] = 0.0;
-				for (p = 0; p < nm; p++) {
-					r = get_radius (GMT, out, X[p], dimension);
-					if (Ctrl->Q.active) {
-						C = get_dircosine (GMT, Ctrl->Q.dir, out, X[p], dimension, false);
-						part = dGdr (GMT, r, par, Lz) * C;
-					}
-					else
-						part = G (GMT, r, par, Lz);
-					out[dimension] += alpha[p] * part;
-				}
-				out[dimension] = undo_normalization (out, out[dimension], normalize, norm, dimension);
+			struct GMT_DATASEGMENT *S = T->segment[seg];
+			/* Evaluate all the locations in this segment first, then write them in order */
+#ifdef _OPENMP
+#pragma omp parallel for private(jj,ii,thread,V) shared(S,E,value,work,nm,dimension,GMT) schedule(dynamic,16)
+#endif
+			for (jj = 0; jj < (int64_t)S->n_rows; jj++) {
+#ifdef _OPENMP
+				thread = omp_get_thread_num ();
+#endif
+				for (ii = 0; ii < dimension; ii++) V[ii] = S->coord[ii][jj];
+				value[jj] = evaluate_spline (GMT, &E, V, &work[2*nm*thread]);
+			}
+			for (row = 0; row < S->n_rows; row++) {
+				for (ii = 0; ii < dimension; ii++) out[ii] = S->coord[ii][row];
+				out[dimension] = undo_normalization (out, value[row], normalize, norm, dimension);
 				GMT_Put_Record (API, GMT_WRITE_DOUBLE, out);
 			}
 		}
+		GMT_free (GMT, value);
 		if (GMT_End_IO (API, GMT_OUT, 0) != GMT_OK) {	/* Disables further data output */
 			Return (API->error);
 		}
@@ -1972,7 +2173,7 @@ int GMT_greenspline (void *V_API, int mode, void *args)
 	else {	/* Output on equidistance lattice */
 		uint64_t nz_off, nxy;
 		unsigned int col, row, layer, wmode = GMT_ADD_DEFAULT;
-		double *xp = NULL, *yp = NULL, wp, V[4];
+		double *xp = NULL, *yp = NULL;
 		GMT_Report (API, GMT_MSG_VERBOSE, "Evaluate spline at %" PRIu64 " equidistant output locations\n", n_ok);
 		/* Precalculate coordinates */
 		xp = GMT_grd_coord (GMT, Grid->header, GMT_X);
@@ -1993,26 +2194,31 @@ int GMT_greenspline (void *V_API, int mode, void *args)
 			}
 		}
 		GMT_memset (V, 4, double);
+		value = GMT_memory (GMT, NULL, Grid->header->nx, double);
 		for (layer = 0, nz_off = 0; layer < Z.nz; layer++, nz_off += nxy) {
 			if (dimension == 3) V[GMT_Z] = GMT_col_to_x (GMT, layer, Z.z_min, Z.z_max, Z.z_inc, Grid->header->xy_off, Z.nz);
 			for (row = 0; row < Grid->header->ny; row++) {
 				if (dimension > 1) V[GMT_Y] = yp[row];
+				/* Evaluate the whole row first, then write it in order */
+#ifdef _OPENMP
+#pragma omp parallel for private(jj,ij,thread,Vt) shared(Grid,E,V,xp,row,nz_off,value,work,nm,dimension,GMT) schedule(dynamic,16)
+#endif
+				for (jj = 0; jj < (int64_t)Grid->header->nx; jj++) {
+					ij = GMT_IJP (Grid->header, row, jj) + nz_off;
+					if (dimension == 2 && GMT_is_fnan (Grid->data[ij])) continue;	/* Only do solution where mask is not NaN */
+#ifdef _OPENMP
+					thread = omp_get_thread_num ();
+#endif
+					GMT_memcpy (Vt, V, 4, double);
+					Vt[GMT_X] = xp[jj];
+					value[jj] = evaluate_spline (GMT, &E, Vt, &work[2*nm*thread]);
+				}
 				for (col = 0; col < Grid->header->nx; col++) {
 					ij = GMT_IJP (Grid->header, row, col) + nz_off;
 					if (dimension == 2 && GMT_is_fnan (Grid->data[ij])) continue;	/* Only do solution where mask is not NaN */
 					V[GMT_X] = xp[col];
 					/* Here, V holds the current output coordinates */
-					for (p = 0, wp = 0.0; p < nm; p++) {
-						r = get_radius (GMT, V, X[p], dimension);
-						if (Ctrl->Q.active) {
-							C = get_dircosine (GMT, Ctrl->Q.dir, V, X[p], dimension, false);
-							part = dGdr (GMT, r, par, Lz) * C;
-						}
-						else
-							part = G (GMT, r, par, Lz);
-						wp += alpha[p] * part;
-					}
-					V[dimension] = (float)undo_normalization (V, wp, normalize, norm, dimension);
+					V[dimension] = (float)undo_normalization (V, value[col], normalize, norm, dimension);
 					if (dimension == 2)	/* Special 2-D grid output */
 						Out->data[ij] = (float)V[dimension];
 					else	/* Crude dump for now for both 1-D and 3-D */
@@ -2042,7 +2248,10 @@ int GMT_greenspline (void *V_API, int mode, void *args)
 			
 		GMT_free (GMT, xp);
 		if (dimension > 1) GMT_free (GMT, yp);
+		GMT_free (GMT, value);
 	}
+	GMT_free (GMT, work);
+	for (k = 0; k < 3; k++) if (E.xyz[k]) GMT_free (GMT, E.xyz[k]);
 	
 	/* Clean up */
 	
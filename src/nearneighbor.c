@@ -40,6 +40,9 @@
 #define GMT_PROG_OPTIONS "-:RVbfhinrs" GMT_OPT("FH")
 
 #define NN_DEF_SECTORS	4
+#define NN_MIN_BAND	16	/* Minimum number of grid rows per band of output nodes */
+#define NN_BANDS_PER_THREAD	4	/* Bands of output rows per thread when gridding in parallel */
+#define NN_BAND_MAX_BYTES	(64 * 1024 * 1024)	/* Cap on the sector tables of one band (per thread) */
 
 struct NEARNEIGHBOR_CTRL {	/* All control options for this program (except common args) */
 	/* active is true if the option has been activated */
@@ -70,15 +73,30 @@ struct NEARNEIGHBOR_CTRL {	/* All control options for this program (except commo
 	} W;
 };
 
+struct NEARNEIGHBOR_POINT {	/* Structure with input data constraints */
+	double x, y;	/* Kept in double so distances and sectors are as computed from the input */
+	float z, w;
+};
+
 struct NEARNEIGHBOR_NODE {	/* Structure with point id and distance pairs for all sectors */
 	float *distance;	/* Distance of nearest datapoint to this node per sector */
 	int64_t *datum;		/* Point id of this data point */
 };
 
-struct NEARNEIGHBOR_POINT {	/* Structure with input data constraints */
-	float x, y, z, w;
+struct NEARNEIGHBOR_BAND {	/* Sector tables for the nodes of one band of output rows */
+	unsigned int sectors;
+	float *distance;	/* Dense tables: distance of nearest point per node and sector... */
+	int64_t *datum;		/* ...and the id of that point, or -1 if the sector is empty */
+	struct NEARNEIGHBOR_NODE **node;	/* Sparse tables: per-node records, allocated when a node is first reached */
 };
 
+static inline int nearneighbor_bucket (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *h, double y, unsigned int d_row, int n_bins)
+{	/* Return the bucket of the grid row nearest to y; buckets start d_row rows above the grid */
+	int bin = (int)GMT_grd_y_to_row (GMT, y, h) + (int)d_row;
+	if (bin < 0) bin = 0; else if (bin >= n_bins) bin = n_bins - 1;	/* Guard against round-off */
+	return (bin);
+}
+
 void *New_nearneighbor_Ctrl (struct GMT_CTRL *GMT) {	/* Allocate and initialize a new control structure */
 	struct NEARNEIGHBOR_CTRL *C;
 
@@ -105,23 +123,30 @@ struct NEARNEIGHBOR_NODE *add_new_node (struct GMT_CTRL *GMT, unsigned int n)
 	return (new_node);
 }
 
-void assign_node (struct GMT_CTRL *GMT, struct NEARNEIGHBOR_NODE **node, unsigned int n_sector, unsigned int sector, double distance, uint64_t id)
-{	/* Allocates node space if not already used and updates the value if closer to node than the current value */
-
-	if (!(*node)) *node = add_new_node (GMT, n_sector);
-	if ((*node)->datum[sector] == -1 || (*node)->distance[sector] > distance) {
-		(*node)->distance[sector] = (float)distance;
-		(*node)->datum[sector] = id;
-	}
-}
-
-void free_node (struct GMT_CTRL *GMT, struct NEARNEIGHBOR_NODE *node)
+void free_node (struct GMT_CTRL *GMT, struct NEARNEIGHBOR_NODE **node)
 {	/* Frees allocated node space */
+	if (!(*node)) return;
+	GMT_free (GMT, (*node)->distance);
+	GMT_free (GMT, (*node)->datum);
+	GMT_free (GMT, *node);
+}
 
-	if (!node) return;	/* Nothing to do */
-	GMT_free (GMT, node->distance);
-	GMT_free (GMT, node->datum);
-	GMT_free (GMT, node);
+void assign_node (struct GMT_CTRL *GMT, struct NEARNEIGHBOR_BAND *B, uint64_t node, unsigned int sector, double distance, uint64_t id)
+{	/* Updates the sector if this point is closer to the node than the current one.  Ties go
+	 * to the lowest point id so the result does not depend on the order points are visited */
+	float d = (float)distance, *node_distance = NULL;
+	int64_t *node_datum = NULL;
+	if (B->node) {	/* Sparse tables; allocate the node record if not already used */
+		if (!B->node[node]) B->node[node] = add_new_node (GMT, B->sectors);
+		node_distance = &B->node[node]->distance[sector];	node_datum = &B->node[node]->datum[sector];
+	}
+	else {
+		node_distance = &B->distance[node*B->sectors+sector];	node_datum = &B->datum[node*B->sectors+sector];
+	}
+	if (*node_datum == -1 || d < *node_distance || (d == *node_distance && (int64_t)id < *node_datum)) {
+		*node_distance = d;
+		*node_datum = id;
+	}
 }
 
 int GMT_nearneighbor_usage (struct GMTAPI_CTRL *API, int level)
@@ -260,12 +285,15 @@ int GMT_nearneighbor_parse (struct GMT_CTRL *GMT, struct NEARNEIGHBOR_CTRL *Ctrl
 
 int GMT_nearneighbor (void *V_API, int mode, void *args)
 {
-	int col_0, row_0, row, col, row_end, col_end, ii, jj, error = 0;
-	unsigned int k, rowu, colu, d_row, sector, y_wrap, max_d_col, x_wrap, *d_col = NULL;
-	bool wrap_180, replicate_x, replicate_y;
-	size_t n_alloc = GMT_INITIAL_MEM_ROW_ALLOC;
+	int col_0, row_0, row, col, row_end, col_end, ii, jj, error = 0, n_bins, bin, band, n_bands, band_rows, shift, n_threads = 1;
+	unsigned int k, rowu, colu, d_row, sector, max_d_col, x_wrap, *d_col = NULL, *b_id = NULL;
+	bool wrap_180, replicate_x, replicate_y, sparse;
+	size_t n_alloc = GMT_INITIAL_MEM_ROW_ALLOC, row_bytes;
 
-	uint64_t ij, ij0, kk, n, n_read, n_almost, n_none, n_set, n_filled;
+	uint64_t ij, ij0, kk, p, n, n_read, n_almost, n_none, n_set, n_filled, n_per_band;
+	uint64_t *b_start = NULL;
+	int64_t *node_datum = NULL;
+	float *node_distance = NULL;
 
 	double weight, weight_sum, grd_sum, dx, dy, delta, distance = 0.0;
 	double x_left, x_right, y_top, y_bottom, factor, three_over_radius;
@@ -273,7 +301,6 @@ int GMT_nearneighbor (void *V_API, int mode, void *args)
 	double *x0 = NULL, *y0 = NULL, *in = NULL;
 
 	struct GMT_GRID *Grid = NULL;
-	struct NEARNEIGHBOR_NODE **grid_node = NULL;
 	struct NEARNEIGHBOR_POINT *point = NULL;
 	struct NEARNEIGHBOR_CTRL *Ctrl = NULL;
 	struct GMT_CTRL *GMT = NULL, *GMT_cpy = NULL;
@@ -314,7 +341,6 @@ int GMT_nearneighbor (void *V_API, int mode, void *args)
 	GMT_Report (API, GMT_MSG_VERBOSE, "Grid dimensions are nx = %d, ny = %d\n", Grid->header->nx, Grid->header->ny);
 	GMT_Report (API, GMT_MSG_VERBOSE, "Number of sectors = %d, minimum number of filled sectors = %d\n", Ctrl->N.sectors, Ctrl->N.min_sectors);
 
-	grid_node = GMT_memory (GMT, NULL, Grid->header->nm, struct NEARNEIGHBOR_NODE *);
 	point = GMT_memory (GMT, NULL, n_alloc, struct NEARNEIGHBOR_POINT);
 
 	x0 = GMT_grd_coord (GMT, Grid->header, GMT_X);
@@ -342,7 +368,6 @@ int GMT_nearneighbor (void *V_API, int mode, void *args)
 	replicate_x = (Grid->header->nxp && Grid->header->registration == GMT_GRID_NODE_REG);	/* Gridline registration has duplicate column */
 	replicate_y = (Grid->header->nyp && Grid->header->registration == GMT_GRID_NODE_REG);	/* Gridline registration has duplicate row */
 	x_wrap = Grid->header->nx - 1;				/* Add to node index to go to right column */
-	y_wrap = (Grid->header->ny - 1) * Grid->header->nx;	/* Add to node index to go to bottom row */
 	GMT_Report (API, GMT_MSG_VERBOSE, "Processing input table data\n");
 	if (GMT_Begin_IO (API, GMT_IS_DATASET, GMT_IN, GMT_HEADER_ON) != GMT_OK) {	/* Enables data input and sets access mode */
 		Return (API->error);
@@ -367,72 +392,11 @@ int GMT_nearneighbor (void *V_API, int mode, void *args)
 
 		/* Store this point in memory */
 		
-		point[n].x = (float)in[GMT_X];
-		point[n].y = (float)in[GMT_Y];
+		point[n].x = in[GMT_X];
+		point[n].y = in[GMT_Y];
 		point[n].z = (float)in[GMT_Z];
 		if (Ctrl->W.active) point[n].w = (float)in[3];
 
-		/* Find row/col indices of the node closest to this data point.  Note: These may be negative */
-
-		col_0 = (int)GMT_grd_x_to_col (GMT, in[GMT_X], Grid->header);
-		row_0 = (int)GMT_grd_y_to_row (GMT, in[GMT_Y], Grid->header);
-
-		/* Loop over all nodes within radius of this node */
-
-		row_end = row_0 + d_row;
-		for (row = row_0 - d_row; row <= row_end; row++) {
-
-			jj = row;
-			if (GMT_y_out_of_bounds (GMT, &jj, Grid->header, &wrap_180)) continue;	/* Outside y-range */
-			rowu = jj;
-			col_end = col_0 + d_col[jj];
-			for (col = col_0 - d_col[jj]; col <= col_end; col++) {
-
-				ii = col;
-				if (GMT_x_out_of_bounds (GMT, &ii, Grid->header, wrap_180)) continue;	/* Outside x-range */ 
-
-				/* Here, (ii,jj) [both are >= 0] is index of a node (kk) inside the grid */
-				colu = ii;
-
-				distance = GMT_distance (GMT, x0[colu], y0[rowu], in[GMT_X], in[GMT_Y]);
-
-				if (distance > Ctrl->S.radius) continue;	/* Data constraint is too far from this node */
-				kk = GMT_IJ0 (Grid->header, rowu, colu);	/* No padding used for gridnode array */
-				dx = in[GMT_X] - x0[colu];	dy = in[GMT_Y] - y0[rowu];
-
-				/* Check for wrap-around in x or y.  This should only occur if the
-				   search radius is larger than 1/2 the grid width/height so that
-				   the shortest distance is going through the periodic boundary.
-				   For longitudes the dx obviously cannot exceed 180 (half_x_width)
-				   since we could then go the other direction instead.
-				*/
-				if (Grid->header->nxp && fabs (dx) > half_x_width) dx -= copysign (x_width, dx);
-				if (Grid->header->nyp && fabs (dy) > half_y_width) dy -= copysign (y_width, dy);
-
-				/* OK, this point should constrain this node.  Calculate which sector and assign the value */
-
-				sector = urint (floor (((d_atan2 (dy, dx) + M_PI) * factor))) % Ctrl->N.sectors;
-				assign_node (GMT, &grid_node[kk], Ctrl->N.sectors, sector, distance, n);
-
-				/* With periodic, gridline-registered grids there are duplicate rows and/or columns
-				   so we may have to assign the point to more than one node.  The next section deals
-				   with this situation.
-				*/
-
-				if (replicate_x) {	/* Must check if we have to replicate a column */
-					if (colu == 0) 	/* Must replicate left to right column */
-						assign_node (GMT, &grid_node[kk+x_wrap], Ctrl->N.sectors, sector, distance, n);
-					else if (colu == Grid->header->nxp)	/* Must replicate right to left column */
-						assign_node (GMT, &grid_node[kk-x_wrap], Ctrl->N.sectors, sector, distance, n);
-				}
-				if (replicate_y) {	/* Must check if we have to replicate a row */
-					if (rowu == 0)	/* Must replicate top to bottom row */
-						assign_node (GMT, &grid_node[kk+y_wrap], Ctrl->N.sectors, sector, distance, n);
-					else if (rowu == Grid->header->nyp)	/* Must replicate bottom to top row */
-						assign_node (GMT, &grid_node[kk-y_wrap], Ctrl->N.sectors, sector, distance, n);
-				}
-			}
-		}
 		n++;
 		if (!(n%1000)) GMT_Report (API, GMT_MSG_VERBOSE, "Processed record %10ld\r", n);
 		if (n == n_alloc) {
@@ -449,7 +413,30 @@ int GMT_nearneighbor (void *V_API, int mode, void *args)
 	GMT_Report (API, GMT_MSG_VERBOSE, "Processed record %10ld\n", n);
 
 	if (n < n_alloc) point = GMT_memory (GMT, point, n, struct NEARNEIGHBOR_POINT);
-	/* Compute weighted averages based on the nearest neighbors */
+	if (n > UINT_MAX) {	/* Point ids in the buckets are 32-bit to keep the memory down */
+		GMT_Report (API, GMT_MSG_NORMAL, "Cannot grid more than %u points\n", UINT_MAX);
+		Return (GMT_RUNTIME_ERROR);
+	}
+
+	/* Sort the points into buckets by the grid row nearest to them (compressed row storage).  Buckets
+	 * cover the rows the points may fall in, i.e., d_row rows beyond the grid on either side */
+
+	n_bins = Grid->header->ny + 2 * d_row;
+	b_start = GMT_memory (GMT, NULL, n_bins + 1, uint64_t);
+	b_id = GMT_memory (GMT, NULL, n, unsigned int);
+	for (kk = 0; kk < n; kk++) b_start[nearneighbor_bucket (GMT, Grid->header, point[kk].y, d_row, n_bins)+1]++;
+	for (bin = 0; bin < n_bins; bin++) b_start[bin+1] += b_start[bin];
+	for (kk = 0; kk < n; kk++)	/* Fill; this advances b_start to the next bucket... */
+		b_id[b_start[nearneighbor_bucket (GMT, Grid->header, point[kk].y, d_row, n_bins)]++] = (unsigned int)kk;
+	for (bin = n_bins; bin > 0; bin--) b_start[bin] = b_start[bin-1];	/* ...so shift it back */
+	b_start[0] = 0;
+
+	/* Compute weighted averages based on the nearest neighbors.  The output rows are split into bands that
+	 * are processed in parallel.  Each band visits the buckets within d_row rows of it (and, for grids
+	 * periodic in y, those a period away), finds the nearest point per sector for its own nodes only, and
+	 * then computes the node values.  The sector tables are flat arrays allocated once per thread and the
+	 * band height is limited so they stay below NN_BAND_MAX_BYTES.  If even a single row would exceed
+	 * that we instead allocate sector records only for the nodes reached, and grid the bands serially */
 
 	if (GMT_Create_Data (API, GMT_IS_GRID, GMT_IS_SURFACE, GMT_GRID_DATA_ONLY, NULL, NULL, NULL, 0, 0, Grid) == NULL) Return (API->error);
 
@@ -457,46 +444,168 @@ int GMT_nearneighbor (void *V_API, int mode, void *args)
 
 	if (!Ctrl->E.active) Ctrl->E.value = GMT->session.d_NaN;
 	three_over_radius = 3.0 / Ctrl->S.radius;
-
-	ij0 = 0;
-	GMT_row_loop (GMT, Grid, row) {
-		GMT_col_loop (GMT, Grid, row, col, ij) {
-			if (!grid_node[ij0]) {	/* No nearest neighbors, set to empty and goto next node */
-				n_none++;
-				Grid->data[ij] = (float)Ctrl->E.value;
-				ij0++;
-				continue;
+	row_bytes = (size_t)Grid->header->nx * Ctrl->N.sectors * (sizeof (float) + sizeof (int64_t));
+	if ((sparse = (row_bytes > NN_BAND_MAX_BYTES))) row_bytes = (size_t)Grid->header->nx * sizeof (struct NEARNEIGHBOR_NODE *);
+#ifdef _OPENMP
+	if (!sparse) n_threads = omp_get_max_threads ();
+#endif
+	band_rows = MAX (NN_MIN_BAND, ((int)Grid->header->ny + NN_BANDS_PER_THREAD * n_threads - 1) / (NN_BANDS_PER_THREAD * n_threads));
+	band_rows = MIN (band_rows, (int)MAX (1, NN_BAND_MAX_BYTES / row_bytes));	/* Keep the band tables below the cap */
+	band_rows = MIN (band_rows, (int)Grid->header->ny);
+	n_bands = (Grid->header->ny + band_rows - 1) / band_rows;
+	n_per_band = (uint64_t)band_rows * Grid->header->nx;	/* Nodes per band */
+	GMT_Report (API, GMT_MSG_VERBOSE, "Gridding %d bands of %d rows%s\n", n_bands, band_rows, (sparse) ? " with sparse sector tables" : "");
+
+#ifdef _OPENMP
+#pragma omp parallel if (!sparse) private(band,row,col,row_0,col_0,row_end,col_end,ii,jj,rowu,colu,wrap_180,k,kk,ij,ij0,p,shift,bin,sector,distance,dx,dy,delta,weight,weight_sum,grd_sum,n_filled,node_distance,node_datum) shared(GMT,Ctrl,Grid,point,b_start,b_id,n_bins,band_rows,n_bands,n_per_band,sparse,d_row,d_col,x0,y0,factor,three_over_radius,x_width,y_width,half_x_width,half_y_width,replicate_x,replicate_y,x_wrap) reduction(+:n_set,n_almost,n_none)
+#endif
+	{
+	int r0, r1, lo, hi;
+	struct NEARNEIGHBOR_BAND B;
+	GMT_memset (&B, 1, struct NEARNEIGHBOR_BAND);
+	B.sectors = Ctrl->N.sectors;
+	if (sparse)
+		B.node = GMT_memory (GMT, NULL, n_per_band, struct NEARNEIGHBOR_NODE *);
+	else {
+		B.distance = GMT_memory (GMT, NULL, n_per_band * Ctrl->N.sectors, float);
+		B.datum = GMT_memory (GMT, NULL, n_per_band * Ctrl->N.sectors, int64_t);
+	}
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,1)
+#endif
+	for (band = 0; band < n_bands; band++) {
+		r0 = band * band_rows;	r1 = MIN (r0 + band_rows, (int)Grid->header->ny);	/* This band owns rows r0 <= row < r1 */
+		if (!sparse) for (kk = 0; kk < n_per_band * Ctrl->N.sectors; kk++) B.datum[kk] = -1;	/* Sparse records are freed as they are used */
+
+		for (shift = -1; shift <= 1; shift++) {	/* Visit buckets near the band, and if periodic in y, also a period away */
+			if (shift && !Grid->header->nyp) continue;
+			lo = r0 - (int)d_row + shift * (int)Grid->header->nyp + (int)d_row;	/* First bucket (buckets start at row -d_row) */
+			hi = r1 - 1 + (int)d_row + shift * (int)Grid->header->nyp + (int)d_row;	/* Last bucket */
+			if (lo < 0) lo = 0;
+			if (hi >= n_bins) hi = n_bins - 1;
+			for (bin = lo; bin <= hi; bin++) {
+				for (p = b_start[bin]; p < b_start[bin+1]; p++) {	/* Visit all points in this bucket */
+					kk = b_id[p];
+					col_0 = (int)GMT_grd_x_to_col (GMT, point[kk].x, Grid->header);
+					row_0 = (int)GMT_grd_y_to_row (GMT, point[kk].y, Grid->header);
+
+					/* Loop over all nodes within radius of this node */
+
+					row_end = row_0 + d_row;
+					for (row = row_0 - d_row; row <= row_end; row++) {
+
+						jj = row;
+						if (GMT_y_out_of_bounds (GMT, &jj, Grid->header, &wrap_180)) continue;	/* Outside y-range */
+						rowu = jj;
+						if (!((int)rowu >= r0 && (int)rowu < r1) && !(replicate_y && (rowu == 0 || rowu == Grid->header->nyp))) continue;	/* Cannot affect this band */
+						col_end = col_0 + d_col[jj];
+						for (col = col_0 - d_col[jj]; col <= col_end; col++) {
+
+							ii = col;
+							if (GMT_x_out_of_bounds (GMT, &ii, Grid->header, wrap_180)) continue;	/* Outside x-range */ 
+
+							/* Here, (ii,jj) [both are >= 0] is index of a node (ij) inside the grid */
+							colu = ii;
+
+							distance = GMT_distance (GMT, x0[colu], y0[rowu], point[kk].x, point[kk].y);
+
+							if (distance > Ctrl->S.radius) continue;	/* Data constraint is too far from this node */
+							dx = point[kk].x - x0[colu];	dy = point[kk].y - y0[rowu];
+
+							/* Check for wrap-around in x or y.  This should only occur if the
+							   search radius is larger than 1/2 the grid width/height so that
+							   the shortest distance is going through the periodic boundary.
+							   For longitudes the dx obviously cannot exceed 180 (half_x_width)
+							   since we could then go the other direction instead.
+							*/
+							if (Grid->header->nxp && fabs (dx) > half_x_width) dx -= copysign (x_width, dx);
+							if (Grid->header->nyp && fabs (dy) > half_y_width) dy -= copysign (y_width, dy);
+
+							/* OK, this point should constrain this node.  Calculate which sector and assign the value */
+
+							sector = urint (floor (((d_atan2 (dy, dx) + M_PI) * factor))) % Ctrl->N.sectors;
+							if ((int)rowu >= r0 && (int)rowu < r1) {	/* Node is in this band */
+								ij = (uint64_t)(rowu - r0) * Grid->header->nx + colu;
+								assign_node (GMT, &B, ij, sector, distance, kk);
+
+								/* With periodic, gridline-registered grids there are duplicate columns
+								   so we may have to assign the point to more than one node. */
+
+								if (replicate_x) {	/* Must check if we have to replicate a column */
+									if (colu == 0) 	/* Must replicate left to right column */
+										assign_node (GMT, &B, ij + x_wrap, sector, distance, kk);
+									else if (colu == Grid->header->nxp)	/* Must replicate right to left column */
+										assign_node (GMT, &B, ij - x_wrap, sector, distance, kk);
+								}
+							}
+							if (replicate_y) {	/* Must check if we have to replicate a row; it may be in this band */
+								if (rowu == 0)	/* Must replicate top to bottom row */
+									jj = Grid->header->ny - 1;
+								else if (rowu == Grid->header->nyp)	/* Must replicate bottom to top row */
+									jj = 0;
+								if ((rowu == 0 || rowu == Grid->header->nyp) && jj >= r0 && jj < r1)
+									assign_node (GMT, &B, (uint64_t)(jj - r0) * Grid->header->nx + colu, sector, distance, kk);
+							}
+						}
+					}
+				}
 			}
+		}
 
-			for (k = 0, n_filled = 0; k < Ctrl->N.sectors; k++) if (grid_node[ij0]->datum[k] >= 0) n_filled++;
-			if (n_filled < Ctrl->N.min_sectors) { 	/* Not minimum set of neighbors in all sectors, set to empty and goto next node */
-				n_almost++;
-				Grid->data[ij] = (float)Ctrl->E.value;
-				free_node (GMT, grid_node[ij0]);
-				ij0++;
-				continue;
-			}
+		/* Now compute the node values for this band */
+
+		for (row = r0, ij0 = 0; row < r1; row++) {
+			for (col = 0; col < (int)Grid->header->nx; col++, ij0++) {
+				ij = GMT_IJP (Grid->header, row, col);
+				if (sparse) {	/* Unreached nodes have no record */
+					node_distance = (B.node[ij0]) ? B.node[ij0]->distance : NULL;
+					node_datum = (B.node[ij0]) ? B.node[ij0]->datum : NULL;
+				}
+				else {
+					node_distance = &B.distance[ij0*Ctrl->N.sectors];
+					node_datum = &B.datum[ij0*Ctrl->N.sectors];
+				}
+				n_filled = 0;
+				if (node_datum) for (k = 0; k < Ctrl->N.sectors; k++) if (node_datum[k] >= 0) n_filled++;
+				if (n_filled == 0) {	/* No nearest neighbors, set to empty and goto next node */
+					n_none++;
+					Grid->data[ij] = (float)Ctrl->E.value;
+					if (sparse) free_node (GMT, &B.node[ij0]);
+					continue;
+				}
+				if (n_filled < Ctrl->N.min_sectors) { 	/* Not minimum set of neighbors in all sectors, set to empty and goto next node */
+					n_almost++;
+					Grid->data[ij] = (float)Ctrl->E.value;
+					if (sparse) free_node (GMT, &B.node[ij0]);
+					continue;
+				}
 
-			/* OK, here we have enough data and need to calculate the weighted value */
-
-			n_set++;
-			weight_sum = grd_sum = 0.0;	/* Initialize sums */
-			for (k = 0; k < Ctrl->N.sectors; k++) {
-				if (grid_node[ij0]->datum[k] >= 0) {
-					delta = three_over_radius * grid_node[ij0]->distance[k];
-					weight = 1.0 / (1.0 + delta * delta);	/* This is distance weight */
-					if (Ctrl->W.active) weight *= point[grid_node[ij0]->datum[k]].w;	/* This is observation weight */
-					grd_sum += weight * point[grid_node[ij0]->datum[k]].z;
-					weight_sum += weight;
+				/* OK, here we have enough data and need to calculate the weighted value */
+
+				n_set++;
+				weight_sum = grd_sum = 0.0;	/* Initialize sums */
+				for (k = 0; k < Ctrl->N.sectors; k++) {
+					if (node_datum[k] >= 0) {
+						delta = three_over_radius * node_distance[k];
+						weight = 1.0 / (1.0 + delta * delta);	/* This is distance weight */
+						if (Ctrl->W.active) weight *= point[node_datum[k]].w;	/* This is observation weight */
+						grd_sum += weight * point[node_datum[k]].z;
+						weight_sum += weight;
+					}
 				}
+				Grid->data[ij] = (float)(grd_sum / weight_sum);
+				if (sparse) free_node (GMT, &B.node[ij0]);
 			}
-			Grid->data[ij] = (float)(grd_sum / weight_sum);
-			free_node (GMT, grid_node[ij0]);
-			ij0++;
 		}
-		GMT_Report (API, GMT_MSG_VERBOSE, "Gridded row %10ld\r", row);
+		GMT_Report (API, GMT_MSG_DEBUG, "Gridded rows %d-%d\n", r0, r1 - 1);
+	}
+	if (sparse)
+		GMT_free (GMT, B.node);
+	else {
+		GMT_free (GMT, B.distance);
+		GMT_free (GMT, B.datum);
+	}
 	}
-	GMT_Report (API, GMT_MSG_VERBOSE, "Gridded row %10ld\n", row);
 
 	if (GMT_Set_Comment (API, GMT_IS_GRID, GMT_COMMENT_IS_OPTION | GMT_COMMENT_IS_COMMAND, options, Grid)) Return (API->error);
 
@@ -513,7 +622,8 @@ int GMT_nearneighbor (void *V_API, int mode, void *args)
 	}
 
 	GMT_free (GMT, point);
-	GMT_free (GMT, grid_node);
+	GMT_free (GMT, b_start);
+	GMT_free (GMT, b_id);
 	GMT_free (GMT, d_col);
 	GMT_free (GMT, x0);
 	GMT_free (GMT, y0);
@@ -793,7 +793,7 @@ int GMT_pscontour (void *V_API, int mode, void *args)
 
 	/* Map transform */
 
-	if (convert) for (i = 0; i < n; i++) GMT_geo_to_xy (GMT, x[i], y[i], &x[i], &y[i]);
+	if (convert) GMT_geo_to_xy_n (GMT, x, y, x, y, n);
 
 	if (Ctrl->Q.active) {	/* Read precalculated triangulation indices */
 		uint64_t seg, row, col;
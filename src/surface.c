@@ -58,6 +58,9 @@ struct SURFACE_CTRL {
 		bool active;
 		double value;
 	} C;
+	struct E {	/* -E */
+		bool active;
+	} E;
 	struct D {	/* -D<line.xyz> */
 		bool active;
 		char *file;	/* Name of file with breaklines */
@@ -99,6 +102,7 @@ struct SURFACE_CTRL {
 };
 
 #define SURFACE_OUTSIDE LONG_MAX	/* Index number indicating data is outside usable area */
+#define SURFACE_N_COLORS 5	/* Node colors needed so no two nodes in the 12-point stencil share a color */
 
 struct SURFACE_DATA {	/* Data point and index to node it currently constrains  */
 	float x;
@@ -143,6 +147,7 @@ struct SURFACE_INFO {	/* Control structure for surface setup and execution */
 	unsigned int max_iterations;	/* Max iter per call to iterate */
 	uint64_t total_iterations;
 	bool periodic;		/* true if geographic grid and west-east == 360 */
+	bool multicolor;	/* true if nodes are updated in multicolor order (-E) */
 	int grid_east;
 	int offset[25][12];	/* Indices of 12 nearby points in 25 cases of edge conditions  */
 	bool constrained;		/* true if set_low or set_high is true */
@@ -778,16 +783,158 @@ int write_output_surface (struct GMT_CTRL *GMT, struct SURFACE_INFO *C, char *gr
 	return (0);
 }
 
+double update_node (struct SURFACE_INFO *C, float *u, char *iu, uint64_t ij, int i, int j, int kase, struct SURFACE_BRIGGS *B)
+{	/* Finite difference update of the unfixed node ij at column i, row j given its edge kase.  B holds the
+	 * Briggs coefficients if the node is constrained.  Returns the absolute change of the node value */
+	int k;
+	uint64_t ij_v2;
+	double change, busum, sum_ij = 0.0;
+	double b0, b1, b2, b3, b4, b5;
+
+	if (iu[ij] == 0) {		/* Point is unconstrained  */
+		for (k = 0; k < 12; k++) {
+			sum_ij += (u[ij + C->offset[kase][k]] * C->coeff[0][k]);
+		}
+	}
+	else {				/* Point is constrained  */
+
+		b0 = B->b[0];
+		b1 = B->b[1];
+		b2 = B->b[2];
+		b3 = B->b[3];
+		b4 = B->b[4];
+		b5 = B->b[5];
+		if (iu[ij] < 3) {
+			if (iu[ij] == 1) {	/* Point is in quadrant 1  */
+				busum = b0 * u[ij + C->offset[kase][10]]
+					+ b1 * u[ij + C->offset[kase][9]]
+					+ b2 * u[ij + C->offset[kase][5]]
+					+ b3 * u[ij + C->offset[kase][1]];
+			}
+			else {			/* Point is in quadrant 2  */
+				busum = b0 * u[ij + C->offset[kase][8]]
+					+ b1 * u[ij + C->offset[kase][9]]
+					+ b2 * u[ij + C->offset[kase][6]]
+					+ b3 * u[ij + C->offset[kase][3]];
+			}
+		}
+		else {
+			if (iu[ij] == 3) {	/* Point is in quadrant 3  */
+				busum = b0 * u[ij + C->offset[kase][1]]
+					+ b1 * u[ij + C->offset[kase][2]]
+					+ b2 * u[ij + C->offset[kase][6]]
+					+ b3 * u[ij + C->offset[kase][10]];
+			}
+			else {		/* Point is in quadrant 4  */
+				busum = b0 * u[ij + C->offset[kase][3]]
+					+ b1 * u[ij + C->offset[kase][2]]
+					+ b2 * u[ij + C->offset[kase][5]]
+					+ b3 * u[ij + C->offset[kase][8]];
+			}
+		}
+		for (k = 0; k < 12; k++) {
+			sum_ij += (u[ij + C->offset[kase][k]] * C->coeff[1][k]);
+		}
+		sum_ij = (sum_ij + C->a0_const_2 * (busum + b5))
+			/ (C->a0_const_1 + C->a0_const_2 * b4);
+	}
+
+	/* New relaxation here  */
+	sum_ij = u[ij] * C->relax_old + sum_ij * C->relax_new;
+
+	if (C->constrained) {	/* Must check limits.  Note lower/upper is in standard scanline format and need ij_v2! */
+		ij_v2 = GMT_IJP (C->Grid->header, C->ny - j - 1, i);
+		if (C->set_low && !GMT_is_fnan (C->Low->data[ij_v2]) && sum_ij < C->Low->data[ij_v2])
+			sum_ij = C->Low->data[ij_v2];
+		else if (C->set_high && !GMT_is_fnan (C->High->data[ij_v2]) && sum_ij > C->High->data[ij_v2])
+			sum_ij = C->High->data[ij_v2];
+	}
+
+	change = fabs (sum_ij - u[ij]);
+	u[ij] = (float)sum_ij;
+	return (change);
+}
+
+uint64_t *set_briggs_start (struct GMT_CTRL *GMT, struct SURFACE_INFO *C)
+{	/* The Briggs coefficients are stored in the order the nodes are visited by the
+	 * serial sweep.  For the multicolor sweep each column must know where its
+	 * coefficients start, so we return the number of constrained nodes before each column */
+	int i, j, col;
+	uint64_t ij, n = 0, *b_start = GMT_memory (GMT, NULL, C->block_nx, uint64_t);
+
+	for (i = col = 0; i < C->nx; i += C->grid, col++) {
+		b_start[col] = n;
+		for (j = 0, ij = C->ij_sw_corner + i * C->my; j < C->ny; j += C->grid, ij += C->grid)
+			if (C->iu[ij] > 0 && C->iu[ij] < 5) n++;
+	}
+	return (b_start);
+}
+
+double sweep_multicolor (struct SURFACE_INFO *C, uint64_t *b_start)
+{	/* One iteration over all nodes in multicolor order.  Node (col,row) in units of C->grid
+	 * gets color (col + 3*row) % SURFACE_N_COLORS, which gives different colors to any two nodes
+	 * within the 12-point stencil.  Hence all nodes of one color can be updated at the same
+	 * time, and we split each color sweep over threads by column.  Returns max abs change */
+	int i, j, col, row, color, kase, x_case, y_case;
+	uint64_t ij, briggs_index;
+	double change, max_change = -1.0, thread_max;
+	char *iu = C->iu;
+	float *u = C->Grid->data;
+
+#ifdef _OPENMP
+#pragma omp parallel private(i,j,col,row,color,kase,x_case,y_case,ij,briggs_index,change,thread_max) shared(C,u,iu,b_start,max_change)
+#endif
+	{
+	thread_max = -1.0;
+	for (color = 0; color < SURFACE_N_COLORS; color++) {	/* Colors must be done one after the other */
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+		for (col = 0; col < C->block_nx; col++) {
+			i = col * C->grid;
+			if (col < 2)
+				x_case = col;
+			else if (C->block_nx - 1 - col < 2)
+				x_case = 4 - (C->block_nx - 1 - col);
+			else
+				x_case = 2;
+			briggs_index = b_start[col];
+			for (row = j = 0, ij = C->ij_sw_corner + i * C->my; j < C->ny; row++, j += C->grid, ij += C->grid) {
+				if (iu[ij] == 5) continue;	/* Point is fixed  */
+				if ((col + 3 * row) % SURFACE_N_COLORS != color) {	/* Not this time, but keep track of constraints */
+					if (iu[ij] > 0) briggs_index++;
+					continue;
+				}
+				if (row < 2)
+					y_case = row;
+				else if (C->block_ny - 1 - row < 2)
+					y_case = 4 - (C->block_ny - 1 - row);
+				else
+					y_case = 2;
+				kase = x_case * 5 + y_case;
+				change = update_node (C, u, iu, ij, i, j, kase, C->briggs + briggs_index);
+				if (iu[ij] > 0) briggs_index++;	/* Used one constraint */
+				if (change > thread_max) thread_max = change;
+			}
+		}	/* Implicit barrier here so the next color sees all updates */
+	}
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+	if (thread_max > max_change) max_change = thread_max;
+	}
+	return (max_change);
+}
+
 uint64_t iterate (struct GMT_CTRL *GMT, struct SURFACE_INFO *C, int mode)
 {	/* Main finite difference solver */
-	uint64_t ij, briggs_index, ij_v2, iteration_count = 0, ij_sw, ij_se;
-	int i, j, k, kase;
+	uint64_t ij, briggs_index, iteration_count = 0, ij_sw, ij_se, *b_start = NULL;
+	int i, j, kase;
 	int x_case, y_case, x_w_case, x_e_case, y_s_case, y_n_case;
 	char *iu = C->iu;
 
 	double current_limit = C->converge_limit / C->grid;
-	double change, max_change = 0.0, busum, sum_ij;
-	double b0, b1, b2, b3, b4, b5;
+	double change, max_change = 0.0;
 	float *u = C->Grid->data;
 
 	double x_0_const = 4.0 * (1.0 - C->boundary_tension) / (2.0 - C->boundary_tension);
@@ -797,6 +944,7 @@ uint64_t iterate (struct GMT_CTRL *GMT, struct SURFACE_INFO *C, int mode)
 	double y_1_const = (C->boundary_tension - 2 * C->l_epsilon * (1.0 - C->boundary_tension) ) / y_denom;
 
 	sprintf (C->format,"%%4ld\t%%c\t%%8" PRIu64 "\t%s\t%s\t%%10" PRIu64 "\n", GMT->current.setting.format_float_out, GMT->current.setting.format_float_out);
+	if (C->multicolor) b_start = set_briggs_start (GMT, C);	/* Constrained nodes do not change during iterations */
 
 	do {
 		briggs_index = 0;	/* Reset the constraint table stack pointer  */
@@ -932,99 +1080,41 @@ uint64_t iterate (struct GMT_CTRL *GMT, struct SURFACE_INFO *C, int mode)
 
 		/* That's it for the boundary points.  Now loop over all data  */
 
-		x_w_case = 0;
-		x_e_case = C->block_nx - 1;
-		for (i = 0; i < C->nx; i += C->grid, x_w_case++, x_e_case--) {
-
-			if(x_w_case < 2)
-				x_case = x_w_case;
-			else if(x_e_case < 2)
-				x_case = 4 - x_e_case;
-			else
-				x_case = 2;
-
-			y_s_case = 0;
-			y_n_case = C->block_ny - 1;
-
-			ij = C->ij_sw_corner + i * C->my;
-
-			for (j = 0; j < C->ny; j += C->grid, ij += C->grid, y_s_case++, y_n_case--) {
+		if (C->multicolor)	/* Sweep the nodes of one color at a time, sharing each sweep among threads */
+			max_change = sweep_multicolor (C, b_start);
+		else {	/* Classic Gauss-Seidel sweep in storage order */
+			x_w_case = 0;
+			x_e_case = C->block_nx - 1;
+			for (i = 0; i < C->nx; i += C->grid, x_w_case++, x_e_case--) {
+
+				if(x_w_case < 2)
+					x_case = x_w_case;
+				else if(x_e_case < 2)
+					x_case = 4 - x_e_case;
+				else
+					x_case = 2;
 
-				if (iu[ij] == 5) continue;	/* Point is fixed  */
+				y_s_case = 0;
+				y_n_case = C->block_ny - 1;
 
-				if(y_s_case < 2)
-					y_case = y_s_case;
-				else if(y_n_case < 2)
-					y_case = 4 - y_n_case;
-				else
-					y_case = 2;
+				ij = C->ij_sw_corner + i * C->my;
 
-				kase = x_case * 5 + y_case;
-				sum_ij = 0.0;
+				for (j = 0; j < C->ny; j += C->grid, ij += C->grid, y_s_case++, y_n_case--) {
 
-				if (iu[ij] == 0) {		/* Point is unconstrained  */
-					for (k = 0; k < 12; k++) {
-						sum_ij += (u[ij + C->offset[kase][k]] * C->coeff[0][k]);
-					}
-				}
-				else {				/* Point is constrained  */
-
-					b0 = C->briggs[briggs_index].b[0];
-					b1 = C->briggs[briggs_index].b[1];
-					b2 = C->briggs[briggs_index].b[2];
-					b3 = C->briggs[briggs_index].b[3];
-					b4 = C->briggs[briggs_index].b[4];
-					b5 = C->briggs[briggs_index].b[5];
-					briggs_index++;
-					if (iu[ij] < 3) {
-						if (iu[ij] == 1) {	/* Point is in quadrant 1  */
-							busum = b0 * u[ij + C->offset[kase][10]]
-								+ b1 * u[ij + C->offset[kase][9]]
-								+ b2 * u[ij + C->offset[kase][5]]
-								+ b3 * u[ij + C->offset[kase][1]];
-						}
-						else {			/* Point is in quadrant 2  */
-							busum = b0 * u[ij + C->offset[kase][8]]
-								+ b1 * u[ij + C->offset[kase][9]]
-								+ b2 * u[ij + C->offset[kase][6]]
-								+ b3 * u[ij + C->offset[kase][3]];
-						}
-					}
-					else {
-						if (iu[ij] == 3) {	/* Point is in quadrant 3  */
-							busum = b0 * u[ij + C->offset[kase][1]]
-								+ b1 * u[ij + C->offset[kase][2]]
-								+ b2 * u[ij + C->offset[kase][6]]
-								+ b3 * u[ij + C->offset[kase][10]];
-						}
-						else {		/* Point is in quadrant 4  */
-							busum = b0 * u[ij + C->offset[kase][3]]
-								+ b1 * u[ij + C->offset[kase][2]]
-								+ b2 * u[ij + C->offset[kase][5]]
-								+ b3 * u[ij + C->offset[kase][8]];
-						}
-					}
-					for (k = 0; k < 12; k++) {
-						sum_ij += (u[ij + C->offset[kase][k]] * C->coeff[1][k]);
-					}
-					sum_ij = (sum_ij + C->a0_const_2 * (busum + b5))
-						/ (C->a0_const_1 + C->a0_const_2 * b4);
-				}
+					if (iu[ij] == 5) continue;	/* Point is fixed  */
 
-				/* New relaxation here  */
-				sum_ij = u[ij] * C->relax_old + sum_ij * C->relax_new;
+					if(y_s_case < 2)
+						y_case = y_s_case;
+					else if(y_n_case < 2)
+						y_case = 4 - y_n_case;
+					else
+						y_case = 2;
 
-				if (C->constrained) {	/* Must check limits.  Note lower/upper is in standard scanline format and need ij_v2! */
-					ij_v2 = GMT_IJP (C->Grid->header, C->ny - j - 1, i);
-					if (C->set_low && !GMT_is_fnan (C->Low->data[ij_v2]) && sum_ij < C->Low->data[ij_v2])
-						sum_ij = C->Low->data[ij_v2];
-					else if (C->set_high && !GMT_is_fnan (C->High->data[ij_v2]) && sum_ij > C->High->data[ij_v2])
-						sum_ij = C->High->data[ij_v2];
+					kase = x_case * 5 + y_case;
+					change = update_node (C, u, iu, ij, i, j, kase, C->briggs + briggs_index);
+					if (iu[ij] > 0) briggs_index++;	/* Used one constraint */
+					if (change > max_change) max_change = change;
 				}
-
-				change = fabs (sum_ij - u[ij]);
-				u[ij] = (float)sum_ij;
-				if (change > max_change) max_change = change;
 			}
 		}
 		iteration_count++;
@@ -1038,6 +1128,7 @@ uint64_t iterate (struct GMT_CTRL *GMT, struct SURFACE_INFO *C, int mode)
 	GMT_Report (GMT->parent, GMT_MSG_VERBOSE, C->format,
 		C->grid, C->mode_type[mode], iteration_count, max_change, current_limit, C->total_iterations);
 
+	if (C->multicolor) GMT_free (GMT, b_start);
 	return (iteration_count);
 }
 
@@ -1365,6 +1456,7 @@ void load_parameters_surface (struct SURFACE_INFO *C, struct SURFACE_CTRL *Ctrl)
 	C->interior_tension = Ctrl->T.i_tension;
 	C->l_epsilon = Ctrl->A.value;
 	C->converge_limit = Ctrl->C.value;
+	C->multicolor = Ctrl->E.active;
 }
 
 void interp_breakline (struct GMT_CTRL *GMT, struct SURFACE_INFO *C, struct GMT_DATATABLE *xyzline)
@@ -1489,7 +1581,7 @@ int GMT_surface_usage (struct GMTAPI_CTRL *API, int level)
 	if (level == GMT_MODULE_PURPOSE) return (GMT_NOERROR);
 	GMT_Message (API, GMT_TIME_NONE, "usage: surface [<table>] -G<outgrid> %s\n", GMT_I_OPT);
 	GMT_Message (API, GMT_TIME_NONE, "\t%s [-A<aspect_ratio>] [-C<convergence_limit>]\n", GMT_Rgeo_OPT);
-	GMT_Message (API, GMT_TIME_NONE, "\t[-D<breakline>] [-Ll<limit>] [-Lu<limit>] [-N<n_iterations>] ] [-S<search_radius>[m|s]]\n");
+	GMT_Message (API, GMT_TIME_NONE, "\t[-D<breakline>] [-E] [-Ll<limit>] [-Lu<limit>] [-N<n_iterations>] ] [-S<search_radius>[m|s]]\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t[-T[i|b]<tension>] [-Q] [%s] [-Z<over_relaxation_parameter>]\n\t[%s] [%s]\n\t[%s] [%s]\n\t[%s] [%s] [%s]\n\n",
 		GMT_V_OPT, GMT_bi_OPT, GMT_f_OPT, GMT_h_OPT, GMT_i_OPT, GMT_r_OPT, GMT_s_OPT, GMT_colon_OPT);
 
@@ -1507,6 +1599,8 @@ int GMT_surface_usage (struct GMTAPI_CTRL *API, int level)
 	GMT_Message (API, GMT_TIME_NONE, "\t   Default will choose 0.001 of the range of your z data (1 ppt precision).\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   Enter your own convergence limit in same units as z data.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t-D Use xyz data (can be multiseg) in the <breakline> file as a 'soft breakline'.\n");
+	GMT_Message (API, GMT_TIME_NONE, "\t-E Update nodes in multicolor order so each iteration can be shared among threads.\n");
+	GMT_Message (API, GMT_TIME_NONE, "\t   The solution may differ from the default ordering by up to the convergence limit.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t-L Constrain the range of output values:\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   -Ll<limit> specifies lower limit; forces solution to be >= <limit>.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   -Lu<limit> specifies upper limit; forces solution to be <= <limit>.\n");
@@ -1574,6 +1668,9 @@ int GMT_surface_parse (struct GMT_CTRL *GMT, struct SURFACE_CTRL *Ctrl, struct G
 				else
 					n_errors++;
 				break;
+			case 'E':
+				Ctrl->E.active = true;
+				break;
 			case 'G':
 				if ((Ctrl->G.active = GMT_check_filearg (GMT, 'G', opt->arg, GMT_OUT, GMT_IS_GRID)))
 					Ctrl->G.file = strdup (opt->arg);
@@ -0,0 +1,106 @@
+/*--------------------------------------------------------------------
+ *	$Id$
+ *
+ *	Copyright (c) 1991-$year by P. Wessel, W. H. F. Smith, R. Scharroo, J. Luis and F. Wobbe
+ *	See LICENSE.TXT file for copying and redistribution conditions.
+ *
+ *	This program is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU Lesser General Public License as published by
+ *	the Free Software Foundation; version 3 or any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU Lesser General Public License for more details.
+ *
+ *	Contact info: gmt.soest.hawaii.edu
+ *--------------------------------------------------------------------*/
+/*
+ * Benchmark for decoding plain floating point columns.  Writes a synthetic
+ * table with <n_rows> records (or uses the given file), then decodes every
+ * field with GMT_scanf (GMT_IS_FLOAT) and with plain strtod, reporting the
+ * time spent by each and the number of values that were not identical.
+ *
+ * Usage:	testscanf [<n_rows>] [<file>]
+ *
+ * Version:	5
+ * Created:	16-Oct-2026
+ *
+ */
+
+#include "gmt_dev.h"
+
+#define N_ROWS_DEFAULT 2000000
+
+int main (int argc, char *argv[]) {
+	uint64_t row, n_rows = N_ROWS_DEFAULT, n_values = 0, n_diff = 0, n_nan = 0;
+	unsigned int pass;
+	bool remove_file = false;
+	char line[GMT_BUFSIZ], *token = NULL, *stringp = NULL, *end = NULL, file[GMT_BUFSIZ] = {"testscanf.txt"};
+	double x, y, sum[2] = {0.0, 0.0}, elapsed[2];
+	clock_t tic;
+	FILE *fp = NULL;
+	struct GMTAPI_CTRL *API = NULL;		/* GMT API control structure */
+	struct GMT_CTRL *GMT = NULL;
+
+	/* 1. Initializing new GMT session */
+	if ((API = GMT_Create_Session ("TEST", 2U, 0U, NULL)) == NULL) exit (EXIT_FAILURE);
+	GMT = API->GMT;
+
+	if (argc > 1) n_rows = strtoull (argv[1], NULL, 10);
+	if (argc > 2)	/* Use the user's file */
+		strncpy (file, argv[2], GMT_BUFSIZ-1);
+	else {	/* 2. Write a synthetic table with a mix of typical number formats */
+		if ((fp = fopen (file, "w")) == NULL) exit (EXIT_FAILURE);
+		srand (1);
+		for (row = 0; row < n_rows; row++) {
+			x = 360.0 * rand () / RAND_MAX - 180.0;
+			y = 180.0 * rand () / RAND_MAX - 90.0;
+			fprintf (fp, "%.6f\t%.10g %.4e,%d\n", x, y, 1.0e4 * (x - y), rand () % 10000);
+		}
+		fclose (fp);
+		remove_file = true;
+	}
+
+	/* 3. Decode all fields with strtod, then with GMT_scanf, and finally compare the two */
+	for (pass = 0; pass < 3; pass++) {
+		if ((fp = fopen (file, "r")) == NULL) exit (EXIT_FAILURE);
+		tic = clock ();
+		while (fgets (line, GMT_BUFSIZ, fp)) {
+			if (line[0] == '#' || line[0] == '>') continue;
+			GMT_chop (line);
+			stringp = line;
+			while ((token = strsepz (&stringp, GMT_TOKEN_SEPARATORS)) != NULL) {
+				if (pass != 1) {
+					x = strtod (token, &end);
+					if (end[0]) x = GMT->session.d_NaN;
+				}
+				if (pass != 0 && GMT_scanf (GMT, token, GMT_IS_FLOAT, &y) == GMT_IS_NAN)
+					y = GMT->session.d_NaN;
+				if (pass == 0)
+					sum[0] += (GMT_is_dnan (x)) ? 0.0 : x;
+				else if (pass == 1)
+					sum[1] += (GMT_is_dnan (y)) ? 0.0 : y;
+				else {	/* Compare the two */
+					if (GMT_is_dnan (x) && GMT_is_dnan (y))
+						n_nan++;
+					else if (GMT_is_dnan (x) || GMT_is_dnan (y) || memcmp (&x, &y, sizeof (double)))
+						n_diff++;
+					n_values++;
+				}
+			}
+		}
+		if (pass < 2) elapsed[pass] = (double)(clock () - tic) / CLOCKS_PER_SEC;
+		fclose (fp);
+	}
+	if (remove_file) remove (file);
+
+	printf ("Decoded %" PRIu64 " values (%" PRIu64 " NaN)\n", n_values, n_nan);
+	printf ("strtod    : %8.3f s [checksum %.17g]\n", elapsed[0], sum[0]);
+	printf ("GMT_scanf : %8.3f s [checksum %.17g] (%" PRIu64 " values differ)\n", elapsed[1], sum[1], n_diff);
+
+	/* 4. Destroy GMT session */
+	if (GMT_Destroy_Session (API)) exit (EXIT_FAILURE);
+
+	exit ((n_diff) ? EXIT_FAILURE : GMT_OK);
+}
@@ -89,6 +89,89 @@ int compare_edge (const void *p1, const void *p2)
 	return (0);
 }
 
+#define TRIANGULATE_BANDS_PER_THREAD	8	/* Row bands per thread when gridding in parallel */
+
+bool triangle_rows (struct GMT_CTRL *GMT, struct GMT_GRID_HEADER *h, double *xx, double *yy, int *link, uint64_t k, int *row_min, int *row_max)
+{	/* Determine the grid rows triangle k may cover; return false if it is entirely outside the grid */
+	int col_min, col_max, nx = h->nx, ny = h->ny;
+	uint64_t ij = 3 * k;
+	double x0 = xx[link[ij]], x1 = xx[link[ij+1]], x2 = xx[link[ij+2]];
+	double y0 = yy[link[ij]], y1 = yy[link[ij+1]], y2 = yy[link[ij+2]];
+
+	col_min = (int)GMT_grd_x_to_col (GMT, MIN (MIN (x0, x1), x2), h);
+	col_max = (int)GMT_grd_x_to_col (GMT, MAX (MAX (x0, x1), x2), h);
+	*row_min = (int)GMT_grd_y_to_row (GMT, MAX (MAX (y0, y1), y2), h);
+	*row_max = (int)GMT_grd_y_to_row (GMT, MIN (MIN (y0, y1), y2), h);
+
+	if ((col_max < 0) || (col_min >= nx)) return (false);	/* Triangle to the left or right */
+	if ((*row_max < 0) || (*row_min >= ny)) return (false);	/* Triangle above or below */
+	if (*row_min < 0) *row_min = 0;
+	if (*row_max >= ny) *row_max = ny - 1;
+	return (true);
+}
+
+void triangle_fill (struct GMT_CTRL *GMT, struct GMT_GRID *G, double *x_grd, double *y_grd, double *xx, double *yy, double *zz, int *link, uint64_t k, unsigned int dir, int row_min, int row_max)
+{	/* Scan-convert triangle k over rows row_min-row_max.  For each row we intersect the three edges with the
+	 * row to get the exact x-span covered and turn it into a column range, so no node is ever tested for
+	 * inclusion.  Nodes on the edges (within a tiny tolerance) are included, as for the old winding test. */
+	int row, col, col_min, col_max, nx = G->header->nx;
+	unsigned int e;
+	uint64_t p, ij = 3 * k;
+	double vx[4], vy[4], zj, zk, zl, xkj, ykj, zkj, xlj, ylj, zlj, f, a, b, c;
+	double yp, t, xc, x_min, x_max, y_lo, y_hi, x_tol, y_tol;
+
+	/* Find equation for the plane as z = ax + by + c */
+
+	vx[0] = vx[3] = xx[link[ij]];	vy[0] = vy[3] = yy[link[ij]];	zj = zz[link[ij++]];
+	vx[1] = xx[link[ij]];	vy[1] = yy[link[ij]];	zk = zz[link[ij++]];
+	vx[2] = xx[link[ij]];	vy[2] = yy[link[ij]];	zl = zz[link[ij]];
+
+	xkj = vx[1] - vx[0];	ykj = vy[1] - vy[0];
+	zkj = zk - zj;	xlj = vx[2] - vx[0];
+	ylj = vy[2] - vy[0];	zlj = zl - zj;
+
+	f = 1.0 / (xkj * ylj - ykj * xlj);
+	a = -f * (ykj * zlj - zkj * ylj);
+	b = -f * (zkj * xlj - xkj * zlj);
+	c = -a * vx[1] - b * vy[1] + zk;
+
+	x_tol = GMT_CONV8_LIMIT * G->header->inc[GMT_X];
+	y_tol = GMT_CONV8_LIMIT * G->header->inc[GMT_Y];
+
+	for (row = row_min; row <= row_max; row++) {
+		yp = y_grd[row];
+		x_min = DBL_MAX;	x_max = -DBL_MAX;
+		for (e = 0; e < 3; e++) {	/* Intersect row with each edge */
+			y_lo = MIN (vy[e], vy[e+1]);	y_hi = MAX (vy[e], vy[e+1]);
+			if (yp < (y_lo - y_tol) || yp > (y_hi + y_tol)) continue;	/* Edge does not reach this row */
+			if ((y_hi - y_lo) <= y_tol) {	/* Horizontal edge lying on the row */
+				x_min = MIN (x_min, MIN (vx[e], vx[e+1]));
+				x_max = MAX (x_max, MAX (vx[e], vx[e+1]));
+				continue;
+			}
+			t = (yp - vy[e]) / (vy[e+1] - vy[e]);
+			if (t < 0.0) t = 0.0; else if (t > 1.0) t = 1.0;
+			xc = vx[e] + t * (vx[e+1] - vx[e]);
+			if (xc < x_min) x_min = xc;
+			if (xc > x_max) x_max = xc;
+		}
+		if (x_min > x_max) continue;	/* Row misses the triangle */
+		col_min = (int)ceil ((x_min - x_tol - x_grd[0]) * G->header->r_inc[GMT_X]);
+		col_max = (int)floor ((x_max + x_tol - x_grd[0]) * G->header->r_inc[GMT_X]);
+		if (col_min < 0) col_min = 0;
+		if (col_max >= nx) col_max = nx - 1;
+		if (col_min > col_max) continue;	/* Span falls between nodes or outside the grid */
+
+		p = GMT_IJP (G->header, row, col_min);
+		if (dir == GMT_X)
+			for (col = col_min; col <= col_max; col++, p++) G->data[p] = (float)a;
+		else if (dir == GMT_Y)
+			for (col = col_min; col <= col_max; col++, p++) G->data[p] = (float)b;
+		else
+			for (col = col_min; col <= col_max; col++, p++) G->data[p] = (float)(a * x_grd[col] + b * yp + c);
+	}
+}
+
 void *New_triangulate_Ctrl (struct GMT_CTRL *GMT) {	/* Allocate and initialize a new control structure */
 	struct TRIANGULATE_CTRL *C = NULL;
 	
@@ -240,13 +323,12 @@ int GMT_triangulate (void *V_API, int mode, void *args)
 	
 	uint64_t ij, ij1, ij2, ij3, np, i, j, k, n_edge, p, n = 0;
 	unsigned int n_input, n_output;
-	int row, col, col_min, col_max, row_min, row_max, error = 0;
+	int row_min, row_max, n_bands = 1, band_h = 0, n_threads = 1, error = 0;
 	bool triplets[2] = {false, false}, map_them = false;
 	
 	size_t n_alloc;
 	
-	double zj, zk, zl, zlj, zkj, xp, yp, a, b, c, f;
-	double xkj, xlj, ykj, ylj, out[3], vx[4], vy[4];
+	double out[3], *x_grd = NULL, *y_grd = NULL;
 	double *xx = NULL, *yy = NULL, *zz = NULL, *in = NULL;
 	double *xe = NULL, *ye = NULL;
 
@@ -367,7 +449,7 @@ int GMT_triangulate (void *V_API, int mode, void *args)
 
 		xxp = GMT_memory (GMT, NULL, n, double);
 		yyp = GMT_memory (GMT, NULL, n, double);
-		for (i = 0; i < n; i++) GMT_geo_to_xy (GMT, xx[i], yy[i], &xxp[i], &yyp[i]);
+		GMT_geo_to_xy_n (GMT, xx, yy, xxp, yyp, n);
 
 		GMT_Report (API, GMT_MSG_VERBOSE, "Do Delaunay optimal triangulation on projected coordinates\n");
 
@@ -401,65 +483,59 @@ int GMT_triangulate (void *V_API, int mode, void *args)
 	
 
 	if (Ctrl->G.active) {	/* Grid via planar triangle segments */
-		int nx = Grid->header->nx, ny = Grid->header->ny;	/* Signed versions */
+		int ny = Grid->header->ny;	/* Signed version */
 		if (GMT_Create_Data (API, GMT_IS_GRID, GMT_IS_GRID, GMT_GRID_DATA_ONLY, NULL, NULL, NULL, 0, 0, Grid) == NULL) Return (API->error);
 		if (!Ctrl->E.active) Ctrl->E.value = GMT->session.d_NaN;
 		for (p = 0; p < Grid->header->size; p++) Grid->data[p] = (float)Ctrl->E.value;	/* initialize grid */
 
-		for (k = ij = 0; k < np; k++) {
-
-			/* Find equation for the plane as z = ax + by + c */
-
-			vx[0] = vx[3] = xx[link[ij]];	vy[0] = vy[3] = yy[link[ij]];	zj = zz[link[ij++]];
-			vx[1] = xx[link[ij]];	vy[1] = yy[link[ij]];	zk = zz[link[ij++]];
-			vx[2] = xx[link[ij]];	vy[2] = yy[link[ij]];	zl = zz[link[ij++]];
-
-			xkj = vx[1] - vx[0];	ykj = vy[1] - vy[0];
-			zkj = zk - zj;	xlj = vx[2] - vx[0];
-			ylj = vy[2] - vy[0];	zlj = zl - zj;
-
-			f = 1.0 / (xkj * ylj - ykj * xlj);
-			a = -f * (ykj * zlj - zkj * ylj);
-			b = -f * (zkj * xlj - xkj * zlj);
-			c = -a * vx[1] - b * vy[1] + zk;
-
-			/* Compute grid indices the current triangle may cover, assuming all triangles are
-			   in the -R region (Grid->header->wesn[XLO]/x_max etc.)  Always, col_min <= col_max, row_min <= row_max.
-			 */
-
-			xp = MIN (MIN (vx[0], vx[1]), vx[2]);	col_min = (int)GMT_grd_x_to_col (GMT, xp, Grid->header);
-			xp = MAX (MAX (vx[0], vx[1]), vx[2]);	col_max = (int)GMT_grd_x_to_col (GMT, xp, Grid->header);
-			yp = MAX (MAX (vy[0], vy[1]), vy[2]);	row_min = (int)GMT_grd_y_to_row (GMT, yp, Grid->header);
-			yp = MIN (MIN (vy[0], vy[1]), vy[2]);	row_max = (int)GMT_grd_y_to_row (GMT, yp, Grid->header);
-
-			/* Adjustments for triangles outside -R region. */
-			/* Triangle to the left or right. */
-			if ((col_max < 0) || (col_min >= nx)) continue;
-			/* Triangle Above or below */
-			if ((row_max < 0) || (row_min >= ny)) continue;
-
-			/* Triangle covers boundary, left or right. */
-			if (col_min < 0) col_min = 0;       if (col_max >= nx) col_max = Grid->header->nx - 1;
-			/* Triangle covers boundary, top or bottom. */
-			if (row_min < 0) row_min = 0;       if (row_max >= ny) row_max = Grid->header->ny - 1;
-
-			for (row = row_min; row <= row_max; row++) {
-				yp = GMT_grd_row_to_y (GMT, row, Grid->header);
-				p = GMT_IJP (Grid->header, row, col_min);
-				for (col = col_min; col <= col_max; col++, p++) {
-					xp = GMT_grd_col_to_x (GMT, col, Grid->header);
-
-					if (!GMT_non_zero_winding (GMT, xp, yp, vx, vy, 4)) continue;	/* Outside */
-
-					if (Ctrl->D.dir == GMT_X)
-						Grid->data[p] = (float)a;
-					else if (Ctrl->D.dir == GMT_Y)
-						Grid->data[p] = (float)b;
-					else
-						Grid->data[p] = (float)(a * xp + b * yp + c);
+		x_grd = GMT_grd_coord (GMT, Grid->header, GMT_X);
+		y_grd = GMT_grd_coord (GMT, Grid->header, GMT_Y);
+#ifdef _OPENMP
+		if ((n_threads = omp_get_max_threads ()) > 1) {	/* Split rows into bands so each thread owns the nodes it writes */
+			band_h = (ny + TRIANGULATE_BANDS_PER_THREAD * n_threads - 1) / (TRIANGULATE_BANDS_PER_THREAD * n_threads);
+			n_bands = (ny + band_h - 1) / band_h;
+		}
+#endif
+		if (n_bands == 1) {	/* Serial: just scan-convert each triangle in turn */
+			for (k = 0; k < np; k++) {
+				if (!triangle_rows (GMT, Grid->header, xx, yy, link, k, &row_min, &row_max)) continue;	/* Outside -R */
+				triangle_fill (GMT, Grid, x_grd, y_grd, xx, yy, zz, link, k, Ctrl->D.dir, row_min, row_max);
+			}
+		}
+		else {	/* Bin triangles by the row bands they touch, then grid the bands in parallel */
+			int band;
+			uint64_t *b_start = NULL, *b_next = NULL, *b_list = NULL;
+			GMT_Report (API, GMT_MSG_VERBOSE, "Gridding %d row bands over %d threads\n", n_bands, n_threads);
+			b_start = GMT_memory (GMT, NULL, n_bands + 1, uint64_t);
+			b_next  = GMT_memory (GMT, NULL, n_bands, uint64_t);
+			for (k = 0; k < np; k++) {	/* Count triangles per band */
+				if (!triangle_rows (GMT, Grid->header, xx, yy, link, k, &row_min, &row_max)) continue;
+				for (band = row_min / band_h; band <= row_max / band_h; band++) b_start[band+1]++;
+			}
+			for (band = 0; band < n_bands; band++) b_start[band+1] += b_start[band];
+			for (band = 0; band < n_bands; band++) b_next[band] = b_start[band];
+			b_list = GMT_memory (GMT, NULL, MAX (b_start[n_bands], 1), uint64_t);
+			for (k = 0; k < np; k++) {	/* Fill band lists, keeping the triangle order so shared edges resolve as in serial mode */
+				if (!triangle_rows (GMT, Grid->header, xx, yy, link, k, &row_min, &row_max)) continue;
+				for (band = row_min / band_h; band <= row_max / band_h; band++) b_list[b_next[band]++] = k;
+			}
+#ifdef _OPENMP
+#pragma omp parallel for private(band,p,k,row_min,row_max) shared(GMT,Grid,Ctrl,x_grd,y_grd,xx,yy,zz,link,b_start,b_list,band_h,n_bands,ny) schedule(dynamic,1)
+#endif
+			for (band = 0; band < n_bands; band++) {
+				int r0 = band * band_h, r1 = MIN (r0 + band_h, ny) - 1;
+				for (p = b_start[band]; p < b_start[band+1]; p++) {
+					k = b_list[p];
+					triangle_rows (GMT, Grid->header, xx, yy, link, k, &row_min, &row_max);
+					triangle_fill (GMT, Grid, x_grd, y_grd, xx, yy, zz, link, k, Ctrl->D.dir, MAX (row_min, r0), MIN (row_max, r1));
 				}
 			}
+			GMT_free (GMT, b_start);
+			GMT_free (GMT, b_next);
+			GMT_free (GMT, b_list);
 		}
+		GMT_free (GMT, x_grd);
+		GMT_free (GMT, y_grd);
 		if (GMT_Set_Comment (API, GMT_IS_GRID, GMT_COMMENT_IS_OPTION | GMT_COMMENT_IS_COMMAND, options, Grid)) Return (API->error);
 		if (GMT_Write_Data (API, GMT_IS_GRID, GMT_IS_FILE, GMT_IS_SURFACE, GMT_GRID_ALL, NULL, Ctrl->G.file, Grid) != GMT_OK) {
 			Return (API->error);
@@ -33,6 +33,9 @@
 #define THIS_MODULE_PURPOSE	"Calculate crossovers between track data files"
 
 #include "x2sys.h"
+#ifdef HAVE_SYS_TIME_H_
+#include <sys/time.h>
+#endif
 
 #define GMT_PROG_OPTIONS "->JRVb"
 
@@ -55,6 +58,9 @@ struct X2SYS_CROSS_CTRL {
 		bool active;
 		int mode;
 	} I;
+	struct X2S_CROSS_M {	/* -M */
+		bool active;
+	} M;
 	struct X2S_CROSS_S {	/* -S */
 		bool active[2];
 		double limit[3];
@@ -80,6 +86,51 @@ struct PAIR {				/* Used with -Kkombinations.lis option */
 	char *id1, *id2;
 };
 
+struct X2SYS_CROSS_TRACK {	/* Everything we need to know about one track */
+	uint64_t n_rec;			/* Number of data records */
+	bool has_time;			/* true if the track actually has a time column */
+	double **data;			/* Data matrix */
+	double *dist;			/* Along-track distances */
+	double *time;			/* Along-track times (or dummy node indices) */
+	struct GMT_XSEGMENT *ylist;	/* y-indices sorted in increasing order */
+	struct X2SYS_FILE_INFO info;	/* File information */
+	uint64_t n_bins;		/* Number of index bins visited by the track [-M] */
+	uint64_t *bin;			/* Sorted list of these bins [-M] */
+};
+
+struct X2SYS_CROSS_WORK {	/* Settings and scratch space needed to evaluate crossovers; one per thread */
+	struct X2SYS_CROSS_CTRL *Ctrl;
+	struct X2SYS_INFO *s;
+	bool got_time;			/* true if there is a time column */
+	uint64_t n_data_col;		/* Number of data fields */
+	uint64_t *col_number;		/* Column numbers of the data fields */
+	double vel_scale;		/* Scale to give selected velocity units */
+	double t_scale;			/* Scale to give time in seconds */
+	double time_gap, dist_gap;	/* Data gap criteria */
+	double *t, *y;			/* Interpolation y(t) arrays */
+	double *xdata[2];		/* Data vectors with estimated values at crossover points */
+	unsigned int *ok;		/* Number of tracks with an estimate for each field */
+};
+
+struct X2SYS_CROSS_INDEX {	/* Regular bins used to find the track pairs that may cross [-M] */
+	bool periodic;			/* true if x is longitude and wraps around */
+	unsigned int nx, ny;		/* Number of bins */
+	double wesn[4];			/* Region covered by the bins */
+	double i_inc[2];		/* Inverse bin sizes */
+};
+
+struct X2SYS_CROSS_BINTRACK {	/* A track visiting a bin [-M] */
+	uint64_t bin, track;
+};
+
+struct X2SYS_CROSS_RESULT {	/* Crossovers found between two tracks [-M] */
+	uint64_t A, B;			/* The two tracks */
+	uint64_t nx;			/* Number of crossovers found */
+	uint64_t n_out;			/* Number of output records in out */
+	double *out;			/* The output records */
+	double run_time;		/* Run time for -C */
+};
+
 void *New_x2sys_cross_Ctrl (struct GMT_CTRL *GMT) {	/* Allocate and initialize a new control structure */
 	struct X2SYS_CROSS_CTRL *C;
 
@@ -103,7 +154,7 @@ void Free_x2sys_cross_Ctrl (struct GMT_CTRL *GMT, struct X2SYS_CROSS_CTRL *C) {
 int GMT_x2sys_cross_usage (struct GMTAPI_CTRL *API, int level) {
 	GMT_show_name_and_purpose (API, THIS_MODULE_LIB, THIS_MODULE_NAME, THIS_MODULE_PURPOSE);
 	if (level == GMT_MODULE_PURPOSE) return (GMT_NOERROR);
-	GMT_Message (API, GMT_TIME_NONE, "usage: x2sys_cross <files> -T<TAG> [-A<combi.lis>] [-C[<fname>]] [-Il|a|c] [%s] [-Qe|i]\n", GMT_J_OPT);
+	GMT_Message (API, GMT_TIME_NONE, "usage: x2sys_cross <files> -T<TAG> [-A<combi.lis>] [-C[<fname>]] [-Il|a|c] [%s] [-M] [-Qe|i]\n", GMT_J_OPT);
 	GMT_Message (API, GMT_TIME_NONE, "\t[%s] [-Sl|h|u<speed>] [%s] [-W<size>] [-Z]\n", GMT_Rgeo_OPT, GMT_V_OPT);
 	GMT_Message (API, GMT_TIME_NONE, "\t[%s]\n\n", GMT_bo_OPT);
 
@@ -122,6 +173,9 @@ int GMT_x2sys_cross_usage (struct GMTAPI_CTRL *API, int level) {
 	GMT_Message (API, GMT_TIME_NONE, "\t   a Akima spline interpolation.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   c Acubic spline interpolation.\n");
 	GMT_Option (API, "J-");
+	GMT_Message (API, GMT_TIME_NONE, "\t-M Load all tracks into memory, use the bin index to skip track pairs that cannot\n");
+	GMT_Message (API, GMT_TIME_NONE, "\t   cross, and process the remaining pairs in parallel (if built with OpenMP).\n");
+	GMT_Message (API, GMT_TIME_NONE, "\t   Much faster for many tracks but requires memory for all of them.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t-Q Append e for external crossovers.\n");
 	GMT_Message (API, GMT_TIME_NONE, "\t   Append i for internal crossovers [Default is all crossovers].\n");
 	GMT_Option (API, "R");
@@ -191,6 +245,9 @@ int GMT_x2sys_cross_parse (struct GMT_CTRL *GMT, struct X2SYS_CROSS_CTRL *Ctrl,
 						break;
 				}
 				break;
+			case 'M':	/* Keep all tracks in memory and use an index */
+				Ctrl->M.active = true;
+				break;
 			case 'S':	/* Speed checks */
 				switch (opt->arg[0]) {
 					case 'L':
@@ -259,6 +316,397 @@ int combo_ok (char *name_1, char *name_2, struct PAIR *pair, uint64_t n_pairs)
 	return (false);
 }
 
+int x2sys_cross_load (struct GMT_CTRL *GMT, struct X2SYS_INFO *s, char *name, struct X2SYS_CROSS_TRACK *T, bool got_time, bool do_project, double dist_scale)
+{	/* Read one track and prepare everything needed to look for crossovers.  T->n_rec is 0 for empty tracks */
+	int error;
+	uint64_t i, n_bad;
+	double xx, yy;
+
+	GMT_memset (T, 1, struct X2SYS_CROSS_TRACK);
+	if ((error = (s->read_file) (GMT, name, &T->data, s, &T->info, &GMT->current.io, &T->n_rec))) return (error);
+
+	if (T->n_rec == 0) {	/* No data in this track */
+		x2sys_free_data (GMT, T->data, s->n_out_columns, &T->info);
+		T->data = NULL;
+		return (X2SYS_NOERROR);
+	}
+
+	if (got_time) {	/* Check to make sure we do in fact have time */
+		for (i = n_bad = 0; i < T->n_rec; i++) n_bad += GMT_is_dnan (T->data[s->t_col][i]);
+		if (n_bad < T->n_rec) T->has_time = true;
+	}
+
+	if (do_project) {	/* Convert all the coordinates */
+		for (i = 0; i < T->n_rec; i++) {
+			GMT_geo_to_xy (GMT, T->data[s->x_col][i], T->data[s->y_col][i], &xx, &yy);
+			T->data[s->x_col][i] = xx;
+			T->data[s->y_col][i] = yy;
+		}
+	}
+
+	if ((T->dist = GMT_dist_array_2 (GMT, T->data[s->x_col], T->data[s->y_col], T->n_rec, dist_scale, s->dist_flag)) == NULL) GMT_err_fail (GMT, GMT_MAP_BAD_DIST_FLAG, "");
+
+	T->time = (T->has_time) ? T->data[s->t_col] : x2sys_dummytimes (GMT, T->n_rec);
+
+	GMT_init_track (GMT, T->data[s->y_col], T->n_rec, &T->ylist);
+
+	return (X2SYS_NOERROR);
+}
+
+void x2sys_cross_free_track (struct GMT_CTRL *GMT, struct X2SYS_INFO *s, struct X2SYS_CROSS_TRACK *T)
+{	/* Free everything allocated by x2sys_cross_load */
+	if (T->bin) GMT_free (GMT, T->bin);
+	if (T->data == NULL) return;	/* Empty track */
+	x2sys_free_data (GMT, T->data, s->n_out_columns, &T->info);
+	GMT_free (GMT, T->dist);
+	if (!T->has_time) GMT_free (GMT, T->time);
+	GMT_free (GMT, T->ylist);
+	T->data = NULL;
+}
+
+bool x2sys_cross_record (struct GMT_CTRL *GMT, struct X2SYS_CROSS_WORK *W, struct X2SYS_CROSS_TRACK *T[], struct GMT_XOVER *XC, uint64_t i, double *out)
+{	/* Evaluate the data fields at crossover i between the tracks T[0] and T[1] and fill in the output record.
+	 * Returns false if no data field could be estimated on both tracks. */
+	uint64_t j, k, col, start, end, first, n_ok, n_left, n_right, t_left, t_right, n_errors;
+	uint64_t left[2], right[2];
+	int64_t start_s;
+	double dt, deld, delt, speed[2], dist_x[2], time_x[2], *t = W->t, *y = W->y, **data[2], *dist[2], *time[2];
+	struct X2SYS_CROSS_CTRL *Ctrl = W->Ctrl;
+	struct X2SYS_INFO *s = W->s;
+
+	for (k = 0; k < 2; k++) {	/* Short-hand for the two tracks */
+		data[k] = T[k]->data;
+		dist[k] = T[k]->dist;
+		time[k] = T[k]->time;
+	}
+
+	GMT_memset (W->ok, W->n_data_col, unsigned int);
+	n_ok = 0;
+
+	for (k = 0; k < 2; k++) {	/* For each of the two data sets involved */
+
+		/* Get node number to each side of crossover location */
+
+/*	--o----------o--------o------X-------o-------o----------o-- ----> time
+			      ^      ^       ^
+			    left   xover   right			*/
+
+		left[k]  = lrint (floor (XC->xnode[k][i]));
+		right[k] = lrint (ceil  (XC->xnode[k][i]));
+
+		if (left[k] == right[k]) {	/* Crosses exactly on a node; move left or right so interpolation will work */
+			if (left[k] > 0)
+				left[k]--;	/* Move back so cross occurs at right[k] */
+			else
+				right[k]++;	/* Move forward so cross occurs at left[k] */
+		}
+
+		deld = dist[k][right[k]] - dist[k][left[k]];
+		delt = time[k][right[k]] - time[k][left[k]];
+
+		/* Check if speed is outside accepted domain */
+
+		speed[k] = (delt == 0.0) ? GMT->session.d_NaN : W->vel_scale * (deld / (delt * W->t_scale));
+		if (Ctrl->S.active[VLO] && !GMT_is_dnan (speed[k]) && (speed[k] < Ctrl->S.limit[VLO] || speed[k] > Ctrl->S.limit[VHI])) continue;
+
+		/* Linearly estimate the crossover times and distances */
+
+		dt = XC->xnode[k][i] - left[k];
+		time_x[k] = time[k][left[k]];
+		dist_x[k] = dist[k][left[k]];
+		if (dt > 0.0) {
+			time_x[k] += dt * delt;
+			dist_x[k] += dt * deld;
+		}
+
+		for (j = 0; j < W->n_data_col; j++) {	/* Evaluate each field at the crossover */
+
+			col = W->col_number[j];
+
+			start = t_right = left[k];
+			end = t_left = right[k];
+			n_left = n_right = 0;
+
+			W->xdata[k][col] = GMT->session.d_NaN;	/* In case of nuthin' */
+
+			/* First find the required <window> points to the left of the xover */
+			start_s = start;
+			while (start_s >= 0 && n_left < Ctrl->W.width) {
+				if (!GMT_is_dnan (data[k][col][start])) {
+					n_left++;
+					if (t_left > left[k]) t_left = start;
+					y[Ctrl->W.width-n_left] = data[k][col][start];
+					t[Ctrl->W.width-n_left] = time[k][start];
+				}
+				start--;
+				start_s--;
+			}
+
+			if (!n_left) continue;
+			if (W->got_time && ((time_x[k] - time[k][t_left]) > W->time_gap)) continue;
+			if ((dist_x[k] - dist[k][t_left]) > W->dist_gap) continue;
+
+			/* Ok, that worked.  Now for the right side: */
+
+			while (end < T[k]->n_rec && n_right < Ctrl->W.width) {
+				if (!GMT_is_dnan (data[k][col][end])) {
+					y[Ctrl->W.width+n_right] = data[k][col][end];
+					t[Ctrl->W.width+n_right] = time[k][end];
+					n_right++;
+					if (t_right < right[k]) t_right = end;
+				}
+				end++;
+			}
+
+			if (!n_right) continue;
+			/* See if we pass any gap criteria */
+			if (W->got_time && ((time[k][t_right] - time_x[k]) > W->time_gap)) continue;	/* Exceeded time gap */
+			if ((dist[k][t_right] - dist_x[k]) > W->dist_gap) continue;			/* Exceeded distance gap */
+
+			/* Ok, got enough data to interpolate at xover */
+
+			first = Ctrl->W.width - n_left;
+			n_errors = GMT_intpol (GMT, &t[first], &y[first], (n_left + n_right), 1, &time_x[k], &W->xdata[k][col], GMT->current.setting.interpolant);
+			if (n_errors == 0) {	/* OK */
+				W->ok[j]++;
+				n_ok++;
+			}
+		}
+	}
+
+	/* Only output crossover if there are any data there */
+
+	if (n_ok == 0) return (false);
+	for (j = n_ok = 0; j < W->n_data_col; j++) if (W->ok[j] == 2) n_ok++;
+	if (n_ok == 0) return (false);
+
+	/* OK, got something to report */
+
+	/* Load the out array */
+
+	out[0] = XC->x[i];	/* Crossover location */
+	out[1] = XC->y[i];
+
+	for (k = 0; k < 2; k++) {	/* Get times, distances, headings, and velocities */
+
+		/* Get time */
+
+		out[2+k] = (W->got_time && !T[k]->has_time) ? GMT->session.d_NaN : time_x[k];
+
+		/* Get cumulative distance at crossover */
+
+		out[k+4] = dist_x[k];
+
+		/* Estimate heading there */
+
+		j = k + 6;
+		out[j] = (!GMT_is_dnan (speed[k]) && (!Ctrl->S.active[HHI] || speed[k] > Ctrl->S.limit[HHI])) ? (*GMT->current.map.azimuth_func) (GMT, data[k][s->x_col][right[k]], data[k][s->y_col][right[k]], data[k][s->x_col][left[k]], data[k][s->y_col][left[k]], false) : GMT->session.d_NaN;
+
+		/* Estimate velocities there */
+
+		j = k + 8;
+		out[j] = (T[k]->has_time) ? speed[k] : GMT->session.d_NaN;
+	}
+
+	/* Calculate crossover and mean value */
+
+	for (k = 0, j = 10; k < W->n_data_col; k++) {
+		col = W->col_number[k];
+		if (Ctrl->Z.active) {
+			out[j++] = W->xdata[0][col];
+			out[j++] = W->xdata[1][col];
+		}
+		else {
+			if (W->ok[k] == 2) {
+				out[j++] = W->xdata[0][col] - W->xdata[1][col];
+				out[j++] = 0.5 * (W->xdata[0][col] + W->xdata[1][col]);
+			}
+			else {
+				out[j] = out[j+1] = GMT->session.d_NaN;
+				j += 2;
+			}
+		}
+	}
+	if (s->geographic) GMT_lon_range_adjust (s->geodetic, &out[0]);
+	return (true);
+}
+
+void x2sys_cross_table_header (struct GMT_CTRL *GMT, struct X2SYS_CROSS_WORK *W, struct GMT_OPTION *options)
+{	/* Write the header records that precede the very first crossover */
+	uint64_t j, col;
+	char line[GMT_BUFSIZ] = {""}, item[GMT_BUFSIZ] = {""}, *cmd = NULL, *c = GMT->current.setting.io_col_separator;
+	char t_or_i = (W->got_time) ? 't' : 'i';	/* t = time, i = dummy node time */
+	struct X2SYS_INFO *s = W->s;
+
+	sprintf (line, "# Tag: %s", W->Ctrl->T.TAG);
+	GMT_Put_Record (GMT->parent, GMT_WRITE_TABLE_HEADER, line);
+	cmd = GMT_Create_Cmd (GMT->parent, options);
+	sprintf (line, "# Command: %s %s", THIS_MODULE_NAME, cmd);	/* Build command line argument string */
+	GMT_free (GMT, cmd);
+	GMT_Put_Record (GMT->parent, GMT_WRITE_TABLE_HEADER, line);
+	sprintf (line, "# %s%s%s%s%c_1%s%c_2%sdist_1%sdist_2%shead_1%shead_2%svel_1%svel_2",
+		s->info[s->out_order[s->x_col]].name, c, s->info[s->out_order[s->y_col]].name, c, t_or_i, c, t_or_i, c, c, c, c, c, c);
+	for (j = 0; j < W->n_data_col; j++) {
+		col = W->col_number[j];
+		if (W->Ctrl->Z.active)
+			sprintf (item, "%s%s_1%s%s_2", c, s->info[s->out_order[col]].name, c, s->info[s->out_order[col]].name);
+		else
+			sprintf (item, "%s%s_X%s%s_M", c, s->info[s->out_order[col]].name, c, s->info[s->out_order[col]].name);
+		strcat (line, item);
+	}
+	GMT_Put_Record (GMT->parent, GMT_WRITE_TABLE_HEADER, line);
+}
+
+void x2sys_cross_segment_header (struct GMT_CTRL *GMT, char *name_1, char *name_2, struct X2SYS_CROSS_TRACK *T[])
+{	/* Write the segment header that precedes the crossovers between two tracks */
+	uint64_t j, k;
+	char line[GMT_BUFSIZ] = {""}, info[GMT_BUFSIZ] = {""}, start[2][GMT_LEN64], stop[2][GMT_LEN64];
+	char *x2sys_header = "%s %d %s %d %s";
+
+	for (k = 0; k < 2; k++) {
+		if (T[k]->has_time) {	/* Find first and last record times */
+			for (j = 0; j < T[k]->n_rec && GMT_is_dnan (T[k]->time[j]); j++);	/* Find first non-NaN time */
+			GMT_ascii_format_col (GMT, start[k], T[k]->time[j], GMT_OUT, 2);
+			for (j = T[k]->n_rec-1; j > 0 && GMT_is_dnan (T[k]->time[j]); j--);	/* Find last non-NaN time */
+			GMT_ascii_format_col (GMT, stop[k], T[k]->time[j], GMT_OUT, 3);
+		}
+		else {
+			strcpy (start[k], "NaN");
+			strcpy (stop[k], "NaN");
+		}
+	}
+	sprintf (info, "%s/%s/%g %s/%s/%g", start[0], stop[0], T[0]->dist[T[0]->n_rec-1], start[1], stop[1], T[1]->dist[T[1]->n_rec-1]);
+	sprintf (line, x2sys_header, name_1, T[0]->info.year, name_2, T[1]->info.year, info);
+	GMT_Put_Record (GMT->parent, GMT_WRITE_SEGMENT_HEADER, line);
+}
+
+int64_t x2sys_cross_bin_col (struct X2SYS_CROSS_INDEX *I, double v, unsigned int dim)
+{	/* Return the bin column (dim = GMT_X) or row (dim = GMT_Y) for coordinate v.  Bins are clamped to the
+	 * index region unless x is periodic, in which case the caller wraps them */
+	unsigned int n = (dim == GMT_X) ? I->nx : I->ny;
+	double f = floor ((v - I->wesn[2*dim]) * I->i_inc[dim]);
+	if (dim == GMT_X && I->periodic) return ((int64_t)f);
+	if (f < 0.0) return (0);
+	if (f >= n) return (n - 1);
+	return ((int64_t)f);
+}
+
+int x2sys_cross_uint64_comp (const void *p_1, const void *p_2)
+{
+	const uint64_t *a = p_1, *b = p_2;
+	if (*a < *b) return (-1);
+	if (*a > *b) return (+1);
+	return (0);
+}
+
+int x2sys_cross_bintrack_comp (const void *p_1, const void *p_2)
+{	/* Sort on bin, then on track */
+	const struct X2SYS_CROSS_BINTRACK *a = p_1, *b = p_2;
+	if (a->bin < b->bin) return (-1);
+	if (a->bin > b->bin) return (+1);
+	if (a->track < b->track) return (-1);
+	if (a->track > b->track) return (+1);
+	return (0);
+}
+
+void x2sys_cross_bin_track (struct GMT_CTRL *GMT, struct X2SYS_INFO *s, struct X2SYS_CROSS_INDEX *I, struct X2SYS_CROSS_TRACK *T)
+{	/* Build the sorted list of index bins visited by this track.  Each line segment claims every bin that
+	 * overlaps its bounding box, so two segments that cross always share at least one bin.  Segments that
+	 * jump between multiple segments are ignored since GMT_crossover skips them as well. */
+	uint64_t row, k, n = 0, n_alloc = GMT_CHUNK, *ms = T->info.ms_rec;
+	int64_t col, c0, c1, r, r0, r1;
+	double *x = T->data[s->x_col], *y = T->data[s->y_col], x0, x1, y0, y1, eps_x, eps_y;
+
+	eps_x = 1.0e-6 / I->i_inc[GMT_X];	eps_y = 1.0e-6 / I->i_inc[GMT_Y];	/* Guard against round-off at bin edges */
+	T->bin = GMT_memory (GMT, NULL, n_alloc, uint64_t);
+	for (row = 1; row < T->n_rec; row++) {
+		if (ms && ms[row] != ms[row-1]) continue;	/* Jump between multiple segments */
+		if (GMT_is_dnan (x[row]) || GMT_is_dnan (y[row]) || GMT_is_dnan (x[row-1]) || GMT_is_dnan (y[row-1])) continue;
+		x0 = x[row-1];	x1 = x[row];
+		if (x1 < x0) double_swap (x0, x1);
+		if (I->periodic && (x1 - x0) > 180.0) {	/* Goes the other way across the 360 jump, as in GMT_crossover */
+			x0 += 360.0;
+			double_swap (x0, x1);
+		}
+		y0 = MIN (y[row-1], y[row]);	y1 = MAX (y[row-1], y[row]);
+		c0 = x2sys_cross_bin_col (I, x0 - eps_x, GMT_X);	c1 = x2sys_cross_bin_col (I, x1 + eps_x, GMT_X);
+		r0 = x2sys_cross_bin_col (I, y0 - eps_y, GMT_Y);	r1 = x2sys_cross_bin_col (I, y1 + eps_y, GMT_Y);
+		if (I->periodic && (c1 - c0 + 1) >= (int64_t)I->nx) c0 = 0, c1 = I->nx - 1;	/* Spans all columns */
+		for (r = r0; r <= r1; r++) {
+			for (col = c0; col <= c1; col++) {
+				if (n == n_alloc) {
+					n_alloc <<= 1;
+					T->bin = GMT_memory (GMT, T->bin, n_alloc, uint64_t);
+				}
+				k = (I->periodic) ? ((col % I->nx) + I->nx) % I->nx : col;
+				T->bin[n++] = (uint64_t)r * I->nx + k;
+			}
+		}
+	}
+	/* Sort and remove duplicates */
+	if (n > 1) qsort (T->bin, n, sizeof (uint64_t), x2sys_cross_uint64_comp);
+	for (row = k = 0; row < n; row++) if (row == 0 || T->bin[row] != T->bin[k-1]) T->bin[k++] = T->bin[row];
+	T->n_bins = k;
+	if (k) T->bin = GMT_memory (GMT, T->bin, k, uint64_t);
+	else GMT_free (GMT, T->bin);
+}
+
+double x2sys_cross_wall_time (void)
+{	/* Elapsed wall-clock time in seconds, used for the -C run times */
+#ifdef _OPENMP
+	return (omp_get_wtime ());
+#elif defined HAVE_SYS_TIME_H_
+	struct timeval tv;
+	gettimeofday (&tv, NULL);
+	return ((double)tv.tv_sec + 1.0e-6 * tv.tv_usec);
+#else	/* Only whole seconds, but clock () would give CPU time summed over all threads */
+	return ((double)time (NULL));
+#endif
+}
+
+void x2sys_cross_pair (struct GMT_CTRL *GMT, struct X2SYS_CROSS_WORK *W, struct X2SYS_CROSS_TRACK *TA, struct X2SYS_CROSS_TRACK *TB, bool wrap, bool locations_only, unsigned int n_output, struct X2SYS_CROSS_RESULT *R)
+{	/* Find and evaluate all crossovers between two tracks held in memory [-M].  GMT_crossover may shift
+	 * longitudes by 360 so it works on private copies of the x-coordinates; the tracks are shared among threads. */
+	uint64_t i, k, n_tracks = (TA == TB) ? 1 : 2;
+	struct X2SYS_CROSS_TRACK copy[2], *T[2];
+	struct X2SYS_INFO *s = W->s;
+	struct GMT_XOVER XC;
+	double tic = x2sys_cross_wall_time ();
+
+	copy[0] = *TA;	copy[1] = *TB;
+	for (k = 0; k < n_tracks; k++) {
+		copy[k].data = GMT_memory (GMT, NULL, s->n_out_columns, double *);
+		GMT_memcpy (copy[k].data, (k == 0) ? TA->data : TB->data, s->n_out_columns, double *);
+		copy[k].data[s->x_col] = GMT_memory (GMT, NULL, copy[k].n_rec, double);
+		GMT_memcpy (copy[k].data[s->x_col], (k == 0) ? TA->data[s->x_col] : TB->data[s->x_col], copy[k].n_rec, double);
+	}
+	T[0] = &copy[0];
+	T[1] = (n_tracks == 1) ? &copy[0] : &copy[1];
+
+	R->nx = GMT_crossover (GMT, T[0]->data[s->x_col], T[0]->data[s->y_col], T[0]->info.ms_rec, T[0]->ylist, T[0]->n_rec, T[1]->data[s->x_col], T[1]->data[s->y_col], T[1]->info.ms_rec, T[1]->ylist, T[1]->n_rec, (TA == TB), wrap, &XC);
+	R->n_out = 0;
+	if (R->nx) {
+		R->out = GMT_memory (GMT, NULL, R->nx * n_output, double);
+		for (i = 0; i < R->nx; i++) {
+			double *out = &R->out[R->n_out*n_output];
+			if (locations_only) {	/* Report crossover locations only */
+				out[0] = XC.x[i];
+				out[1] = XC.y[i];
+				if (s->geographic) GMT_lon_range_adjust (s->geodetic, &out[0]);
+				R->n_out++;
+			}
+			else if (x2sys_cross_record (GMT, W, T, &XC, i, out))
+				R->n_out++;
+		}
+		GMT_x_free (GMT, &XC);
+	}
+	for (k = 0; k < n_tracks; k++) {
+		GMT_free (GMT, copy[k].data[s->x_col]);
+		GMT_free (GMT, copy[k].data);
+	}
+	R->run_time = x2sys_cross_wall_time () - tic;
+}
+
 #define bailout(code) {GMT_Free_Options (mode); return (code);}
 #define Return(code) {Free_x2sys_cross_Ctrl (GMT, Ctrl); GMT_end_module (GMT, GMT_cpy); bailout (code);}
 
@@ -266,23 +714,17 @@ int GMT_x2sys_cross (void *V_API, int mode, void *args)
 {
 	char **trk_name = NULL;			/* Name of tracks */
 	char line[GMT_BUFSIZ] = {""};		/* buffer */
-	char item[GMT_BUFSIZ] = {""};		/* buffer */
-	char t_or_i;				/* t = time, i = dummy node time */
 	char name1[80] = {""}, name2[80] = {""};		/* Name of two files to be examined */
-	char *x2sys_header = "%s %d %s %d %s";
 
-	uint64_t n_rec[2];			/* Number of data records for both files */
 	uint64_t window_width;			/* Max number of points to use in the interpolation */
 	uint64_t n_tracks = 0;			/* Total number of data sets to compare */
 	uint64_t nx;				/* Number of crossovers found for this pair */
 	uint64_t *col_number = NULL;		/* Array with the column numbers of the data fields */
 	unsigned int n_output;			/* Number of columns on output */
 	uint64_t n_pairs = 0;			/* Number of acceptable combinations */
-	uint64_t A, B, i, j, col, k, start, n_bad;	/* Misc. counters and local variables */
-	uint64_t end, first, n_ok;
-	uint64_t n_data_col, left[2], t_left;
-	uint64_t n_left, right[2], t_right, n_right;
-	uint64_t n_duplicates, n_errors;
+	uint64_t A, B, i, col, k;		/* Misc. counters and local variables */
+	uint64_t n_data_col;
+	uint64_t n_duplicates;
 	uint64_t add_chunk;
 	int scol;
 	int error = 0;				/* nonzero for invalid arguments */
@@ -296,36 +738,26 @@ int GMT_x2sys_cross (void *V_API, int mode, void *args)
 	bool first_header = true;		/* true for very first crossover */
 	bool first_crossover;		/* true for first crossover between two data sets */
 	bool same = false;			/* true when the two cruises we compare have the same name */
-	bool has_time[2];			/* true for each cruises that actually has a time column */
 	bool *duplicate = NULL;		/* Array, true for any cruise that is already listed */
 	bool cmdline_files = false;		/* true if files where given directly on the command line */
 	bool wrap = false;			/* true if data wraps so -Rg was given */
 	
 	size_t n_alloc = 1;
 
-	double dt;				/* Time between crossover and previous node */
-	double dist_x[2];			/* Distance(s) along track at the crossover point */
-	double time_x[2];			/* Time(s) along track at the crossover point */
-	double deld, delt;			/* Differences in dist and time across xpoint */
-	double speed[2];			/* speed across the xpoint ( = deld/delt) */
-	double **data[2] = {NULL, NULL};	/* Data matrices for the two data sets to be checked */
 	double *xdata[2] = {NULL, NULL};	/* Data vectors with estimated values at crossover points */
-	double *dist[2] = {NULL, NULL};		/* Data vectors with along-track distances */
-	double *time[2] = {NULL, NULL};		/* Data vectors with along-track times (or dummy node indices) */
 	double *t = NULL, *y = NULL;		/* Interpolation y(t) arrays */
 	double *out = NULL;			/* Output record array */
-	double X2SYS_NaN;			/* Value to write out when result is NaN */
 	double xx, yy;				/* Temporary projection variables */
 	double dist_scale;			/* Scale to give selected distance units */
 	double vel_scale;			/* Scale to give selected velocity units */
 	double t_scale;				/* Scale to give time in seconds */
 
-	clock_t tic = 0, toc = 0;
+	double tic = 0.0, toc = 0.0;
 
 	struct X2SYS_INFO *s = NULL;			/* Data format information  */
-	struct GMT_XSEGMENT *ylist_A = NULL, *ylist_B = NULL;		/* y-indices sorted in increasing order */
 	struct GMT_XOVER XC;				/* Structure with resulting crossovers */
-	struct X2SYS_FILE_INFO data_set[2];		/* File information */
+	struct X2SYS_CROSS_TRACK TA, TB, *T[2];		/* The two tracks being compared */
+	struct X2SYS_CROSS_WORK W;			/* Settings and scratch space for evaluating crossovers */
 	struct X2SYS_BIX Bix;
 	struct PAIR *pair = NULL;		/* Used with -Akombinations.lis option */
 	FILE *fp = NULL, *fpC = NULL;
@@ -442,8 +874,6 @@ int GMT_x2sys_cross (void *V_API, int mode, void *args)
 		}
 	}
 
-	X2SYS_NaN = GMT->session.d_NaN;
-
 	if (GMT->current.setting.interpolant == 0) Ctrl->W.width = 1;
 	window_width = 2 * Ctrl->W.width;
 	n_data_col = x2sys_n_data_cols (GMT, s);
@@ -528,339 +958,285 @@ int GMT_x2sys_cross (void *V_API, int mode, void *args)
 		Return (API->error);
 	}
 
-	for (A = 0; A < n_tracks; A++) {	/* Loop over all files */
-		if (duplicate[A]) continue;
-
-		if (s->x_col < 0 || s->x_col < 0) {
-			GMT_Report (API, GMT_MSG_NORMAL, "Error: x and/or y column not found for track %s!\n", trk_name[A]);
-			Return (EXIT_FAILURE);
-		}
-
-		x2sys_err_fail (GMT, (s->read_file) (GMT, trk_name[A], &data[0], s, &data_set[0], &GMT->current.io, &n_rec[0]), trk_name[A]);
-
-		if (n_rec[0] == 0) {	/* No data in track A */
-			x2sys_free_data (GMT, data[0], s->n_out_columns, &data_set[0]);
-			continue;
-		}
-		
-		has_time[0] = false;
-		if (got_time) {	/* Check to make sure we do in fact have time */
-			for (i = n_bad = 0; i < n_rec[0]; i++) n_bad += GMT_is_dnan (data[0][s->t_col][i]);
-			if (n_bad < n_rec[0]) has_time[0] = true;
-		}
-
-		if (do_project) {	/* Convert all the coordinates */
-			for (i = 0; i < n_rec[0]; i++) {
-				GMT_geo_to_xy (GMT, data[0][s->x_col][i], data[0][s->y_col][i], &xx, &yy);
-				data[0][s->x_col][i] = xx;
-				data[0][s->y_col][i] = yy;
-			}
-		}
-
-		if ((dist[0] = GMT_dist_array_2 (GMT, data[0][s->x_col], data[0][s->y_col], n_rec[0], dist_scale, s->dist_flag)) == NULL) GMT_err_fail (GMT, GMT_MAP_BAD_DIST_FLAG, "");
-
-		time[0] = (has_time[0]) ? data[0][s->t_col] : x2sys_dummytimes (GMT, n_rec[0]) ;
-
-		GMT_init_track (GMT, data[0][s->y_col], n_rec[0], &ylist_A);
-
-		for (B = A; B < n_tracks; B++) {
-			if (duplicate[B]) continue;
-
-			same = !strcmp (trk_name[A], trk_name[B]);
-			if (same && !(A == B)) {
-				GMT_Report (API, GMT_MSG_NORMAL, "File %s repeated on command line - skipped\n", trk_name[A]);
-				continue;
+	/* Settings and scratch space for evaluating crossovers */
+	W.Ctrl = Ctrl;
+	W.s = s;
+	W.got_time = got_time;
+	W.n_data_col = n_data_col;
+	W.col_number = col_number;
+	W.vel_scale = vel_scale;
+	W.t_scale = t_scale;
+	W.time_gap = Bix.time_gap;
+	W.dist_gap = Bix.dist_gap;
+	W.t = t;	W.y = y;
+	W.xdata[0] = xdata[0];	W.xdata[1] = xdata[1];
+	W.ok = ok;
+
+	if (!Ctrl->M.active) {	/* Read one track at the time and compare it to all the others */
+		for (A = 0; A < n_tracks; A++) {	/* Loop over all files */
+			if (duplicate[A]) continue;
+
+			if (s->x_col < 0 || s->x_col < 0) {
+				GMT_Report (API, GMT_MSG_NORMAL, "Error: x and/or y column not found for track %s!\n", trk_name[A]);
+				Return (EXIT_FAILURE);
 			}
-			if (!internal &&  same) continue;	/* Only do external errors */
-			if (!external && !same) continue;	/* Only do internal errors */
 
-			if (Ctrl->A.active && !combo_ok (trk_name[A], trk_name[B], pair, n_pairs)) continue;	/* Do not want this combo */
-			
-			if (Ctrl->C.active) tic = clock();	/* To report execution time from this pair */
-
-			GMT_Report (API, GMT_MSG_VERBOSE, "Processing %s - %s : ", trk_name[A], trk_name[B]);
-
-			if (same) {	/* Just set pointers */
-				data[1] = data[0];
-				dist[1] = dist[0];
-				time[1] = time[0];
-				has_time[1] = has_time[0];
-				n_rec[1] = n_rec[0];
-				ylist_B = ylist_A;
-				data_set[1] = data_set[0];
-			}
-			else {	/* Must read a second file */
+			x2sys_err_fail (GMT, x2sys_cross_load (GMT, s, trk_name[A], &TA, got_time, do_project, dist_scale), trk_name[A]);
+			if (TA.n_rec == 0) continue;	/* No data in track A */
+			T[0] = &TA;
 
-				x2sys_err_fail (GMT, (s->read_file) (GMT, trk_name[B], &data[1], s, &data_set[1], &GMT->current.io, &n_rec[1]), trk_name[B]);
+			for (B = A; B < n_tracks; B++) {
+				if (duplicate[B]) continue;
 
-				if (n_rec[1] == 0) {	/* No data in track B */
-					x2sys_free_data (GMT, data[1], s->n_out_columns, &data_set[1]);
+				same = !strcmp (trk_name[A], trk_name[B]);
+				if (same && !(A == B)) {
+					GMT_Report (API, GMT_MSG_NORMAL, "File %s repeated on command line - skipped\n", trk_name[A]);
 					continue;
 				}
-				has_time[1] = false;
-				if (got_time) {	/* Check to make sure we do in fact have time */
-					for (i = n_bad = 0; i < n_rec[1]; i++) n_bad += GMT_is_dnan (data[1][s->t_col][i]);
-					if (n_bad < n_rec[1]) has_time[1] = true;
-				}
-				
-				if (do_project) {	/* Convert all the coordinates */
-					for (i = 0; i < n_rec[0]; i++) {
-						GMT_geo_to_xy (GMT, data[1][s->x_col][i], data[1][s->y_col][i], &xx, &yy);
-						data[1][s->x_col][i] = xx;
-						data[1][s->y_col][i] = yy;
-					}
-				}
-
-				if ((dist[1] = GMT_dist_array_2 (GMT, data[1][s->x_col], data[1][s->y_col], n_rec[1], dist_scale, s->dist_flag)) == NULL) GMT_err_fail (GMT, GMT_MAP_BAD_DIST_FLAG, "");
+				if (!internal &&  same) continue;	/* Only do external errors */
+				if (!external && !same) continue;	/* Only do internal errors */
 
-				time[1] = (has_time[1]) ? data[1][s->t_col] : x2sys_dummytimes (GMT, n_rec[1]);
-
-				GMT_init_track (GMT, data[1][s->y_col], n_rec[1], &ylist_B);
-			}
+				if (Ctrl->A.active && !combo_ok (trk_name[A], trk_name[B], pair, n_pairs)) continue;	/* Do not want this combo */
 
-			/* Calculate all possible crossover locations */
+				if (Ctrl->C.active) tic = x2sys_cross_wall_time ();	/* To report execution time from this pair */
 
-			nx = GMT_crossover (GMT, data[0][s->x_col], data[0][s->y_col], data_set[0].ms_rec, ylist_A, n_rec[0], data[1][s->x_col], data[1][s->y_col], data_set[1].ms_rec, ylist_B, n_rec[1], (A == B), wrap, &XC);
+				GMT_Report (API, GMT_MSG_VERBOSE, "Processing %s - %s : ", trk_name[A], trk_name[B]);
 
-			if (nx && xover_locations_only) {	/* Report crossover locations only */
-				sprintf (line, "%s - %s", trk_name[A], trk_name[B]);
-				GMT_Put_Record (API, GMT_WRITE_SEGMENT_HEADER, line);
-				for (i = 0; i < nx; i++) {
-					out[0] = XC.x[i];
-					out[1] = XC.y[i];
-					if (s->geographic) GMT_lon_range_adjust (s->geodetic, &out[0]);
-					GMT_Put_Record (API, GMT_WRITE_DOUBLE, out);	/* Write this to output */
+				if (same)	/* Just set pointers */
+					T[1] = &TA;
+				else {	/* Must read a second file */
+					x2sys_err_fail (GMT, x2sys_cross_load (GMT, s, trk_name[B], &TB, got_time, do_project, dist_scale), trk_name[B]);
+					if (TB.n_rec == 0) continue;	/* No data in track B */
+					T[1] = &TB;
 				}
-				GMT_x_free (GMT, &XC);
-			}
-			else if (nx) {	/* Got crossovers, now estimate crossover values */
-				int64_t start_s;
-				first_crossover = true;
-
-				for (i = 0; i < nx; i++) {	/* For each potential crossover */
-
-					GMT_memset (ok, n_data_col, unsigned int);
-					n_ok = 0;
 
-					for (k = 0; k < 2; k++) {	/* For each of the two data sets involved */
+				/* Calculate all possible crossover locations */
 
-						/* Get node number to each side of crossover location */
+				nx = GMT_crossover (GMT, T[0]->data[s->x_col], T[0]->data[s->y_col], T[0]->info.ms_rec, T[0]->ylist, T[0]->n_rec, T[1]->data[s->x_col], T[1]->data[s->y_col], T[1]->info.ms_rec, T[1]->ylist, T[1]->n_rec, (A == B), wrap, &XC);
 
-				/*	--o----------o--------o------X-------o-------o----------o-- ----> time
-							      ^      ^       ^
-							    left   xover   right			*/
-
-						left[k]  = lrint (floor (XC.xnode[k][i]));
-						right[k] = lrint (ceil  (XC.xnode[k][i]));
-						
-						if (left[k] == right[k]) {	/* Crosses exactly on a node; move left or right so interpolation will work */
-							if (left[k] > 0)
-								left[k]--;	/* Move back so cross occurs at right[k] */
-							else
-								right[k]++;	/* Move forward so cross occurs at left[k] */
-						}
-
-						deld = dist[k][right[k]] - dist[k][left[k]];
-						delt = time[k][right[k]] - time[k][left[k]];
-
-						/* Check if speed is outside accepted domain */
-
-						speed[k] = (delt == 0.0) ? GMT->session.d_NaN : vel_scale * (deld / (delt * t_scale));
-						if (Ctrl->S.active[VLO] && !GMT_is_dnan (speed[k]) && (speed[k] < Ctrl->S.limit[VLO] || speed[k] > Ctrl->S.limit[VHI])) continue;
+				if (nx && xover_locations_only) {	/* Report crossover locations only */
+					sprintf (line, "%s - %s", trk_name[A], trk_name[B]);
+					GMT_Put_Record (API, GMT_WRITE_SEGMENT_HEADER, line);
+					for (i = 0; i < nx; i++) {
+						out[0] = XC.x[i];
+						out[1] = XC.y[i];
+						if (s->geographic) GMT_lon_range_adjust (s->geodetic, &out[0]);
+						GMT_Put_Record (API, GMT_WRITE_DOUBLE, out);	/* Write this to output */
+					}
+					GMT_x_free (GMT, &XC);
+				}
+				else if (nx) {	/* Got crossovers, now estimate crossover values */
+					first_crossover = true;
 
-						/* Linearly estimate the crossover times and distances */
+					for (i = 0; i < nx; i++) {	/* For each potential crossover */
+						if (!x2sys_cross_record (GMT, &W, T, &XC, i, out)) continue;	/* No data there */
 
-						dt = XC.xnode[k][i] - left[k];
-						time_x[k] = time[k][left[k]];
-						dist_x[k] = dist[k][left[k]];
-						if (dt > 0.0) {
-							time_x[k] += dt * delt;
-							dist_x[k] += dt * deld;
+						if (first_header) {	/* Write the header record */
+							x2sys_cross_table_header (GMT, &W, options);
+							first_header = false;
 						}
-
-
-						for (j = 0; j < n_data_col; j++) {	/* Evaluate each field at the crossover */
-
-							col = col_number[j];
-
-							start = t_right = left[k];
-							end = t_left = right[k];
-							n_left = n_right = 0;
-
-							xdata[k][col] = GMT->session.d_NaN;	/* In case of nuthin' */
-
-							/* First find the required <window> points to the left of the xover */
-							start_s = start;
-							while (start_s >= 0 && n_left < Ctrl->W.width) {
-								if (!GMT_is_dnan (data[k][col][start])) {
-									n_left++;
-									if (t_left > left[k]) t_left = start;
-									y[Ctrl->W.width-n_left] = data[k][col][start];
-									t[Ctrl->W.width-n_left] = time[k][start];
-								}
-								start--;
-								start_s--;
-							}
-
-							if (!n_left) continue;
-							if (got_time && ((time_x[k] - time[k][t_left]) > Bix.time_gap)) continue;
-							if ((dist_x[k] - dist[k][t_left]) > Bix.dist_gap) continue;
-
-							/* Ok, that worked.  Now for the right side: */
-
-							while (end < n_rec[k] && n_right < Ctrl->W.width) {
-								if (!GMT_is_dnan (data[k][col][end])) {
-									y[Ctrl->W.width+n_right] = data[k][col][end];
-									t[Ctrl->W.width+n_right] = time[k][end];
-									n_right++;
-									if (t_right < right[k]) t_right = end;
-								}
-								end++;
-							}
-
-							if (!n_right) continue;
-							/* See if we pass any gap criteria */
-							if (got_time && ((time[k][t_right] - time_x[k]) > Bix.time_gap)) continue;	/* Exceeded time gap */
-							if ((dist[k][t_right] - dist_x[k]) > Bix.dist_gap) continue;			/* Exceeded distance gap */
-
-							/* Ok, got enough data to interpolate at xover */
-
-							first = Ctrl->W.width - n_left;
-							n_errors = GMT_intpol (GMT, &t[first], &y[first], (n_left + n_right), 1, &time_x[k], &xdata[k][col], GMT->current.setting.interpolant);
-							if (n_errors == 0) {	/* OK */
-								ok[j]++;
-								n_ok++;
-							}
+						if (first_crossover) {
+							x2sys_cross_segment_header (GMT, trk_name[A], trk_name[B], T);
+							first_crossover = false;
 						}
+						GMT_Put_Record (API, GMT_WRITE_DOUBLE, out);	/* Write this to output */
 					}
 
-					/* Only output crossover if there are any data there */
-
-					if (n_ok == 0) continue;
-					for (j = n_ok = 0; j < n_data_col; j++) if (ok[j] == 2) n_ok++;
-					if (n_ok == 0) continue;
-
-					/* OK, got something to report */
-
-					/* Load the out array */
-
-					out[0] = XC.x[i];	/* Crossover location */
-					out[1] = XC.y[i];
-
-					for (k = 0; k < 2; k++) {	/* Get times, distances, headings, and velocities */
-
-						/* Get time */
-
-						out[2+k] = (got_time && !has_time[k]) ? X2SYS_NaN : time_x[k];
-
-						/* Get cumulative distance at crossover */
-
-						out[k+4] = dist_x[k];
-
-						/* Estimate heading there */
-
-						j = k + 6;
-						out[j] = (!GMT_is_dnan (speed[k]) && (!Ctrl->S.active[HHI] || speed[k] > Ctrl->S.limit[HHI])) ? (*GMT->current.map.azimuth_func) (GMT, data[k][s->x_col][right[k]], data[k][s->y_col][right[k]], data[k][s->x_col][left[k]], data[k][s->y_col][left[k]], false) : X2SYS_NaN;
-
-						/* Estimate velocities there */
+					GMT_x_free (GMT, &XC);
+				}
 
-						j = k + 8;
-						out[j] = (has_time[k]) ? speed[k] : X2SYS_NaN;
-					}
+				if (!same) x2sys_cross_free_track (GMT, s, &TB);	/* Must free up memory for B */
+				if (!Ctrl->C.active)
+					GMT_Report (API, GMT_MSG_VERBOSE, "%" PRIu64 "\n", nx);
+				else {
+					toc = x2sys_cross_wall_time ();
+					GMT_Report (API, GMT_MSG_VERBOSE, "%" PRIu64 "\t%.3f sec\n", nx, toc - tic);
+					if (fpC)	/* Save also the run time in file */
+						fprintf (fpC, "%s\t%s\t%d\t%.3f\n", trk_name[A], trk_name[B], (int)nx, toc - tic);
+				}
+			}
 
-					/* Calculate crossover and mean value */
+			x2sys_cross_free_track (GMT, s, &TA);	/* Must free up memory for A */
+		}
+	}
+	else {	/* -M: Load all tracks, find the pairs sharing index bins, and process those pairs in parallel */
+		uint64_t n_cand = 0, n_cand_alloc = GMT_CHUNK, n_entries = 0, n_list, chunk, first_pair, last_pair, lo, hi, mid;
+		uint64_t *list = NULL, *mark = NULL;
+		int64_t kk;
+		int thread = 0, n_threads = 1;
+		struct X2SYS_CROSS_TRACK *Trk = NULL;
+		struct X2SYS_CROSS_INDEX I;
+		struct X2SYS_CROSS_BINTRACK *entry = NULL;
+		struct X2SYS_CROSS_RESULT *cand = NULL, *R = NULL;
+		struct X2SYS_CROSS_WORK *Wt = NULL;
+
+		GMT_Report (API, GMT_MSG_VERBOSE, "Load all tracks into memory\n");
+		Trk = GMT_memory (GMT, NULL, n_tracks, struct X2SYS_CROSS_TRACK);
+		for (A = 0; A < n_tracks; A++) {
+			if (duplicate[A]) continue;
+			x2sys_err_fail (GMT, x2sys_cross_load (GMT, s, trk_name[A], &Trk[A], got_time, do_project, dist_scale), trk_name[A]);
+		}
 
-					for (k = 0, j = 10; k < n_data_col; k++) {
-						if (Ctrl->Z.active) {
-							col = col_number[k];
-							out[j++] = xdata[0][col];
-							out[j++] = xdata[1][col];
-						}
-						else {
-							if (ok[k] == 2) {
-								col = col_number[k];
-								out[j++] = xdata[0][col] - xdata[1][col];
-								out[j++] = 0.5 * (xdata[0][col] + xdata[1][col]);
-							}
-							else {
-								out[j] = out[j+1] = X2SYS_NaN;
-								j += 2;
-							}
-						}
-					}
+		/* Set up the index bins.  We use the bin spacing of the x2sys system, and its region unless we projected */
+		x2sys_bix_init (GMT, &Bix, false);
+		GMT_memset (&I, 1, struct X2SYS_CROSS_INDEX);
+		I.nx = (Bix.nx_bin > 0) ? Bix.nx_bin : 1;
+		I.ny = (Bix.ny_bin > 0) ? Bix.ny_bin : 1;
+		I.periodic = (wrap && !do_project);
+		if (do_project) {	/* Let bins cover all the projected tracks */
+			I.wesn[XLO] = I.wesn[YLO] = DBL_MAX;	I.wesn[XHI] = I.wesn[YHI] = -DBL_MAX;
+			for (A = 0; A < n_tracks; A++) for (i = 0; i < Trk[A].n_rec; i++) {
+				xx = Trk[A].data[s->x_col][i];	yy = Trk[A].data[s->y_col][i];
+				if (xx < I.wesn[XLO]) I.wesn[XLO] = xx;
+				if (xx > I.wesn[XHI]) I.wesn[XHI] = xx;
+				if (yy < I.wesn[YLO]) I.wesn[YLO] = yy;
+				if (yy > I.wesn[YHI]) I.wesn[YHI] = yy;
+			}
+		}
+		else
+			GMT_memcpy (I.wesn, Bix.wesn, 4, double);
+		if (I.periodic) {	/* Bins must wrap around exactly once */
+			I.nx = MAX (1, irint (360.0 * Bix.i_bin_x));
+			I.wesn[XHI] = I.wesn[XLO] + 360.0;
+		}
+		I.i_inc[GMT_X] = (I.wesn[XHI] > I.wesn[XLO]) ? I.nx / (I.wesn[XHI] - I.wesn[XLO]) : 1.0;
+		I.i_inc[GMT_Y] = (I.wesn[YHI] > I.wesn[YLO]) ? I.ny / (I.wesn[YHI] - I.wesn[YLO]) : 1.0;
+
+		/* Get the bins visited by each track; tracks are independent */
+#ifdef _OPENMP
+#pragma omp parallel for private(kk) shared(GMT,s,I,Trk,n_tracks) schedule(dynamic,1)
+#endif
+		for (kk = 0; kk < (int64_t)n_tracks; kk++) if (Trk[kk].n_rec) x2sys_cross_bin_track (GMT, s, &I, &Trk[kk]);
+
+		/* Build the list of (bin, track) entries sorted on bin */
+		for (A = 0; A < n_tracks; A++) n_entries += Trk[A].n_bins;
+		entry = GMT_memory (GMT, NULL, MAX (n_entries, 1), struct X2SYS_CROSS_BINTRACK);
+		for (A = k = 0; A < n_tracks; A++) for (i = 0; i < Trk[A].n_bins; i++, k++) {
+			entry[k].bin = Trk[A].bin[i];
+			entry[k].track = A;
+		}
+		qsort (entry, n_entries, sizeof (struct X2SYS_CROSS_BINTRACK), x2sys_cross_bintrack_comp);
+
+		/* Find the candidate pairs, in the same order as without -M */
+		mark = GMT_memory (GMT, NULL, n_tracks, uint64_t);
+		list = GMT_memory (GMT, NULL, n_tracks, uint64_t);
+		cand = GMT_memory (GMT, NULL, n_cand_alloc, struct X2SYS_CROSS_RESULT);
+		for (A = 0; A < n_tracks; A++) {
+			if (duplicate[A] || Trk[A].n_rec == 0) continue;
+			n_list = 0;
+			mark[A] = A + 1;	/* The internal pair is always a candidate */
+			list[n_list++] = A;
+			for (i = 0; i < Trk[A].n_bins; i++) {	/* Collect the later tracks visiting any of the same bins */
+				lo = 0;	hi = n_entries;	/* Binary search for the first entry in this bin */
+				while (lo < hi) {
+					mid = (lo + hi) / 2;
+					if (entry[mid].bin < Trk[A].bin[i]) lo = mid + 1; else hi = mid;
+				}
+				for (k = lo; k < n_entries && entry[k].bin == Trk[A].bin[i]; k++) {
+					B = entry[k].track;
+					if (B < A || mark[B] == A + 1) continue;
+					mark[B] = A + 1;
+					list[n_list++] = B;
+				}
+			}
+			if (n_list > 1) qsort (list, n_list, sizeof (uint64_t), x2sys_cross_uint64_comp);
+			for (k = 0; k < n_list; k++) {
+				B = list[k];
+				same = !strcmp (trk_name[A], trk_name[B]);
+				if (same && !(A == B)) {
+					GMT_Report (API, GMT_MSG_NORMAL, "File %s repeated on command line - skipped\n", trk_name[A]);
+					continue;
+				}
+				if (!internal &&  same) continue;	/* Only do external errors */
+				if (!external && !same) continue;	/* Only do internal errors */
+				if (Ctrl->A.active && !combo_ok (trk_name[A], trk_name[B], pair, n_pairs)) continue;	/* Do not want this combo */
+				if (n_cand == n_cand_alloc) {
+					n_cand_alloc <<= 1;
+					cand = GMT_memory (GMT, cand, n_cand_alloc, struct X2SYS_CROSS_RESULT);
+				}
+				GMT_memset (&cand[n_cand], 1, struct X2SYS_CROSS_RESULT);
+				cand[n_cand].A = A;
+				cand[n_cand++].B = B;
+			}
+		}
+		GMT_free (GMT, entry);
+		GMT_free (GMT, mark);
+		GMT_free (GMT, list);
+		GMT_Report (API, GMT_MSG_VERBOSE, "Index bins leave %" PRIu64 " track pairs to examine\n", n_cand);
+
+		/* Each thread needs its own scratch space */
+#ifdef _OPENMP
+		n_threads = omp_get_max_threads ();
+#endif
+		Wt = GMT_memory (GMT, NULL, n_threads, struct X2SYS_CROSS_WORK);
+		for (k = 0; k < (uint64_t)n_threads; k++) {
+			Wt[k] = W;
+			Wt[k].xdata[0] = GMT_memory (GMT, NULL, s->n_out_columns, double);
+			Wt[k].xdata[1] = GMT_memory (GMT, NULL, s->n_out_columns, double);
+			if (n_data_col) {
+				Wt[k].t = GMT_memory (GMT, NULL, window_width, double);
+				Wt[k].y = GMT_memory (GMT, NULL, window_width, double);
+				Wt[k].ok = GMT_memory (GMT, NULL, n_data_col, unsigned int);
+			}
+		}
 
-					if (first_header) {	/* Write the header record */
-						char *cmd = NULL, *c = GMT->current.setting.io_col_separator;
-						t_or_i = (got_time) ? 't' : 'i';
-						sprintf (line, "# Tag: %s", Ctrl->T.TAG);
-						GMT_Put_Record (API, GMT_WRITE_TABLE_HEADER, line);
-						cmd = GMT_Create_Cmd (API, options);
-						sprintf (line, "# Command: %s %s", THIS_MODULE_NAME, cmd);	/* Build command line argument string */
-						GMT_free (GMT, cmd);
-						GMT_Put_Record (API, GMT_WRITE_TABLE_HEADER, line);
-						sprintf (line, "# %s%s%s%s%c_1%s%c_2%sdist_1%sdist_2%shead_1%shead_2%svel_1%svel_2",
-							s->info[s->out_order[s->x_col]].name, c, s->info[s->out_order[s->y_col]].name, c, t_or_i, c, t_or_i, c, c, c, c, c, c);
-						for (j = 0; j < n_data_col; j++) {
-							col = col_number[j];
-							if (Ctrl->Z.active)
-								sprintf (item, "%s%s_1%s%s_2", c, s->info[s->out_order[col]].name, c, s->info[s->out_order[col]].name);
-							else
-								sprintf (item, "%s%s_X%s%s_M", c, s->info[s->out_order[col]].name, c, s->info[s->out_order[col]].name);
-							strcat (line, item);
-						}
-						GMT_Put_Record (API, GMT_WRITE_TABLE_HEADER, line);
-						first_header = false;
+		/* Process the pairs in chunks; the pairs in a chunk are shared among the threads and then
+		 * their results are written in order so the output is the same as without -M.  The headings
+		 * come from GMT->current.map.azimuth_func, so every azimuth function must be reentrant */
+		chunk = 64 * n_threads;
+		for (first_pair = 0; first_pair < n_cand; first_pair += chunk) {
+			last_pair = MIN (first_pair + chunk, n_cand);
+#ifdef _OPENMP
+#pragma omp parallel for private(kk,thread) shared(GMT,Wt,Trk,cand,first_pair,last_pair,wrap,xover_locations_only,n_output) schedule(dynamic,1)
+#endif
+			for (kk = (int64_t)first_pair; kk < (int64_t)last_pair; kk++) {
+#ifdef _OPENMP
+				thread = omp_get_thread_num ();
+#endif
+				x2sys_cross_pair (GMT, &Wt[thread], &Trk[cand[kk].A], &Trk[cand[kk].B], wrap, xover_locations_only, n_output, &cand[kk]);
+			}
+			for (k = first_pair; k < last_pair; k++) {
+				R = &cand[k];
+				A = R->A;	B = R->B;
+				T[0] = &Trk[A];	T[1] = &Trk[B];
+				if (R->n_out) {
+					if (xover_locations_only) {
+						sprintf (line, "%s - %s", trk_name[A], trk_name[B]);
+						GMT_Put_Record (API, GMT_WRITE_SEGMENT_HEADER, line);
 					}
-
-					if (first_crossover) {
-						char info[GMT_BUFSIZ] = {""}, start[2][GMT_LEN64], stop[2][GMT_LEN64];
-						for (k = 0; k < 2; k++) {
-							if (has_time[k]) {	/* Find first and last record times */
-								for (j = 0; j < n_rec[k] && GMT_is_dnan (time[k][j]); j++);	/* Find first non-NaN time */
-								GMT_ascii_format_col (GMT, start[k], time[k][j], GMT_OUT, 2);
-								for (j = n_rec[k]-1; j > 0 && GMT_is_dnan (time[k][j]); j--);	/* Find last non-NaN time */
-								GMT_ascii_format_col (GMT, stop[k], time[k][j], GMT_OUT, 3);
-							}
-							else {
-								strcpy (start[k], "NaN");
-								strcpy (stop[k], "NaN");
-							}
+					else {
+						if (first_header) {	/* Write the header record */
+							x2sys_cross_table_header (GMT, &W, options);
+							first_header = false;
 						}
-						sprintf (info, "%s/%s/%g %s/%s/%g", start[0], stop[0], dist[0][n_rec[0]-1], start[1], stop[1], dist[1][n_rec[1]-1]);
-						sprintf (line, x2sys_header, trk_name[A], data_set[0].year, trk_name[B], data_set[1].year, info);
-						GMT_Put_Record (API, GMT_WRITE_SEGMENT_HEADER, line);
-						first_crossover = false;
+						x2sys_cross_segment_header (GMT, trk_name[A], trk_name[B], T);
 					}
-
-					if (s->geographic) GMT_lon_range_adjust (s->geodetic, &out[0]);
-					GMT_Put_Record (API, GMT_WRITE_DOUBLE, out);	/* Write this to output */
+					for (i = 0; i < R->n_out; i++) GMT_Put_Record (API, GMT_WRITE_DOUBLE, &R->out[i*n_output]);	/* Write this to output */
+				}
+				if (R->nx) GMT_free (GMT, R->out);
+				if (!Ctrl->C.active)
+					GMT_Report (API, GMT_MSG_VERBOSE, "Processing %s - %s : %" PRIu64 "\n", trk_name[A], trk_name[B], R->nx);
+				else {
+					GMT_Report (API, GMT_MSG_VERBOSE, "Processing %s - %s : %" PRIu64 "\t%.3f sec\n", trk_name[A], trk_name[B], R->nx, R->run_time);
+					if (fpC)	/* Save also the run time in file */
+						fprintf (fpC, "%s\t%s\t%d\t%.3f\n", trk_name[A], trk_name[B], (int)R->nx, R->run_time);
 				}
-
-				GMT_x_free (GMT, &XC);
 			}
+		}
 
-			if (!same) {	/* Must free up memory for B */
-				x2sys_free_data (GMT, data[1], s->n_out_columns, &data_set[1]);
-				GMT_free (GMT, dist[1]);
-				if (!got_time) GMT_free (GMT, time[1]);
-				GMT_free (GMT, ylist_B);
-			}
-			if (!Ctrl->C.active)
-				GMT_Report (API, GMT_MSG_VERBOSE, "%" PRIu64 "\n", nx);
-			else {
-				toc = clock();
-				GMT_Report (API, GMT_MSG_VERBOSE, "%" PRIu64 "\t%.3f sec\n", nx, (double)(toc - tic)/1000);
-				if (fpC)	/* Save also the run time in file */
-					fprintf (fpC, "%s\t%s\t%d\t%.3f\n", trk_name[A], trk_name[B], (int)nx, (double)(toc - tic)/1000);
+		for (k = 0; k < (uint64_t)n_threads; k++) {
+			GMT_free (GMT, Wt[k].xdata[0]);
+			GMT_free (GMT, Wt[k].xdata[1]);
+			if (n_data_col) {
+				GMT_free (GMT, Wt[k].t);
+				GMT_free (GMT, Wt[k].y);
+				GMT_free (GMT, Wt[k].ok);
 			}
 		}
-
-		/* Must free up memory for A */
-
-		x2sys_free_data (GMT, data[0], s->n_out_columns, &data_set[0]);
-		GMT_free (GMT, dist[0]);
-		if (!got_time) GMT_free (GMT, time[0]);
-		GMT_free (GMT, ylist_A);
+		GMT_free (GMT, Wt);
+		GMT_free (GMT, cand);
+		for (A = 0; A < n_tracks; A++) x2sys_cross_free_track (GMT, s, &Trk[A]);
+		GMT_free (GMT, Trk);
 	}
 
 	if (fpC) fclose (fpC);
@@ -0,0 +1,45 @@
+#!/bin/bash
+#	$Id$
+#
+# Make sure gmtselect writes each segment header in front of the
+# records of its own segment, also when a whole segment is rejected.
+
+log=segheaders.log
+
+cat << EOF > segs.d
+> seg A
+0	0
+1	1
+> seg B
+5	5
+6	6
+> seg C
+10	10
+EOF
+cat << EOF > all.d
+0	0
+5	5
+10	10
+EOF
+cat << EOF > ends.d
+0	0
+10	10
+EOF
+cat << EOF > truth.d
+> seg A
+0	0
+1	1
+> seg B
+5	5
+6	6
+> seg C
+10	10
+> seg A
+0	0
+1	1
+> seg C
+10	10
+EOF
+gmt gmtselect segs.d -C2/all.d > $log
+gmt gmtselect segs.d -C2/ends.d >> $log
+diff $log truth.d --strip-trailing-cr > fail
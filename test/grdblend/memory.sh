@@ -0,0 +1,35 @@
+#!/bin/bash
+#	$Id$
+#
+# Make sure gmt grdblend -M gives the same grid as the row-by-row
+# blending, both for grids that are co-registered with the output
+# and for grids that must be resampled onto it.
+
+log=memory.log
+
+# Co-registered grids with overlaps and tapers
+gmt grdmath -R0/6/0/6 -I0.1 X Y MUL = a.nc
+gmt grdmath -R4/10/0/5 -I0.1 X SIN Y MUL = b.nc
+gmt grdmath -R0/6/4/10 -I0.1 8 = c.nc
+gmt grdmath -R4/10/4/10 -I0.1 X Y ADD = d.nc
+cat << EOF > info.txt
+a.nc	-R1/5/1/5	1
+b.nc	-R5/10/1/4	1
+c.nc	-R5/9/5/9	1
+d.nc	-R1/5/5/9	1
+EOF
+gmt grdblend info.txt -R0/10/0/10 -I0.1 -Grow.nc
+gmt grdblend info.txt -R0/10/0/10 -I0.1 -M -Gmem.nc
+gmt grdmath row.nc mem.nc SUB = diff.nc
+gmt grd2xyz diff.nc -ZTLa > $log
+
+# Pixel-registered and coarser grids that must be resampled
+gmt grdmath -R0/6/0/6 -I0.2 -r X Y MUL = a.nc
+gmt grdmath -R4/10/0/5 -I0.25 X SIN Y MUL = b.nc
+gmt grdblend info.txt -R0/10/0/10 -I0.1 -Grow.nc
+gmt grdblend info.txt -R0/10/0/10 -I0.1 -M -Gmem.nc
+gmt grdmath row.nc mem.nc SUB ABS 1e-5 GT = diff.nc
+gmt grd2xyz diff.nc -ZTLa >> $log
+
+res=`gmt info -C $log`
+echo ${res[0]} ${res[1]} | $AWK '{if($1 != 0 || $2 != 0) print 1}' > fail
@@ -0,0 +1,39 @@
+#!/bin/bash
+#	$Id$
+#
+# Make sure gmt grdlandmask gives the same mask when the shorelines come
+# from the GSHHG cache in GMT_GSHHG_CACHEDIR, both when the cache is built
+# and when it is reused, and that the cache is rebuilt once the netCDF
+# file it was made from changes.  We work on a copy of the crude file so
+# we can touch it.
+
+log=cache.log
+
+mkdir -p gshhg cachedir
+cp -f "${GSHHG_DIR}/binned_GSHHS_c.nc" gshhg/
+unset GMT_GSHHG_CACHEDIR
+gmt grdlandmask -R-30/30/-30/30 -I1 -Dc -N0/1/2/3/4 -Gnocache.nc --DIR_GSHHG=`pwd`/gshhg
+gmt grd2xyz nocache.nc > nocache.txt
+
+export GMT_GSHHG_CACHEDIR=`pwd`/cachedir
+rm -f $log
+for run in build reuse; do
+	gmt grdlandmask -R-30/30/-30/30 -I1 -Dc -N0/1/2/3/4 -Gcache.nc --DIR_GSHHG=`pwd`/gshhg
+	gmt grd2xyz cache.nc | diff - nocache.txt --strip-trailing-cr >> $log
+done
+if [ ! -f cachedir/binned_GSHHS_c.cache ]; then
+	echo "cache was not created" >> $log
+fi
+
+# Make the cache look old, then change the netCDF file it came from
+touch -t 200001010000 cachedir/binned_GSHHS_c.cache
+touch -t 200001010001 stamp
+touch gshhg/binned_GSHHS_c.nc
+gmt grdlandmask -R-30/30/-30/30 -I1 -Dc -N0/1/2/3/4 -Gcache.nc --DIR_GSHHG=`pwd`/gshhg
+gmt grd2xyz cache.nc | diff - nocache.txt --strip-trailing-cr >> $log
+if [ ! cachedir/binned_GSHHS_c.cache -nt stamp ]; then
+	echo "cache was not rebuilt" >> $log
+fi
+
+rm -rf gshhg cachedir stamp
+diff $log /dev/null > fail
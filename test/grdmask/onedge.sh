@@ -0,0 +1,70 @@
+#!/bin/bash
+#	$Id$
+#
+# Make sure gmt grdmask finds the nodes that lie exactly on sloped,
+# vertical and horizontal polygon edges, and sets the ones in the
+# notch between two sloped edges to outside.
+
+log=onedge.log
+
+cat << EOF > poly.d
+0	0
+4	2
+2	3
+4	4
+0	4
+EOF
+cat << EOF > truth.d
+-1	5	0
+0	5	0
+1	5	0
+2	5	0
+3	5	0
+4	5	0
+5	5	0
+-1	4	0
+0	4	5
+1	4	5
+2	4	5
+3	4	5
+4	4	5
+5	4	0
+-1	3	0
+0	3	5
+1	3	9
+2	3	5
+3	3	0
+4	3	0
+5	3	0
+-1	2	0
+0	2	5
+1	2	9
+2	2	9
+3	2	9
+4	2	5
+5	2	0
+-1	1	0
+0	1	5
+1	1	9
+2	1	5
+3	1	0
+4	1	0
+5	1	0
+-1	0	0
+0	0	5
+1	0	0
+2	0	0
+3	0	0
+4	0	0
+5	0	0
+-1	-1	0
+0	-1	0
+1	-1	0
+2	-1	0
+3	-1	0
+4	-1	0
+5	-1	0
+EOF
+gmt grdmask poly.d -R-1/5/-1/5 -I1 -N0/5/9 -Gmask.nc
+gmt grd2xyz mask.nc > $log
+diff $log truth.d --strip-trailing-cr > fail